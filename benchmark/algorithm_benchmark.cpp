@@ -0,0 +1,202 @@
+#include "../src/algorithm.h"
+#include "../src/vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+// tracystl:: algorithms against libstdc++'s std:: ones over Vector<int> and
+// Vector<float> of 4K (L1) and 1M (L2/L3) elements. find and min/max_element
+// have to scan the whole range: the value looked for is not in it, the
+// extreme value is at the end. The Scalar/SSE2 variants pin the tracystl
+// kernels to that level, to compare them with the AVX2 default.
+
+namespace {
+
+template <class T>
+tracystl::Vector<T> make_data(size_t n) {
+  std::mt19937 rng(1);
+  tracystl::Vector<T> vec;
+  for (size_t i = 0; i < n; ++i) {
+    vec.push_back(static_cast<T>(rng() % 1000));
+  }
+  vec.back() = static_cast<T>(5000);
+  return vec;
+}
+
+struct Std {
+  template <class It, class T>
+  static It find(It first, It last, const T& value) {
+    return std::find(first, last, value);
+  }
+  template <class It, class T>
+  static auto count(It first, It last, const T& value) {
+    return std::count(first, last, value);
+  }
+  template <class It1, class It2>
+  static bool equal(It1 first1, It1 last1, It2 first2) {
+    return std::equal(first1, last1, first2);
+  }
+  template <class It>
+  static It max_element(It first, It last) {
+    return std::max_element(first, last);
+  }
+  template <class It, class T>
+  static T accumulate(It first, It last, T init) {
+    return std::accumulate(first, last, init);
+  }
+  template <class It1, class It2>
+  static It2 copy(It1 first, It1 last, It2 d_first) {
+    return std::copy(first, last, d_first);
+  }
+  template <class It, class T>
+  static void fill(It first, It last, const T& value) {
+    std::fill(first, last, value);
+  }
+};
+
+template <tracystl::simd_level Level>
+struct Tracy {
+  Tracy() { tracystl::set_simd_level(Level); }
+  ~Tracy() { tracystl::set_simd_level(tracystl::cpu_simd_level()); }
+  template <class It, class T>
+  static It find(It first, It last, const T& value) {
+    return tracystl::find(first, last, value);
+  }
+  template <class It, class T>
+  static auto count(It first, It last, const T& value) {
+    return tracystl::count(first, last, value);
+  }
+  template <class It1, class It2>
+  static bool equal(It1 first1, It1 last1, It2 first2) {
+    return tracystl::equal(first1, last1, first2);
+  }
+  template <class It>
+  static It max_element(It first, It last) {
+    return tracystl::max_element(first, last);
+  }
+  template <class It, class T>
+  static T accumulate(It first, It last, T init) {
+    return tracystl::accumulate(first, last, init);
+  }
+  template <class It1, class It2>
+  static It2 copy(It1 first, It1 last, It2 d_first) {
+    return tracystl::copy(first, last, d_first);
+  }
+  template <class It, class T>
+  static void fill(It first, It last, const T& value) {
+    tracystl::fill(first, last, value);
+  }
+};
+
+typedef Tracy<tracystl::simd_level::avx2> TracyAvx2;
+typedef Tracy<tracystl::simd_level::sse2> TracySse2;
+typedef Tracy<tracystl::simd_level::scalar> TracyScalar;
+
+template <class Impl, class T>
+void BM_Find(benchmark::State& state) {
+  const Impl impl;
+  const tracystl::Vector<T> data = make_data<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        impl.find(data.begin(), data.end(), static_cast<T>(-1)));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+template <class Impl, class T>
+void BM_Count(benchmark::State& state) {
+  const Impl impl;
+  const tracystl::Vector<T> data = make_data<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        impl.count(data.begin(), data.end(), static_cast<T>(7)));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+template <class Impl, class T>
+void BM_Equal(benchmark::State& state) {
+  const Impl impl;
+  const tracystl::Vector<T> a = make_data<T>(state.range(0));
+  const tracystl::Vector<T> b = a;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(impl.equal(a.begin(), a.end(), b.begin()));
+  }
+  state.SetBytesProcessed(state.iterations() * a.size() * sizeof(T));
+}
+
+template <class Impl, class T>
+void BM_MaxElement(benchmark::State& state) {
+  const Impl impl;
+  const tracystl::Vector<T> data = make_data<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(impl.max_element(data.begin(), data.end()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+template <class Impl, class T>
+void BM_Accumulate(benchmark::State& state) {
+  const Impl impl;
+  const tracystl::Vector<T> data = make_data<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        impl.accumulate(data.begin(), data.end(), static_cast<T>(0)));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+template <class Impl, class T>
+void BM_Copy(benchmark::State& state) {
+  const Impl impl;
+  const tracystl::Vector<T> src = make_data<T>(state.range(0));
+  tracystl::Vector<T> dst(src.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(impl.copy(src.begin(), src.end(), dst.begin()));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * src.size() * sizeof(T));
+}
+
+template <class Impl, class T>
+void BM_Fill(benchmark::State& state) {
+  const Impl impl;
+  tracystl::Vector<T> data(state.range(0));
+  for (auto _ : state) {
+    impl.fill(data.begin(), data.end(), static_cast<T>(0));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+void Sizes(benchmark::internal::Benchmark* b) {
+  b->Arg(1 << 12)->Arg(1 << 20);
+}
+
+}  // namespace
+
+#define TRACYSTL_BENCH_ALGORITHM(bm, T)                  \
+  BENCHMARK_TEMPLATE(bm, Std, T)->Apply(Sizes);          \
+  BENCHMARK_TEMPLATE(bm, TracyScalar, T)->Apply(Sizes);  \
+  BENCHMARK_TEMPLATE(bm, TracySse2, T)->Apply(Sizes);    \
+  BENCHMARK_TEMPLATE(bm, TracyAvx2, T)->Apply(Sizes);
+
+TRACYSTL_BENCH_ALGORITHM(BM_Find, int)
+TRACYSTL_BENCH_ALGORITHM(BM_Find, float)
+TRACYSTL_BENCH_ALGORITHM(BM_Count, int)
+TRACYSTL_BENCH_ALGORITHM(BM_Count, float)
+TRACYSTL_BENCH_ALGORITHM(BM_Equal, int)
+TRACYSTL_BENCH_ALGORITHM(BM_Equal, float)
+TRACYSTL_BENCH_ALGORITHM(BM_MaxElement, int)
+TRACYSTL_BENCH_ALGORITHM(BM_MaxElement, float)
+TRACYSTL_BENCH_ALGORITHM(BM_Accumulate, int)
+TRACYSTL_BENCH_ALGORITHM(BM_Accumulate, float)
+TRACYSTL_BENCH_ALGORITHM(BM_Copy, int)
+TRACYSTL_BENCH_ALGORITHM(BM_Copy, float)
+TRACYSTL_BENCH_ALGORITHM(BM_Fill, int)
+TRACYSTL_BENCH_ALGORITHM(BM_Fill, float)
+
+BENCHMARK_MAIN();
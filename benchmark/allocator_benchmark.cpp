@@ -0,0 +1,52 @@
+#include "../src/allocator.h"
+#include "../src/thread_cache_allocator.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+
+// Every thread keeps a small window of live objects and replaces one of them
+// per step, which is what a server doing per-message allocations looks like.
+
+namespace {
+
+struct Message {
+  int64_t payload[6];
+};
+
+template <class Alloc>
+void BM_SmallObjectChurn(benchmark::State& state) {
+  constexpr int kWindow = 256;
+  Alloc alloc;
+  Message* live[kWindow];
+  for (int i = 0; i < kWindow; ++i) {
+    live[i] = alloc.allocate(1);
+  }
+  uint32_t slot = 0;
+  for (auto _ : state) {
+    slot = (slot * 1103515245u + 12345u);
+    const int victim = static_cast<int>(slot % kWindow);
+    alloc.deallocate(live[victim], 1);
+    live[victim] = alloc.allocate(1);
+    benchmark::DoNotOptimize(live[victim]);
+  }
+  for (int i = 0; i < kWindow; ++i) {
+    alloc.deallocate(live[i], 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_SmallObjectChurn, std::allocator<Message>)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SmallObjectChurn, tracystl::Allocator<Message>)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SmallObjectChurn, tracystl::ThreadCacheAllocator<Message>)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+#include "../src/btree.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+// BTreeMap against std::map keyed by 64-bit timestamps.
+//
+//   Insert       build a map of n random timestamps from empty
+//   Lookup       find present keys in random order
+//   RangeScan    lower_bound a random timestamp, then sum the next 100 values
+//   SortedLoad   build from already sorted input (sorted_unique for BTreeMap,
+//                end hint for std::map)
+
+namespace {
+
+typedef std::map<uint64_t, uint64_t> StdMap;
+typedef tracystl::BTreeMap<uint64_t, uint64_t> TracyMap;
+
+std::vector<uint64_t> make_keys(size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<uint64_t> keys(n);
+  for (uint64_t& key : keys) {
+    key = rng();
+  }
+  return keys;
+}
+
+template <class Map>
+Map build(const std::vector<uint64_t>& keys) {
+  Map map;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    map[keys[i]] = i;
+  }
+  return map;
+}
+
+template <class Map>
+void BM_Insert(benchmark::State& state) {
+  const std::vector<uint64_t> keys = make_keys(state.range(0), 1);
+  for (auto _ : state) {
+    Map map;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      map[keys[i]] = i;
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <class Map>
+void BM_Lookup(benchmark::State& state) {
+  std::vector<uint64_t> keys = make_keys(state.range(0), 1);
+  const Map map = build<Map>(keys);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(2));
+  size_t i = 0;
+  uint64_t sum = 0;
+  for (auto _ : state) {
+    sum += map.find(keys[i])->second;
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Map>
+void BM_RangeScan(benchmark::State& state) {
+  const Map map = build<Map>(make_keys(state.range(0), 1));
+  const std::vector<uint64_t> starts = make_keys(4096, 3);
+  size_t i = 0;
+  uint64_t sum = 0;
+  for (auto _ : state) {
+    auto it = map.lower_bound(starts[i++ & 4095]);
+    for (int n = 0; n < 100 && it != map.end(); ++n, ++it) {
+      sum += it->second;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SortedLoadStd(benchmark::State& state) {
+  std::vector<uint64_t> keys = make_keys(state.range(0), 1);
+  std::sort(keys.begin(), keys.end());
+  for (auto _ : state) {
+    StdMap map;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      map.emplace_hint(map.end(), keys[i], i);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void BM_SortedLoadTracy(benchmark::State& state) {
+  std::vector<uint64_t> keys = make_keys(state.range(0), 1);
+  std::sort(keys.begin(), keys.end());
+  std::vector<std::pair<uint64_t, uint64_t>> sorted;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    sorted.emplace_back(keys[i], i);
+  }
+  for (auto _ : state) {
+    TracyMap map(tracystl::sorted_unique, sorted.begin(), sorted.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void Sizes(benchmark::internal::Benchmark* b) { b->Arg(1000)->Arg(1000000); }
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Insert, StdMap)
+    ->Apply(Sizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, TracyMap)
+    ->Apply(Sizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Lookup, StdMap)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_Lookup, TracyMap)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_RangeScan, StdMap)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_RangeScan, TracyMap)->Apply(Sizes);
+BENCHMARK(BM_SortedLoadStd)->Apply(Sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SortedLoadTracy)->Apply(Sizes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,37 @@
+# `cd benchmark`, then run `./commands.sh` to compile all benchmarks.
+# Always benchmark optimized builds; -DNDEBUG strips assertions.
+
+#vector_benchmark
+g++ -std=c++20 -O2 -DNDEBUG vector_benchmark.cpp -lbenchmark -pthread -o vector_benchmark
+#list_benchmark
+g++ -std=c++20 -O2 -DNDEBUG list_benchmark.cpp -lbenchmark -pthread -o list_benchmark
+#allocator_benchmark
+g++ -std=c++20 -O2 -DNDEBUG allocator_benchmark.cpp -lbenchmark -pthread -o allocator_benchmark
+#deque_benchmark
+g++ -std=c++20 -O2 -DNDEBUG deque_benchmark.cpp -lbenchmark -pthread -o deque_benchmark
+#ring_buffer_benchmark
+g++ -std=c++20 -O2 -DNDEBUG ring_buffer_benchmark.cpp -lbenchmark -pthread -o ring_buffer_benchmark
+#mpmc_queue_benchmark
+g++ -std=c++20 -O2 -DNDEBUG mpmc_queue_benchmark.cpp -lbenchmark -pthread -o mpmc_queue_benchmark
+#small_vector_benchmark
+g++ -std=c++20 -O2 -DNDEBUG small_vector_benchmark.cpp -lbenchmark -pthread -o small_vector_benchmark
+#hash_map_benchmark
+g++ -std=c++20 -O2 -DNDEBUG hash_map_benchmark.cpp -lbenchmark -pthread -o hash_map_benchmark
+#btree_benchmark
+g++ -std=c++20 -O2 -DNDEBUG btree_benchmark.cpp -lbenchmark -pthread -o btree_benchmark
+#flat_map_benchmark
+g++ -std=c++20 -O2 -DNDEBUG flat_map_benchmark.cpp -lbenchmark -pthread -o flat_map_benchmark
+#algorithm_benchmark
+g++ -std=c++20 -O2 -DNDEBUG algorithm_benchmark.cpp -lbenchmark -pthread -o algorithm_benchmark
+#sort_benchmark
+g++ -std=c++20 -O2 -DNDEBUG sort_benchmark.cpp -lbenchmark -pthread -o sort_benchmark
+#execution_benchmark
+g++ -std=c++20 -O2 -DNDEBUG execution_benchmark.cpp -lbenchmark -pthread -o execution_benchmark
+#unrolled_list_benchmark
+g++ -std=c++20 -O2 -DNDEBUG unrolled_list_benchmark.cpp -lbenchmark -pthread -o unrolled_list_benchmark
+#string_benchmark
+g++ -std=c++20 -O2 -DNDEBUG string_benchmark.cpp -lbenchmark -pthread -o string_benchmark
+#priority_queue_benchmark
+g++ -std=c++20 -O2 -DNDEBUG priority_queue_benchmark.cpp -lbenchmark -pthread -o priority_queue_benchmark
+#dynamic_bitset_benchmark
+g++ -std=c++20 -O2 -DNDEBUG dynamic_bitset_benchmark.cpp -lbenchmark -pthread -o dynamic_bitset_benchmark
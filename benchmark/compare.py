@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Compare two runs of the benchmarks and flag regressions.
+
+Each run is a Google Benchmark JSON file (--benchmark_out_format=json) or a
+directory of them, such as the benchmark_results directory the run_*
+targets write. Benchmarks are matched by name; with --benchmark_repetitions
+the median of the repetitions is compared.
+
+    python3 compare.py baseline/ contender/ --threshold 5
+
+Exits with status 1 when a benchmark got slower by more than the threshold
+(in percent), so it can gate a CI job.
+"""
+
+import argparse
+import json
+import os
+import statistics
+import sys
+
+TIME_UNITS_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_file(path, metric):
+    """Returns {benchmark name: time in ns} for one JSON file."""
+    with open(path) as f:
+        data = json.load(f)
+    samples = {}
+    medians = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        time_ns = bench[metric] * TIME_UNITS_NS[bench.get("time_unit", "ns")]
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[bench["run_name"]] = time_ns
+        else:
+            name = bench.get("run_name", bench["name"])
+            samples.setdefault(name, []).append(time_ns)
+    results = {name: statistics.median(times)
+               for name, times in samples.items()}
+    results.update(medians)
+    return results
+
+
+def load(path, metric):
+    """Returns {(file name, benchmark name): time in ns} for a directory, or
+    {("", benchmark name): time in ns} for a single file."""
+    if not os.path.isdir(path):
+        return {("", name): time_ns
+                for name, time_ns in load_file(path, metric).items()}
+    results = {}
+    for file in sorted(os.listdir(path)):
+        if file.endswith(".json"):
+            stem = os.path.splitext(file)[0]
+            for name, time_ns in load_file(os.path.join(path, file),
+                                           metric).items():
+                results[(stem, name)] = time_ns
+    return results
+
+
+def format_ns(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return "%.3g %s" % (ns / scale, unit)
+    return "%.3g ns" % ns
+
+
+def main(args):
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+
+    rows = []
+    regressions = 0
+    for key in sorted(baseline.keys() & contender.keys()):
+        old, new = baseline[key], contender[key]
+        change = (new - old) / old * 100 if old > 0 else 0.0
+        if change > args.threshold:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            verdict = "improved"
+        else:
+            verdict = ""
+        if verdict or not args.only_changes:
+            name = "%s: %s" % key if key[0] else key[1]
+            rows.append((name, format_ns(old), format_ns(new),
+                         "%+.1f%%" % change, verdict))
+
+    if rows:
+        width = max(len(row[0]) for row in rows)
+        print("%-*s %11s %11s %9s" % (width, "Benchmark", "Baseline",
+                                       "Contender", "Change"))
+        for name, old, new, change, verdict in rows:
+            print("%-*s %11s %11s %9s  %s" % (width, name, old, new, change,
+                                               verdict))
+
+    for label, missing in (("baseline", contender.keys() - baseline.keys()),
+                           ("contender", baseline.keys() - contender.keys())):
+        if missing:
+            print("\n%d benchmark(s) missing from the %s run, not compared"
+                  % (len(missing), label))
+
+    print("\n%d benchmark(s) compared, %d slower by more than %g%% (%s)"
+          % (len(baseline.keys() & contender.keys()), regressions,
+             args.threshold, args.metric))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Flag benchmarks that got slower between two runs.")
+    parser.add_argument("baseline", help="JSON file or directory of them")
+    parser.add_argument("contender", help="JSON file or directory of them")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="percent slowdown reported as a regression "
+                             "(default: 5)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"),
+                        default="cpu_time",
+                        help="time to compare (default: cpu_time)")
+    parser.add_argument("--only-changes", action="store_true",
+                        help="list only benchmarks beyond the threshold")
+    sys.exit(main(parser.parse_args()))
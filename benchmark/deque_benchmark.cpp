@@ -0,0 +1,49 @@
+#include "../src/deque.h"
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+
+// A work queue in steady state: n queued items, one pop_front and one
+// push_back per step.
+
+namespace {
+
+template <class Container>
+void BM_DequeFifo(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  Container q;
+  for (int i = 0; i < n; ++i) {
+    q.push_back(i);
+  }
+  int i = 0;
+  for (auto _ : state) {
+    q.pop_front();
+    q.push_back(++i);
+  }
+  benchmark::DoNotOptimize(q.back());
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Container>
+void BM_DequePushBothEnds(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Container q;
+    for (int i = 0; i < n; ++i) {
+      q.push_back(i);
+      q.push_front(i);
+    }
+    benchmark::DoNotOptimize(&q);
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * n);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_DequeFifo, tracystl::Deque<int>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_DequeFifo, std::deque<int>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_DequePushBothEnds, tracystl::Deque<int>)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_DequePushBothEnds, std::deque<int>)->Range(1 << 8, 1 << 20);
+
+BENCHMARK_MAIN();
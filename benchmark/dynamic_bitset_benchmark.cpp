@@ -0,0 +1,150 @@
+#include "../src/dynamic_bitset.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Bitsets of n bits with a quarter of them set at random, the way a
+// scheduler tracks free slots or a query engine tracks matching rows.
+//
+// Count: number of set bits.
+// And: intersect one bitset with another in place.
+// Iterate: visit the index of every set bit, for a dense (25%) and a sparse
+// (1 in 1000) bitset.
+//
+// std::vector<bool> is walked a bit at a time, as code written against it
+// usually does; DynamicBitset runs once per kernel set.
+
+namespace {
+
+std::vector<bool> random_bits(size_t n, unsigned per_mille, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::vector<bool> bits(n);
+  for (size_t i = 0; i < n; ++i) {
+    bits[i] = rng() % 1000 < per_mille;
+  }
+  return bits;
+}
+
+tracystl::DynamicBitset to_bitset(const std::vector<bool>& bits) {
+  tracystl::DynamicBitset result(bits.size());
+  for (size_t i = 0; i < bits.size(); ++i) {
+    result.set(i, bits[i]);
+  }
+  return result;
+}
+
+template <tracystl::simd_level Level>
+bool use_level(benchmark::State& state) {
+  if (Level > tracystl::cpu_simd_level()) {
+    state.SkipWithError("kernel set not supported by this CPU");
+    return false;
+  }
+  tracystl::set_simd_level(Level);
+  return true;
+}
+
+void BM_CountStd(benchmark::State& state) {
+  const std::vector<bool> bits =
+      random_bits(static_cast<size_t>(state.range(0)), 250, 1);
+  for (auto _ : state) {
+    size_t count = 0;
+    for (size_t i = 0; i < bits.size(); ++i) {
+      count += bits[i];
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <tracystl::simd_level Level>
+void BM_CountTracy(benchmark::State& state) {
+  if (!use_level<Level>(state)) {
+    return;
+  }
+  const tracystl::DynamicBitset bits =
+      to_bitset(random_bits(static_cast<size_t>(state.range(0)), 250, 1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(bits.count());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  tracystl::set_simd_level(tracystl::cpu_simd_level());
+}
+
+void BM_AndStd(benchmark::State& state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  std::vector<bool> a = random_bits(n, 250, 1);
+  const std::vector<bool> b = random_bits(n, 900, 2);
+  for (auto _ : state) {
+    for (size_t i = 0; i < n; ++i) {
+      a[i] = a[i] && b[i];
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <tracystl::simd_level Level>
+void BM_AndTracy(benchmark::State& state) {
+  if (!use_level<Level>(state)) {
+    return;
+  }
+  const size_t n = static_cast<size_t>(state.range(0));
+  tracystl::DynamicBitset a = to_bitset(random_bits(n, 250, 1));
+  const tracystl::DynamicBitset b = to_bitset(random_bits(n, 900, 2));
+  for (auto _ : state) {
+    a &= b;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  tracystl::set_simd_level(tracystl::cpu_simd_level());
+}
+
+void BM_IterateStd(benchmark::State& state) {
+  const std::vector<bool> bits = random_bits(
+      static_cast<size_t>(state.range(0)), static_cast<unsigned>(state.range(1)),
+      3);
+  for (auto _ : state) {
+    size_t sum = 0;
+    for (size_t i = 0; i < bits.size(); ++i) {
+      if (bits[i]) {
+        sum += i;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_IterateTracy(benchmark::State& state) {
+  const tracystl::DynamicBitset bits = to_bitset(random_bits(
+      static_cast<size_t>(state.range(0)), static_cast<unsigned>(state.range(1)),
+      3));
+  for (auto _ : state) {
+    size_t sum = 0;
+    for (size_t i : bits.set_bits()) {
+      sum += i;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_CountStd)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_CountTracy, tracystl::simd_level::scalar)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_CountTracy, tracystl::simd_level::sse2)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_CountTracy, tracystl::simd_level::avx2)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_AndStd)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_AndTracy, tracystl::simd_level::scalar)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_AndTracy, tracystl::simd_level::sse2)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_AndTracy, tracystl::simd_level::avx2)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_IterateStd)->Args({1 << 16, 250})->Args({1 << 16, 1});
+BENCHMARK(BM_IterateTracy)->Args({1 << 16, 250})->Args({1 << 16, 1});
+
+BENCHMARK_MAIN();
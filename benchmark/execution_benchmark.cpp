@@ -0,0 +1,186 @@
+#include "../src/execution.h"
+#include "../src/vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+
+// Scaling of the execution::par algorithms with the number of workers:
+// every benchmark runs on pools of 1, 2, 4, ... threads up to the hardware
+// concurrency, over Vector<int> / Vector<float> of 8M elements. The Seq
+// variants are the sequential tracystl/std versions, as the baseline.
+// Times are wall clock.
+
+namespace {
+
+constexpr size_t kSize = 1 << 23;
+
+// one pool per thread count, kept for the whole run
+tracystl::ThreadPool& pool_with(size_t threads) {
+  static tracystl::Vector<std::unique_ptr<tracystl::ThreadPool>> pools;
+  while (pools.size() <= threads) {
+    pools.push_back(nullptr);
+  }
+  if (!pools[threads]) {
+    pools[threads] = std::make_unique<tracystl::ThreadPool>(threads);
+  }
+  return *pools[threads];
+}
+
+tracystl::Vector<int> make_ints(size_t n) {
+  std::mt19937 rng(1);
+  tracystl::Vector<int> vec;
+  vec.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    vec.push_back(static_cast<int>(rng() % 1000000));
+  }
+  return vec;
+}
+
+void BM_SortSeq(benchmark::State& state) {
+  const tracystl::Vector<int> input = make_ints(kSize);
+  tracystl::Vector<int> data(kSize);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::copy(input.begin(), input.end(), data.begin());
+    state.ResumeTiming();
+    tracystl::sort(data.begin(), data.end());
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+void BM_SortPar(benchmark::State& state) {
+  const auto par = tracystl::execution::par.on(pool_with(state.range(0)));
+  const tracystl::Vector<int> input = make_ints(kSize);
+  tracystl::Vector<int> data(kSize);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::copy(input.begin(), input.end(), data.begin());
+    state.ResumeTiming();
+    tracystl::sort(par, data.begin(), data.end());
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+// enough arithmetic per element that the loop is not memory bound
+struct heavy_op {
+  float operator()(float x) const {
+    return std::sqrt(x * x + 1.0f) * std::sin(x);
+  }
+};
+
+void BM_TransformSeq(benchmark::State& state) {
+  const tracystl::Vector<float> input(kSize, 0.5f);
+  tracystl::Vector<float> out(kSize);
+  for (auto _ : state) {
+    std::transform(input.begin(), input.end(), out.begin(), heavy_op());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+void BM_TransformPar(benchmark::State& state) {
+  const auto par = tracystl::execution::par.on(pool_with(state.range(0)));
+  const tracystl::Vector<float> input(kSize, 0.5f);
+  tracystl::Vector<float> out(kSize);
+  for (auto _ : state) {
+    tracystl::transform(par, input.begin(), input.end(), out.begin(),
+                        heavy_op());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+void BM_ForEachPar(benchmark::State& state) {
+  const auto par = tracystl::execution::par.on(pool_with(state.range(0)));
+  tracystl::Vector<float> data(kSize, 0.5f);
+  for (auto _ : state) {
+    tracystl::for_each(par, data.begin(), data.end(),
+                       [](float& x) { x = heavy_op()(x); });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+void BM_ReduceSeq(benchmark::State& state) {
+  const tracystl::Vector<int> data = make_ints(kSize);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::reduce(data.begin(), data.end(), static_cast<long>(0)));
+  }
+  state.SetBytesProcessed(state.iterations() * kSize * sizeof(int));
+}
+
+void BM_ReducePar(benchmark::State& state) {
+  const auto par = tracystl::execution::par.on(pool_with(state.range(0)));
+  const tracystl::Vector<int> data = make_ints(kSize);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        tracystl::reduce(par, data.begin(), data.end(), static_cast<long>(0)));
+  }
+  state.SetBytesProcessed(state.iterations() * kSize * sizeof(int));
+}
+
+void BM_InclusiveScanSeq(benchmark::State& state) {
+  const tracystl::Vector<int> data = make_ints(kSize);
+  tracystl::Vector<int> out(kSize);
+  for (auto _ : state) {
+    std::inclusive_scan(data.begin(), data.end(), out.begin());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * kSize * sizeof(int));
+}
+
+void BM_InclusiveScanPar(benchmark::State& state) {
+  const auto par = tracystl::execution::par.on(pool_with(state.range(0)));
+  const tracystl::Vector<int> data = make_ints(kSize);
+  tracystl::Vector<int> out(kSize);
+  for (auto _ : state) {
+    tracystl::inclusive_scan(par, data.begin(), data.end(), out.begin());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * kSize * sizeof(int));
+}
+
+void BM_ExclusiveScanPar(benchmark::State& state) {
+  const auto par = tracystl::execution::par.on(pool_with(state.range(0)));
+  const tracystl::Vector<int> data = make_ints(kSize);
+  tracystl::Vector<int> out(kSize);
+  for (auto _ : state) {
+    tracystl::exclusive_scan(par, data.begin(), data.end(), out.begin(), 0);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * kSize * sizeof(int));
+}
+
+void Threads(benchmark::internal::Benchmark* b) {
+  size_t hardware = std::thread::hardware_concurrency();
+  if (hardware == 0) {
+    hardware = 1;
+  }
+  for (size_t threads = 1; threads < hardware; threads *= 2) {
+    b->Arg(static_cast<int64_t>(threads));
+  }
+  b->Arg(static_cast<int64_t>(hardware));
+  b->ArgName("threads")->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SortSeq)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SortPar)->Apply(Threads);
+BENCHMARK(BM_TransformSeq)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TransformPar)->Apply(Threads);
+BENCHMARK(BM_ForEachPar)->Apply(Threads);
+BENCHMARK(BM_ReduceSeq)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReducePar)->Apply(Threads);
+BENCHMARK(BM_InclusiveScanSeq)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InclusiveScanPar)->Apply(Threads);
+BENCHMARK(BM_ExclusiveScanPar)->Apply(Threads);
+
+BENCHMARK_MAIN();
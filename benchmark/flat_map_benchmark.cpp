@@ -0,0 +1,106 @@
+#include "../src/flat_map.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+// FlatMap against std::map and a plain std::lower_bound over a sorted
+// std::vector, with 64-bit keys at 1K, 64K and 1M elements.
+//
+//   Lookup       find present keys in random order
+//   Build        build from n random pairs (one range insert for FlatMap)
+
+namespace {
+
+typedef std::pair<uint64_t, uint64_t> Pair;
+
+std::vector<Pair> make_pairs(size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<Pair> pairs(n);
+  for (size_t i = 0; i < n; ++i) {
+    pairs[i] = Pair(rng(), i);
+  }
+  return pairs;
+}
+
+std::vector<uint64_t> shuffled_keys(const std::vector<Pair>& pairs) {
+  std::vector<uint64_t> keys;
+  for (const Pair& p : pairs) {
+    keys.push_back(p.first);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(2));
+  return keys;
+}
+
+template <class Map>
+void BM_Lookup(benchmark::State& state) {
+  const std::vector<Pair> pairs = make_pairs(state.range(0), 1);
+  const Map map(pairs.begin(), pairs.end());
+  const std::vector<uint64_t> keys = shuffled_keys(pairs);
+  size_t i = 0;
+  uint64_t sum = 0;
+  for (auto _ : state) {
+    sum += map.find(keys[i])->second;
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_LookupStdLowerBound(benchmark::State& state) {
+  std::vector<Pair> pairs = make_pairs(state.range(0), 1);
+  const std::vector<uint64_t> keys = shuffled_keys(pairs);
+  std::sort(pairs.begin(), pairs.end());
+  size_t i = 0;
+  uint64_t sum = 0;
+  for (auto _ : state) {
+    sum += std::lower_bound(pairs.begin(), pairs.end(), keys[i],
+                            [](const Pair& p, uint64_t key) {
+                              return p.first < key;
+                            })
+               ->second;
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Map>
+void BM_Build(benchmark::State& state) {
+  const std::vector<Pair> pairs = make_pairs(state.range(0), 1);
+  for (auto _ : state) {
+    Map map(pairs.begin(), pairs.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * pairs.size());
+}
+
+void Sizes(benchmark::internal::Benchmark* b) {
+  b->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+}
+
+typedef std::map<uint64_t, uint64_t> StdMap;
+typedef tracystl::FlatMap<uint64_t, uint64_t> TracyFlatMap;
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Lookup, StdMap)->Apply(Sizes);
+BENCHMARK(BM_LookupStdLowerBound)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_Lookup, TracyFlatMap)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_Build, StdMap)
+    ->Apply(Sizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Build, TracyFlatMap)
+    ->Apply(Sizes)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,137 @@
+#include "../src/hash_map.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// HashMap against std::unordered_map with 64-bit keys and values at 1K
+// (fits in L1/L2), 1M (L3 / DRAM) and, with -DTRACYSTL_BENCH_HUGE=1, 100M
+// keys. The 100M runs need about 7 GB between the two maps, so they are off
+// by default.
+//
+//   Insert       build a map of n random keys from empty, growth included
+//   LookupHit    find keys that are present, in random order
+//   LookupMiss   find keys that are absent
+//   EraseInsert  erase a present key and insert it back (tombstone churn)
+
+#ifndef TRACYSTL_BENCH_HUGE
+#define TRACYSTL_BENCH_HUGE 0
+#endif
+
+namespace {
+
+typedef std::unordered_map<uint64_t, uint64_t> StdMap;
+typedef tracystl::HashMap<uint64_t, uint64_t> TracyMap;
+
+// even keys are inserted, odd keys are guaranteed misses
+std::vector<uint64_t> make_keys(size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<uint64_t> keys(n);
+  for (uint64_t& key : keys) {
+    key = rng() & ~uint64_t{1};
+  }
+  return keys;
+}
+
+template <class Map>
+Map build(const std::vector<uint64_t>& keys) {
+  Map map;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    map[keys[i]] = i;
+  }
+  return map;
+}
+
+template <class Map>
+void BM_Insert(benchmark::State& state) {
+  const std::vector<uint64_t> keys = make_keys(state.range(0), 1);
+  for (auto _ : state) {
+    Map map;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      map[keys[i]] = i;
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <class Map>
+void BM_LookupHit(benchmark::State& state) {
+  std::vector<uint64_t> keys = make_keys(state.range(0), 1);
+  const Map map = build<Map>(keys);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(2));
+  size_t i = 0;
+  uint64_t sum = 0;
+  for (auto _ : state) {
+    sum += map.find(keys[i])->second;
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Map>
+void BM_LookupMiss(benchmark::State& state) {
+  std::vector<uint64_t> keys = make_keys(state.range(0), 1);
+  const Map map = build<Map>(keys);
+  for (uint64_t& key : keys) {
+    key |= 1;
+  }
+  size_t i = 0;
+  size_t found = 0;
+  for (auto _ : state) {
+    found += map.find(keys[i]) != map.end();
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Map>
+void BM_EraseInsert(benchmark::State& state) {
+  std::vector<uint64_t> keys = make_keys(state.range(0), 1);
+  Map map = build<Map>(keys);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(3));
+  size_t i = 0;
+  for (auto _ : state) {
+    map.erase(keys[i]);
+    map[keys[i]] = i;
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+  benchmark::DoNotOptimize(map.size());
+  state.SetItemsProcessed(state.iterations());
+}
+
+void Sizes(benchmark::internal::Benchmark* b) {
+  b->Arg(1000)->Arg(1000000);
+  if (TRACYSTL_BENCH_HUGE) {
+    b->Arg(100000000);
+  }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Insert, StdMap)
+    ->Apply(Sizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, TracyMap)
+    ->Apply(Sizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_LookupHit, StdMap)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_LookupHit, TracyMap)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_LookupMiss, StdMap)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_LookupMiss, TracyMap)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_EraseInsert, StdMap)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_EraseInsert, TracyMap)->Apply(Sizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,182 @@
+#include "../src/list.h"
+#include "../src/sort.h"
+#include "../src/vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <list>
+#include <random>
+
+// Order-book style churn: a list of n nodes where every step erases the
+// front node and appends a new one, then a full clear at the end.
+//
+// Sort and merge: List::sort / List::merge relink nodes in place, against
+// std::list and against copying the list into a Vector, sorting (or
+// merging) there and copying the result back. Elements are ints and 64-byte
+// records, whose copies cost more than relinking.
+
+namespace {
+
+template <class Container>
+void BM_ListChurn(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Container c;
+    for (int i = 0; i < n; ++i) {
+      c.push_back(i);
+    }
+    for (int i = 0; i < 4 * n; ++i) {
+      c.pop_front();
+      c.push_back(i);
+    }
+    benchmark::DoNotOptimize(&c);
+    c.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * 5 * n);
+}
+
+typedef tracystl::List<int> DefaultList;
+typedef tracystl::List<int, tracystl::PoolAllocator<int>> PoolList;
+
+struct record {
+  int key;
+  int payload[15];
+  bool operator<(const record& rhs) const { return key < rhs.key; }
+};
+
+template <class T>
+tracystl::Vector<T> random_values(size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  tracystl::Vector<T> values;
+  for (size_t i = 0; i < n; ++i) {
+    T value{};
+    reinterpret_cast<int&>(value) = static_cast<int>(rng());
+    values.push_back(value);
+  }
+  return values;
+}
+
+// overwrites the list's elements with values, keeping its node order
+template <class List, class T>
+void refill(List& list, const tracystl::Vector<T>& values) {
+  auto it = values.begin();
+  for (T& x : list) {
+    x = *it++;
+  }
+}
+
+template <class List, class T>
+void BM_ListSort(benchmark::State& state) {
+  const tracystl::Vector<T> values = random_values<T>(state.range(0), 1);
+  List list;
+  for (const T& x : values) {
+    list.push_back(x);
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    refill(list, values);
+    state.ResumeTiming();
+    list.sort();
+    benchmark::DoNotOptimize(&list.front());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+template <class T>
+void BM_VectorCopySort(benchmark::State& state) {
+  const tracystl::Vector<T> values = random_values<T>(state.range(0), 1);
+  tracystl::List<T> list;
+  for (const T& x : values) {
+    list.push_back(x);
+  }
+  tracystl::Vector<T> scratch(values.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    refill(list, values);
+    state.ResumeTiming();
+    std::copy(list.begin(), list.end(), scratch.begin());
+    tracystl::stable_sort(scratch.begin(), scratch.end());
+    std::copy(scratch.begin(), scratch.end(), list.begin());
+    benchmark::DoNotOptimize(&list.front());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// two sorted lists of n / 2 elements each
+template <class T>
+void BM_ListMerge(benchmark::State& state) {
+  tracystl::Vector<T> values = random_values<T>(state.range(0), 2);
+  const size_t half = values.size() / 2;
+  std::sort(values.begin(), values.begin() + half);
+  std::sort(values.begin() + half, values.end());
+  tracystl::List<T> a;
+  tracystl::List<T> b;
+  for (size_t i = 0; i < values.size(); ++i) {
+    (i < half ? a : b).push_back(values[i]);
+  }
+  for (auto _ : state) {
+    a.merge(b);
+    benchmark::DoNotOptimize(&a.front());
+    state.PauseTiming();
+    // split the merged list back into its halves, without allocating
+    for (auto it = a.begin(); it != a.end();) {
+      auto next = std::next(it);
+      if (!(values[half - 1] < *it) &&
+          std::binary_search(values.begin(), values.begin() + half, *it)) {
+        it = next;
+        continue;
+      }
+      b.splice(b.end(), a, it);
+      it = next;
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+template <class T>
+void BM_VectorCopyMerge(benchmark::State& state) {
+  tracystl::Vector<T> values = random_values<T>(state.range(0), 2);
+  const size_t half = values.size() / 2;
+  std::sort(values.begin(), values.begin() + half);
+  std::sort(values.begin() + half, values.end());
+  tracystl::List<T> a;
+  tracystl::List<T> b;
+  for (size_t i = 0; i < values.size(); ++i) {
+    (i < half ? a : b).push_back(values[i]);
+  }
+  tracystl::List<T> out;
+  for (size_t i = 0; i < values.size(); ++i) {
+    out.push_back(values[i]);
+  }
+  tracystl::Vector<T> scratch(values.size());
+  tracystl::Vector<T> merged(values);
+  for (auto _ : state) {
+    auto mid = std::copy(a.begin(), a.end(), scratch.begin());
+    std::copy(b.begin(), b.end(), mid);
+    std::merge(scratch.begin(), mid, mid, scratch.end(), merged.begin());
+    std::copy(merged.begin(), merged.end(), out.begin());
+    benchmark::DoNotOptimize(&out.front());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ListChurn, DefaultList)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_ListChurn, PoolList)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_ListChurn, std::list<int>)->Range(1 << 8, 1 << 18);
+
+BENCHMARK_TEMPLATE(BM_ListSort, tracystl::List<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ListSort, std::list<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_VectorCopySort, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ListSort, tracystl::List<record>, record)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ListSort, std::list<record>, record)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_VectorCopySort, record)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ListMerge, int)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_VectorCopyMerge, int)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_ListMerge, record)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_VectorCopyMerge, record)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_MAIN();
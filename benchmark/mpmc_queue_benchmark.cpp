@@ -0,0 +1,69 @@
+#include "../src/deque.h"
+#include "../src/mpmc_queue.h"
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+
+// Every thread alternates enqueue and dequeue on one shared queue, so the
+// contention on the queue grows with the thread count. Scales from 1 thread
+// to the number of hardware threads.
+
+namespace {
+
+class LockedDeque {
+ public:
+  bool try_enqueue(int v) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    deque_.push_back(v);
+    return true;
+  }
+  bool try_dequeue(int& v) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deque_.empty()) {
+      return false;
+    }
+    v = deque_.front();
+    deque_.pop_front();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  tracystl::Deque<int> deque_;
+};
+
+class Mpmc : public tracystl::MpmcQueue<int> {
+ public:
+  Mpmc() : tracystl::MpmcQueue<int>(1024) {}
+};
+
+template <class Queue>
+void BM_Contention(benchmark::State& state) {
+  static Queue* queue = nullptr;
+  if (state.thread_index() == 0) {
+    queue = new Queue();
+  }
+  // benchmark runs a barrier between setup and the timed loop
+  int value = 0;
+  for (auto _ : state) {
+    while (!queue->try_enqueue(value)) {
+    }
+    while (!queue->try_dequeue(value)) {
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+  if (state.thread_index() == 0) {
+    delete queue;
+    queue = nullptr;
+  }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Contention, LockedDeque)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Contention, Mpmc)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Contention, LockedDeque)->ThreadPerCpu()->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Contention, Mpmc)->ThreadPerCpu()->UseRealTime();
+
+BENCHMARK_MAIN();
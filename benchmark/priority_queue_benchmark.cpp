@@ -0,0 +1,156 @@
+#include "../src/priority_queue.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Timer-like workloads over min-queues of 64-bit deadlines.
+//
+// Hold: n pending timers; each step expires the earliest one and arms a new
+// one a random delay after it, so the queue size stays n.
+//
+// Make heap: heapify n random deadlines.
+//
+// Reschedule: n pending timers that are mostly pushed back before they fire
+// (like idle or retransmission timeouts): each step moves a random timer to
+// a later deadline, every fourth step also expires the earliest one and
+// re-arms it. IndexedPriorityQueue moves the timer through its handle;
+// std::priority_queue has no way to find it, so it pushes a new entry and
+// skips stale ones when they reach the top.
+
+namespace {
+
+typedef std::priority_queue<uint64_t, std::vector<uint64_t>,
+                            std::greater<uint64_t>>
+    StdQueue;
+template <size_t D>
+using TracyQueue = tracystl::PriorityQueue<uint64_t, std::greater<uint64_t>, D>;
+
+template <class Queue>
+void BM_TimerHold(benchmark::State& state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  std::mt19937_64 rng(1);
+  Queue q;
+  for (size_t i = 0; i < n; ++i) {
+    q.push(rng() % (1 << 20));
+  }
+  for (auto _ : state) {
+    const uint64_t now = q.top();
+    q.pop();
+    q.push(now + 1 + rng() % (1 << 20));
+  }
+  benchmark::DoNotOptimize(q.top());
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_MakeHeapStd(benchmark::State& state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  std::mt19937_64 rng(2);
+  std::vector<uint64_t> values(n);
+  for (uint64_t& v : values) {
+    v = rng();
+  }
+  for (auto _ : state) {
+    std::vector<uint64_t> copy = values;
+    StdQueue q(std::greater<uint64_t>(), std::move(copy));
+    benchmark::DoNotOptimize(q.top());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <size_t D>
+void BM_MakeHeapTracy(benchmark::State& state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  std::mt19937_64 rng(2);
+  tracystl::Vector<uint64_t> values;
+  for (size_t i = 0; i < n; ++i) {
+    values.push_back(rng());
+  }
+  for (auto _ : state) {
+    tracystl::Vector<uint64_t> copy = values;
+    TracyQueue<D> q(std::move(copy));
+    benchmark::DoNotOptimize(q.top());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_RescheduleStd(benchmark::State& state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  std::mt19937_64 rng(3);
+  typedef std::pair<uint64_t, size_t> timer;  // deadline, timer id
+  std::priority_queue<timer, std::vector<timer>, std::greater<timer>> q;
+  std::vector<uint64_t> deadline(n);
+  for (size_t i = 0; i < n; ++i) {
+    deadline[i] = rng() % (1 << 20);
+    q.emplace(deadline[i], i);
+  }
+  uint64_t now = 0;
+  size_t step = 0;
+  for (auto _ : state) {
+    const size_t id = rng() % n;
+    deadline[id] += 1 + rng() % (1 << 20);
+    q.emplace(deadline[id], id);
+    if (++step % 4 == 0) {
+      // drop stale entries, then fire the earliest live timer
+      while (q.top().first != deadline[q.top().second]) {
+        q.pop();
+      }
+      const size_t fired = q.top().second;
+      now = q.top().first;
+      q.pop();
+      deadline[fired] = now + 1 + rng() % (1 << 20);
+      q.emplace(deadline[fired], fired);
+    }
+  }
+  benchmark::DoNotOptimize(now);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["heap_size"] = static_cast<double>(q.size());
+}
+
+template <size_t D>
+void BM_RescheduleTracy(benchmark::State& state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  std::mt19937_64 rng(3);
+  tracystl::IndexedPriorityQueue<uint64_t, std::greater<uint64_t>, D> q;
+  std::vector<size_t> handle(n);
+  for (size_t i = 0; i < n; ++i) {
+    handle[i] = q.push(rng() % (1 << 20));
+  }
+  uint64_t now = 0;
+  size_t step = 0;
+  for (auto _ : state) {
+    const size_t id = rng() % n;
+    // a later deadline moves away from the top of a min-queue
+    q.increase_key(handle[id], q[handle[id]] + 1 + rng() % (1 << 20));
+    if (++step % 4 == 0) {
+      now = q.top();
+      q.increase_key(q.top_handle(), now + 1 + rng() % (1 << 20));
+    }
+  }
+  benchmark::DoNotOptimize(now);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["heap_size"] = static_cast<double>(q.size());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_TimerHold, StdQueue)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_TimerHold, TracyQueue<2>)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_TimerHold, TracyQueue<4>)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_TimerHold, TracyQueue<8>)->Range(1 << 8, 1 << 20);
+
+BENCHMARK(BM_MakeHeapStd)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MakeHeapTracy, 2)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MakeHeapTracy, 4)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_RescheduleStd)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_RescheduleTracy, 2)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_RescheduleTracy, 4)->Range(1 << 8, 1 << 18);
+
+BENCHMARK_MAIN();
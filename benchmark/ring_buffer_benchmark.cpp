@@ -0,0 +1,141 @@
+#include "../src/list.h"
+#include "../src/ring_buffer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// One producer thread hands kMessages messages to the benchmark thread.
+// Reports messages per second and the p50/p99 handoff latency (time between
+// the producer stamping a message and the consumer receiving it).
+
+namespace {
+
+constexpr int kMessages = 1 << 18;
+
+struct Message {
+  int64_t seq;
+  int64_t stamp_ns;
+};
+
+int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// what we use today: a List behind a mutex
+class LockedList {
+ public:
+  bool try_push(const Message& m) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    list_.push_back(m);
+    return true;
+  }
+  bool try_pop(Message& m) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (list_.empty()) {
+      return false;
+    }
+    m = list_.front();
+    list_.pop_front();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  tracystl::List<Message> list_;
+};
+
+class Spsc : public tracystl::SpscQueue<Message> {
+ public:
+  Spsc() : tracystl::SpscQueue<Message>(1024) {}
+};
+
+void report_latency(benchmark::State& state, std::vector<int64_t>& latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  state.counters["p50_ns"] = static_cast<double>(latencies[latencies.size() / 2]);
+  state.counters["p99_ns"] =
+      static_cast<double>(latencies[latencies.size() * 99 / 100]);
+}
+
+template <class Queue>
+void BM_Handoff(benchmark::State& state) {
+  std::vector<int64_t> latencies;
+  latencies.reserve(kMessages);
+  for (auto _ : state) {
+    Queue queue;
+    latencies.clear();
+    std::thread producer([&queue] {
+      for (int64_t i = 0; i < kMessages; ++i) {
+        while (!queue.try_push(Message{i, now_ns()})) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    Message m;
+    for (int i = 0; i < kMessages; ++i) {
+      while (!queue.try_pop(m)) {
+        std::this_thread::yield();
+      }
+      latencies.push_back(now_ns() - m.stamp_ns);
+    }
+    producer.join();
+  }
+  state.SetItemsProcessed(state.iterations() * kMessages);
+  report_latency(state, latencies);
+}
+
+// producer and consumer move 64-message spans at a time
+void BM_HandoffBatched(benchmark::State& state) {
+  constexpr int kBatch = 64;
+  std::vector<int64_t> latencies;
+  latencies.reserve(kMessages);
+  for (auto _ : state) {
+    Spsc queue;
+    latencies.clear();
+    std::thread producer([&queue] {
+      Message batch[kBatch];
+      for (int64_t i = 0; i < kMessages; i += kBatch) {
+        const int64_t stamp = now_ns();
+        for (int j = 0; j < kBatch; ++j) {
+          batch[j] = Message{i + j, stamp};
+        }
+        size_t sent = 0;
+        while (sent < kBatch) {
+          sent += queue.try_push_n(batch + sent, kBatch - sent);
+          if (sent < kBatch) std::this_thread::yield();
+        }
+      }
+    });
+    Message batch[kBatch];
+    for (int received = 0; received < kMessages;) {
+      const size_t n = queue.try_pop_n(batch, kBatch);
+      if (n == 0) {
+        std::this_thread::yield();
+        continue;
+      }
+      const int64_t now = now_ns();
+      for (size_t j = 0; j < n; ++j) {
+        latencies.push_back(now - batch[j].stamp_ns);
+      }
+      received += static_cast<int>(n);
+    }
+    producer.join();
+  }
+  state.SetItemsProcessed(state.iterations() * kMessages);
+  report_latency(state, latencies);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Handoff, LockedList)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Handoff, Spsc)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HandoffBatched)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
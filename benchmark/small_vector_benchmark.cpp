@@ -0,0 +1,83 @@
+#include "../src/small_vector.h"
+#include "../src/vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+// Per-message metadata: every message carries a handful of small fields
+// (here 1-8 header ids) in a short-lived vector. With SmallVector<_, 8> that
+// never touches the allocator; Vector and std::vector pay a malloc/free pair
+// and several regrowths per message. The allocations_per_message counter
+// shows it directly.
+
+namespace {
+
+size_t g_allocations = 0;
+
+template <class T>
+struct CountingAllocator : tracystl::Allocator<T> {
+  typedef T value_type;
+  template <class U>
+  struct rebind {
+    typedef CountingAllocator<U> other;
+  };
+  CountingAllocator() = default;
+  template <class U>
+  CountingAllocator(const CountingAllocator<U>&) {}
+  T* allocate(size_t n) {
+    ++g_allocations;
+    return tracystl::Allocator<T>::allocate(n);
+  }
+  template <class U>
+  bool operator==(const CountingAllocator<U>&) const {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const CountingAllocator<U>&) const {
+    return false;
+  }
+};
+
+struct Field {
+  uint32_t id;
+  uint32_t offset;
+};
+
+template <class Container>
+void BM_MessageMetadata(benchmark::State& state) {
+  const int messages = 1024;
+  g_allocations = 0;
+  uint64_t checksum = 0;
+  for (auto _ : state) {
+    for (int m = 0; m < messages; ++m) {
+      Container fields;
+      const int count = 1 + m % 8;
+      for (int i = 0; i < count; ++i) {
+        fields.push_back(Field{static_cast<uint32_t>(i),
+                               static_cast<uint32_t>(m + i)});
+      }
+      for (auto it = fields.begin(); it != fields.end(); ++it) {
+        checksum += it->offset;
+      }
+      benchmark::DoNotOptimize(fields.data());
+    }
+  }
+  benchmark::DoNotOptimize(checksum);
+  state.SetItemsProcessed(state.iterations() * messages);
+  state.counters["allocations_per_message"] = benchmark::Counter(
+      static_cast<double>(g_allocations) /
+      (static_cast<double>(state.iterations()) * messages));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_MessageMetadata,
+                   std::vector<Field, CountingAllocator<Field>>);
+BENCHMARK_TEMPLATE(BM_MessageMetadata,
+                   tracystl::Vector<Field, CountingAllocator<Field>>);
+BENCHMARK_TEMPLATE(BM_MessageMetadata,
+                   tracystl::SmallVector<Field, 8, CountingAllocator<Field>>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,122 @@
+#include "../src/sort.h"
+#include "../src/vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+// tracystl::sort, stable_sort and radix_sort against libstdc++'s std::sort
+// and std::stable_sort, over Vector<int> of 1M elements shaped as random,
+// sorted, reversed, few unique (8 values) and organ pipe (ascending, then
+// descending) input. Each iteration sorts a fresh copy; copying is not timed.
+// Build with -DTRACYSTL_BENCH_HUGE to add 16M elements (beyond L3).
+
+namespace {
+
+enum Pattern { kRandom, kSorted, kReversed, kFewUnique, kOrganPipe };
+
+tracystl::Vector<int> make_input(Pattern pattern, size_t n) {
+  std::mt19937 rng(1);
+  tracystl::Vector<int> vec;
+  vec.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const int v = static_cast<int>(i);
+    switch (pattern) {
+      case kRandom:
+        vec.push_back(static_cast<int>(rng()));
+        break;
+      case kSorted:
+        vec.push_back(v);
+        break;
+      case kReversed:
+        vec.push_back(static_cast<int>(n) - v);
+        break;
+      case kFewUnique:
+        vec.push_back(static_cast<int>(rng() % 8));
+        break;
+      case kOrganPipe:
+        vec.push_back(i < n / 2 ? v : static_cast<int>(n) - v);
+        break;
+    }
+  }
+  return vec;
+}
+
+struct StdSort {
+  template <class It>
+  void operator()(It first, It last) {
+    std::sort(first, last);
+  }
+};
+
+struct TracySort {
+  template <class It>
+  void operator()(It first, It last) {
+    tracystl::sort(first, last);
+  }
+};
+
+struct StdStableSort {
+  template <class It>
+  void operator()(It first, It last) {
+    std::stable_sort(first, last);
+  }
+};
+
+struct TracyStableSort {
+  template <class It>
+  void operator()(It first, It last) {
+    tracystl::stable_sort(first, last);
+  }
+};
+
+// keeps its scratch buffer across iterations, as a caller sorting
+// repeatedly would
+struct TracyRadixSort {
+  tracystl::Vector<int> scratch;
+  template <class It>
+  void operator()(It first, It last) {
+    tracystl::radix_sort(first, last, scratch);
+  }
+};
+
+template <class Impl, Pattern P>
+void BM_Sort(benchmark::State& state) {
+  Impl impl;
+  const tracystl::Vector<int> input = make_input(P, state.range(0));
+  tracystl::Vector<int> data(input.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::copy(input.begin(), input.end(), data.begin());
+    state.ResumeTiming();
+    impl(data.begin(), data.end());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void Sizes(benchmark::internal::Benchmark* b) {
+  b->Arg(1 << 20);
+#ifdef TRACYSTL_BENCH_HUGE
+  b->Arg(1 << 24);
+#endif
+  b->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+#define TRACYSTL_BENCH_SORT(P)                                      \
+  BENCHMARK_TEMPLATE(BM_Sort, StdSort, P)->Apply(Sizes);            \
+  BENCHMARK_TEMPLATE(BM_Sort, TracySort, P)->Apply(Sizes);          \
+  BENCHMARK_TEMPLATE(BM_Sort, StdStableSort, P)->Apply(Sizes);      \
+  BENCHMARK_TEMPLATE(BM_Sort, TracyStableSort, P)->Apply(Sizes);    \
+  BENCHMARK_TEMPLATE(BM_Sort, TracyRadixSort, P)->Apply(Sizes);
+
+TRACYSTL_BENCH_SORT(kRandom)
+TRACYSTL_BENCH_SORT(kSorted)
+TRACYSTL_BENCH_SORT(kReversed)
+TRACYSTL_BENCH_SORT(kFewUnique)
+TRACYSTL_BENCH_SORT(kOrganPipe)
+
+BENCHMARK_MAIN();
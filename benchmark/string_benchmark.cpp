@@ -0,0 +1,119 @@
+#include "../src/tracy_string.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Construction: build strings of a given length from a character buffer,
+// below and above the inline capacity (15 characters for libstdc++'s
+// std::string, 23 for String).
+//
+// Append: grow one string by appending short pieces, as a serializer does.
+//
+// Search: find a needle in a text of n bytes over a 16-letter alphabet where
+// the needle sits at the very end, for each kernel set and for
+// std::string_view::find.
+
+namespace {
+
+template <class S>
+void BM_Construct(benchmark::State& state) {
+  const size_t len = static_cast<size_t>(state.range(0));
+  const std::string source(len, 'k');
+  for (auto _ : state) {
+    S s(source.c_str());
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class S>
+void BM_Append(benchmark::State& state) {
+  const int pieces = static_cast<int>(state.range(0));
+  const char* words[] = {"id", "=", "4711", ";", "name", "=", "tracy", ";"};
+  for (auto _ : state) {
+    S s;
+    for (int i = 0; i < pieces; ++i) {
+      s += words[i & 7];
+    }
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetItemsProcessed(state.iterations() * pieces);
+}
+
+std::string make_text(size_t n, const std::string& needle) {
+  std::mt19937 rng(11);
+  std::string text;
+  for (size_t i = 0; i + needle.size() < n; ++i) {
+    text.push_back(static_cast<char>('a' + rng() % 16));
+  }
+  return text + needle;
+}
+
+const char needle[] = "needle-in-haystack";
+
+void BM_FindStd(benchmark::State& state) {
+  const std::string text = make_text(static_cast<size_t>(state.range(0)),
+                                     needle);
+  const std::string_view view(text);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view.find(needle));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+template <tracystl::simd_level Level>
+void BM_FindTracy(benchmark::State& state) {
+  if (Level > tracystl::cpu_simd_level()) {
+    state.SkipWithError("kernel set not supported by this CPU");
+    return;
+  }
+  tracystl::set_simd_level(Level);
+  const std::string text = make_text(static_cast<size_t>(state.range(0)),
+                                     needle);
+  const tracystl::StringView view(text);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view.find(needle));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  tracystl::set_simd_level(tracystl::cpu_simd_level());
+}
+
+void BM_CompareStd(benchmark::State& state) {
+  const std::string a(static_cast<size_t>(state.range(0)), 'x');
+  const std::string b = a;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.compare(b));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CompareTracy(benchmark::State& state) {
+  const tracystl::String a(static_cast<size_t>(state.range(0)), 'x');
+  const tracystl::String b = a;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.compare(b));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Construct, std::string)->Arg(8)->Arg(15)->Arg(20)->Arg(23)->Arg(64);
+BENCHMARK_TEMPLATE(BM_Construct, tracystl::String)->Arg(8)->Arg(15)->Arg(20)->Arg(23)->Arg(64);
+
+BENCHMARK_TEMPLATE(BM_Append, std::string)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Append, tracystl::String)->Range(8, 1 << 16);
+
+BENCHMARK(BM_FindStd)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FindTracy, tracystl::simd_level::scalar)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FindTracy, tracystl::simd_level::sse2)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FindTracy, tracystl::simd_level::avx2)->Range(64, 1 << 20);
+
+BENCHMARK(BM_CompareStd)->Range(16, 1 << 16);
+BENCHMARK(BM_CompareTracy)->Range(16, 1 << 16);
+
+BENCHMARK_MAIN();
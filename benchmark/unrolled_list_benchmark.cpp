@@ -0,0 +1,103 @@
+#include "../src/list.h"
+#include "../src/unrolled_list.h"
+
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <random>
+
+// Traversal: sum every element of an n element list. Linked lists are
+// measured fresh (nodes allocated in list order) and scattered (the same
+// nodes relinked into random memory order by sorting on random keys, as a
+// long-lived list ends up); UnrolledList is measured with full chunks
+// (push_back) and with half-full chunks (every element inserted in the
+// middle, so every chunk came from a split).
+//
+// Mid-list insert: with a cursor in the middle of an n element list, insert
+// before the cursor and erase the element after it, so the size stays n and
+// the cursor walks forward through the list.
+
+namespace {
+
+template <class Container>
+void build(Container& c, int n, bool scattered) {
+  std::mt19937 rng(7);
+  for (int i = 0; i < n; ++i) {
+    c.push_back(static_cast<int>(rng() >> 1));
+  }
+  if (scattered) {
+    c.sort();
+  }
+}
+
+template <class T, class A, size_t B>
+void build(tracystl::UnrolledList<T, A, B>& c, int n, bool half_full) {
+  std::mt19937 rng(7);
+  if (!half_full) {
+    for (int i = 0; i < n; ++i) {
+      c.push_back(static_cast<int>(rng() >> 1));
+    }
+    return;
+  }
+  // a cursor that sometimes steps over the value it just inserted lands in
+  // the middle of full chunks, which then split
+  auto cursor = c.end();
+  for (int i = 0; i < n; ++i) {
+    cursor = c.insert(cursor, static_cast<int>(rng() >> 1));
+    if (rng() & 1) {
+      ++cursor;
+    }
+  }
+}
+
+template <class Container>
+void BM_Traverse(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  Container c;
+  build(c, n, state.range(1) != 0);
+  for (auto _ : state) {
+    long long sum = 0;
+    for (int v : c) {
+      sum += v;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <class Container>
+void BM_MidInsert(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  Container c;
+  build(c, n, false);
+  auto it = c.begin();
+  for (int i = 0; i < n / 2; ++i) {
+    ++it;
+  }
+  int value = 0;
+  for (auto _ : state) {
+    it = c.insert(it, ++value);
+    ++it;
+    it = c.erase(it);
+    if (it == c.end()) {
+      it = c.begin();
+    }
+  }
+  benchmark::DoNotOptimize(&*c.begin());
+  state.SetItemsProcessed(state.iterations());
+}
+
+typedef tracystl::List<int> List;
+typedef tracystl::UnrolledList<int> UnrolledList;
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Traverse, List)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_Traverse, std::list<int>)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_Traverse, UnrolledList)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 1}});
+
+BENCHMARK_TEMPLATE(BM_MidInsert, List)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MidInsert, std::list<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MidInsert, UnrolledList)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
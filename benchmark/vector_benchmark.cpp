@@ -0,0 +1,94 @@
+#include "../src/vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+// Growth cost of push_back: every run starts from an empty vector, so the
+// measured time includes all log2(n) reallocations.
+
+namespace {
+
+struct Small {
+  int a, b, c, d;
+  explicit Small(int v) : a(v), b(v), c(v), d(v) {}
+};
+
+// The pre-relocation growth path: copy construct every element into the new
+// buffer and destroy the old one. Kept here as the "before" baseline.
+template <class T>
+class CopyGrowthVector {
+ public:
+  ~CopyGrowthVector() {
+    tracystl::Allocator<T>::destroy(begin_, end_);
+    tracystl::Allocator<T>::deallocate(begin_);
+  }
+  void push_back(const T& value) {
+    if (end_ == capacity_) {
+      const size_t old_size = end_ - begin_;
+      const size_t new_size = old_size != 0 ? 2 * old_size : 1;
+      T* new_begin = tracystl::Allocator<T>::allocate(new_size);
+      for (size_t i = 0; i < old_size; ++i) {
+        tracystl::Allocator<T>::construct(new_begin + i, *(begin_ + i));
+        tracystl::Allocator<T>::destroy(begin_ + i);
+      }
+      tracystl::Allocator<T>::deallocate(begin_);
+      begin_ = new_begin;
+      end_ = new_begin + old_size;
+      capacity_ = new_begin + new_size;
+    }
+    tracystl::Allocator<T>::construct(end_, value);
+    ++end_;
+  }
+
+ private:
+  T* begin_ = nullptr;
+  T* end_ = nullptr;
+  T* capacity_ = nullptr;
+};
+
+template <class T>
+T make_value(int i) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(32, static_cast<char>('a' + i % 26));
+  } else {
+    return T(i);
+  }
+}
+
+template <class Container, class T>
+void BM_PushBackGrowth(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const T value = make_value<T>(7);
+  for (auto _ : state) {
+    Container c;
+    for (int i = 0; i < n; ++i) {
+      c.push_back(value);
+    }
+    benchmark::DoNotOptimize(&c);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+}  // namespace
+
+#define GROWTH_BENCHMARK(Container, T)                          \
+  BENCHMARK_TEMPLATE(BM_PushBackGrowth, Container<T>, T)        \
+      ->RangeMultiplier(16)                                     \
+      ->Range(1 << 10, 1 << 22)
+
+GROWTH_BENCHMARK(CopyGrowthVector, int);
+GROWTH_BENCHMARK(tracystl::Vector, int);
+GROWTH_BENCHMARK(std::vector, int);
+
+GROWTH_BENCHMARK(CopyGrowthVector, Small);
+GROWTH_BENCHMARK(tracystl::Vector, Small);
+GROWTH_BENCHMARK(std::vector, Small);
+
+GROWTH_BENCHMARK(CopyGrowthVector, std::string);
+GROWTH_BENCHMARK(tracystl::Vector, std::string);
+GROWTH_BENCHMARK(std::vector, std::string);
+
+BENCHMARK_MAIN();
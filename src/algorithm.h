@@ -0,0 +1,915 @@
+#ifndef _TRACYSTL_ALGORITHM_H_
+#define _TRACYSTL_ALGORITHM_H_
+
+#include "iterator.h"
+#include <atomic>
+#include <cstddef> // For std::size_t
+#include <cstdint>
+#include <cstring> // For std::memmove, std::memset, std::memchr, std::memcmp
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    defined(__SSE2__)
+#define TRACYSTL_ALGORITHM_X86 1
+#include <immintrin.h>
+#else
+#define TRACYSTL_ALGORITHM_X86 0
+#endif
+
+namespace tracystl {
+
+// The algorithms below behave like their <algorithm>/<numeric> namesakes.
+// When both the iterators are contiguous (pointers, Vector iterators) and
+// the value type is trivially copyable, they work on the underlying array
+// instead of element by element:
+//
+//   copy, move      memmove
+//   fill            memset for bytes and all-zero values
+//   find, count     memchr / SIMD compare for 1-byte and 4-byte integers
+//                   and float
+//   equal           memcmp for integers and pointers, SIMD for float
+//   min_element,    SIMD for int32_t and float (ranges holding a NaN take
+//   max_element     the scalar path, so NaN handling matches std::)
+//   accumulate      SIMD for 32-bit integers with the default std::plus
+//
+// The SIMD kernels come in SSE2 and AVX2 flavours; which one runs is
+// decided once from CPUID, so one binary runs everywhere and uses AVX2
+// where it exists. Everything else is a plain loop.
+
+enum class simd_level { scalar, sse2, avx2 };
+
+namespace algorithm_detail {
+
+inline simd_level detect_simd_level() noexcept {
+#if TRACYSTL_ALGORITHM_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+    return simd_level::avx2;
+  }
+  return simd_level::sse2;
+#else
+  return simd_level::scalar;
+#endif
+}
+
+inline std::atomic<simd_level>& active_level() noexcept {
+  static std::atomic<simd_level> level(detect_simd_level());
+  return level;
+}
+
+}  // namespace algorithm_detail
+
+// The best kernel set this CPU supports.
+inline simd_level cpu_simd_level() noexcept {
+  static const simd_level level = algorithm_detail::detect_simd_level();
+  return level;
+}
+
+// The kernel set in use; starts as cpu_simd_level().
+inline simd_level active_simd_level() noexcept {
+  return algorithm_detail::active_level().load(std::memory_order_relaxed);
+}
+
+// Restricts the algorithms to a lower kernel set, e.g. to test or benchmark
+// the fallbacks. Requests above cpu_simd_level() are clamped to it.
+inline void set_simd_level(simd_level level) noexcept {
+  if (level > cpu_simd_level()) {
+    level = cpu_simd_level();
+  }
+  algorithm_detail::active_level().store(level, std::memory_order_relaxed);
+}
+
+namespace algorithm_detail {
+
+// Each kernel takes n elements at p and returns the index of the match
+// (n if none) or the reduced value.
+
+#if TRACYSTL_ALGORITHM_X86
+
+namespace sse2 {
+
+struct i8_ops {
+  typedef int8_t value_type;
+  static constexpr size_t width = 16;
+  __m128i v;
+  explicit i8_ops(value_type x) : v(_mm_set1_epi8(x)) {}
+  __m128i cmp(const value_type* p) const {
+    return _mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), v);
+  }
+  unsigned eq(const value_type* p) const {
+    return static_cast<unsigned>(_mm_movemask_epi8(cmp(p)));
+  }
+  static __m128i subtract(__m128i a, __m128i b) { return _mm_sub_epi8(a, b); }
+  static size_t sum(__m128i a) {
+    const __m128i halves = _mm_sad_epu8(a, _mm_setzero_si128());
+    return static_cast<size_t>(_mm_cvtsi128_si32(halves)) +
+           static_cast<size_t>(
+               _mm_cvtsi128_si32(_mm_unpackhi_epi64(halves, halves)));
+  }
+};
+
+struct i32_ops {
+  typedef int32_t value_type;
+  static constexpr size_t width = 4;
+  __m128i v;
+  explicit i32_ops(value_type x) : v(_mm_set1_epi32(x)) {}
+  __m128i cmp(const value_type* p) const {
+    return _mm_cmpeq_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), v);
+  }
+  unsigned eq(const value_type* p) const {
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(cmp(p))));
+  }
+  static __m128i subtract(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+  static size_t sum(__m128i a) {
+    a = _mm_add_epi32(a, _mm_shuffle_epi32(a, 0x4e));
+    a = _mm_add_epi32(a, _mm_shuffle_epi32(a, 0xb1));
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(a));
+  }
+};
+
+struct f32_ops {
+  typedef float value_type;
+  static constexpr size_t width = 4;
+  __m128 v;
+  explicit f32_ops(value_type x) : v(_mm_set1_ps(x)) {}
+  __m128i cmp(const value_type* p) const {
+    return _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(p), v));
+  }
+  unsigned eq(const value_type* p) const {
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(cmp(p))));
+  }
+  static __m128i subtract(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+  static size_t sum(__m128i a) { return i32_ops::sum(a); }
+};
+
+template <class Ops>
+size_t find(const typename Ops::value_type* p, size_t n,
+            typename Ops::value_type x) {
+  const Ops ops(x);
+  size_t i = 0;
+  for (; i + Ops::width <= n; i += Ops::width) {
+    const unsigned mask = ops.eq(p + i);
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+  for (; i < n && !(p[i] == x); ++i) {
+  }
+  return i;
+}
+
+// Counting keeps one counter per lane: the compare yields -1 in matching
+// lanes, which is subtracted. Byte counters would wrap after 255 steps, so
+// they are added up and restarted every 255 vectors.
+template <class Ops>
+size_t count(const typename Ops::value_type* p, size_t n,
+             typename Ops::value_type x) {
+  const Ops ops(x);
+  size_t result = 0;
+  size_t i = 0;
+  while (i + Ops::width <= n) {
+    const size_t vectors = (n - i) / Ops::width;
+    const size_t end = i + (vectors < 255 ? vectors : 255) * Ops::width;
+    __m128i counters = _mm_setzero_si128();
+    for (; i < end; i += Ops::width) {
+      counters = Ops::subtract(counters, ops.cmp(p + i));
+    }
+    result += Ops::sum(counters);
+  }
+  for (; i < n; ++i) {
+    result += p[i] == x;
+  }
+  return result;
+}
+
+inline bool equal_f32(const float* a, const float* b, size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+    if (_mm_movemask_ps(eq) != 0xf) {
+      return false;
+    }
+  }
+  for (; i < n; ++i) {
+    if (!(a[i] == b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// SSE2 has no 32-bit integer min/max; select with a compare instead
+template <bool Max>
+__m128i select_i32(__m128i a, __m128i b) {
+  const __m128i take_b = Max ? _mm_cmpgt_epi32(b, a) : _mm_cmplt_epi32(b, a);
+  return _mm_or_si128(_mm_and_si128(take_b, b), _mm_andnot_si128(take_b, a));
+}
+
+// n must be at least 1
+template <bool Max>
+int32_t reduce_i32(const int32_t* p, size_t n) {
+  size_t i = 0;
+  int32_t result = p[0];
+  if (n >= 4) {
+    __m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    for (i = 4; i + 4 <= n; i += 4) {
+      acc = select_i32<Max>(
+          acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+    }
+    acc = select_i32<Max>(acc, _mm_shuffle_epi32(acc, 0x4e));
+    acc = select_i32<Max>(acc, _mm_shuffle_epi32(acc, 0xb1));
+    result = _mm_cvtsi128_si32(acc);
+  }
+  for (; i < n; ++i) {
+    result = (Max ? result < p[i] : p[i] < result) ? p[i] : result;
+  }
+  return result;
+}
+
+// false if the range holds a NaN; n must be at least 1
+template <bool Max>
+bool reduce_f32(const float* p, size_t n, float& out) {
+  size_t i = 0;
+  float result = p[0];
+  if (n >= 4) {
+    __m128 acc = _mm_loadu_ps(p);
+    __m128 nan = _mm_cmpunord_ps(acc, acc);
+    for (i = 4; i + 4 <= n; i += 4) {
+      const __m128 x = _mm_loadu_ps(p + i);
+      nan = _mm_or_ps(nan, _mm_cmpunord_ps(x, x));
+      acc = Max ? _mm_max_ps(acc, x) : _mm_min_ps(acc, x);
+    }
+    if (_mm_movemask_ps(nan) != 0) {
+      return false;
+    }
+    __m128 swapped = _mm_shuffle_ps(acc, acc, 0x4e);
+    acc = Max ? _mm_max_ps(acc, swapped) : _mm_min_ps(acc, swapped);
+    swapped = _mm_shuffle_ps(acc, acc, 0xb1);
+    acc = Max ? _mm_max_ps(acc, swapped) : _mm_min_ps(acc, swapped);
+    result = _mm_cvtss_f32(acc);
+  }
+  for (; i < n; ++i) {
+    if (p[i] != p[i]) {
+      return false;
+    }
+    result = (Max ? result < p[i] : p[i] < result) ? p[i] : result;
+  }
+  out = result;
+  return true;
+}
+
+// wrapping sum
+inline uint32_t sum_u32(const uint32_t* p, size_t n) {
+  __m128i acc = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    acc = _mm_add_epi32(
+        acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+  }
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4e));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xb1));
+  uint32_t result = static_cast<uint32_t>(_mm_cvtsi128_si32(acc));
+  for (; i < n; ++i) {
+    result += p[i];
+  }
+  return result;
+}
+
+}  // namespace sse2
+
+// Everything up to the pop_options is compiled for AVX2 no matter what the
+// rest of the program is compiled for. It only runs if CPUID says so.
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+
+namespace avx2 {
+
+struct i8_ops {
+  typedef int8_t value_type;
+  static constexpr size_t width = 32;
+  __m256i v;
+  explicit i8_ops(value_type x) : v(_mm256_set1_epi8(x)) {}
+  unsigned eq(const value_type* p) const {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, v)));
+  }
+};
+
+struct i32_ops {
+  typedef int32_t value_type;
+  static constexpr size_t width = 8;
+  __m256i v;
+  explicit i32_ops(value_type x) : v(_mm256_set1_epi32(x)) {}
+  unsigned eq(const value_type* p) const {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return static_cast<unsigned>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, v))));
+  }
+};
+
+struct f32_ops {
+  typedef float value_type;
+  static constexpr size_t width = 8;
+  __m256 v;
+  explicit f32_ops(value_type x) : v(_mm256_set1_ps(x)) {}
+  unsigned eq(const value_type* p) const {
+    return static_cast<unsigned>(_mm256_movemask_ps(
+        _mm256_cmp_ps(_mm256_loadu_ps(p), v, _CMP_EQ_OQ)));
+  }
+};
+
+// Four vectors per iteration: one compare-and-branch per 128 bytes keeps
+// the loop bound by loads rather than by the branch.
+template <class Ops>
+size_t find(const typename Ops::value_type* p, size_t n,
+            typename Ops::value_type x) {
+  const Ops ops(x);
+  size_t i = 0;
+  for (; i + 4 * Ops::width <= n; i += 4 * Ops::width) {
+    const unsigned m0 = ops.eq(p + i);
+    const unsigned m1 = ops.eq(p + i + Ops::width);
+    const unsigned m2 = ops.eq(p + i + 2 * Ops::width);
+    const unsigned m3 = ops.eq(p + i + 3 * Ops::width);
+    if ((m0 | m1 | m2 | m3) != 0) {
+      break;
+    }
+  }
+  for (; i + Ops::width <= n; i += Ops::width) {
+    const unsigned mask = ops.eq(p + i);
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+  for (; i < n && !(p[i] == x); ++i) {
+  }
+  return i;
+}
+
+template <class Ops>
+size_t count(const typename Ops::value_type* p, size_t n,
+             typename Ops::value_type x) {
+  const Ops ops(x);
+  size_t result = 0;
+  size_t i = 0;
+  for (; i + Ops::width <= n; i += Ops::width) {
+    result += static_cast<size_t>(__builtin_popcount(ops.eq(p + i)));
+  }
+  for (; i < n; ++i) {
+    result += p[i] == x;
+  }
+  return result;
+}
+
+inline bool equal_f32(const float* a, const float* b, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(a + i),
+                                    _mm256_loadu_ps(b + i), _CMP_EQ_OQ);
+    if (_mm256_movemask_ps(eq) != 0xff) {
+      return false;
+    }
+  }
+  for (; i < n; ++i) {
+    if (!(a[i] == b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <bool Max>
+int32_t reduce_i32(const int32_t* p, size_t n) {
+  size_t i = 0;
+  int32_t result = p[0];
+  if (n >= 8) {
+    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    for (i = 8; i + 8 <= n; i += 8) {
+      const __m256i x =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+      acc = Max ? _mm256_max_epi32(acc, x) : _mm256_min_epi32(acc, x);
+    }
+    __m128i half = _mm256_castsi256_si128(acc);
+    __m128i high = _mm256_extracti128_si256(acc, 1);
+    half = Max ? _mm_max_epi32(half, high) : _mm_min_epi32(half, high);
+    high = _mm_shuffle_epi32(half, 0x4e);
+    half = Max ? _mm_max_epi32(half, high) : _mm_min_epi32(half, high);
+    high = _mm_shuffle_epi32(half, 0xb1);
+    half = Max ? _mm_max_epi32(half, high) : _mm_min_epi32(half, high);
+    result = _mm_cvtsi128_si32(half);
+  }
+  for (; i < n; ++i) {
+    result = (Max ? result < p[i] : p[i] < result) ? p[i] : result;
+  }
+  return result;
+}
+
+template <bool Max>
+bool reduce_f32(const float* p, size_t n, float& out) {
+  size_t i = 0;
+  float result = p[0];
+  if (n >= 8) {
+    __m256 acc = _mm256_loadu_ps(p);
+    __m256 nan = _mm256_cmp_ps(acc, acc, _CMP_UNORD_Q);
+    for (i = 8; i + 8 <= n; i += 8) {
+      const __m256 x = _mm256_loadu_ps(p + i);
+      nan = _mm256_or_ps(nan, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+      acc = Max ? _mm256_max_ps(acc, x) : _mm256_min_ps(acc, x);
+    }
+    if (_mm256_movemask_ps(nan) != 0) {
+      return false;
+    }
+    __m128 half = _mm256_castps256_ps128(acc);
+    __m128 high = _mm256_extractf128_ps(acc, 1);
+    half = Max ? _mm_max_ps(half, high) : _mm_min_ps(half, high);
+    high = _mm_shuffle_ps(half, half, 0x4e);
+    half = Max ? _mm_max_ps(half, high) : _mm_min_ps(half, high);
+    high = _mm_shuffle_ps(half, half, 0xb1);
+    half = Max ? _mm_max_ps(half, high) : _mm_min_ps(half, high);
+    result = _mm_cvtss_f32(half);
+  }
+  for (; i < n; ++i) {
+    if (p[i] != p[i]) {
+      return false;
+    }
+    result = (Max ? result < p[i] : p[i] < result) ? p[i] : result;
+  }
+  out = result;
+  return true;
+}
+
+inline uint32_t sum_u32(const uint32_t* p, size_t n) {
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm256_add_epi32(
+        acc0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+    acc1 = _mm256_add_epi32(
+        acc1,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 8)));
+  }
+  acc0 = _mm256_add_epi32(acc0, acc1);
+  __m128i acc = _mm_add_epi32(_mm256_castsi256_si128(acc0),
+                              _mm256_extracti128_si256(acc0, 1));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4e));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xb1));
+  uint32_t result = static_cast<uint32_t>(_mm_cvtsi128_si32(acc));
+  for (; i < n; ++i) {
+    result += p[i];
+  }
+  return result;
+}
+
+}  // namespace avx2
+
+#pragma GCC pop_options
+
+#endif  // TRACYSTL_ALGORITHM_X86
+
+// Which kernel family, if any, handles a value type.
+enum class kind { none, i8, i32, f32 };
+
+template <class T>
+constexpr kind kind_of() {
+  typedef typename std::remove_cv<T>::type U;
+  if constexpr (std::is_integral<U>::value && sizeof(U) == 1) {
+    return kind::i8;
+  } else if constexpr (std::is_integral<U>::value && sizeof(U) == 4) {
+    return kind::i32;
+  } else if constexpr (std::is_same<U, float>::value) {
+    return kind::f32;
+  } else {
+    return kind::none;
+  }
+}
+
+template <class T>
+struct bits_of {
+  typedef typename std::conditional<
+      kind_of<T>() == kind::i8, int8_t,
+      typename std::conditional<kind_of<T>() == kind::i32, int32_t,
+                                float>::type>::type type;
+};
+
+// A contiguous [first, first + n) of a type the kernels can read as raw
+// memory.
+template <class It>
+constexpr bool is_raw_range =
+    is_contiguous_iterator_v<It> &&
+    std::is_trivially_copyable<
+        typename iterator_traits<It>::value_type>::value;
+
+template <class It>
+auto raw(It it) noexcept {
+  return &*it;
+}
+
+// equality is the same as equal object representations
+template <class T>
+constexpr bool is_bitwise_comparable =
+    std::is_integral<T>::value || std::is_pointer<T>::value ||
+    std::is_enum<T>::value;
+
+template <class T>
+size_t find(const T* p, size_t n, const T& x) {
+  typedef typename bits_of<T>::type B;
+  B bits;
+  std::memcpy(&bits, &x, sizeof(B));
+  if constexpr (kind_of<T>() == kind::i8) {
+    const void* hit = std::memchr(p, static_cast<unsigned char>(bits), n);
+    return hit != nullptr ? static_cast<size_t>(
+                                static_cast<const unsigned char*>(hit) -
+                                reinterpret_cast<const unsigned char*>(p))
+                          : n;
+  } else {
+    const B* b = reinterpret_cast<const B*>(p);
+#if TRACYSTL_ALGORITHM_X86
+    typedef typename std::conditional<kind_of<T>() == kind::i32, avx2::i32_ops,
+                                      avx2::f32_ops>::type avx2_ops;
+    typedef typename std::conditional<kind_of<T>() == kind::i32, sse2::i32_ops,
+                                      sse2::f32_ops>::type sse2_ops;
+    switch (active_simd_level()) {
+      case simd_level::avx2:
+        return avx2::find<avx2_ops>(b, n, bits);
+      case simd_level::sse2:
+        return sse2::find<sse2_ops>(b, n, bits);
+      case simd_level::scalar:
+        break;
+    }
+#endif
+    size_t i = 0;
+    for (; i < n && !(b[i] == bits); ++i) {
+    }
+    return i;
+  }
+}
+
+template <class T>
+size_t count(const T* p, size_t n, const T& x) {
+  typedef typename bits_of<T>::type B;
+  const B* b = reinterpret_cast<const B*>(p);
+  B bits;
+  std::memcpy(&bits, &x, sizeof(B));
+#if TRACYSTL_ALGORITHM_X86
+  typedef typename std::conditional<
+      kind_of<T>() == kind::i8, avx2::i8_ops,
+      typename std::conditional<kind_of<T>() == kind::i32, avx2::i32_ops,
+                                avx2::f32_ops>::type>::type avx2_ops;
+  typedef typename std::conditional<
+      kind_of<T>() == kind::i8, sse2::i8_ops,
+      typename std::conditional<kind_of<T>() == kind::i32, sse2::i32_ops,
+                                sse2::f32_ops>::type>::type sse2_ops;
+  switch (active_simd_level()) {
+    case simd_level::avx2:
+      return avx2::count<avx2_ops>(b, n, bits);
+    case simd_level::sse2:
+      return sse2::count<sse2_ops>(b, n, bits);
+    case simd_level::scalar:
+      break;
+  }
+#endif
+  size_t result = 0;
+  for (size_t i = 0; i < n; ++i) {
+    result += b[i] == bits;
+  }
+  return result;
+}
+
+inline bool equal_f32(const float* a, const float* b, size_t n) {
+#if TRACYSTL_ALGORITHM_X86
+  switch (active_simd_level()) {
+    case simd_level::avx2:
+      return avx2::equal_f32(a, b, n);
+    case simd_level::sse2:
+      return sse2::equal_f32(a, b, n);
+    case simd_level::scalar:
+      break;
+  }
+#endif
+  for (size_t i = 0; i < n; ++i) {
+    if (!(a[i] == b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Index of the first smallest (largest if Max) element; n must be at least
+// 1. Finds the extreme value with the kernels, then its first occurrence.
+// Returns n if the kernels cannot handle the range (a float NaN).
+template <bool Max, class T>
+size_t extreme_element(const T* p, size_t n) {
+#if TRACYSTL_ALGORITHM_X86
+  const simd_level level = active_simd_level();
+  if (level == simd_level::scalar) {
+    return n;
+  }
+  T value;
+  if constexpr (std::is_same<T, float>::value) {
+    const bool ok = level == simd_level::avx2
+                        ? avx2::reduce_f32<Max>(p, n, value)
+                        : sse2::reduce_f32<Max>(p, n, value);
+    if (!ok) {
+      return n;
+    }
+  } else {
+    value = level == simd_level::avx2 ? avx2::reduce_i32<Max>(p, n)
+                                      : sse2::reduce_i32<Max>(p, n);
+  }
+  return algorithm_detail::find(p, n, value);
+#else
+  (void)p;
+  return n;
+#endif
+}
+
+inline uint32_t sum_u32(const uint32_t* p, size_t n) {
+#if TRACYSTL_ALGORITHM_X86
+  switch (active_simd_level()) {
+    case simd_level::avx2:
+      return avx2::sum_u32(p, n);
+    case simd_level::sse2:
+      return sse2::sum_u32(p, n);
+    case simd_level::scalar:
+      break;
+  }
+#endif
+  uint32_t result = 0;
+  for (size_t i = 0; i < n; ++i) {
+    result += p[i];
+  }
+  return result;
+}
+
+}  // namespace algorithm_detail
+
+template <class InputIt, class OutputIt>
+OutputIt copy(InputIt first, InputIt last, OutputIt d_first) {
+  typedef typename iterator_traits<InputIt>::value_type T;
+  if constexpr (algorithm_detail::is_raw_range<InputIt> &&
+                is_contiguous_iterator_v<OutputIt> &&
+                std::is_same<T, typename iterator_traits<OutputIt>::
+                                    value_type>::value) {
+    const auto n = last - first;
+    if (n > 0) {
+      std::memmove(static_cast<void*>(algorithm_detail::raw(d_first)),
+                   static_cast<const void*>(algorithm_detail::raw(first)),
+                   static_cast<size_t>(n) * sizeof(T));
+    }
+    return d_first + n;
+  } else {
+    for (; first != last; ++first, ++d_first) {
+      *d_first = *first;
+    }
+    return d_first;
+  }
+}
+
+template <class InputIt, class OutputIt>
+OutputIt move(InputIt first, InputIt last, OutputIt d_first) {
+  typedef typename iterator_traits<InputIt>::value_type T;
+  if constexpr (algorithm_detail::is_raw_range<InputIt> &&
+                is_contiguous_iterator_v<OutputIt> &&
+                std::is_same<T, typename iterator_traits<OutputIt>::
+                                    value_type>::value) {
+    // moving a trivially copyable object is copying it
+    return tracystl::copy(first, last, d_first);
+  } else {
+    for (; first != last; ++first, ++d_first) {
+      *d_first = std::move(*first);
+    }
+    return d_first;
+  }
+}
+
+template <class ForwardIt, class T>
+void fill(ForwardIt first, ForwardIt last, const T& value) {
+  typedef typename iterator_traits<ForwardIt>::value_type V;
+  if constexpr (algorithm_detail::is_raw_range<ForwardIt> &&
+                std::is_arithmetic<V>::value) {
+    const V v = static_cast<V>(value);
+    unsigned char bytes[sizeof(V)];
+    std::memcpy(bytes, &v, sizeof(V));
+    bool same_bytes = true;
+    for (size_t i = 1; i < sizeof(V); ++i) {
+      same_bytes = same_bytes && bytes[i] == bytes[0];
+    }
+    // one byte repeated: bytes, zeros, -1
+    if (same_bytes) {
+      const auto n = last - first;
+      if (n > 0) {
+        std::memset(static_cast<void*>(algorithm_detail::raw(first)),
+                    bytes[0], static_cast<size_t>(n) * sizeof(V));
+      }
+      return;
+    }
+  }
+  for (; first != last; ++first) {
+    *first = value;
+  }
+}
+
+template <class InputIt, class T>
+InputIt find(InputIt first, InputIt last, const T& value) {
+  typedef typename iterator_traits<InputIt>::value_type V;
+  if constexpr (algorithm_detail::is_raw_range<InputIt> &&
+                algorithm_detail::kind_of<V>() !=
+                    algorithm_detail::kind::none &&
+                std::is_same<V, typename std::remove_cv<T>::type>::value) {
+    const auto n = last - first;
+    if (n <= 0) {
+      return last;
+    }
+    return first + static_cast<decltype(n)>(algorithm_detail::find(
+                       algorithm_detail::raw(first), static_cast<size_t>(n),
+                       value));
+  } else {
+    for (; first != last; ++first) {
+      if (*first == value) {
+        break;
+      }
+    }
+    return first;
+  }
+}
+
+template <class InputIt, class T>
+typename iterator_traits<InputIt>::difference_type count(InputIt first,
+                                                         InputIt last,
+                                                         const T& value) {
+  typedef typename iterator_traits<InputIt>::value_type V;
+  typedef typename iterator_traits<InputIt>::difference_type difference_type;
+  if constexpr (algorithm_detail::is_raw_range<InputIt> &&
+                algorithm_detail::kind_of<V>() !=
+                    algorithm_detail::kind::none &&
+                std::is_same<V, typename std::remove_cv<T>::type>::value) {
+    const auto n = last - first;
+    if (n <= 0) {
+      return 0;
+    }
+    return static_cast<difference_type>(algorithm_detail::count(
+        algorithm_detail::raw(first), static_cast<size_t>(n), value));
+  } else {
+    difference_type result = 0;
+    for (; first != last; ++first) {
+      if (*first == value) {
+        ++result;
+      }
+    }
+    return result;
+  }
+}
+
+template <class InputIt1, class InputIt2>
+bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+  typedef typename iterator_traits<InputIt1>::value_type V;
+  if constexpr (algorithm_detail::is_raw_range<InputIt1> &&
+                is_contiguous_iterator_v<InputIt2> &&
+                std::is_same<V, typename iterator_traits<InputIt2>::
+                                    value_type>::value &&
+                (algorithm_detail::is_bitwise_comparable<V> ||
+                 std::is_same<V, float>::value)) {
+    const auto n = last1 - first1;
+    if (n <= 0) {
+      return true;
+    }
+    if constexpr (std::is_same<V, float>::value) {
+      return algorithm_detail::equal_f32(algorithm_detail::raw(first1),
+                                         algorithm_detail::raw(first2),
+                                         static_cast<size_t>(n));
+    } else {
+      return std::memcmp(algorithm_detail::raw(first1),
+                         algorithm_detail::raw(first2),
+                         static_cast<size_t>(n) * sizeof(V)) == 0;
+    }
+  } else {
+    for (; first1 != last1; ++first1, ++first2) {
+      if (!(*first1 == *first2)) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+// the ranges are equal only if they have the same length
+template <class InputIt1, class InputIt2>
+bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+           InputIt2 last2) {
+  if constexpr (iterator_detail::is_random_access<InputIt1> &&
+                iterator_detail::is_random_access<InputIt2>) {
+    if (last1 - first1 != last2 - first2) {
+      return false;
+    }
+    return tracystl::equal(first1, last1, first2);
+  } else {
+    for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+      if (!(*first1 == *first2)) {
+        return false;
+      }
+    }
+    return first1 == last1 && first2 == last2;
+  }
+}
+
+// the first smallest element, last if the range is empty
+template <class ForwardIt>
+ForwardIt min_element(ForwardIt first, ForwardIt last) {
+  typedef typename std::remove_cv<
+      typename iterator_traits<ForwardIt>::value_type>::type V;
+  if constexpr (algorithm_detail::is_raw_range<ForwardIt> &&
+                (std::is_same<V, int32_t>::value ||
+                 std::is_same<V, float>::value)) {
+    const auto n = last - first;
+    if (n > 0) {
+      const size_t i = algorithm_detail::extreme_element<false>(
+          algorithm_detail::raw(first), static_cast<size_t>(n));
+      if (i != static_cast<size_t>(n)) {
+        return first + static_cast<decltype(n)>(i);
+      }
+    }
+  }
+  if (first == last) {
+    return last;
+  }
+  ForwardIt smallest = first;
+  while (++first != last) {
+    if (*first < *smallest) {
+      smallest = first;
+    }
+  }
+  return smallest;
+}
+
+// the first largest element, last if the range is empty
+template <class ForwardIt>
+ForwardIt max_element(ForwardIt first, ForwardIt last) {
+  typedef typename std::remove_cv<
+      typename iterator_traits<ForwardIt>::value_type>::type V;
+  if constexpr (algorithm_detail::is_raw_range<ForwardIt> &&
+                (std::is_same<V, int32_t>::value ||
+                 std::is_same<V, float>::value)) {
+    const auto n = last - first;
+    if (n > 0) {
+      const size_t i = algorithm_detail::extreme_element<true>(
+          algorithm_detail::raw(first), static_cast<size_t>(n));
+      if (i != static_cast<size_t>(n)) {
+        return first + static_cast<decltype(n)>(i);
+      }
+    }
+  }
+  if (first == last) {
+    return last;
+  }
+  ForwardIt largest = first;
+  while (++first != last) {
+    if (*largest < *first) {
+      largest = first;
+    }
+  }
+  return largest;
+}
+
+// Left fold with +. Only 32-bit integer sums are vectorised: they are the
+// same in any order (wrapping on overflow), which is not true of floats.
+template <class InputIt, class T>
+T accumulate(InputIt first, InputIt last, T init) {
+  typedef typename std::remove_cv<
+      typename iterator_traits<InputIt>::value_type>::type V;
+  if constexpr (algorithm_detail::is_raw_range<InputIt> &&
+                std::is_integral<V>::value && sizeof(V) == 4 &&
+                std::is_same<V, T>::value) {
+    const auto n = last - first;
+    if (n <= 0) {
+      return init;
+    }
+    const uint32_t sum = algorithm_detail::sum_u32(
+        reinterpret_cast<const uint32_t*>(algorithm_detail::raw(first)),
+        static_cast<size_t>(n));
+    return static_cast<T>(static_cast<uint32_t>(init) + sum);
+  } else {
+    for (; first != last; ++first) {
+      init = std::move(init) + *first;
+    }
+    return init;
+  }
+}
+
+template <class InputIt, class T, class BinaryOp>
+T accumulate(InputIt first, InputIt last, T init, BinaryOp op) {
+  for (; first != last; ++first) {
+    init = op(std::move(init), *first);
+  }
+  return init;
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_ALGORITHM_H_
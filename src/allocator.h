@@ -1,7 +1,18 @@
 #ifndef _TRACYSTL_ALLOCATOR_H_
 #define _TRACYSTL_ALLOCATOR_H_
 #include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
 #include <utility>
+
+// Size of a destructive-interference unit. Concurrent containers keep state
+// written by different threads on different lines of this size so they do not
+// invalidate each other. Override it for targets with other line sizes.
+#ifndef TRACYSTL_CACHE_LINE_SIZE
+#define TRACYSTL_CACHE_LINE_SIZE 64
+#endif
+
 namespace tracystl {
 
 template <class T>
@@ -16,7 +27,22 @@ class Allocator {
   typedef size_t size_type;
   typedef ptrdiff_t difference_type;
 
+  // Allocator<T>::rebind<U>::other is the same allocator for another type,
+  // e.g. List<T> turns its Allocator<T> into an Allocator<list_node<T>>.
+  template <class U>
+  struct rebind {
+    typedef Allocator<U> other;
+  };
+
  public:
+  // Allocator is stateless: the members stay static so Allocator<T>::allocate
+  // keeps working, but containers hold an instance (taking no space, see
+  // allocator_holder) and call through it, so stateful allocators plug in
+  // the same way.
+  Allocator() noexcept {}
+  template <class U>
+  Allocator(const Allocator<U>&) noexcept {}
+
   static T* allocate();
   static T* allocate(size_t n);
 
@@ -26,11 +52,24 @@ class Allocator {
   static void construct(T* ptr);
   static void construct(T* ptr, const T& value);
   static void construct(T* ptr, T&& value);
+  template <class... Args>
+  static void construct(T* ptr, Args&&... args);
 
   static void destroy(T* ptr);
   static void destroy(T* first, T* last);
 };
 
+// any two Allocators can free each other's memory
+template <class T, class U>
+bool operator==(const Allocator<T>&, const Allocator<U>&) noexcept {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const Allocator<T>&, const Allocator<U>&) noexcept {
+  return false;
+}
+
 template <class T>
 T* Allocator<T>::allocate() {
   return static_cast<T*>(::operator new(sizeof(T)));
@@ -83,6 +122,13 @@ void Allocator<T>::construct(T* ptr, T&& value) {
   new (ptr) T(std::move(value));
 }
 
+// in-place construction from arbitrary constructor arguments (emplace_back etc.)
+template <class T>
+template <class... Args>
+void Allocator<T>::construct(T* ptr, Args&&... args) {
+  new (ptr) T(std::forward<Args>(args)...);
+}
+
 template <class T>
 void Allocator<T>::destroy(T* ptr) {
   if(ptr == nullptr) {
@@ -101,5 +147,387 @@ void Allocator<T>::destroy(T* first, T* last) {
   }
 }
 
+// PoolAllocator hands out fixed-size slots carved from large slabs.
+// It is meant for node based containers (List), where every allocation has
+// the same size: allocate(1) pops a slot from the free list (or bumps a pointer
+// in the newest slab) and deallocate(p, 1) pushes it back, so ::operator new is
+// only called once per SlotsPerSlab nodes.
+//
+// The pool is owned by the allocator instance: a copy starts with an empty
+// pool, and release() hands every slab back to ::operator delete at once, which
+// is how List::clear() frees all its nodes in O(number of slabs).
+// Requests for more than one object bypass the pool.
+template <class T, size_t SlotsPerSlab = 256>
+class PoolAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <class U>
+  struct rebind {
+    typedef PoolAllocator<U, SlotsPerSlab> other;
+  };
+
+  static_assert(SlotsPerSlab > 0, "a slab needs at least one slot");
+
+ private:
+  union slot {
+    slot* next_;
+    alignas(T) unsigned char storage_[sizeof(T)];
+  };
+  struct slab {
+    slab* next_;
+    slot slots_[SlotsPerSlab];
+  };
+
+  slab* slabs_;       // every slab we own, newest first
+  slot* free_list_;   // slots given back by deallocate
+  slot* bump_;        // next never-used slot of the newest slab
+  slot* bump_end_;
+
+ public:
+  PoolAllocator() noexcept
+      : slabs_(nullptr), free_list_(nullptr), bump_(nullptr), bump_end_(nullptr) {}
+  // pools are never shared, a copy (or a rebound copy) gets its own empty pool
+  PoolAllocator(const PoolAllocator&) noexcept : PoolAllocator() {}
+  template <class U>
+  PoolAllocator(const PoolAllocator<U, SlotsPerSlab>&) noexcept : PoolAllocator() {}
+  PoolAllocator(PoolAllocator&& rhs) noexcept
+      : slabs_(rhs.slabs_), free_list_(rhs.free_list_), bump_(rhs.bump_),
+        bump_end_(rhs.bump_end_) {
+    rhs.slabs_ = nullptr;
+    rhs.free_list_ = rhs.bump_ = rhs.bump_end_ = nullptr;
+  }
+  PoolAllocator& operator=(const PoolAllocator&) noexcept { return *this; }
+  // moving a pool moves its slabs, so containers can swap/move their storage
+  PoolAllocator& operator=(PoolAllocator&& rhs) noexcept {
+    if (this != &rhs) {
+      release();
+      slabs_ = rhs.slabs_;
+      free_list_ = rhs.free_list_;
+      bump_ = rhs.bump_;
+      bump_end_ = rhs.bump_end_;
+      rhs.slabs_ = nullptr;
+      rhs.free_list_ = rhs.bump_ = rhs.bump_end_ = nullptr;
+    }
+    return *this;
+  }
+  ~PoolAllocator() { release(); }
+
+  // only the pool that handed out a slot can take it back
+  bool operator==(const PoolAllocator& rhs) const noexcept { return this == &rhs; }
+  bool operator!=(const PoolAllocator& rhs) const noexcept { return this != &rhs; }
+
+  T* allocate() { return allocate(1); }
+  T* allocate(size_t n);
+
+  void deallocate(T* ptr) { deallocate(ptr, 1); }
+  void deallocate(T* ptr, size_type n);
+
+  // returns every slab at once; all outstanding pointers become invalid
+  void release() noexcept;
+
+  template <class... Args>
+  static void construct(T* ptr, Args&&... args) {
+    new (ptr) T(std::forward<Args>(args)...);
+  }
+  static void destroy(T* ptr) { Allocator<T>::destroy(ptr); }
+  static void destroy(T* first, T* last) { Allocator<T>::destroy(first, last); }
+};
+
+template <class T, size_t SlotsPerSlab>
+T* PoolAllocator<T, SlotsPerSlab>::allocate(size_t n) {
+  if (n != 1) {
+    return Allocator<T>::allocate(n);
+  }
+  if (free_list_ != nullptr) {
+    slot* s = free_list_;
+    free_list_ = s->next_;
+    return reinterpret_cast<T*>(s->storage_);
+  }
+  if (bump_ == bump_end_) {
+    slab* fresh = static_cast<slab*>(::operator new(sizeof(slab)));
+    fresh->next_ = slabs_;
+    slabs_ = fresh;
+    bump_ = fresh->slots_;
+    bump_end_ = fresh->slots_ + SlotsPerSlab;
+  }
+  return reinterpret_cast<T*>((bump_++)->storage_);
+}
+
+template <class T, size_t SlotsPerSlab>
+void PoolAllocator<T, SlotsPerSlab>::deallocate(T* ptr, size_type n) {
+  if (ptr == nullptr) {
+    return;
+  }
+  if (n != 1) {
+    Allocator<T>::deallocate(ptr, n);
+    return;
+  }
+  slot* s = reinterpret_cast<slot*>(ptr);
+  s->next_ = free_list_;
+  free_list_ = s;
+}
+
+template <class T, size_t SlotsPerSlab>
+void PoolAllocator<T, SlotsPerSlab>::release() noexcept {
+  while (slabs_ != nullptr) {
+    slab* next = slabs_->next_;
+    ::operator delete(slabs_);
+    slabs_ = next;
+  }
+  free_list_ = bump_ = bump_end_ = nullptr;
+}
+
+// MonotonicArena is a bump-pointer memory resource for request-scoped data.
+// Memory comes from a chain of blocks; allocate only moves a cursor forward,
+// deallocate does nothing, and everything is given back at once:
+//   reset()   rewinds to the first block and keeps the blocks for reuse, so a
+//             warmed-up arena serves later requests without ::operator new;
+//   release() returns every block to ::operator delete.
+// Blocks grow geometrically, and an optional caller-provided initial buffer
+// (e.g. on the stack) is used before any block is allocated. A request too
+// large for any block throws std::bad_alloc.
+// Not thread safe: use one arena per thread/request.
+class MonotonicArena {
+ private:
+  struct block {
+    block* next_;
+    size_t size_;  // usable bytes after the header
+    unsigned char* data() { return reinterpret_cast<unsigned char*>(this + 1); }
+  };
+
+  block* head_;     // first block we own (blocks are kept in creation order)
+  block* current_;  // block the cursor is in, nullptr while in the initial buffer
+  unsigned char* cursor_;
+  unsigned char* limit_;
+  unsigned char* initial_;
+  size_t initial_size_;
+  size_t next_block_size_;
+
+ public:
+  explicit MonotonicArena(size_t block_size = 4096) noexcept
+      : MonotonicArena(nullptr, 0, block_size) {}
+  MonotonicArena(void* buffer, size_t size, size_t block_size = 4096) noexcept
+      : head_(nullptr), current_(nullptr),
+        cursor_(static_cast<unsigned char*>(buffer)),
+        limit_(static_cast<unsigned char*>(buffer) + size),
+        initial_(static_cast<unsigned char*>(buffer)), initial_size_(size),
+        next_block_size_(block_size != 0 ? block_size : 1) {}
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+  ~MonotonicArena() { release(); }
+
+  void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+  void deallocate(void*, size_t) noexcept {}
+
+  void reset() noexcept;
+  void release() noexcept;
+
+ private:
+  // aligns the cursor for `alignment` and checks the block has `bytes` left
+  static unsigned char* fit(unsigned char* cursor, unsigned char* limit,
+                            size_t bytes, size_t alignment) noexcept {
+    const size_t misalign = reinterpret_cast<size_t>(cursor) & (alignment - 1);
+    const size_t padding = misalign != 0 ? alignment - misalign : 0;
+    if (static_cast<size_t>(limit - cursor) < padding ||
+        static_cast<size_t>(limit - cursor) - padding < bytes) {
+      return nullptr;
+    }
+    return cursor + padding;
+  }
+};
+
+inline void* MonotonicArena::allocate(size_t bytes, size_t alignment) {
+  if (cursor_ != nullptr) {
+    if (unsigned char* p = fit(cursor_, limit_, bytes, alignment)) {
+      cursor_ = p + bytes;
+      return p;
+    }
+  }
+  // try the blocks kept by reset() before asking ::operator new
+  block* next = current_ != nullptr ? current_->next_ : head_;
+  while (next != nullptr) {
+    if (unsigned char* p = fit(next->data(), next->data() + next->size_, bytes,
+                               alignment)) {
+      current_ = next;
+      limit_ = next->data() + next->size_;
+      cursor_ = p + bytes;
+      return p;
+    }
+    next = next->next_;
+  }
+  // the block header and the alignment padding come on top of bytes
+  constexpr size_t max_block_size =
+      std::numeric_limits<size_t>::max() - sizeof(block);
+  if (bytes > max_block_size - alignment) {
+    throw std::bad_alloc();
+  }
+  const size_t needed = bytes + alignment;
+  size_t size = next_block_size_;
+  while (size < needed) {
+    if (size > max_block_size / 2) {
+      size = needed;  // doubling would overflow
+      break;
+    }
+    size *= 2;
+  }
+  next_block_size_ = size <= max_block_size / 2 ? size * 2 : size;
+  block* fresh = static_cast<block*>(::operator new(sizeof(block) + size));
+  fresh->size_ = size;
+  // append after the current block so reset() replays blocks in order
+  if (current_ != nullptr) {
+    fresh->next_ = current_->next_;
+    current_->next_ = fresh;
+  } else {
+    fresh->next_ = head_;
+    head_ = fresh;
+  }
+  current_ = fresh;
+  limit_ = fresh->data() + size;
+  unsigned char* p = fit(fresh->data(), limit_, bytes, alignment);
+  cursor_ = p + bytes;
+  return p;
+}
+
+inline void MonotonicArena::reset() noexcept {
+  current_ = nullptr;
+  cursor_ = initial_;
+  limit_ = initial_ + initial_size_;
+}
+
+inline void MonotonicArena::release() noexcept {
+  while (head_ != nullptr) {
+    block* next = head_->next_;
+    ::operator delete(head_);
+    head_ = next;
+  }
+  reset();
+}
+
+// ArenaAllocator<T> adapts a MonotonicArena to the container allocator
+// interface: Vector<T, ArenaAllocator<T>> and List<T, ArenaAllocator<T>>
+// allocate from the arena and their deallocations are free. The arena must
+// outlive every container using it; copies share the same arena.
+template <class T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <class U>
+  struct rebind {
+    typedef ArenaAllocator<U> other;
+  };
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {}
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& rhs) noexcept : arena_(rhs.arena()) {}
+
+  T* allocate() { return allocate(1); }
+  T* allocate(size_t n) {
+    if (n == 0) {
+      return nullptr;
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T*) noexcept {}
+  void deallocate(T*, size_type) noexcept {}
+
+  template <class... Args>
+  static void construct(T* ptr, Args&&... args) {
+    new (ptr) T(std::forward<Args>(args)...);
+  }
+  static void destroy(T* ptr) { Allocator<T>::destroy(ptr); }
+  static void destroy(T* first, T* last) { Allocator<T>::destroy(first, last); }
+
+  MonotonicArena* arena() const noexcept { return arena_; }
+
+ private:
+  MonotonicArena* arena_;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+  return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+  return lhs.arena() != rhs.arena();
+}
+
+// Detects allocators that can free everything they handed out in one call
+// (PoolAllocator::release). A container that owns such an allocator instance
+// may skip the per-element deallocate when it empties itself.
+template <class Alloc, class = void>
+struct has_bulk_release : std::false_type {};
+
+template <class Alloc>
+struct has_bulk_release<Alloc, std::void_t<decltype(std::declval<Alloc&>().release())>>
+    : std::true_type {};
+
+// Containers call this whenever they move their elements to a bigger (or
+// smaller) buffer, e.g. Vector growth. Allocators that want to observe it
+// (InstrumentedAllocator) provide on_reallocate(old_bytes, new_bytes); for all
+// others the call compiles to nothing.
+template <class Alloc, class = void>
+struct has_on_reallocate : std::false_type {};
+
+template <class Alloc>
+struct has_on_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().on_reallocate(
+                                    size_t(), size_t()))>> : std::true_type {};
+
+template <class Alloc>
+inline void notify_reallocate(Alloc& alloc, size_t old_bytes, size_t new_bytes) {
+  if constexpr (has_on_reallocate<Alloc>::value) {
+    alloc.on_reallocate(old_bytes, new_bytes);
+  } else {
+    (void)alloc;
+    (void)old_bytes;
+    (void)new_bytes;
+  }
+}
+
+// Stores an allocator instance inside a container. Empty (stateless)
+// allocators such as Allocator<T> are kept as a base class, so thanks to the
+// empty base optimization they add nothing to sizeof(container); stateful ones
+// are stored as a plain member.
+template <class Alloc,
+          bool = std::is_empty<Alloc>::value && !std::is_final<Alloc>::value>
+class allocator_holder : private Alloc {
+ public:
+  allocator_holder() = default;
+  explicit allocator_holder(const Alloc& alloc) : Alloc(alloc) {}
+  explicit allocator_holder(Alloc&& alloc) : Alloc(std::move(alloc)) {}
+
+  Alloc& alloc() noexcept { return *this; }
+  const Alloc& alloc() const noexcept { return *this; }
+};
+
+template <class Alloc>
+class allocator_holder<Alloc, false> {
+ public:
+  allocator_holder() = default;
+  explicit allocator_holder(const Alloc& alloc) : alloc_(alloc) {}
+  explicit allocator_holder(Alloc&& alloc) : alloc_(std::move(alloc)) {}
+
+  Alloc& alloc() noexcept { return alloc_; }
+  const Alloc& alloc() const noexcept { return alloc_; }
+
+ private:
+  Alloc alloc_;
+};
+
 }  // namespace tracystl
 #endif  // TRACYSTL_ALLOCATOR_H
\ No newline at end of file
@@ -0,0 +1,986 @@
+#ifndef _TRACYSTL_BTREE_H_
+#define _TRACYSTL_BTREE_H_
+
+#include "allocator.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "uninitialized.h"
+#include "utility.h"
+#include <cstddef> // For std::size_t
+#include <functional>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tracystl {
+
+// Bytes per B-tree node, a few cache lines. Lookups do one binary search per
+// node, so a tree of n elements touches about log_{B}(n) nodes instead of
+// the log_2(n) of a red-black tree.
+#ifndef TRACYSTL_BTREE_NODE_BYTES
+#define TRACYSTL_BTREE_NODE_BYTES 256
+#endif
+
+namespace btree_detail {
+
+template <class T>
+struct identity_key {
+  const T& operator()(const T& value) const noexcept { return value; }
+};
+
+template <class Pair>
+struct first_key {
+  const typename Pair::first_type& operator()(const Pair& value) const
+      noexcept {
+    return value.first;
+  }
+};
+
+// Leaves hold only values; internal nodes add count + 1 child pointers.
+// Every node knows its parent and its index there, so iterators need
+// nothing but (node, position).
+template <class V, size_t NodeBytes>
+struct node {
+  static constexpr size_t header_bytes = sizeof(void*) + 8;
+  static constexpr size_t fitting = NodeBytes > header_bytes
+                                        ? (NodeBytes - header_bytes) / sizeof(V)
+                                        : 0;
+  // at least 3 values, so a split always leaves both halves non-empty
+  // after the insertion; at most 255 so count fits in a byte
+  static constexpr size_t max_values =
+      fitting < 3 ? 3 : fitting > 255 ? 255 : fitting;
+  static constexpr size_t min_values = max_values / 2;
+
+  node* parent;
+  unsigned char position;
+  unsigned char count;
+  bool leaf;
+  alignas(V) unsigned char storage[max_values * sizeof(V)];
+
+  V* values() noexcept { return reinterpret_cast<V*>(storage); }
+  V& value(size_t i) noexcept { return values()[i]; }
+};
+
+template <class V, size_t NodeBytes>
+struct internal_node : node<V, NodeBytes> {
+  node<V, NodeBytes>* children[node<V, NodeBytes>::max_values + 1];
+};
+
+}  // namespace btree_detail
+
+template <class V, size_t NodeBytes, class Ref, class Ptr>
+class btree_iterator
+    : public tracystl::iterator<tracystl::bidirectional_iterator_tag, V,
+                                std::ptrdiff_t, Ptr, Ref> {
+  typedef btree_detail::node<V, NodeBytes> node_type;
+  typedef btree_detail::internal_node<V, NodeBytes> internal_type;
+
+ public:
+  btree_iterator() noexcept : node_(nullptr), position_(0) {}
+  btree_iterator(node_type* n, size_t position) noexcept
+      : node_(n), position_(position) {}
+  // iterator -> const_iterator
+  template <class R, class P,
+            class = typename std::enable_if<
+                std::is_convertible<P, Ptr>::value>::type>
+  btree_iterator(const btree_iterator<V, NodeBytes, R, P>& rhs) noexcept
+      : node_(rhs.node_), position_(rhs.position_) {}
+
+  Ref operator*() const noexcept { return node_->value(position_); }
+  Ptr operator->() const noexcept { return &node_->value(position_); }
+
+  btree_iterator& operator++() noexcept {
+    if (node_->leaf && ++position_ < node_->count) {
+      return *this;
+    }
+    increment_slow();
+    return *this;
+  }
+  btree_iterator operator++(int) noexcept {
+    btree_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  btree_iterator& operator--() noexcept {
+    if (node_->leaf && position_ > 0) {
+      --position_;
+      return *this;
+    }
+    decrement_slow();
+    return *this;
+  }
+  btree_iterator operator--(int) noexcept {
+    btree_iterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  friend bool operator==(const btree_iterator& a,
+                         const btree_iterator& b) noexcept {
+    return a.node_ == b.node_ && a.position_ == b.position_;
+  }
+  friend bool operator!=(const btree_iterator& a,
+                         const btree_iterator& b) noexcept {
+    return !(a == b);
+  }
+
+ private:
+  template <class, size_t, class, class>
+  friend class btree_iterator;
+  template <class, class, class, class, class, size_t>
+  friend class btree;
+
+  static node_type* child(node_type* n, size_t i) noexcept {
+    return static_cast<internal_type*>(n)->children[i];
+  }
+
+  // Past the last value of a leaf, or on an internal value: the next value
+  // is the leftmost one of the right subtree, or the first ancestor we
+  // climb into from the left. Running off the root yields end(), which is
+  // one past the last value of the rightmost leaf.
+  void increment_slow() noexcept {
+    if (node_->leaf) {
+      node_type* n = node_;
+      size_t position = position_;
+      while (position == n->count && n->parent != nullptr) {
+        position = n->position;
+        n = n->parent;
+      }
+      if (position != n->count) {
+        node_ = n;
+        position_ = position;
+      }
+      return;
+    }
+    node_ = child(node_, position_ + 1);
+    while (!node_->leaf) {
+      node_ = child(node_, 0);
+    }
+    position_ = 0;
+  }
+
+  void decrement_slow() noexcept {
+    if (node_->leaf) {
+      while (position_ == 0 && node_->parent != nullptr) {
+        position_ = node_->position;
+        node_ = node_->parent;
+      }
+      --position_;
+      return;
+    }
+    node_ = child(node_, position_);
+    while (!node_->leaf) {
+      node_ = child(node_, node_->count);
+    }
+    position_ = node_->count - 1;
+  }
+
+  node_type* node_;
+  size_t position_;
+};
+
+// The tree shared by BTreeMap and BTreeSet. Values are stored in every node
+// (not only in leaves), ordered by Compare applied to KeyOfValue(value), and
+// keys are unique.
+//
+// Inserting at the very end or the very beginning of a full node splits it
+// unevenly, so sorted input fills nodes completely instead of halfway. Any
+// insertion or erase invalidates all iterators except the one erase()
+// returns. Moving values between nodes assumes their relocation does not
+// throw.
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes = TRACYSTL_BTREE_NODE_BYTES>
+class btree
+    : private allocator_holder<typename Alloc::template rebind<
+          btree_detail::node<V, NodeBytes>>::other>,
+      private allocator_holder<typename Alloc::template rebind<
+          btree_detail::internal_node<V, NodeBytes>>::other> {
+ public:
+  typedef Key key_type;
+  typedef V value_type;
+  typedef Compare key_compare;
+  typedef Alloc allocator_type;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef btree_iterator<V, NodeBytes, const V&, const V*> const_iterator;
+  // a set's elements are its keys and must not change in place
+  typedef typename std::conditional<
+      std::is_same<Key, V>::value, const_iterator,
+      btree_iterator<V, NodeBytes, V&, V*>>::type iterator;
+
+ protected:
+  typedef btree_detail::node<V, NodeBytes> node_type;
+  typedef btree_detail::internal_node<V, NodeBytes> internal_type;
+  typedef typename Alloc::template rebind<node_type>::other leaf_allocator;
+  typedef
+      typename Alloc::template rebind<internal_type>::other internal_allocator;
+  typedef allocator_holder<leaf_allocator> leaf_base;
+  typedef allocator_holder<internal_allocator> internal_base;
+
+ public:
+  static constexpr size_type node_values = node_type::max_values;
+
+  btree() : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr),
+            size_(0) {}
+  explicit btree(const Compare& comp, const Alloc& a = Alloc())
+      : leaf_base(leaf_allocator(a)), internal_base(internal_allocator(a)),
+        root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0),
+        comp_(comp) {}
+  // the source is already in order: every element is appended
+  btree(const btree& rhs)
+      : leaf_base(rhs.leaf_alloc()), internal_base(rhs.internal_alloc()),
+        root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0),
+        comp_(rhs.comp_) {
+    try {
+      for (const_iterator it = rhs.begin(); it != rhs.end(); ++it) {
+        append_back(*it);
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+  btree(btree&& rhs) noexcept
+      : leaf_base(std::move(rhs.leaf_alloc())),
+        internal_base(std::move(rhs.internal_alloc())), root_(rhs.root_),
+        leftmost_(rhs.leftmost_), rightmost_(rhs.rightmost_),
+        size_(rhs.size_), comp_(std::move(rhs.comp_)) {
+    rhs.root_ = rhs.leftmost_ = rhs.rightmost_ = nullptr;
+    rhs.size_ = 0;
+  }
+  ~btree() { clear(); }
+
+  btree& operator=(const btree& rhs) {
+    if (this != &rhs) {
+      btree tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+  btree& operator=(btree&& rhs) noexcept {
+    if (this != &rhs) {
+      btree tmp(std::move(rhs));
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  void swap(btree& rhs) noexcept {
+    using std::swap;
+    swap(leaf_alloc(), rhs.leaf_alloc());
+    swap(internal_alloc(), rhs.internal_alloc());
+    swap(root_, rhs.root_);
+    swap(leftmost_, rhs.leftmost_);
+    swap(rightmost_, rhs.rightmost_);
+    swap(size_, rhs.size_);
+    swap(comp_, rhs.comp_);
+  }
+
+  allocator_type get_allocator() const {
+    return allocator_type(leaf_alloc());
+  }
+  key_compare key_comp() const { return comp_; }
+
+  iterator begin() noexcept { return iterator(leftmost_, 0); }
+  const_iterator begin() const noexcept { return const_iterator(leftmost_, 0); }
+  iterator end() noexcept {
+    return iterator(rightmost_, rightmost_ != nullptr ? rightmost_->count : 0);
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(rightmost_,
+                          rightmost_ != nullptr ? rightmost_->count : 0);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  void clear() noexcept {
+    if (root_ != nullptr) {
+      destroy_subtree(root_);
+    }
+    root_ = leftmost_ = rightmost_ = nullptr;
+    size_ = 0;
+  }
+
+  // lookup
+  iterator lower_bound(const key_type& key) {
+    return lower_bound_impl<false>(key);
+  }
+  const_iterator lower_bound(const key_type& key) const {
+    return const_cast<btree*>(this)->lower_bound(key);
+  }
+  iterator upper_bound(const key_type& key) {
+    return lower_bound_impl<true>(key);
+  }
+  const_iterator upper_bound(const key_type& key) const {
+    return const_cast<btree*>(this)->upper_bound(key);
+  }
+  std::pair<iterator, iterator> equal_range(const key_type& key) {
+    return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+  }
+  iterator find(const key_type& key) {
+    iterator it = lower_bound(key);
+    return it != end() && !comp_(key, key_of(*it)) ? it : end();
+  }
+  const_iterator find(const key_type& key) const {
+    return const_cast<btree*>(this)->find(key);
+  }
+  bool contains(const key_type& key) const { return find(key) != end(); }
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  // insertion; the bool is false if the key was already there
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return insert_unique(key_of(value), value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return insert_unique(key_of(value), std::move(value));
+  }
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+  // Bulk load: values greater than everything in the tree go straight into
+  // the rightmost leaf without a search, so loading n sorted values is O(n).
+  // Values that turn out not to be in order are inserted normally.
+  template <class InputIt>
+  void insert(sorted_unique_t, InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      if (empty() ||
+          comp_(key_of(rightmost_->value(rightmost_->count - 1)),
+                key_of(*first))) {
+        append_back(*first);
+      } else {
+        insert(*first);
+      }
+    }
+  }
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  // erase returns the iterator following the erased element(s)
+  iterator erase(const_iterator pos);
+  template <class It,
+            class = typename std::enable_if<
+                std::is_same<It, iterator>::value &&
+                !std::is_same<It, const_iterator>::value>::type>
+  iterator erase(It pos) {
+    return erase(const_iterator(pos));
+  }
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type& key) {
+    iterator it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    erase(it);
+    return 1;
+  }
+
+ protected:
+  static const key_type& key_of(const value_type& value) noexcept {
+    return KeyOfValue()(value);
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> insert_unique(const key_type& key,
+                                          Args&&... args);
+  template <class... Args>
+  iterator append_back(Args&&... args) {
+    if (root_ == nullptr) {
+      root_ = leftmost_ = rightmost_ = new_node(true);
+    }
+    return insert_at(rightmost_, rightmost_->count,
+                     std::forward<Args>(args)...);
+  }
+
+ private:
+  leaf_allocator& leaf_alloc() noexcept { return leaf_base::alloc(); }
+  const leaf_allocator& leaf_alloc() const noexcept {
+    return leaf_base::alloc();
+  }
+  internal_allocator& internal_alloc() noexcept {
+    return internal_base::alloc();
+  }
+  const internal_allocator& internal_alloc() const noexcept {
+    return internal_base::alloc();
+  }
+
+  static node_type*& child(node_type* n, size_type i) noexcept {
+    return static_cast<internal_type*>(n)->children[i];
+  }
+  static void set_child(node_type* n, size_type i, node_type* c) noexcept {
+    child(n, i) = c;
+    c->parent = n;
+    c->position = static_cast<unsigned char>(i);
+  }
+
+  node_type* new_node(bool leaf);
+  void free_node(node_type* n) noexcept;
+  void destroy_subtree(node_type* n) noexcept;
+
+  // first value not less than key (Upper: first value greater than key)
+  template <bool Upper>
+  iterator lower_bound_impl(const key_type& key);
+  // same, within one node
+  template <bool Upper>
+  size_type search_node(node_type* n, const key_type& key) const;
+
+  template <class... Args>
+  iterator insert_at(node_type* n, size_type position, Args&&... args);
+  // inserts a value relocated from *value (and, in internal nodes, the child
+  // to its right); n must not be full
+  void insert_into_node(node_type* n, size_type position, value_type* value,
+                        node_type* right_child) noexcept;
+  void split(node_type*& n, size_type& position);
+
+  void rebalance_after_erase(node_type* n, iterator& track) noexcept;
+  void merge(node_type* parent, size_type i, iterator& track) noexcept;
+  void rotate_left(node_type* parent, size_type i, size_type k,
+                   iterator& track) noexcept;
+  void rotate_right(node_type* parent, size_type i, size_type k,
+                    iterator& track) noexcept;
+
+  node_type* root_;
+  node_type* leftmost_;
+  node_type* rightmost_;
+  size_type size_;
+  Compare comp_;
+};
+
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+typename btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::node_type*
+btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::new_node(bool leaf) {
+  node_type* n;
+  if (leaf) {
+    n = leaf_alloc().allocate(1);
+  } else {
+    internal_type* in = internal_alloc().allocate(1);
+    n = in;
+  }
+  n->parent = nullptr;
+  n->position = 0;
+  n->count = 0;
+  n->leaf = leaf;
+  return n;
+}
+
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+void btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::free_node(
+    node_type* n) noexcept {
+  if (n->leaf) {
+    leaf_alloc().deallocate(n, 1);
+  } else {
+    internal_alloc().deallocate(static_cast<internal_type*>(n), 1);
+  }
+}
+
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+void btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::destroy_subtree(
+    node_type* n) noexcept {
+  if (!n->leaf) {
+    for (size_type i = 0; i <= n->count; ++i) {
+      destroy_subtree(child(n, i));
+    }
+  }
+  if constexpr (!std::is_trivially_destructible<value_type>::value) {
+    for (size_type i = 0; i < n->count; ++i) {
+      n->value(i).~value_type();
+    }
+  }
+  free_node(n);
+}
+
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+template <bool Upper>
+typename btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::size_type
+btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::search_node(
+    node_type* n, const key_type& key) const {
+  size_type lo = 0;
+  size_type hi = n->count;
+  while (lo < hi) {
+    const size_type mid = (lo + hi) / 2;
+    const bool go_right = Upper ? !comp_(key, key_of(n->value(mid)))
+                                : comp_(key_of(n->value(mid)), key);
+    if (go_right) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+template <bool Upper>
+typename btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::iterator
+btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::lower_bound_impl(
+    const key_type& key) {
+  iterator result = end();
+  node_type* n = root_;
+  while (n != nullptr) {
+    const size_type i = search_node<Upper>(n, key);
+    if (i < n->count) {
+      // the best candidate so far; anything smaller is further down
+      result = iterator(n, i);
+    }
+    if (n->leaf) {
+      break;
+    }
+    n = child(n, i);
+  }
+  return result;
+}
+
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+template <class... Args>
+std::pair<typename btree<Key, V, KeyOfValue, Compare, Alloc,
+                         NodeBytes>::iterator,
+          bool>
+btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::insert_unique(
+    const key_type& key, Args&&... args) {
+  if (root_ == nullptr) {
+    root_ = leftmost_ = rightmost_ = new_node(true);
+  }
+  node_type* n = root_;
+  for (;;) {
+    const size_type i = search_node<false>(n, key);
+    if (i < n->count && !comp_(key, key_of(n->value(i)))) {
+      return std::pair<iterator, bool>(iterator(n, i), false);
+    }
+    if (n->leaf) {
+      return std::pair<iterator, bool>(
+          insert_at(n, i, std::forward<Args>(args)...), true);
+    }
+    n = child(n, i);
+  }
+}
+
+// Inserts into a leaf, splitting it (and its ancestors) first if it is full.
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+template <class... Args>
+typename btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::iterator
+btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::insert_at(
+    node_type* n, size_type position, Args&&... args) {
+  if (n->count == node_values) {
+    split(n, position);
+  }
+  value_type* slot = n->values() + position;
+  tracystl::uninitialized_relocate_overlapping_n(slot, n->count - position,
+                                                 slot + 1);
+  try {
+    ::new (static_cast<void*>(slot)) value_type(std::forward<Args>(args)...);
+  } catch (...) {
+    tracystl::uninitialized_relocate_overlapping_n(slot + 1,
+                                                   n->count - position, slot);
+    if (n->count == 0) {
+      // a split left this leaf empty for us; it cannot stay that way, so
+      // take its separator back from the parent
+      iterator ignored;
+      rebalance_after_erase(n, ignored);
+    }
+    throw;
+  }
+  ++n->count;
+  ++size_;
+  return iterator(n, position);
+}
+
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+void btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::insert_into_node(
+    node_type* n, size_type position, value_type* value,
+    node_type* right_child) noexcept {
+  tracystl::uninitialized_relocate_overlapping_n(n->values() + position,
+                                                 n->count - position,
+                                                 n->values() + position + 1);
+  tracystl::uninitialized_relocate_overlapping_n(value, 1,
+                                                 n->values() + position);
+  if (!n->leaf) {
+    for (size_type i = n->count + 1; i > position + 1; --i) {
+      set_child(n, i, child(n, i - 1));
+    }
+    set_child(n, position + 1, right_child);
+  }
+  ++n->count;
+}
+
+// Splits the full node n, whose pending insertion goes at `position`, and
+// updates (n, position) to where that insertion now belongs. The median moves
+// up into the parent, which is split first if it is full as well.
+//
+// Appending at the end keeps node_values - 1 values on the left and
+// prepending keeps them on the right, so ascending or descending input
+// leaves nodes full.
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+void btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::split(
+    node_type*& n, size_type& position) {
+  if (n->parent == nullptr) {
+    node_type* new_root = new_node(false);
+    set_child(new_root, 0, n);
+    root_ = new_root;
+  } else if (n->parent->count == node_values) {
+    node_type* parent = n->parent;
+    size_type parent_position = n->position;
+    split(parent, parent_position);
+  }
+  node_type* parent = n->parent;
+  node_type* sibling = new_node(n->leaf);
+
+  const size_type left = position == node_values ? node_values - 1
+                         : position == 0         ? 0
+                                                 : node_values / 2;
+  const size_type moved = node_values - left - 1;
+  tracystl::uninitialized_relocate_overlapping_n(n->values() + left + 1, moved,
+                                                 sibling->values());
+  if (!n->leaf) {
+    for (size_type i = 0; i <= moved; ++i) {
+      set_child(sibling, i, child(n, left + 1 + i));
+    }
+  }
+  sibling->count = static_cast<unsigned char>(moved);
+  n->count = static_cast<unsigned char>(left);
+  insert_into_node(parent, n->position, n->values() + left, sibling);
+  if (rightmost_ == n) {
+    rightmost_ = sibling;
+  }
+  if (position > left) {
+    position -= left + 1;
+    n = sibling;
+  }
+}
+
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+typename btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::iterator
+btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::erase(
+    const_iterator pos) {
+  node_type* n = pos.node_;
+  const size_type i = pos.position_;
+  // track follows the value after the erased one through the rebalancing
+  iterator track;
+  n->value(i).~value_type();
+  if (n->leaf) {
+    tracystl::uninitialized_relocate_overlapping_n(n->values() + i + 1,
+                                                   n->count - i - 1,
+                                                   n->values() + i);
+    --n->count;
+    track = iterator(n, i);
+  } else {
+    // refill the hole with the predecessor, the last value of the rightmost
+    // leaf of the left subtree; the successor starts the right subtree
+    node_type* leaf = child(n, i);
+    while (!leaf->leaf) {
+      leaf = child(leaf, leaf->count);
+    }
+    node_type* next = child(n, i + 1);
+    while (!next->leaf) {
+      next = child(next, 0);
+    }
+    tracystl::uninitialized_relocate_overlapping_n(
+        leaf->values() + leaf->count - 1, 1, n->values() + i);
+    --leaf->count;
+    track = iterator(next, 0);
+    n = leaf;
+  }
+  --size_;
+  rebalance_after_erase(n, track);
+  if (track.node_ == nullptr) {
+    return end();
+  }
+  // track may sit one past the end of its node: climb to the next value
+  if (track.position_ == track.node_->count) {
+    track.increment_slow();
+  }
+  return track;
+}
+
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+typename btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::iterator
+btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::erase(
+    const_iterator first, const_iterator last) {
+  // every erase invalidates last, so count the elements first
+  size_type n = 0;
+  for (const_iterator it = first; it != last; ++it) {
+    ++n;
+  }
+  iterator it(first.node_, first.position_);
+  if (n == size_) {
+    clear();
+    return end();
+  }
+  for (; n != 0; --n) {
+    it = erase(it);
+  }
+  return it;
+}
+
+// Restores the minimum fill from n upwards: an underfull node merges with a
+// sibling if both fit in one node, otherwise it borrows values from the
+// fuller sibling. A merge can leave the parent underfull in turn; an empty
+// root is replaced by its only child.
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+void btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::
+    rebalance_after_erase(node_type* n, iterator& track) noexcept {
+  while (n != root_ && n->count < node_type::min_values) {
+    node_type* parent = n->parent;
+    const size_type p = n->position;
+    node_type* left = p > 0 ? child(parent, p - 1) : nullptr;
+    node_type* right = p < parent->count ? child(parent, p + 1) : nullptr;
+    if (left != nullptr &&
+        size_type{left->count} + 1 + n->count <= node_values) {
+      merge(parent, p - 1, track);
+      n = parent;
+    } else if (right != nullptr &&
+               size_type{n->count} + 1 + right->count <= node_values) {
+      merge(parent, p, track);
+      n = parent;
+    } else {
+      if (left != nullptr && (right == nullptr || left->count >= right->count)) {
+        rotate_right(parent, p - 1, (left->count - n->count) / 2, track);
+      } else {
+        rotate_left(parent, p, (right->count - n->count) / 2, track);
+      }
+      break;
+    }
+  }
+  if (root_->count == 0) {
+    node_type* old_root = root_;
+    if (old_root->leaf) {
+      root_ = leftmost_ = rightmost_ = nullptr;
+    } else {
+      root_ = child(old_root, 0);
+      root_->parent = nullptr;
+      root_->position = 0;
+    }
+    if (track.node_ == old_root) {
+      track = iterator();
+    }
+    free_node(old_root);
+  }
+}
+
+// Pulls the separator parent[i] and all of child i + 1 into child i.
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+void btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::merge(
+    node_type* parent, size_type i, iterator& track) noexcept {
+  node_type* left = child(parent, i);
+  node_type* right = child(parent, i + 1);
+  const size_type a = left->count;
+  tracystl::uninitialized_relocate_overlapping_n(parent->values() + i, 1,
+                                                 left->values() + a);
+  tracystl::uninitialized_relocate_overlapping_n(right->values(), right->count,
+                                                 left->values() + a + 1);
+  if (!left->leaf) {
+    for (size_type j = 0; j <= right->count; ++j) {
+      set_child(left, a + 1 + j, child(right, j));
+    }
+  }
+  left->count = static_cast<unsigned char>(a + 1 + right->count);
+
+  tracystl::uninitialized_relocate_overlapping_n(parent->values() + i + 1,
+                                                 parent->count - i - 1,
+                                                 parent->values() + i);
+  if (!parent->leaf) {
+    for (size_type j = i + 1; j < parent->count; ++j) {
+      set_child(parent, j, child(parent, j + 1));
+    }
+  }
+  --parent->count;
+
+  if (track.node_ == right) {
+    track = iterator(left, a + 1 + track.position_);
+  } else if (track.node_ == parent && track.position_ >= i) {
+    if (track.position_ == i) {
+      track = iterator(left, a);
+    } else {
+      --track.position_;
+    }
+  }
+  if (rightmost_ == right) {
+    rightmost_ = left;
+  }
+  free_node(right);
+}
+
+// Moves k values from child i + 1 into child i, through the separator.
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+void btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::rotate_left(
+    node_type* parent, size_type i, size_type k, iterator& track) noexcept {
+  node_type* left = child(parent, i);
+  node_type* right = child(parent, i + 1);
+  const size_type a = left->count;
+  const size_type b = right->count;
+  tracystl::uninitialized_relocate_overlapping_n(parent->values() + i, 1,
+                                                 left->values() + a);
+  tracystl::uninitialized_relocate_overlapping_n(right->values(), k - 1,
+                                                 left->values() + a + 1);
+  tracystl::uninitialized_relocate_overlapping_n(right->values() + k - 1, 1,
+                                                 parent->values() + i);
+  tracystl::uninitialized_relocate_overlapping_n(right->values() + k, b - k,
+                                                 right->values());
+  if (!left->leaf) {
+    for (size_type j = 0; j < k; ++j) {
+      set_child(left, a + 1 + j, child(right, j));
+    }
+    for (size_type j = 0; j <= b - k; ++j) {
+      set_child(right, j, child(right, j + k));
+    }
+  }
+  left->count = static_cast<unsigned char>(a + k);
+  right->count = static_cast<unsigned char>(b - k);
+
+  if (track.node_ == right) {
+    if (track.position_ + 1 < k) {
+      track = iterator(left, a + 1 + track.position_);
+    } else if (track.position_ + 1 == k) {
+      track = iterator(parent, i);
+    } else {
+      track.position_ -= k;
+    }
+  } else if (track.node_ == parent && track.position_ == i) {
+    track = iterator(left, a);
+  }
+}
+
+// Moves k values from child i into child i + 1, through the separator.
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc,
+          size_t NodeBytes>
+void btree<Key, V, KeyOfValue, Compare, Alloc, NodeBytes>::rotate_right(
+    node_type* parent, size_type i, size_type k, iterator& track) noexcept {
+  node_type* left = child(parent, i);
+  node_type* right = child(parent, i + 1);
+  const size_type a = left->count;
+  const size_type b = right->count;
+  tracystl::uninitialized_relocate_overlapping_n(right->values(), b,
+                                                 right->values() + k);
+  tracystl::uninitialized_relocate_overlapping_n(parent->values() + i, 1,
+                                                 right->values() + k - 1);
+  tracystl::uninitialized_relocate_overlapping_n(left->values() + a - k + 1,
+                                                 k - 1, right->values());
+  tracystl::uninitialized_relocate_overlapping_n(left->values() + a - k, 1,
+                                                 parent->values() + i);
+  if (!left->leaf) {
+    for (size_type j = b + 1; j-- > 0;) {
+      set_child(right, j + k, child(right, j));
+    }
+    for (size_type j = 0; j < k; ++j) {
+      set_child(right, j, child(left, a - k + 1 + j));
+    }
+  }
+  left->count = static_cast<unsigned char>(a - k);
+  right->count = static_cast<unsigned char>(b + k);
+
+  if (track.node_ == right) {
+    track.position_ += k;
+  } else if (track.node_ == left && track.position_ >= a - k) {
+    if (track.position_ == a - k) {
+      track = iterator(parent, i);
+    } else {
+      track = iterator(right, track.position_ - (a - k + 1));
+    }
+  } else if (track.node_ == parent && track.position_ == i) {
+    track = iterator(right, k - 1);
+  }
+}
+
+// An ordered map on a B-tree. Iterators are bidirectional
+// (tracystl::bidirectional_iterator_tag); see btree for invalidation.
+template <class K, class V, class Compare = std::less<K>,
+          class Alloc = tracystl::Allocator<std::pair<const K, V>>>
+class BTreeMap
+    : public btree<K, std::pair<const K, V>,
+                   btree_detail::first_key<std::pair<const K, V>>, Compare,
+                   Alloc> {
+  typedef btree<K, std::pair<const K, V>,
+                btree_detail::first_key<std::pair<const K, V>>, Compare, Alloc>
+      base;
+
+ public:
+  typedef V mapped_type;
+  typedef typename base::iterator iterator;
+
+  BTreeMap() = default;
+  explicit BTreeMap(const Compare& comp, const Alloc& a = Alloc())
+      : base(comp, a) {}
+  template <class InputIt>
+  BTreeMap(InputIt first, InputIt last) {
+    this->insert(first, last);
+  }
+  template <class InputIt>
+  BTreeMap(sorted_unique_t, InputIt first, InputIt last) {
+    this->insert(sorted_unique, first, last);
+  }
+
+  V& operator[](const K& key) { return try_emplace(key).first->second; }
+  V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+  // constructs the mapped value from args only if the key is new
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    return this->insert_unique(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    return this->insert_unique(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+    std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+};
+
+// An ordered set on a B-tree. Its iterator is a const_iterator.
+template <class K, class Compare = std::less<K>,
+          class Alloc = tracystl::Allocator<K>>
+class BTreeSet
+    : public btree<K, K, btree_detail::identity_key<K>, Compare, Alloc> {
+  typedef btree<K, K, btree_detail::identity_key<K>, Compare, Alloc> base;
+
+ public:
+  BTreeSet() = default;
+  explicit BTreeSet(const Compare& comp, const Alloc& a = Alloc())
+      : base(comp, a) {}
+  template <class InputIt>
+  BTreeSet(InputIt first, InputIt last) {
+    this->insert(first, last);
+  }
+  template <class InputIt>
+  BTreeSet(sorted_unique_t, InputIt first, InputIt last) {
+    this->insert(sorted_unique, first, last);
+  }
+};
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_BTREE_H_
@@ -1,6 +1,12 @@
 #ifndef _TRACYSTL_DEQUE_H_
 #define _TRACYSTL_DEQUE_H_
 #include "allocator.h"
+#include "iterator.h"
+#include <cstddef> // For std::size_t, std::ptrdiff_t
+#include <cstring> // For std::memcpy, std::memmove
+#include <iterator> // For std::random_access_iterator_tag
+#include <type_traits>
+#include <utility>
 
 namespace tracystl {
 
@@ -8,18 +14,164 @@ namespace tracystl {
 #define DEQUE_MAP_INIT_SIZE 8
 #endif
 
+// how many emptied blocks a Deque keeps for reuse instead of freeing them
+#ifndef DEQUE_SPARE_BLOCKS
+#define DEQUE_SPARE_BLOCKS 2
+#endif
+
 template <class T> struct deque_buf_size {
   // value must >= 16
   static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
 };
-template <class T> class Deque {
+
+// A Deque is a "map": an array of pointers to fixed-size blocks holding
+// deque_buf_size<T>::value elements each. The iterator remembers the block it
+// is in ([first_, last_)) and its slot in the map (node_), so crossing a block
+// boundary is a jump to the next map entry.
+//
+//   map_:  [ ][ ][*][*][*][ ][ ]
+//                 |  |  |
+//                 v  v  v
+//   blocks      [..xx][xxxx][xx..]
+//                  ^            ^
+//               begin_        end_
+template <class T, class Ref, class Ptr>
+struct deque_iterator
+    : public tracystl::iterator<tracystl::random_access_iterator_tag, T> {
+  typedef deque_iterator<T, T&, T*> iterator;
+  typedef deque_iterator<T, const T&, const T*> const_iterator;
+  typedef deque_iterator self;
+
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef T value_type;
+  typedef Ptr pointer;
+  typedef Ref reference;
+  typedef std::ptrdiff_t difference_type;
+  typedef T* value_pointer;
+  typedef T** map_pointer;
+
+  static constexpr difference_type buffer_size =
+      static_cast<difference_type>(deque_buf_size<T>::value);
+
+  value_pointer cur_;
+  value_pointer first_;
+  value_pointer last_;
+  map_pointer node_;
+
+  deque_iterator() noexcept
+      : cur_(nullptr), first_(nullptr), last_(nullptr), node_(nullptr) {}
+  deque_iterator(value_pointer cur, map_pointer node) noexcept
+      : cur_(cur), first_(*node), last_(*node + buffer_size), node_(node) {}
+  // iterator -> const_iterator
+  deque_iterator(const iterator& x) noexcept
+      : cur_(x.cur_), first_(x.first_), last_(x.last_), node_(x.node_) {}
+  self& operator=(const iterator& x) noexcept {
+    cur_ = x.cur_;
+    first_ = x.first_;
+    last_ = x.last_;
+    node_ = x.node_;
+    return *this;
+  }
+
+  // jump to another block; cur_ is left for the caller to set
+  void set_node(map_pointer node) noexcept {
+    node_ = node;
+    first_ = *node;
+    last_ = first_ + buffer_size;
+  }
+
+  reference operator*() const { return *cur_; }
+  pointer operator->() const { return cur_; }
+
+  difference_type operator-(const self& x) const {
+    if (node_ == x.node_) {
+      return cur_ - x.cur_;
+    }
+    return buffer_size * (node_ - x.node_ - 1) + (cur_ - first_) +
+           (x.last_ - x.cur_);
+  }
+
+  self& operator++() {
+    ++cur_;
+    if (cur_ == last_) {
+      set_node(node_ + 1);
+      cur_ = first_;
+    }
+    return *this;
+  }
+  self operator++(int) {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  self& operator--() {
+    if (cur_ == first_) {
+      set_node(node_ - 1);
+      cur_ = last_;
+    }
+    --cur_;
+    return *this;
+  }
+  self operator--(int) {
+    self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  self& operator+=(difference_type n) {
+    const difference_type offset = n + (cur_ - first_);
+    if (offset >= 0 && offset < buffer_size) {
+      cur_ += n;
+    } else {
+      const difference_type node_offset =
+          offset > 0 ? offset / buffer_size
+                     : -((-offset - 1) / buffer_size) - 1;
+      set_node(node_ + node_offset);
+      cur_ = first_ + (offset - node_offset * buffer_size);
+    }
+    return *this;
+  }
+  self operator+(difference_type n) const {
+    self tmp = *this;
+    return tmp += n;
+  }
+  self& operator-=(difference_type n) { return *this += -n; }
+  self operator-(difference_type n) const {
+    self tmp = *this;
+    return tmp -= n;
+  }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  bool operator==(const self& x) const { return cur_ == x.cur_; }
+  bool operator!=(const self& x) const { return cur_ != x.cur_; }
+  bool operator<(const self& x) const {
+    return node_ == x.node_ ? cur_ < x.cur_ : node_ < x.node_;
+  }
+  bool operator>(const self& x) const { return x < *this; }
+  bool operator<=(const self& x) const { return !(x < *this); }
+  bool operator>=(const self& x) const { return !(*this < x); }
+};
+
+template <class T, class Ref, class Ptr>
+deque_iterator<T, Ref, Ptr> operator+(
+    typename deque_iterator<T, Ref, Ptr>::difference_type n,
+    const deque_iterator<T, Ref, Ptr>& x) {
+  return x + n;
+}
+
+// push/pop at either end are O(1): only when a block fills up (or empties)
+// does the deque touch the map, and emptied blocks are parked in a small
+// spare list so a steady FIFO keeps recycling the same blocks. When one end of
+// the map runs out of slots the used part is recentered in place, and the map
+// only grows when it is more than half full.
+template <class T, class Alloc = tracystl::Allocator<T>>
+class Deque : private allocator_holder<Alloc> {
 public:
-  // they don't depend on a nested type. It is already clear to the compiler
-  // that tracystl::allocator<T *> is a type, so typename is not required in
-  // this context.
-  typedef tracystl::allocator<T> allocator_type;
-  typedef tracystl::allocator<T> data_allocator;
-  typedef tracystl::allocator<T *> map_allocator;
+  // Alloc is a template parameter, so rebind is a dependent name: it needs
+  // both `typename` and `template` to be parsed as a member template type.
+  typedef Alloc allocator_type;
+  typedef Alloc data_allocator;
+  typedef typename Alloc::template rebind<T *>::other map_allocator;
 
   typedef typename allocator_type::value_type value_type;
   typedef typename allocator_type::pointer pointer;
@@ -30,7 +182,356 @@ public:
   typedef typename allocator_type::difference_type difference_type;
   typedef pointer *map_pointer;
   typedef const_pointer *const_map_pointer;
+
+  typedef deque_iterator<T, T &, T *> iterator;
+  typedef deque_iterator<T, const T &, const T *> const_iterator;
+
+  static constexpr size_type buffer_size = deque_buf_size<T>::value;
+
+private:
+  typedef allocator_holder<Alloc> alloc_base;
+  using alloc_base::alloc;
+
+  // An empty Deque owns nothing: map_ is null until the first insertion.
+  iterator begin_;
+  iterator end_;  // end_.cur_ always points into a block, never at last_
+  map_pointer map_;
+  size_type map_size_;
+  pointer spare_;  // emptied blocks, linked through their first bytes
+  size_type spare_count_;
+
+public:
+  Deque() noexcept
+      : begin_(), end_(), map_(nullptr), map_size_(0), spare_(nullptr),
+        spare_count_(0) {}
+  explicit Deque(const allocator_type &a)
+      : alloc_base(a), begin_(), end_(), map_(nullptr), map_size_(0),
+        spare_(nullptr), spare_count_(0) {}
+  explicit Deque(size_type n, const allocator_type &a = allocator_type())
+      : Deque(a) {
+    for (size_type i = 0; i < n; ++i) {
+      emplace_back();
+    }
+  }
+  Deque(size_type n, const value_type &value,
+        const allocator_type &a = allocator_type())
+      : Deque(a) {
+    for (size_type i = 0; i < n; ++i) {
+      push_back(value);
+    }
+  }
+  Deque(const Deque &rhs) : Deque(rhs.alloc()) {
+    for (const_iterator it = rhs.begin(); it != rhs.end(); ++it) {
+      push_back(*it);
+    }
+  }
+  // steal the map, rhs is left empty
+  Deque(Deque &&rhs) noexcept
+      : alloc_base(std::move(rhs.alloc())), begin_(rhs.begin_),
+        end_(rhs.end_), map_(rhs.map_), map_size_(rhs.map_size_),
+        spare_(rhs.spare_), spare_count_(rhs.spare_count_) {
+    rhs.begin_ = rhs.end_ = iterator();
+    rhs.map_ = nullptr;
+    rhs.map_size_ = 0;
+    rhs.spare_ = nullptr;
+    rhs.spare_count_ = 0;
+  }
+  ~Deque() { release(); }
+
+  Deque &operator=(const Deque &rhs) {
+    if (this != &rhs) {
+      Deque tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+  Deque &operator=(Deque &&rhs) noexcept {
+    if (this != &rhs) {
+      Deque tmp(std::move(rhs));
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  void swap(Deque &rhs) noexcept {
+    using std::swap;
+    swap(alloc(), rhs.alloc());
+    swap(begin_, rhs.begin_);
+    swap(end_, rhs.end_);
+    swap(map_, rhs.map_);
+    swap(map_size_, rhs.map_size_);
+    swap(spare_, rhs.spare_);
+    swap(spare_count_, rhs.spare_count_);
+  }
+
+  allocator_type get_allocator() const { return alloc(); }
+
+  iterator begin() noexcept { return begin_; }
+  const_iterator begin() const noexcept { return begin_; }
+  iterator end() noexcept { return end_; }
+  const_iterator end() const noexcept { return end_; }
+
+  size_type size() const noexcept {
+    return static_cast<size_type>(end_ - begin_);
+  }
+  bool empty() const noexcept { return begin_ == end_; }
+
+  reference operator[](size_type n) {
+    return begin_[static_cast<difference_type>(n)];
+  }
+  const_reference operator[](size_type n) const {
+    return begin_[static_cast<difference_type>(n)];
+  }
+
+  reference front() { return *begin_; }
+  const_reference front() const { return *begin_; }
+  reference back() { return *(end_ - 1); }
+  const_reference back() const { return *(end_ - 1); }
+
+  void push_back(const value_type &value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+  void push_front(const value_type &value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
+
+  template <class... Args> reference emplace_back(Args &&...args);
+  template <class... Args> reference emplace_front(Args &&...args);
+
+  void pop_back();
+  void pop_front();
+
+  // destroys the elements, keeps the map and one block
+  void clear();
+
+private:
+  void initialize_map();
+  void release() noexcept;
+  void destroy_range(iterator first, iterator last);
+
+  pointer allocate_block();
+  void free_block(pointer block) noexcept;
+
+  void reserve_map_at_back() {
+    if (end_.node_ + 1 == map_ + map_size_) {
+      reallocate_map(false);
+    }
+  }
+  void reserve_map_at_front() {
+    if (begin_.node_ == map_) {
+      reallocate_map(true);
+    }
+  }
+  void reallocate_map(bool add_at_front);
 };
 
+template <class T, class Alloc>
+template <class... Args>
+typename Deque<T, Alloc>::reference
+Deque<T, Alloc>::emplace_back(Args &&...args) {
+  if (map_ == nullptr) {
+    initialize_map();
+  }
+  if (end_.cur_ + 1 != end_.last_) {
+    alloc().construct(end_.cur_, std::forward<Args>(args)...);
+    ++end_.cur_;
+    return *(end_.cur_ - 1);
+  }
+  // the last slot of the block: make sure the next block exists first, so
+  // end_ can move there once the element is built
+  reserve_map_at_back();
+  *(end_.node_ + 1) = allocate_block();
+  try {
+    alloc().construct(end_.cur_, std::forward<Args>(args)...);
+  } catch (...) {
+    free_block(*(end_.node_ + 1));
+    throw;
+  }
+  pointer built = end_.cur_;
+  end_.set_node(end_.node_ + 1);
+  end_.cur_ = end_.first_;
+  return *built;
+}
+
+template <class T, class Alloc>
+template <class... Args>
+typename Deque<T, Alloc>::reference
+Deque<T, Alloc>::emplace_front(Args &&...args) {
+  if (map_ == nullptr) {
+    initialize_map();
+  }
+  if (begin_.cur_ != begin_.first_) {
+    alloc().construct(begin_.cur_ - 1, std::forward<Args>(args)...);
+    --begin_.cur_;
+    return *begin_.cur_;
+  }
+  reserve_map_at_front();
+  *(begin_.node_ - 1) = allocate_block();
+  try {
+    alloc().construct(*(begin_.node_ - 1) + buffer_size - 1,
+                      std::forward<Args>(args)...);
+  } catch (...) {
+    free_block(*(begin_.node_ - 1));
+    throw;
+  }
+  begin_.set_node(begin_.node_ - 1);
+  begin_.cur_ = begin_.last_ - 1;
+  return *begin_.cur_;
+}
+
+template <class T, class Alloc>
+void Deque<T, Alloc>::pop_back() {
+  if (end_.cur_ != end_.first_) {
+    --end_.cur_;
+    alloc().destroy(end_.cur_);
+    return;
+  }
+  free_block(end_.first_);
+  end_.set_node(end_.node_ - 1);
+  end_.cur_ = end_.last_ - 1;
+  alloc().destroy(end_.cur_);
+}
+
+template <class T, class Alloc>
+void Deque<T, Alloc>::pop_front() {
+  alloc().destroy(begin_.cur_);
+  if (begin_.cur_ + 1 != begin_.last_) {
+    ++begin_.cur_;
+    return;
+  }
+  free_block(begin_.first_);
+  begin_.set_node(begin_.node_ + 1);
+  begin_.cur_ = begin_.first_;
+}
+
+template <class T, class Alloc>
+void Deque<T, Alloc>::clear() {
+  if (map_ == nullptr) {
+    return;
+  }
+  destroy_range(begin_, end_);
+  for (map_pointer node = begin_.node_ + 1; node <= end_.node_; ++node) {
+    free_block(*node);
+  }
+  end_ = begin_;
+}
+
+template <class T, class Alloc>
+void Deque<T, Alloc>::destroy_range(iterator first, iterator last) {
+  if constexpr (!std::is_trivially_destructible<T>::value) {
+    // block by block, so the inner loop is a plain pointer loop
+    for (map_pointer node = first.node_ + 1; node < last.node_; ++node) {
+      alloc().destroy(*node, *node + buffer_size);
+    }
+    if (first.node_ != last.node_) {
+      alloc().destroy(first.cur_, first.last_);
+      alloc().destroy(last.first_, last.cur_);
+    } else {
+      alloc().destroy(first.cur_, last.cur_);
+    }
+  } else {
+    (void)first;
+    (void)last;
+  }
+}
+
+// Creates the map with one block in its middle, so both ends have room to
+// grow before the map has to be touched again.
+template <class T, class Alloc>
+void Deque<T, Alloc>::initialize_map() {
+  map_size_ = DEQUE_MAP_INIT_SIZE;
+  map_allocator map_alloc(alloc());
+  map_ = map_alloc.allocate(map_size_);
+  map_pointer start = map_ + map_size_ / 2;
+  try {
+    *start = allocate_block();
+  } catch (...) {
+    map_alloc.deallocate(map_, map_size_);
+    map_ = nullptr;
+    map_size_ = 0;
+    throw;
+  }
+  // start in the middle of the block too, push_front is as cheap as push_back
+  begin_.set_node(start);
+  begin_.cur_ = begin_.first_ + buffer_size / 2;
+  end_ = begin_;
+}
+
+template <class T, class Alloc>
+void Deque<T, Alloc>::release() noexcept {
+  if (map_ == nullptr) {
+    return;
+  }
+  clear();
+  alloc().deallocate(begin_.first_, buffer_size);
+  while (spare_ != nullptr) {
+    pointer next;
+    std::memcpy(&next, static_cast<void *>(spare_), sizeof(next));
+    alloc().deallocate(spare_, buffer_size);
+    spare_ = next;
+  }
+  spare_count_ = 0;
+  map_allocator map_alloc(alloc());
+  map_alloc.deallocate(map_, map_size_);
+  map_ = nullptr;
+  map_size_ = 0;
+  begin_ = end_ = iterator();
+}
+
+template <class T, class Alloc>
+typename Deque<T, Alloc>::pointer Deque<T, Alloc>::allocate_block() {
+  if (spare_ != nullptr) {
+    pointer block = spare_;
+    // the link is stored with memcpy: the block may be less aligned than a
+    // pointer (e.g. a Deque<char> in an arena)
+    std::memcpy(&spare_, static_cast<void *>(block), sizeof(spare_));
+    --spare_count_;
+    return block;
+  }
+  return alloc().allocate(buffer_size);
+}
+
+template <class T, class Alloc>
+void Deque<T, Alloc>::free_block(pointer block) noexcept {
+  if (spare_count_ < DEQUE_SPARE_BLOCKS) {
+    std::memcpy(static_cast<void *>(block), &spare_, sizeof(spare_));
+    spare_ = block;
+    ++spare_count_;
+    return;
+  }
+  alloc().deallocate(block, buffer_size);
+}
+
+// Called when there is no free map slot left at one end. If the map is less
+// than half used the block pointers are just moved back to the center;
+// otherwise a map twice as big is allocated.
+template <class T, class Alloc>
+void Deque<T, Alloc>::reallocate_map(bool add_at_front) {
+  const size_type old_num_nodes =
+      static_cast<size_type>(end_.node_ - begin_.node_) + 1;
+  const size_type new_num_nodes = old_num_nodes + 1;
+
+  map_pointer new_start;
+  if (map_size_ > 2 * new_num_nodes) {
+    new_start = map_ + (map_size_ - new_num_nodes) / 2 + (add_at_front ? 1 : 0);
+    std::memmove(new_start, begin_.node_, old_num_nodes * sizeof(pointer));
+  } else {
+    const size_type new_map_size = 2 * map_size_ + 2;
+    map_allocator map_alloc(alloc());
+    map_pointer new_map = map_alloc.allocate(new_map_size);
+    new_start =
+        new_map + (new_map_size - new_num_nodes) / 2 + (add_at_front ? 1 : 0);
+    std::memcpy(new_start, begin_.node_, old_num_nodes * sizeof(pointer));
+    map_alloc.deallocate(map_, map_size_);
+    map_ = new_map;
+    map_size_ = new_map_size;
+  }
+  // the blocks did not move, only the map slots pointing at them
+  pointer begin_cur = begin_.cur_;
+  pointer end_cur = end_.cur_;
+  begin_.set_node(new_start);
+  begin_.cur_ = begin_cur;
+  end_.set_node(new_start + old_num_nodes - 1);
+  end_.cur_ = end_cur;
+}
+
 } // namespace tracystl
-#endif // !_TRACYSTL_DEQUE_H_
\ No newline at end of file
+#endif // !_TRACYSTL_DEQUE_H_
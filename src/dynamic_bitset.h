@@ -0,0 +1,634 @@
+#ifndef _TRACYSTL_DYNAMIC_BITSET_H_
+#define _TRACYSTL_DYNAMIC_BITSET_H_
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "vector.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef> // For std::size_t
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace tracystl {
+
+namespace bitset_detail {
+
+constexpr size_t word_bits = 64;
+
+inline size_t words_for(size_t bits) noexcept {
+  return (bits + word_bits - 1) / word_bits;
+}
+
+// The four ways to combine a word of the left operand with one of the right.
+enum class op { and_, or_, xor_, and_not };
+
+template <op Op>
+inline uint64_t apply(uint64_t a, uint64_t b) noexcept {
+  switch (Op) {
+    case op::and_:
+      return a & b;
+    case op::or_:
+      return a | b;
+    case op::xor_:
+      return a ^ b;
+    default:
+      return a & ~b;
+  }
+}
+
+// dst[i] = dst[i] Op src[i] for i in [from, n)
+template <op Op>
+inline void combine_scalar(uint64_t* dst, const uint64_t* src, size_t n,
+                           size_t from) noexcept {
+  for (size_t i = from; i < n; ++i) {
+    dst[i] = apply<Op>(dst[i], src[i]);
+  }
+}
+
+inline size_t popcount_scalar(const uint64_t* p, size_t n,
+                              size_t from) noexcept {
+  size_t result = 0;
+  for (size_t i = from; i < n; ++i) {
+    result += static_cast<size_t>(__builtin_popcountll(p[i]));
+  }
+  return result;
+}
+
+#if TRACYSTL_ALGORITHM_X86
+
+namespace sse2 {
+
+template <op Op>
+inline __m128i apply(__m128i a, __m128i b) noexcept {
+  switch (Op) {
+    case op::and_:
+      return _mm_and_si128(a, b);
+    case op::or_:
+      return _mm_or_si128(a, b);
+    case op::xor_:
+      return _mm_xor_si128(a, b);
+    default:
+      return _mm_andnot_si128(b, a);
+  }
+}
+
+template <op Op>
+inline void combine(uint64_t* dst, const uint64_t* src, size_t n) noexcept {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+    const __m128i* s = reinterpret_cast<const __m128i*>(src + i);
+    const __m128i r0 = apply<Op>(_mm_loadu_si128(d), _mm_loadu_si128(s));
+    const __m128i r1 =
+        apply<Op>(_mm_loadu_si128(d + 1), _mm_loadu_si128(s + 1));
+    _mm_storeu_si128(d, r0);
+    _mm_storeu_si128(d + 1, r1);
+  }
+  combine_scalar<Op>(dst, src, n, i);
+}
+
+// SSE2 has no popcnt, so count within each byte with shifts and masks and
+// add the bytes up with psadbw.
+inline size_t popcount(const uint64_t* p, size_t n) noexcept {
+  const __m128i m1 = _mm_set1_epi8(0x55);
+  const __m128i m2 = _mm_set1_epi8(0x33);
+  const __m128i m4 = _mm_set1_epi8(0x0f);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc = zero;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+    v = _mm_add_epi8(_mm_and_si128(v, m2),
+                     _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+    v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+  }
+  uint64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+  return static_cast<size_t>(lanes[0] + lanes[1]) + popcount_scalar(p, n, i);
+}
+
+}  // namespace sse2
+
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+
+namespace avx2 {
+
+template <op Op>
+inline __m256i apply(__m256i a, __m256i b) noexcept {
+  switch (Op) {
+    case op::and_:
+      return _mm256_and_si256(a, b);
+    case op::or_:
+      return _mm256_or_si256(a, b);
+    case op::xor_:
+      return _mm256_xor_si256(a, b);
+    default:
+      return _mm256_andnot_si256(b, a);
+  }
+}
+
+template <op Op>
+inline void combine(uint64_t* dst, const uint64_t* src, size_t n) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+    const __m256i* s = reinterpret_cast<const __m256i*>(src + i);
+    const __m256i r0 =
+        apply<Op>(_mm256_loadu_si256(d), _mm256_loadu_si256(s));
+    const __m256i r1 =
+        apply<Op>(_mm256_loadu_si256(d + 1), _mm256_loadu_si256(s + 1));
+    _mm256_storeu_si256(d, r0);
+    _mm256_storeu_si256(d + 1, r1);
+  }
+  for (; i < n; ++i) {
+    dst[i] = bitset_detail::apply<Op>(dst[i], src[i]);
+  }
+}
+
+// Look up the count of each nibble with vpshufb and add the bytes up with
+// vpsadbw (Mula's method), which beats one popcnt per word once there are a
+// few vectors to count; the tail uses popcnt.
+inline size_t popcount(const uint64_t* p, size_t n) noexcept {
+  const __m256i lookup =
+      _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                       0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low = _mm256_set1_epi8(0x0f);
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i acc = zero;
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    const __m256i b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 4));
+    // byte counts are at most 8 each, so two vectors add up without overflow
+    const __m256i counts = _mm256_add_epi8(
+        _mm256_add_epi8(
+            _mm256_shuffle_epi8(lookup, _mm256_and_si256(a, low)),
+            _mm256_shuffle_epi8(
+                lookup, _mm256_and_si256(_mm256_srli_epi16(a, 4), low))),
+        _mm256_add_epi8(
+            _mm256_shuffle_epi8(lookup, _mm256_and_si256(b, low)),
+            _mm256_shuffle_epi8(
+                lookup, _mm256_and_si256(_mm256_srli_epi16(b, 4), low))));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(counts, zero));
+  }
+  const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc),
+                                    _mm256_extracti128_si256(acc, 1));
+  uint64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum);
+  size_t result = static_cast<size_t>(lanes[0] + lanes[1]);
+  for (; i < n; ++i) {
+    result += static_cast<size_t>(__builtin_popcountll(p[i]));
+  }
+  return result;
+}
+
+}  // namespace avx2
+
+#pragma GCC pop_options
+
+#endif  // TRACYSTL_ALGORITHM_X86
+
+template <op Op>
+inline void combine(uint64_t* dst, const uint64_t* src, size_t n) noexcept {
+#if TRACYSTL_ALGORITHM_X86
+  switch (active_simd_level()) {
+    case simd_level::avx2:
+      avx2::combine<Op>(dst, src, n);
+      return;
+    case simd_level::sse2:
+      sse2::combine<Op>(dst, src, n);
+      return;
+    default:
+      break;
+  }
+#endif
+  combine_scalar<Op>(dst, src, n, 0);
+}
+
+inline size_t popcount(const uint64_t* p, size_t n) noexcept {
+#if TRACYSTL_ALGORITHM_X86
+  switch (active_simd_level()) {
+    case simd_level::avx2:
+      return avx2::popcount(p, n);
+    case simd_level::sse2:
+      return sse2::popcount(p, n);
+    default:
+      break;
+  }
+#endif
+  return popcount_scalar(p, n, 0);
+}
+
+// Iterates over the indices of the set bits: the current word keeps only the
+// bits not visited yet, so each step is a count-trailing-zeros and a
+// clear-lowest-bit, and all-zero words are skipped a word at a time.
+class set_bit_iterator {
+ public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef size_t value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const size_t* pointer;
+  typedef size_t reference;
+
+  set_bit_iterator() noexcept
+      : words_(nullptr), index_(0), count_(0), bits_(0) {}
+  set_bit_iterator(const uint64_t* words, size_t index, size_t count) noexcept
+      : words_(words), index_(index), count_(count), bits_(0) {
+    if (index_ < count_) {
+      bits_ = words_[index_];
+      skip_empty();
+    }
+  }
+
+  size_t operator*() const noexcept {
+    return index_ * word_bits + static_cast<size_t>(__builtin_ctzll(bits_));
+  }
+
+  set_bit_iterator& operator++() noexcept {
+    bits_ &= bits_ - 1;
+    skip_empty();
+    return *this;
+  }
+  set_bit_iterator operator++(int) noexcept {
+    set_bit_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  bool operator==(const set_bit_iterator& rhs) const noexcept {
+    return index_ == rhs.index_ && bits_ == rhs.bits_;
+  }
+  bool operator!=(const set_bit_iterator& rhs) const noexcept {
+    return !(*this == rhs);
+  }
+
+ private:
+  void skip_empty() noexcept {
+    while (bits_ == 0 && ++index_ < count_) {
+      bits_ = words_[index_];
+    }
+  }
+
+  const uint64_t* words_;
+  size_t index_;
+  size_t count_;
+  uint64_t bits_;
+};
+
+class set_bit_range {
+ public:
+  set_bit_range(const uint64_t* words, size_t count) noexcept
+      : words_(words), count_(count) {}
+  set_bit_iterator begin() const noexcept {
+    return set_bit_iterator(words_, 0, count_);
+  }
+  set_bit_iterator end() const noexcept {
+    return set_bit_iterator(words_, count_, count_);
+  }
+
+ private:
+  const uint64_t* words_;
+  size_t count_;
+};
+
+}  // namespace bitset_detail
+
+// A bitset sized at runtime, stored as 64-bit words in a Vector. Bulk
+// operations work a word (or a SIMD vector of words) at a time: count() is a
+// popcount per word, find_first/find_next and set_bits() skip to the next set
+// bit with a count-trailing-zeros, and &=, |=, ^= and and_not() use the same
+// SSE2/AVX2 dispatch as the algorithms in algorithm.h.
+//
+// Bits past size() in the last word are always zero, so whole-word
+// operations never see them.
+template <class Alloc = tracystl::Allocator<uint64_t>>
+class BasicDynamicBitset {
+  static_assert(std::is_same<typename Alloc::value_type, uint64_t>::value,
+                "BasicDynamicBitset stores uint64_t words");
+
+ public:
+  typedef uint64_t word_type;
+  typedef Alloc allocator_type;
+  typedef bitset_detail::set_bit_iterator set_bit_iterator;
+  typedef bitset_detail::set_bit_range set_bit_range;
+
+  static constexpr size_t bits_per_word = bitset_detail::word_bits;
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  BasicDynamicBitset() : size_(0) {}
+  explicit BasicDynamicBitset(const allocator_type& a) : words_(a), size_(0) {}
+  explicit BasicDynamicBitset(size_t n, bool value = false,
+                              const allocator_type& a = allocator_type())
+      : words_(a), size_(0) {
+    resize(n, value);
+  }
+
+  BasicDynamicBitset(const BasicDynamicBitset&) = default;
+  BasicDynamicBitset(BasicDynamicBitset&& rhs) noexcept
+      : words_(std::move(rhs.words_)), size_(rhs.size_) {
+    rhs.size_ = 0;
+  }
+  BasicDynamicBitset& operator=(const BasicDynamicBitset&) = default;
+  BasicDynamicBitset& operator=(BasicDynamicBitset&& rhs) noexcept {
+    if (this != &rhs) {
+      BasicDynamicBitset tmp(std::move(rhs));
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return words_.get_allocator(); }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  size_t num_words() const noexcept { return words_.size(); }
+  // the words, least significant bit first; bits past size() are zero
+  const word_type* data() const noexcept { return words_.data(); }
+
+  void reserve(size_t bits) { words_.reserve(bitset_detail::words_for(bits)); }
+  void resize(size_t n, bool value = false);
+  void clear() noexcept {
+    words_.clear();
+    size_ = 0;
+  }
+  void push_back(bool value) {
+    if (size_ % bits_per_word == 0) {
+      words_.push_back(0);
+    }
+    ++size_;
+    set(size_ - 1, value);
+  }
+  void pop_back() {
+    assert(size_ > 0);
+    reset(size_ - 1);
+    --size_;
+    if (size_ % bits_per_word == 0) {
+      words_.pop_back();
+    }
+  }
+
+  bool test(size_t i) const noexcept {
+    assert(i < size_);
+    return (words_[i / bits_per_word] >> (i % bits_per_word)) & 1;
+  }
+  bool operator[](size_t i) const noexcept { return test(i); }
+
+  BasicDynamicBitset& set(size_t i) noexcept {
+    assert(i < size_);
+    words_[i / bits_per_word] |= bit(i);
+    return *this;
+  }
+  BasicDynamicBitset& set(size_t i, bool value) noexcept {
+    assert(i < size_);
+    word_type& w = words_[i / bits_per_word];
+    w = (w & ~bit(i)) | (word_type(value) << (i % bits_per_word));
+    return *this;
+  }
+  BasicDynamicBitset& reset(size_t i) noexcept {
+    assert(i < size_);
+    words_[i / bits_per_word] &= ~bit(i);
+    return *this;
+  }
+  BasicDynamicBitset& flip(size_t i) noexcept {
+    assert(i < size_);
+    words_[i / bits_per_word] ^= bit(i);
+    return *this;
+  }
+
+  // all bits at once
+  BasicDynamicBitset& set() noexcept {
+    std::fill(words_.begin(), words_.end(), ~word_type(0));
+    clear_unused_bits();
+    return *this;
+  }
+  BasicDynamicBitset& reset() noexcept {
+    std::fill(words_.begin(), words_.end(), word_type(0));
+    return *this;
+  }
+  BasicDynamicBitset& flip() noexcept {
+    for (word_type& w : words_) {
+      w = ~w;
+    }
+    clear_unused_bits();
+    return *this;
+  }
+
+  size_t count() const noexcept {
+    return bitset_detail::popcount(words_.data(), words_.size());
+  }
+  bool any() const noexcept {
+    for (word_type w : words_) {
+      if (w != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+  bool none() const noexcept { return !any(); }
+  bool all() const noexcept;
+
+  // index of the lowest set bit, or npos
+  size_t find_first() const noexcept { return find_from_word(0); }
+  // index of the lowest set bit above i, or npos
+  size_t find_next(size_t i) const noexcept;
+
+  // the indices of the set bits in increasing order:
+  //   for (size_t i : bits.set_bits()) ...
+  set_bit_range set_bits() const noexcept {
+    return set_bit_range(words_.data(), words_.size());
+  }
+  // f(i) for every set bit i in increasing order
+  template <class F>
+  void for_each_set_bit(F f) const {
+    const size_t n = words_.size();
+    for (size_t w = 0; w < n; ++w) {
+      for (word_type bits = words_[w]; bits != 0; bits &= bits - 1) {
+        f(w * bits_per_word + static_cast<size_t>(__builtin_ctzll(bits)));
+      }
+    }
+  }
+
+  // The in-place operations keep the size of the left operand: a shorter
+  // right operand counts as padded with zeros, a longer one as truncated.
+  BasicDynamicBitset& operator&=(const BasicDynamicBitset& rhs) noexcept {
+    const size_t overlap = combine<bitset_detail::op::and_>(rhs);
+    std::fill(words_.begin() + overlap, words_.end(), word_type(0));
+    return *this;
+  }
+  BasicDynamicBitset& operator|=(const BasicDynamicBitset& rhs) noexcept {
+    combine<bitset_detail::op::or_>(rhs);
+    clear_unused_bits();
+    return *this;
+  }
+  BasicDynamicBitset& operator^=(const BasicDynamicBitset& rhs) noexcept {
+    combine<bitset_detail::op::xor_>(rhs);
+    clear_unused_bits();
+    return *this;
+  }
+  // *this &= ~rhs: clears every bit that is set in rhs
+  BasicDynamicBitset& and_not(const BasicDynamicBitset& rhs) noexcept {
+    combine<bitset_detail::op::and_not>(rhs);
+    return *this;
+  }
+
+  // whether any bit is set in both
+  bool intersects(const BasicDynamicBitset& rhs) const noexcept;
+  // whether every bit set here is also set in rhs
+  bool is_subset_of(const BasicDynamicBitset& rhs) const noexcept;
+
+  void swap(BasicDynamicBitset& rhs) noexcept {
+    words_.swap(rhs.words_);
+    std::swap(size_, rhs.size_);
+  }
+
+  friend bool operator==(const BasicDynamicBitset& lhs,
+                         const BasicDynamicBitset& rhs) noexcept {
+    return lhs.size_ == rhs.size_ &&
+           std::equal(lhs.words_.begin(), lhs.words_.end(),
+                      rhs.words_.begin());
+  }
+  friend bool operator!=(const BasicDynamicBitset& lhs,
+                         const BasicDynamicBitset& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+ private:
+  static word_type bit(size_t i) noexcept {
+    return word_type(1) << (i % bits_per_word);
+  }
+
+  // zero the bits past size() in the last word
+  void clear_unused_bits() noexcept {
+    if (size_ % bits_per_word != 0) {
+      words_[words_.size() - 1] &= bit(size_) - 1;
+    }
+  }
+
+  // applies Op over the words both operands have, returns how many
+  template <bitset_detail::op Op>
+  size_t combine(const BasicDynamicBitset& rhs) noexcept {
+    const size_t overlap = std::min(words_.size(), rhs.words_.size());
+    bitset_detail::combine<Op>(words_.data(), rhs.words_.data(), overlap);
+    return overlap;
+  }
+
+  size_t find_from_word(size_t w) const noexcept {
+    const size_t n = words_.size();
+    for (; w < n; ++w) {
+      if (words_[w] != 0) {
+        return w * bits_per_word +
+               static_cast<size_t>(__builtin_ctzll(words_[w]));
+      }
+    }
+    return npos;
+  }
+
+  Vector<word_type, Alloc> words_;
+  size_t size_;
+};
+
+template <class Alloc>
+void BasicDynamicBitset<Alloc>::resize(size_t n, bool value) {
+  const word_type fill = value ? ~word_type(0) : word_type(0);
+  if (n > size_ && value && size_ % bits_per_word != 0) {
+    // the new bits in the current last word
+    words_[words_.size() - 1] |= ~(bit(size_) - 1);
+  }
+  words_.resize(bitset_detail::words_for(n), fill);
+  size_ = n;
+  clear_unused_bits();
+}
+
+template <class Alloc>
+bool BasicDynamicBitset<Alloc>::all() const noexcept {
+  const size_t full = size_ / bits_per_word;
+  for (size_t w = 0; w < full; ++w) {
+    if (words_[w] != ~word_type(0)) {
+      return false;
+    }
+  }
+  return size_ % bits_per_word == 0 || words_[full] == bit(size_) - 1;
+}
+
+template <class Alloc>
+size_t BasicDynamicBitset<Alloc>::find_next(size_t i) const noexcept {
+  // checked before the increment: find_next(npos) must not wrap to bit 0
+  if (i >= size_ || ++i == size_) {
+    return npos;
+  }
+  const size_t w = i / bits_per_word;
+  const word_type rest = words_[w] & ~(bit(i) - 1);
+  if (rest != 0) {
+    return w * bits_per_word + static_cast<size_t>(__builtin_ctzll(rest));
+  }
+  return find_from_word(w + 1);
+}
+
+template <class Alloc>
+bool BasicDynamicBitset<Alloc>::intersects(
+    const BasicDynamicBitset& rhs) const noexcept {
+  const size_t overlap = std::min(words_.size(), rhs.words_.size());
+  for (size_t w = 0; w < overlap; ++w) {
+    if ((words_[w] & rhs.words_[w]) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class Alloc>
+bool BasicDynamicBitset<Alloc>::is_subset_of(
+    const BasicDynamicBitset& rhs) const noexcept {
+  const size_t overlap = std::min(words_.size(), rhs.words_.size());
+  for (size_t w = 0; w < overlap; ++w) {
+    if ((words_[w] & ~rhs.words_[w]) != 0) {
+      return false;
+    }
+  }
+  for (size_t w = overlap; w < words_.size(); ++w) {
+    if (words_[w] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The binary operators return a bitset the size of the left operand.
+template <class Alloc>
+BasicDynamicBitset<Alloc> operator&(BasicDynamicBitset<Alloc> lhs,
+                                    const BasicDynamicBitset<Alloc>& rhs) {
+  lhs &= rhs;
+  return lhs;
+}
+template <class Alloc>
+BasicDynamicBitset<Alloc> operator|(BasicDynamicBitset<Alloc> lhs,
+                                    const BasicDynamicBitset<Alloc>& rhs) {
+  lhs |= rhs;
+  return lhs;
+}
+template <class Alloc>
+BasicDynamicBitset<Alloc> operator^(BasicDynamicBitset<Alloc> lhs,
+                                    const BasicDynamicBitset<Alloc>& rhs) {
+  lhs ^= rhs;
+  return lhs;
+}
+
+template <class Alloc>
+void swap(BasicDynamicBitset<Alloc>& lhs,
+          BasicDynamicBitset<Alloc>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+typedef BasicDynamicBitset<> DynamicBitset;
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_DYNAMIC_BITSET_H_
@@ -0,0 +1,517 @@
+#ifndef _TRACYSTL_EXECUTION_H_
+#define _TRACYSTL_EXECUTION_H_
+
+#include "allocator.h"
+#include "iterator.h"
+#include "sort.h"
+#include "thread_pool.h"
+#include "vector.h"
+#include <algorithm> // For std::lower_bound, std::upper_bound
+#include <cstddef> // For std::size_t
+#include <functional>
+#include <iterator> // For std::make_move_iterator
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace tracystl {
+
+// Execution policies for the algorithms below, as in <execution>:
+//
+//   execution::seq   run on the calling thread
+//   execution::par   split the range over ThreadPool::default_pool(), or
+//                    over the pool given with par.on(pool)
+//
+// A parallel algorithm cuts its range into chunks of grain_size elements,
+// about eight per worker so that stealing can even out uneven chunks, and
+// never smaller than a minimum that keeps task overhead negligible. With a
+// single worker the whole range is one chunk and runs sequentially. The
+// functions passed in may be called concurrently, and reduce and the scans
+// may combine elements in any grouping, so op has to be associative.
+namespace execution {
+
+struct sequenced_policy {};
+
+struct parallel_policy {
+  ThreadPool* pool_ = nullptr;
+
+  constexpr parallel_policy() noexcept = default;
+  constexpr explicit parallel_policy(ThreadPool& pool) noexcept
+      : pool_(&pool) {}
+
+  // the same policy, running on pool
+  constexpr parallel_policy on(ThreadPool& pool) const noexcept {
+    return parallel_policy(pool);
+  }
+  ThreadPool& pool() const {
+    return pool_ != nullptr ? *pool_ : ThreadPool::default_pool();
+  }
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+
+template <class T>
+struct is_execution_policy : std::false_type {};
+template <>
+struct is_execution_policy<sequenced_policy> : std::true_type {};
+template <>
+struct is_execution_policy<parallel_policy> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_execution_policy_v =
+    is_execution_policy<typename std::decay<T>::type>::value;
+
+}  // namespace execution
+
+namespace execution_detail {
+
+// chunks per worker, for load balancing
+constexpr size_t chunks_per_worker = 8;
+// smallest chunk worth a task for element-wise work
+constexpr size_t min_grain = 4096;
+// smallest chunk worth a task for sorting and merging
+constexpr size_t min_sort_grain = 1 << 14;
+
+inline size_t grain_size(size_t n, const ThreadPool& pool, size_t minimum) {
+  if (pool.size() == 1) {
+    return n;
+  }
+  const size_t chunks = pool.size() * chunks_per_worker;
+  const size_t grain = (n + chunks - 1) / chunks;
+  return grain < minimum ? minimum : grain;
+}
+
+// calls body(lo, hi) over [begin, end) in pieces of at most grain
+template <class Body>
+void split_range(ThreadPool& pool, size_t begin, size_t end, size_t grain,
+                 const Body& body) {
+  while (end - begin > grain) {
+    const size_t mid = begin + (end - begin) / 2;
+    pool.fork_join([&] { split_range(pool, begin, mid, grain, body); },
+                   [&] { split_range(pool, mid, end, grain, body); });
+    return;
+  }
+  body(begin, end);
+}
+
+template <class Body>
+void parallel_for(ThreadPool& pool, size_t n, size_t grain, const Body& body) {
+  if (n == 0) {
+    return;
+  }
+  if (n <= grain) {
+    body(size_t{0}, n);
+    return;
+  }
+  pool.run([&] { split_range(pool, 0, n, grain, body); });
+}
+
+// op-fold of first[lo, hi), which must not be empty
+template <class T, class It, class BinaryOp>
+T fold(It first, size_t lo, size_t hi, BinaryOp op) {
+  T acc(first[lo]);
+  for (size_t i = lo + 1; i < hi; ++i) {
+    acc = op(std::move(acc), first[i]);
+  }
+  return acc;
+}
+
+template <class T, class It, class BinaryOp>
+T reduce_range(ThreadPool& pool, It first, size_t lo, size_t hi, size_t grain,
+               BinaryOp& op) {
+  if (hi - lo <= grain) {
+    return fold<T>(first, lo, hi, op);
+  }
+  const size_t mid = lo + (hi - lo) / 2;
+  std::optional<T> left;
+  std::optional<T> right;
+  pool.fork_join(
+      [&] { left.emplace(reduce_range<T>(pool, first, lo, mid, grain, op)); },
+      [&] { right.emplace(reduce_range<T>(pool, first, mid, hi, grain, op)); });
+  return op(std::move(*left), std::move(*right));
+}
+
+// Scans first[lo, hi) into d_first[lo, hi), folding carry, if set, in
+// front of the first element (exclusive scans always have one).
+template <bool Exclusive, class T, class InputIt, class OutputIt,
+          class BinaryOp>
+void scan_block(InputIt first, OutputIt d_first, size_t lo, size_t hi,
+                std::optional<T>& carry, BinaryOp op) {
+  if (lo == hi) {
+    return;
+  }
+  size_t i = lo;
+  if constexpr (Exclusive) {
+    T acc(std::move(*carry));
+    for (; i < hi; ++i) {
+      // read before writing: d_first may be first
+      T value(first[i]);
+      d_first[i] = acc;
+      acc = op(std::move(acc), std::move(value));
+    }
+  } else {
+    T acc = carry ? op(std::move(*carry), first[i]) : T(first[i]);
+    d_first[i] = acc;
+    for (++i; i < hi; ++i) {
+      acc = op(std::move(acc), first[i]);
+      d_first[i] = acc;
+    }
+  }
+}
+
+// Two passes over blocks of the range: the first reduces every block but
+// the last, the block totals are scanned sequentially, and the second pass
+// scans every block starting from its carry.
+template <bool Exclusive, class T, class InputIt, class OutputIt,
+          class BinaryOp>
+OutputIt scan(const execution::parallel_policy& policy, InputIt first,
+              InputIt last, OutputIt d_first, BinaryOp op,
+              std::optional<T> carry) {
+  const size_t n = static_cast<size_t>(last - first);
+  ThreadPool& pool = policy.pool();
+  const size_t grain = grain_size(n, pool, min_grain);
+  const size_t blocks = n == 0 ? 0 : (n + grain - 1) / grain;
+
+  Vector<std::optional<T>> carries(blocks);
+  if (blocks > 1) {
+    Vector<std::optional<T>> totals(blocks - 1);
+    parallel_for(pool, blocks - 1, 1, [&](size_t lo, size_t hi) {
+      for (size_t b = lo; b < hi; ++b) {
+        totals[b].emplace(fold<T>(first, b * grain, (b + 1) * grain, op));
+      }
+    });
+    for (size_t b = 0; b < blocks; ++b) {
+      carries[b] = carry;
+      if (b + 1 < blocks) {
+        carry = carry ? op(std::move(*carry), std::move(*totals[b]))
+                      : std::move(*totals[b]);
+      }
+    }
+  } else if (blocks == 1) {
+    carries[0] = std::move(carry);
+  }
+
+  parallel_for(pool, blocks, 1, [&](size_t lo, size_t hi) {
+    for (size_t b = lo; b < hi; ++b) {
+      scan_block<Exclusive>(first, d_first, b * grain,
+                            b + 1 == blocks ? n : (b + 1) * grain, carries[b],
+                            op);
+    }
+  });
+  return d_first + n;
+}
+
+template <class It, class OutputIt, class Compare>
+void merge_moving(It first1, It last1, It first2, It last2, OutputIt out,
+                  Compare& comp) {
+  std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1),
+             std::make_move_iterator(first2), std::make_move_iterator(last2),
+             out, comp);
+}
+
+// Merges [a, a + na) and [b, b + nb) into out, splitting the merge around
+// the middle of the longer run until the pieces are grain sized.
+template <class It, class OutputIt, class Compare>
+void parallel_merge(ThreadPool& pool, It a, size_t na, It b, size_t nb,
+                    OutputIt out, size_t grain, Compare& comp) {
+  if (na + nb <= grain) {
+    merge_moving(a, a + na, b, b + nb, out, comp);
+    return;
+  }
+  size_t ia;
+  size_t ib;
+  if (na >= nb) {
+    ia = na / 2;
+    ib = static_cast<size_t>(std::lower_bound(b, b + nb, a[ia], comp) - b);
+  } else {
+    ib = nb / 2;
+    ia = static_cast<size_t>(std::upper_bound(a, a + na, b[ib], comp) - a);
+  }
+  pool.fork_join(
+      [&] { parallel_merge(pool, a, ia, b, ib, out, grain, comp); },
+      [&] {
+        parallel_merge(pool, a + ia, na - ia, b + ib, nb - ib, out + (ia + ib),
+                       grain, comp);
+      });
+}
+
+// Merge sort of [first, first + n) that ping-pongs with buffer: the result
+// ends in buffer if to_buffer, in place otherwise. Both hold n live objects.
+template <class It, class BufferIt, class Compare>
+void merge_sort(ThreadPool& pool, It first, BufferIt buffer, size_t n,
+                bool to_buffer, size_t grain, Compare& comp) {
+  if (n <= grain) {
+    tracystl::sort(first, first + n, comp);
+    if (to_buffer) {
+      std::move(first, first + n, buffer);
+    }
+    return;
+  }
+  const size_t mid = n / 2;
+  pool.fork_join(
+      [&] { merge_sort(pool, first, buffer, mid, !to_buffer, grain, comp); },
+      [&] {
+        merge_sort(pool, first + mid, buffer + mid, n - mid, !to_buffer, grain,
+                   comp);
+      });
+  if (to_buffer) {
+    parallel_merge(pool, first, mid, first + mid, n - mid, buffer, grain,
+                   comp);
+  } else {
+    parallel_merge(pool, buffer, mid, buffer + mid, n - mid, first, grain,
+                   comp);
+  }
+}
+
+}  // namespace execution_detail
+
+// for_each
+
+template <class InputIt, class UnaryFunc>
+void for_each(const execution::sequenced_policy&, InputIt first, InputIt last,
+              UnaryFunc f) {
+  for (; first != last; ++first) {
+    f(*first);
+  }
+}
+
+template <class RandomIt, class UnaryFunc>
+void for_each(const execution::parallel_policy& policy, RandomIt first,
+              RandomIt last, UnaryFunc f) {
+  const size_t n = static_cast<size_t>(last - first);
+  ThreadPool& pool = policy.pool();
+  execution_detail::parallel_for(
+      pool, n, execution_detail::grain_size(n, pool, execution_detail::min_grain),
+      [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+          f(first[i]);
+        }
+      });
+}
+
+// transform
+
+template <class InputIt, class OutputIt, class UnaryOp>
+OutputIt transform(const execution::sequenced_policy&, InputIt first,
+                   InputIt last, OutputIt d_first, UnaryOp op) {
+  for (; first != last; ++first, ++d_first) {
+    *d_first = op(*first);
+  }
+  return d_first;
+}
+
+template <class InputIt1, class InputIt2, class OutputIt, class BinaryOp>
+OutputIt transform(const execution::sequenced_policy&, InputIt1 first1,
+                   InputIt1 last1, InputIt2 first2, OutputIt d_first,
+                   BinaryOp op) {
+  for (; first1 != last1; ++first1, ++first2, ++d_first) {
+    *d_first = op(*first1, *first2);
+  }
+  return d_first;
+}
+
+template <class RandomIt, class OutputIt, class UnaryOp>
+OutputIt transform(const execution::parallel_policy& policy, RandomIt first,
+                   RandomIt last, OutputIt d_first, UnaryOp op) {
+  const size_t n = static_cast<size_t>(last - first);
+  ThreadPool& pool = policy.pool();
+  execution_detail::parallel_for(
+      pool, n, execution_detail::grain_size(n, pool, execution_detail::min_grain),
+      [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+          d_first[i] = op(first[i]);
+        }
+      });
+  return d_first + n;
+}
+
+template <class RandomIt1, class RandomIt2, class OutputIt, class BinaryOp>
+OutputIt transform(const execution::parallel_policy& policy, RandomIt1 first1,
+                   RandomIt1 last1, RandomIt2 first2, OutputIt d_first,
+                   BinaryOp op) {
+  const size_t n = static_cast<size_t>(last1 - first1);
+  ThreadPool& pool = policy.pool();
+  execution_detail::parallel_for(
+      pool, n, execution_detail::grain_size(n, pool, execution_detail::min_grain),
+      [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+          d_first[i] = op(first1[i], first2[i]);
+        }
+      });
+  return d_first + n;
+}
+
+// reduce
+
+template <class InputIt, class T, class BinaryOp>
+T reduce(const execution::sequenced_policy&, InputIt first, InputIt last,
+         T init, BinaryOp op) {
+  for (; first != last; ++first) {
+    init = op(std::move(init), *first);
+  }
+  return init;
+}
+
+template <class RandomIt, class T, class BinaryOp>
+T reduce(const execution::parallel_policy& policy, RandomIt first,
+         RandomIt last, T init, BinaryOp op) {
+  const size_t n = static_cast<size_t>(last - first);
+  if (n == 0) {
+    return init;
+  }
+  ThreadPool& pool = policy.pool();
+  const size_t grain =
+      execution_detail::grain_size(n, pool, execution_detail::min_grain);
+  if (n <= grain) {
+    return op(std::move(init), execution_detail::fold<T>(first, 0, n, op));
+  }
+  std::optional<T> total;
+  pool.run([&] {
+    total.emplace(
+        execution_detail::reduce_range<T>(pool, first, 0, n, grain, op));
+  });
+  return op(std::move(init), std::move(*total));
+}
+
+template <class Policy, class It, class T,
+          class = typename std::enable_if<
+              execution::is_execution_policy_v<Policy>>::type>
+T reduce(const Policy& policy, It first, It last, T init) {
+  return tracystl::reduce(policy, first, last, std::move(init), std::plus<>());
+}
+
+template <class Policy, class It,
+          class = typename std::enable_if<
+              execution::is_execution_policy_v<Policy>>::type>
+typename iterator_traits<It>::value_type reduce(const Policy& policy, It first,
+                                                It last) {
+  return tracystl::reduce(policy, first, last,
+                          typename iterator_traits<It>::value_type{});
+}
+
+// inclusive_scan / exclusive_scan
+
+template <class InputIt, class OutputIt, class BinaryOp>
+OutputIt inclusive_scan(const execution::sequenced_policy&, InputIt first,
+                        InputIt last, OutputIt d_first, BinaryOp op) {
+  if (first == last) {
+    return d_first;
+  }
+  typename iterator_traits<InputIt>::value_type acc(*first);
+  *d_first = acc;
+  for (++first, ++d_first; first != last; ++first, ++d_first) {
+    acc = op(std::move(acc), *first);
+    *d_first = acc;
+  }
+  return d_first;
+}
+
+template <class RandomIt, class OutputIt, class BinaryOp>
+OutputIt inclusive_scan(const execution::parallel_policy& policy,
+                        RandomIt first, RandomIt last, OutputIt d_first,
+                        BinaryOp op) {
+  typedef typename iterator_traits<RandomIt>::value_type T;
+  return execution_detail::scan<false, T>(policy, first, last, d_first, op,
+                                          std::optional<T>());
+}
+
+template <class Policy, class It, class OutputIt,
+          class = typename std::enable_if<
+              execution::is_execution_policy_v<Policy>>::type>
+OutputIt inclusive_scan(const Policy& policy, It first, It last,
+                        OutputIt d_first) {
+  return tracystl::inclusive_scan(policy, first, last, d_first, std::plus<>());
+}
+
+template <class InputIt, class OutputIt, class T, class BinaryOp>
+OutputIt exclusive_scan(const execution::sequenced_policy&, InputIt first,
+                        InputIt last, OutputIt d_first, T init, BinaryOp op) {
+  for (; first != last; ++first, ++d_first) {
+    T value(*first);
+    *d_first = init;
+    init = op(std::move(init), std::move(value));
+  }
+  return d_first;
+}
+
+template <class RandomIt, class OutputIt, class T, class BinaryOp>
+OutputIt exclusive_scan(const execution::parallel_policy& policy,
+                        RandomIt first, RandomIt last, OutputIt d_first,
+                        T init, BinaryOp op) {
+  return execution_detail::scan<true, T>(policy, first, last, d_first, op,
+                                         std::optional<T>(std::move(init)));
+}
+
+template <class Policy, class It, class OutputIt, class T,
+          class = typename std::enable_if<
+              execution::is_execution_policy_v<Policy>>::type>
+OutputIt exclusive_scan(const Policy& policy, It first, It last,
+                        OutputIt d_first, T init) {
+  return tracystl::exclusive_scan(policy, first, last, d_first,
+                                  std::move(init), std::plus<>());
+}
+
+// sort
+
+template <class RandomIt, class Compare>
+void sort(const execution::sequenced_policy&, RandomIt first, RandomIt last,
+          Compare comp) {
+  tracystl::sort(first, last, comp);
+}
+
+// Sorts grain sized chunks with tracystl::sort in parallel, then merges
+// them pairwise, each merge split over the pool as well. Needs a buffer of
+// n elements; types that may throw when moved are sorted sequentially.
+template <class RandomIt, class Compare>
+void sort(const execution::parallel_policy& policy, RandomIt first,
+          RandomIt last, Compare comp) {
+  typedef typename iterator_traits<RandomIt>::value_type T;
+  const size_t n = static_cast<size_t>(last - first);
+  ThreadPool& pool = policy.pool();
+  const size_t grain =
+      execution_detail::grain_size(n, pool, execution_detail::min_sort_grain);
+  if (n <= grain || !std::is_nothrow_move_constructible<T>::value) {
+    tracystl::sort(first, last, comp);
+    return;
+  }
+  T* buffer = Allocator<T>::allocate(n);
+  // moving the range in builds the buffer's objects in parallel
+  execution_detail::parallel_for(pool, n, grain, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      Allocator<T>::construct(buffer + i, std::move(first[i]));
+    }
+  });
+  struct release {
+    ThreadPool& pool;
+    T* buffer;
+    size_t n;
+    size_t grain;
+    ~release() {
+      if (!std::is_trivially_destructible<T>::value) {
+        execution_detail::parallel_for(
+            pool, n, grain, [this](size_t lo, size_t hi) {
+              Allocator<T>::destroy(buffer + lo, buffer + hi);
+            });
+      }
+      Allocator<T>::deallocate(buffer, n);
+    }
+  } cleanup{pool, buffer, n, grain};
+  // the data is in the buffer now; the range, holding moved-from
+  // elements, is the scratch space the result ends up in
+  pool.run([&] {
+    execution_detail::merge_sort(pool, buffer, first, n, true, grain, comp);
+  });
+}
+
+template <class Policy, class RandomIt,
+          class = typename std::enable_if<
+              execution::is_execution_policy_v<Policy>>::type>
+void sort(const Policy& policy, RandomIt first, RandomIt last) {
+  tracystl::sort(policy, first, last,
+                 std::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_EXECUTION_H_
@@ -0,0 +1,334 @@
+#ifndef _TRACYSTL_FLAT_MAP_H_
+#define _TRACYSTL_FLAT_MAP_H_
+
+#include "allocator.h"
+#include "utility.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstddef> // For std::size_t
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tracystl {
+
+namespace flat_detail {
+
+template <class T>
+struct identity_key {
+  const T& operator()(const T& value) const noexcept { return value; }
+};
+
+template <class Pair>
+struct first_key {
+  const typename Pair::first_type& operator()(const Pair& value) const
+      noexcept {
+    return value.first;
+  }
+};
+
+// Binary search without a data dependent branch: each step is a conditional
+// move, so there is nothing to mispredict. Both possible probes of the next
+// step are prefetched while the current comparison runs, which hides most
+// of the cache misses once the array is larger than the cache.
+template <class KeyOfValue, class V, class Key, class Compare>
+const V* lower_bound(const V* first, size_t n, const Key& key,
+                     const Compare& comp) {
+  if (n == 0) {
+    return first;
+  }
+  while (n > 1) {
+    const size_t half = n / 2;
+    n -= half;
+#if defined(__GNUC__)
+    __builtin_prefetch(first + n / 2);
+    __builtin_prefetch(first + half + n / 2);
+#endif
+    first = comp(KeyOfValue()(first[half]), key) ? first + half : first;
+  }
+  return first + comp(KeyOfValue()(*first), key);
+}
+
+}  // namespace flat_detail
+
+// Shared implementation of FlatMap and FlatSet: the values are kept sorted
+// by key and unique in one Vector.
+//
+// Lookups are a branch-free binary search over contiguous memory. Inserting
+// or erasing a single element shifts everything after it, O(n), so these
+// containers suit data that is built once and then mostly read. Build them
+// with the range insert, which sorts and merges once, or from already
+// sorted input with the sorted_unique tag.
+//
+// Any insertion or erasure invalidates all iterators.
+template <class Key, class V, class KeyOfValue, class Compare, class Alloc>
+class flat_tree {
+ public:
+  typedef Key key_type;
+  typedef V value_type;
+  typedef Compare key_compare;
+  typedef Alloc allocator_type;
+  typedef Vector<V, Alloc> container_type;
+  typedef size_t size_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef const value_type* const_iterator;
+  // a set's elements are its keys and must not change in place
+  typedef typename std::conditional<std::is_same<Key, V>::value,
+                                    const value_type*, value_type*>::type
+      iterator;
+
+  flat_tree() = default;
+  explicit flat_tree(const Compare& comp, const Alloc& a = Alloc())
+      : data_(a), comp_(comp) {}
+
+  allocator_type get_allocator() const { return data_.get_allocator(); }
+  key_compare key_comp() const { return comp_; }
+
+  iterator begin() noexcept { return data_.begin(); }
+  const_iterator begin() const noexcept { return data_.begin(); }
+  iterator end() noexcept { return data_.end(); }
+  const_iterator end() const noexcept { return data_.end(); }
+
+  bool empty() const noexcept { return data_.empty(); }
+  size_type size() const noexcept { return data_.size(); }
+  size_type capacity() const noexcept { return data_.capacity(); }
+  void reserve(size_type n) { data_.reserve(n); }
+  void shrink_to_fit() { data_.shrink_to_fit(); }
+  void clear() noexcept { data_.clear(); }
+
+  // the sorted values, read only
+  const container_type& values() const noexcept { return data_; }
+
+  // lookup
+  iterator lower_bound(const key_type& key) {
+    return mutable_it(std::as_const(*this).lower_bound(key));
+  }
+  const_iterator lower_bound(const key_type& key) const {
+    return flat_detail::lower_bound<KeyOfValue>(data_.begin(), data_.size(),
+                                                key, comp_);
+  }
+  iterator upper_bound(const key_type& key) {
+    return mutable_it(std::as_const(*this).upper_bound(key));
+  }
+  const_iterator upper_bound(const key_type& key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !comp_(key, key_of(*it)) ? it + 1 : it;
+  }
+  std::pair<iterator, iterator> equal_range(const key_type& key) {
+    iterator it = lower_bound(key);
+    return std::pair<iterator, iterator>(
+        it, it != end() && !comp_(key, key_of(*it)) ? it + 1 : it);
+  }
+  iterator find(const key_type& key) {
+    return mutable_it(std::as_const(*this).find(key));
+  }
+  const_iterator find(const key_type& key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !comp_(key, key_of(*it)) ? it : end();
+  }
+  bool contains(const key_type& key) const { return find(key) != end(); }
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  // insertion; the bool is false if the key was already there
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return insert_unique(key_of(value), value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return insert_unique(key_of(value), std::move(value));
+  }
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+  // Appends the whole range, sorts the new part and merges it with the old
+  // one: O(n + m log m) instead of m shifting inserts. As with the single
+  // insert, a key that is already present keeps its value, and of several
+  // equal new keys only the first one is inserted.
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    const size_type old_size = size();
+    append(first, last);
+    std::stable_sort(data_.begin() + old_size, data_.end(),
+                     value_less{comp_});
+    merge_unique(old_size);
+  }
+  // Same for a range that is already sorted and free of duplicates: the sort
+  // is skipped, and if every new key is greater than the old ones so is the
+  // merge.
+  template <class InputIt>
+  void insert(sorted_unique_t, InputIt first, InputIt last) {
+    const size_type old_size = size();
+    append(first, last);
+    merge_unique(old_size);
+  }
+
+  // erase returns the iterator following the erased element(s)
+  iterator erase(const_iterator pos) { return data_.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) {
+    return data_.erase(first, last);
+  }
+  size_type erase(const key_type& key) {
+    const_iterator it = std::as_const(*this).find(key);
+    if (it == end()) {
+      return 0;
+    }
+    data_.erase(it);
+    return 1;
+  }
+
+  void swap(flat_tree& rhs) noexcept {
+    using std::swap;
+    data_.swap(rhs.data_);
+    swap(comp_, rhs.comp_);
+  }
+
+ protected:
+  struct value_less {
+    const Compare& comp;
+    bool operator()(const value_type& a, const value_type& b) const {
+      return comp(key_of(a), key_of(b));
+    }
+  };
+
+  static const key_type& key_of(const value_type& value) noexcept {
+    return KeyOfValue()(value);
+  }
+
+  iterator mutable_it(const_iterator it) noexcept {
+    return data_.begin() + (it - data_.begin());
+  }
+
+  // args build the value for key if key is not there yet
+  template <class... Args>
+  std::pair<iterator, bool> insert_unique(const key_type& key,
+                                          Args&&... args) {
+    iterator it = lower_bound(key);
+    if (it != end() && !comp_(key, key_of(*it))) {
+      return std::pair<iterator, bool>(it, false);
+    }
+    return std::pair<iterator, bool>(
+        data_.emplace(it, std::forward<Args>(args)...), true);
+  }
+
+ private:
+  template <class InputIt>
+  void append(InputIt first, InputIt last) {
+    typedef typename std::iterator_traits<InputIt>::iterator_category
+        category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                  category>::value) {
+      data_.reserve(size() +
+                    static_cast<size_type>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      data_.emplace_back(*first);
+    }
+  }
+
+  // [begin, begin + n) and [begin + n, end) are each sorted; merges them and
+  // drops every value whose key equals an earlier one.
+  void merge_unique(size_type n) {
+    V* mid = data_.begin() + n;
+    if (mid == data_.end()) {
+      return;
+    }
+    V* from = mid;
+    if (n != 0 && !comp_(key_of(mid[-1]), key_of(*mid))) {
+      // stable: on equal keys the old value stays in front and survives
+      std::inplace_merge(data_.begin(), mid, data_.end(), value_less{comp_});
+      from = data_.begin();
+    }
+    V* last = std::unique(from, data_.end(), [this](const V& a, const V& b) {
+      return !comp_(key_of(a), key_of(b));
+    });
+    data_.erase(last, data_.end());
+  }
+
+  container_type data_;
+  Compare comp_;
+};
+
+// A map stored as a sorted Vector of std::pair<K, V>. Keys are not const,
+// because the vector moves elements around by assignment, but changing one
+// through an iterator breaks the ordering.
+template <class K, class V, class Compare = std::less<K>,
+          class Alloc = tracystl::Allocator<std::pair<K, V>>>
+class FlatMap
+    : public flat_tree<K, std::pair<K, V>,
+                       flat_detail::first_key<std::pair<K, V>>, Compare,
+                       Alloc> {
+  typedef flat_tree<K, std::pair<K, V>, flat_detail::first_key<std::pair<K, V>>,
+                    Compare, Alloc>
+      base;
+
+ public:
+  typedef V mapped_type;
+  typedef typename base::iterator iterator;
+
+  FlatMap() = default;
+  explicit FlatMap(const Compare& comp, const Alloc& a = Alloc())
+      : base(comp, a) {}
+  template <class InputIt>
+  FlatMap(InputIt first, InputIt last) {
+    this->insert(first, last);
+  }
+  template <class InputIt>
+  FlatMap(sorted_unique_t, InputIt first, InputIt last) {
+    this->insert(sorted_unique, first, last);
+  }
+
+  V& operator[](const K& key) { return try_emplace(key).first->second; }
+  V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+  // constructs the mapped value from args only if the key is new
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    return this->insert_unique(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    return this->insert_unique(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+    std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+};
+
+// A set stored as a sorted Vector<K>. Its iterator is a const_iterator.
+template <class K, class Compare = std::less<K>,
+          class Alloc = tracystl::Allocator<K>>
+class FlatSet
+    : public flat_tree<K, K, flat_detail::identity_key<K>, Compare, Alloc> {
+  typedef flat_tree<K, K, flat_detail::identity_key<K>, Compare, Alloc> base;
+
+ public:
+  FlatSet() = default;
+  explicit FlatSet(const Compare& comp, const Alloc& a = Alloc())
+      : base(comp, a) {}
+  template <class InputIt>
+  FlatSet(InputIt first, InputIt last) {
+    this->insert(first, last);
+  }
+  template <class InputIt>
+  FlatSet(sorted_unique_t, InputIt first, InputIt last) {
+    this->insert(sorted_unique, first, last);
+  }
+};
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_FLAT_MAP_H_
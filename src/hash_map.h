@@ -0,0 +1,836 @@
+#ifndef _TRACYSTL_HASH_MAP_H_
+#define _TRACYSTL_HASH_MAP_H_
+
+#include "allocator.h"
+#include "type_traits.h"
+#include <bit>
+#include <cstddef> // For std::size_t
+#include <cstdint>
+#include <cstring> // For std::memcpy, std::memset
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace tracystl {
+
+// Default hash and key equality of HashMap. Hash<std::string> and
+// EqualTo<std::string> are transparent: a HashMap<std::string, V> can be
+// searched with a std::string_view or a const char* without building a
+// std::string.
+template <class K>
+struct Hash : std::hash<K> {};
+
+template <>
+struct Hash<std::string> {
+  typedef void is_transparent;
+  size_t operator()(std::string_view s) const noexcept {
+    return std::hash<std::string_view>()(s);
+  }
+};
+
+template <class K>
+struct EqualTo : std::equal_to<K> {};
+
+template <>
+struct EqualTo<std::string> : std::equal_to<void> {};
+
+namespace hash_map_detail {
+
+// One control byte per slot:
+//   0..127   full, holds the low 7 bits of the element's hash (H2)
+//   kEmpty   never used since the last rehash; stops a lookup
+//   kDeleted erased, but lookups must keep probing past it
+//   kSentinel marks the end of the table for iterators
+typedef signed char ctrl_t;
+constexpr ctrl_t kEmpty = -128;
+constexpr ctrl_t kDeleted = -2;
+constexpr ctrl_t kSentinel = -1;
+
+// Lookups compare a whole group of control bytes at once.
+constexpr size_t kGroupWidth = 16;
+// The first kGroupWidth - 1 control bytes are repeated after the sentinel,
+// so a group can be loaded at any slot without wrapping around.
+constexpr size_t kClonedBytes = kGroupWidth - 1;
+
+// The control bytes of a HashMap that never allocated. Starts with the
+// sentinel (begin() == end()); the empty bytes end every lookup.
+alignas(kGroupWidth) inline constexpr ctrl_t kEmptyGroup[kGroupWidth] = {
+    kSentinel, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+    kEmpty,    kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty};
+
+inline bool is_full(ctrl_t c) noexcept { return c >= 0; }
+
+// One bit per byte of a group.
+class bitmask {
+ public:
+  explicit bitmask(uint32_t mask) noexcept : mask_(mask) {}
+
+  explicit operator bool() const noexcept { return mask_ != 0; }
+  unsigned lowest() const noexcept { return __builtin_ctz(mask_); }
+  void clear_lowest() noexcept { mask_ &= mask_ - 1; }
+  // set bits at the start / end of the group, kGroupWidth if none
+  unsigned trailing_zeros() const noexcept {
+    return mask_ != 0 ? __builtin_ctz(mask_) : kGroupWidth;
+  }
+  unsigned leading_zeros() const noexcept {
+    return mask_ != 0 ? __builtin_clz(mask_) - (32 - kGroupWidth)
+                      : kGroupWidth;
+  }
+
+ private:
+  uint32_t mask_;
+};
+
+#ifdef __SSE2__
+// 16 control bytes in an SSE2 register: every match is one compare and one
+// movemask.
+class group {
+ public:
+  explicit group(const ctrl_t* pos) noexcept
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+  bitmask match(ctrl_t h2) const noexcept {
+    return to_mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+  }
+  bitmask match_empty() const noexcept { return match(kEmpty); }
+  // kEmpty and kDeleted are the only values below kSentinel
+  bitmask match_empty_or_deleted() const noexcept {
+    return to_mask(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_));
+  }
+  // number of empty/deleted bytes at the start of the group
+  unsigned count_leading_empty_or_deleted() const noexcept {
+    const uint32_t mask = _mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_));
+    return __builtin_ctz(mask + 1);
+  }
+
+ private:
+  static bitmask to_mask(__m128i bytes) noexcept {
+    return bitmask(static_cast<uint32_t>(_mm_movemask_epi8(bytes)));
+  }
+
+  __m128i ctrl_;
+};
+#else
+// Portable fallback with the same interface, one byte at a time.
+class group {
+ public:
+  explicit group(const ctrl_t* pos) noexcept {
+    std::memcpy(ctrl_, pos, kGroupWidth);
+  }
+
+  bitmask match(ctrl_t h2) const noexcept {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i) {
+      mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+    }
+    return bitmask(mask);
+  }
+  bitmask match_empty() const noexcept { return match(kEmpty); }
+  bitmask match_empty_or_deleted() const noexcept {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i) {
+      mask |= static_cast<uint32_t>(ctrl_[i] < kSentinel) << i;
+    }
+    return bitmask(mask);
+  }
+  unsigned count_leading_empty_or_deleted() const noexcept {
+    unsigned n = 0;
+    while (n < kGroupWidth && ctrl_[n] < kSentinel) {
+      ++n;
+    }
+    return n;
+  }
+
+ private:
+  ctrl_t ctrl_[kGroupWidth];
+};
+#endif
+
+// Quadratic probing over groups: the i-th probe starts
+// kGroupWidth * i * (i + 1) / 2 slots after the first, which visits every
+// group of a power-of-two table.
+class probe_seq {
+ public:
+  probe_seq(size_t hash, size_t mask) noexcept
+      : mask_(mask), offset_(hash & mask), index_(0) {}
+
+  size_t offset() const noexcept { return offset_; }
+  size_t offset(unsigned i) const noexcept { return (offset_ + i) & mask_; }
+  void next() noexcept {
+    index_ += kGroupWidth;
+    offset_ = (offset_ + index_) & mask_;
+  }
+
+ private:
+  size_t mask_;
+  size_t offset_;
+  size_t index_;
+};
+
+// std::hash of an integer is the identity on libstdc++, but H1 needs good
+// high bits and H2 good low bits, so every hash is mixed first.
+inline size_t mix(size_t hash) noexcept {
+#ifdef __SIZEOF_INT128__
+  const unsigned __int128 m =
+      static_cast<unsigned __int128>(hash) * 0x9E3779B97F4A7C15ull;
+  return static_cast<size_t>(m) ^ static_cast<size_t>(m >> 64);
+#else
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35u;
+  return hash ^ (hash >> 16);
+#endif
+}
+
+inline size_t h1(size_t hash) noexcept { return hash >> 7; }
+inline ctrl_t h2(size_t hash) noexcept {
+  return static_cast<ctrl_t>(hash & 0x7F);
+}
+
+// Tables hold 2^k - 1 slots (k >= 4) and are refilled to at most 7/8.
+inline size_t capacity_to_growth(size_t capacity) noexcept {
+  return capacity - capacity / 8;
+}
+// The largest table whose slot array of Slot fits in a ptrdiff_t.
+template <class Slot>
+constexpr size_t max_capacity() noexcept {
+  const size_t max_slots =
+      static_cast<size_t>(std::numeric_limits<std::ptrdiff_t>::max()) /
+      sizeof(Slot);
+  return std::bit_floor(max_slots + 1) - 1;
+}
+// n must be at most capacity_to_growth of some valid capacity
+inline size_t normalize_capacity(size_t n) noexcept {
+  size_t capacity = kGroupWidth - 1;
+  while (capacity < n) {
+    capacity = capacity * 2 + 1;
+  }
+  return capacity;
+}
+
+template <class T, class = void>
+struct is_transparent : std::false_type {};
+
+template <class T>
+struct is_transparent<T, std::void_t<typename T::is_transparent>>
+    : std::true_type {};
+
+// key_arg_impl<true>::type<Q, K> is Q itself (not a nested typedef of some
+// dependent class), so Q can still be deduced from a call argument.
+template <bool Transparent>
+struct key_arg_impl {
+  template <class Q, class K>
+  using type = K;
+};
+
+template <>
+struct key_arg_impl<true> {
+  template <class Q, class K>
+  using type = Q;
+};
+
+}  // namespace hash_map_detail
+
+// Open-addressing hash map in the style of SwissTable.
+//
+// Elements are stored inline in one flat slot array, next to an array of
+// one-byte control words (see hash_map_detail). A lookup splits the hash into
+// H1, which picks where probing starts, and H2, the 7 bits kept in the control
+// byte. Each probe loads 16 control bytes and compares them against H2 in one
+// SSE2 instruction, so the slots themselves are only touched for likely
+// matches; a group with an empty byte ends the search.
+//
+// erase() only leaves a tombstone (kDeleted) if the slot sits in a run of 16
+// non-empty bytes that some probe may have walked through; otherwise the
+// slot goes straight back to kEmpty. Tombstones are dropped at the next
+// rehash, which does not grow the table if they are the reason it is full.
+//
+// Any insertion may rehash and invalidates iterators and references. A
+// rehash relocates elements; it assumes that does not throw.
+template <class K, class V, class Hash = tracystl::Hash<K>,
+          class KeyEqual = tracystl::EqualTo<K>,
+          class Alloc = tracystl::Allocator<std::pair<const K, V>>>
+class HashMap : private allocator_holder<Alloc> {
+ public:
+  typedef K key_type;
+  typedef V mapped_type;
+  typedef std::pair<const K, V> value_type;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Hash hasher;
+  typedef KeyEqual key_equal;
+  typedef Alloc allocator_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+
+ private:
+  typedef allocator_holder<Alloc> alloc_base;
+  using alloc_base::alloc;
+  typedef hash_map_detail::ctrl_t ctrl_t;
+  typedef typename Alloc::template rebind<ctrl_t>::other ctrl_allocator;
+
+  // Heterogeneous lookup: find/contains/count/erase take any Q the hasher
+  // and key_equal accept, but only if both declare is_transparent.
+  template <class Q>
+  using key_arg = typename hash_map_detail::key_arg_impl<
+      hash_map_detail::is_transparent<Hash>::value &&
+      hash_map_detail::is_transparent<KeyEqual>::value>::template type<Q, K>;
+
+  template <bool Const>
+  class hash_map_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename HashMap::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const value_type*,
+                                      value_type*>::type pointer;
+    typedef typename std::conditional<Const, const value_type&,
+                                      value_type&>::type reference;
+
+    hash_map_iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+    // iterator -> const_iterator
+    template <bool C = Const, class = typename std::enable_if<C>::type>
+    hash_map_iterator(const hash_map_iterator<false>& rhs) noexcept
+        : ctrl_(rhs.ctrl_), slot_(rhs.slot_) {}
+
+    reference operator*() const noexcept { return *slot_; }
+    pointer operator->() const noexcept { return slot_; }
+
+    hash_map_iterator& operator++() noexcept {
+      ++ctrl_;
+      ++slot_;
+      skip_empty_or_deleted();
+      return *this;
+    }
+    hash_map_iterator operator++(int) noexcept {
+      hash_map_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const hash_map_iterator& a,
+                           const hash_map_iterator& b) noexcept {
+      return a.ctrl_ == b.ctrl_;
+    }
+    friend bool operator!=(const hash_map_iterator& a,
+                           const hash_map_iterator& b) noexcept {
+      return a.ctrl_ != b.ctrl_;
+    }
+
+   private:
+    friend class HashMap;
+    template <bool>
+    friend class hash_map_iterator;
+
+    hash_map_iterator(const ctrl_t* ctrl, value_type* slot) noexcept
+        : ctrl_(ctrl), slot_(slot) {}
+
+    // jumps over whole runs of free slots a group at a time; the sentinel
+    // stops it at end()
+    void skip_empty_or_deleted() noexcept {
+      while (*ctrl_ < hash_map_detail::kSentinel) {
+        const unsigned shift =
+            hash_map_detail::group(ctrl_).count_leading_empty_or_deleted();
+        ctrl_ += shift;
+        slot_ += shift;
+      }
+    }
+
+    const ctrl_t* ctrl_;
+    value_type* slot_;
+  };
+
+ public:
+  typedef hash_map_iterator<false> iterator;
+  typedef hash_map_iterator<true> const_iterator;
+
+  HashMap() noexcept(std::is_nothrow_default_constructible<Alloc>::value &&
+                     std::is_nothrow_default_constructible<Hash>::value &&
+                     std::is_nothrow_default_constructible<KeyEqual>::value)
+      : ctrl_(empty_group()), slots_(nullptr), capacity_(0), size_(0),
+        growth_left_(0) {}
+  explicit HashMap(size_type bucket_count, const Hash& hash = Hash(),
+                   const KeyEqual& eq = KeyEqual(),
+                   const Alloc& a = Alloc())
+      : alloc_base(a), ctrl_(empty_group()), slots_(nullptr), capacity_(0),
+        size_(0), growth_left_(0), hash_(hash), eq_(eq) {
+    reserve(bucket_count);
+  }
+  HashMap(const HashMap& rhs);
+  HashMap(HashMap&& rhs) noexcept
+      : alloc_base(std::move(rhs.alloc())), ctrl_(rhs.ctrl_),
+        slots_(rhs.slots_), capacity_(rhs.capacity_), size_(rhs.size_),
+        growth_left_(rhs.growth_left_), hash_(std::move(rhs.hash_)),
+        eq_(std::move(rhs.eq_)) {
+    rhs.ctrl_ = empty_group();
+    rhs.slots_ = nullptr;
+    rhs.capacity_ = rhs.size_ = rhs.growth_left_ = 0;
+  }
+  ~HashMap() { destroy_and_deallocate(); }
+
+  HashMap& operator=(const HashMap& rhs) {
+    if (this != &rhs) {
+      HashMap tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+  HashMap& operator=(HashMap&& rhs) noexcept {
+    if (this != &rhs) {
+      HashMap tmp(std::move(rhs));
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  void swap(HashMap& rhs) noexcept {
+    using std::swap;
+    swap(alloc(), rhs.alloc());
+    swap(ctrl_, rhs.ctrl_);
+    swap(slots_, rhs.slots_);
+    swap(capacity_, rhs.capacity_);
+    swap(size_, rhs.size_);
+    swap(growth_left_, rhs.growth_left_);
+    swap(hash_, rhs.hash_);
+    swap(eq_, rhs.eq_);
+  }
+
+  allocator_type get_allocator() const { return alloc(); }
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return eq_; }
+
+  iterator begin() noexcept {
+    iterator it(ctrl_, slots_);
+    it.skip_empty_or_deleted();
+    return it;
+  }
+  const_iterator begin() const noexcept {
+    return const_cast<HashMap*>(this)->begin();
+  }
+  iterator end() noexcept { return iterator(ctrl_ + capacity_, nullptr); }
+  const_iterator end() const noexcept {
+    return const_iterator(ctrl_ + capacity_, nullptr);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  // number of slots; at most 7/8 of them are used
+  size_type capacity() const noexcept { return capacity_; }
+  size_type max_size() const noexcept {
+    return hash_map_detail::capacity_to_growth(max_capacity());
+  }
+
+  // Makes room for n elements without a rehash.
+  void reserve(size_type n) {
+    if (n > size_ + growth_left_) {
+      if (n > max_size()) {
+        throw std::length_error("HashMap::reserve: too many elements");
+      }
+      size_type capacity = hash_map_detail::normalize_capacity(n);
+      while (hash_map_detail::capacity_to_growth(capacity) < n) {
+        capacity = capacity * 2 + 1;
+      }
+      resize(capacity);
+    }
+  }
+
+  // destroys the elements but keeps the slots
+  void clear() noexcept;
+
+  // lookup
+  template <class Q = K>
+  iterator find(const key_arg<Q>& key) {
+    const size_type i = find_index(key, hash_of(key));
+    return i != capacity_ ? iterator_at(i) : end();
+  }
+  template <class Q = K>
+  const_iterator find(const key_arg<Q>& key) const {
+    return const_cast<HashMap*>(this)->find(key);
+  }
+  template <class Q = K>
+  bool contains(const key_arg<Q>& key) const {
+    return find_index(key, hash_of(key)) != capacity_;
+  }
+  template <class Q = K>
+  size_type count(const key_arg<Q>& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  V& operator[](const K& key) { return try_emplace(key).first->second; }
+  V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+  // insertion; the bool is false if the key was already there, and the
+  // iterator then points at the existing element
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace_key(value.first, value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return emplace_key(value.first, std::move(value));
+  }
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  // builds a value_type from args, then inserts it
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  // constructs the mapped value from args only if the key is new
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    return emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    return emplace_key(key, std::piecewise_construct,
+                       std::forward_as_tuple(std::move(key)),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+    std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  // erase(iterator) returns nothing: finding the next element would cost a
+  // scan that most callers do not need. Only the erased element's iterators
+  // are invalidated.
+  void erase(const_iterator pos) {
+    erase_at(static_cast<size_type>(pos.ctrl_ - ctrl_));
+  }
+  void erase(iterator pos) { erase(const_iterator(pos)); }
+  template <class Q = K>
+  size_type erase(const key_arg<Q>& key) {
+    const size_type i = find_index(key, hash_of(key));
+    if (i == capacity_) {
+      return 0;
+    }
+    erase_at(i);
+    return 1;
+  }
+
+ private:
+  static ctrl_t* empty_group() noexcept {
+    return const_cast<ctrl_t*>(hash_map_detail::kEmptyGroup);
+  }
+
+  template <class Q>
+  size_type hash_of(const Q& key) const {
+    return hash_map_detail::mix(hash_(key));
+  }
+
+  iterator iterator_at(size_type i) noexcept {
+    return iterator(ctrl_ + i, slots_ + i);
+  }
+
+  // index of the element equal to key, capacity_ if there is none
+  template <class Q>
+  size_type find_index(const Q& key, size_type hash) const;
+  // index of the first empty or deleted slot on hash's probe sequence
+  size_type find_first_non_full(size_type hash) const noexcept;
+  // claims a slot for a new element with this hash, growing if needed
+  size_type prepare_insert(size_type hash);
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace_key(const K& key, Args&&... args);
+
+  void erase_at(size_type i) noexcept;
+
+  // writes a control byte and its clone past the sentinel
+  void set_ctrl(size_type i, ctrl_t c) noexcept {
+    ctrl_[i] = c;
+    ctrl_[((i - hash_map_detail::kClonedBytes) & capacity_) +
+          hash_map_detail::kClonedBytes] = c;
+  }
+
+  void allocate_tables(size_type capacity);
+  static constexpr size_type max_capacity() noexcept {
+    return hash_map_detail::max_capacity<value_type>();
+  }
+  void resize(size_type new_capacity);
+  void rehash_and_grow_if_necessary();
+  void destroy_and_deallocate() noexcept;
+
+  void relocate_slot(value_type* dst, value_type* src) {
+    if constexpr (tracystl::is_trivially_relocatable<value_type>::value) {
+      std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                  sizeof(value_type));
+    } else {
+      alloc().construct(dst, std::move(*src));
+      alloc().destroy(src);
+    }
+  }
+
+  ctrl_t* ctrl_;
+  value_type* slots_;
+  size_type capacity_;
+  size_type size_;
+  // insertions left before a rehash; only landing on a kEmpty slot uses one
+  size_type growth_left_;
+  Hash hash_;
+  KeyEqual eq_;
+};
+
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+HashMap<K, V, Hash, KeyEqual, Alloc>::HashMap(const HashMap& rhs)
+    : alloc_base(rhs.alloc()), ctrl_(empty_group()), slots_(nullptr),
+      capacity_(0), size_(0), growth_left_(0), hash_(rhs.hash_),
+      eq_(rhs.eq_) {
+  if (rhs.size_ == 0) {
+    return;
+  }
+  // same capacity and hash function: every element goes to the same slot,
+  // so the control bytes are copied verbatim and nothing is rehashed
+  allocate_tables(rhs.capacity_);
+  std::memcpy(ctrl_, rhs.ctrl_,
+              capacity_ + 1 + hash_map_detail::kClonedBytes);
+  size_type i = 0;
+  try {
+    for (; i < capacity_; ++i) {
+      if (hash_map_detail::is_full(ctrl_[i])) {
+        alloc().construct(slots_ + i, rhs.slots_[i]);
+      }
+    }
+  } catch (...) {
+    for (size_type j = 0; j < i; ++j) {
+      if (hash_map_detail::is_full(ctrl_[j])) {
+        alloc().destroy(slots_ + j);
+      }
+    }
+    size_ = 0;
+    for (size_type j = 0; j < capacity_; ++j) {
+      ctrl_[j] = hash_map_detail::kEmpty;
+    }
+    destroy_and_deallocate();
+    throw;
+  }
+  size_ = rhs.size_;
+  growth_left_ = rhs.growth_left_;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+void HashMap<K, V, Hash, KeyEqual, Alloc>::clear() noexcept {
+  if (capacity_ == 0) {
+    return;
+  }
+  if constexpr (!std::is_trivially_destructible<value_type>::value) {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (hash_map_detail::is_full(ctrl_[i])) {
+        alloc().destroy(slots_ + i);
+      }
+    }
+  }
+  std::memset(ctrl_, static_cast<unsigned char>(hash_map_detail::kEmpty),
+              capacity_ + 1 + hash_map_detail::kClonedBytes);
+  ctrl_[capacity_] = hash_map_detail::kSentinel;
+  size_ = 0;
+  growth_left_ = hash_map_detail::capacity_to_growth(capacity_);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+template <class Q>
+typename HashMap<K, V, Hash, KeyEqual, Alloc>::size_type
+HashMap<K, V, Hash, KeyEqual, Alloc>::find_index(const Q& key,
+                                                 size_type hash) const {
+  const ctrl_t h2 = hash_map_detail::h2(hash);
+  hash_map_detail::probe_seq seq(hash_map_detail::h1(hash), capacity_);
+  for (;;) {
+    const hash_map_detail::group g(ctrl_ + seq.offset());
+    for (hash_map_detail::bitmask match = g.match(h2); match;
+         match.clear_lowest()) {
+      const size_type i = seq.offset(match.lowest());
+      if (eq_(slots_[i].first, key)) {
+        return i;
+      }
+    }
+    if (g.match_empty()) {
+      return capacity_;
+    }
+    seq.next();
+  }
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+typename HashMap<K, V, Hash, KeyEqual, Alloc>::size_type
+HashMap<K, V, Hash, KeyEqual, Alloc>::find_first_non_full(
+    size_type hash) const noexcept {
+  hash_map_detail::probe_seq seq(hash_map_detail::h1(hash), capacity_);
+  for (;;) {
+    const hash_map_detail::bitmask free =
+        hash_map_detail::group(ctrl_ + seq.offset()).match_empty_or_deleted();
+    if (free) {
+      return seq.offset(free.lowest());
+    }
+    seq.next();
+  }
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+typename HashMap<K, V, Hash, KeyEqual, Alloc>::size_type
+HashMap<K, V, Hash, KeyEqual, Alloc>::prepare_insert(size_type hash) {
+  size_type target = find_first_non_full(hash);
+  // reusing a tombstone does not use up growth
+  if (growth_left_ == 0 && ctrl_[target] != hash_map_detail::kDeleted) {
+    rehash_and_grow_if_necessary();
+    target = find_first_non_full(hash);
+  }
+  ++size_;
+  growth_left_ -= ctrl_[target] == hash_map_detail::kEmpty ? 1 : 0;
+  set_ctrl(target, hash_map_detail::h2(hash));
+  return target;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+template <class... Args>
+std::pair<typename HashMap<K, V, Hash, KeyEqual, Alloc>::iterator, bool>
+HashMap<K, V, Hash, KeyEqual, Alloc>::emplace_key(const K& key,
+                                                  Args&&... args) {
+  const size_type hash = hash_of(key);
+  size_type i = find_index(key, hash);
+  if (i != capacity_) {
+    return std::pair<iterator, bool>(iterator_at(i), false);
+  }
+  i = prepare_insert(hash);
+  try {
+    alloc().construct(slots_ + i, std::forward<Args>(args)...);
+  } catch (...) {
+    // give the slot back; a tombstone is always safe here
+    --size_;
+    set_ctrl(i, hash_map_detail::kDeleted);
+    throw;
+  }
+  return std::pair<iterator, bool>(iterator_at(i), true);
+}
+
+// A slot can go straight back to kEmpty unless it is inside a window of
+// kGroupWidth consecutive non-empty bytes: only then could a probe have
+// found its group full and moved past it.
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+void HashMap<K, V, Hash, KeyEqual, Alloc>::erase_at(size_type i) noexcept {
+  alloc().destroy(slots_ + i);
+  --size_;
+  const size_type before = (i - hash_map_detail::kGroupWidth) & capacity_;
+  const hash_map_detail::bitmask empty_after =
+      hash_map_detail::group(ctrl_ + i).match_empty();
+  const hash_map_detail::bitmask empty_before =
+      hash_map_detail::group(ctrl_ + before).match_empty();
+  const bool was_never_full =
+      empty_before && empty_after &&
+      empty_after.trailing_zeros() + empty_before.leading_zeros() <
+          hash_map_detail::kGroupWidth;
+  set_ctrl(i, was_never_full ? hash_map_detail::kEmpty
+                             : hash_map_detail::kDeleted);
+  growth_left_ += was_never_full ? 1 : 0;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+void HashMap<K, V, Hash, KeyEqual, Alloc>::allocate_tables(
+    size_type capacity) {
+  if (capacity > max_capacity()) {
+    throw std::length_error("HashMap: too many elements");
+  }
+  const size_type ctrl_bytes = capacity + 1 + hash_map_detail::kClonedBytes;
+  ctrl_allocator ctrl_alloc(alloc());
+  ctrl_t* ctrl = ctrl_alloc.allocate(ctrl_bytes);
+  try {
+    slots_ = alloc().allocate(capacity);
+  } catch (...) {
+    ctrl_alloc.deallocate(ctrl, ctrl_bytes);
+    throw;
+  }
+  ctrl_ = ctrl;
+  capacity_ = capacity;
+  std::memset(ctrl_, static_cast<unsigned char>(hash_map_detail::kEmpty),
+              ctrl_bytes);
+  ctrl_[capacity_] = hash_map_detail::kSentinel;
+  growth_left_ = hash_map_detail::capacity_to_growth(capacity_) - size_;
+}
+
+// Moves every element into fresh tables of new_capacity slots. Tombstones
+// are not carried over.
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+void HashMap<K, V, Hash, KeyEqual, Alloc>::resize(size_type new_capacity) {
+  ctrl_t* old_ctrl = ctrl_;
+  value_type* old_slots = slots_;
+  const size_type old_capacity = capacity_;
+  allocate_tables(new_capacity);
+  for (size_type i = 0; i < old_capacity; ++i) {
+    if (hash_map_detail::is_full(old_ctrl[i])) {
+      const size_type hash = hash_of(old_slots[i].first);
+      const size_type target = find_first_non_full(hash);
+      set_ctrl(target, hash_map_detail::h2(hash));
+      relocate_slot(slots_ + target, old_slots + i);
+    }
+  }
+  if (old_capacity != 0) {
+    tracystl::notify_reallocate(alloc(), old_capacity * sizeof(value_type),
+                                new_capacity * sizeof(value_type));
+    ctrl_allocator(alloc()).deallocate(
+        old_ctrl, old_capacity + 1 + hash_map_detail::kClonedBytes);
+    alloc().deallocate(old_slots, old_capacity);
+  }
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+void HashMap<K, V, Hash, KeyEqual, Alloc>::rehash_and_grow_if_necessary() {
+  if (capacity_ == 0) {
+    resize(hash_map_detail::kGroupWidth - 1);
+  } else if (size_ * 32 <= capacity_ * 25) {
+    // mostly tombstones: clean up at the same size instead of growing
+    resize(capacity_);
+  } else {
+    if (capacity_ == max_capacity()) {
+      throw std::length_error("HashMap: too many elements");
+    }
+    resize(capacity_ * 2 + 1);
+  }
+}
+
+template <class K, class V, class Hash, class KeyEqual, class Alloc>
+void HashMap<K, V, Hash, KeyEqual, Alloc>::destroy_and_deallocate() noexcept {
+  if (capacity_ == 0) {
+    return;
+  }
+  if constexpr (!std::is_trivially_destructible<value_type>::value) {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (hash_map_detail::is_full(ctrl_[i])) {
+        alloc().destroy(slots_ + i);
+      }
+    }
+  }
+  ctrl_allocator(alloc()).deallocate(
+      ctrl_, capacity_ + 1 + hash_map_detail::kClonedBytes);
+  alloc().deallocate(slots_, capacity_);
+  ctrl_ = empty_group();
+  slots_ = nullptr;
+  capacity_ = size_ = growth_left_ = 0;
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_HASH_MAP_H_
@@ -0,0 +1,251 @@
+#ifndef _TRACYSTL_INSTRUMENTED_ALLOCATOR_H_
+#define _TRACYSTL_INSTRUMENTED_ALLOCATOR_H_
+
+#include "allocator.h"
+#include <atomic>
+#include <cstddef> // For std::size_t
+#include <cstdio>
+
+// Allocation instrumentation is compiled in only when TRACYSTL_ALLOC_STATS is
+// defined to a non-zero value (e.g. -DTRACYSTL_ALLOC_STATS=1). Otherwise
+// InstrumentedAllocator<T, Base> is Base with a different name and every
+// alloc_stats member is an empty inline function, so instrumented code can stay
+// in place in production builds at zero cost.
+//
+// The two variants have different layouts, so they live in different inline
+// namespaces: translation units built with and without the flag name different
+// types and cannot silently share one definition (an ODR violation). Passing
+// an alloc_stats or an instrumented container between them fails to link.
+#ifndef TRACYSTL_ALLOC_STATS
+#define TRACYSTL_ALLOC_STATS 0
+#endif
+
+namespace tracystl {
+#if TRACYSTL_ALLOC_STATS
+inline namespace alloc_stats_enabled {
+#else
+inline namespace alloc_stats_disabled {
+#endif
+
+// Counters for one allocation site, e.g. one container or one kind of
+// container. Safe to share between threads (all counters are relaxed atomics).
+class alloc_stats {
+ public:
+  // bucket i counts requests of [2^i, 2^(i+1)) bytes
+  static constexpr size_t kHistogramBuckets = 48;
+
+  explicit alloc_stats(const char* name = "tracystl") noexcept : name_(name) {}
+  alloc_stats(const alloc_stats&) = delete;
+  alloc_stats& operator=(const alloc_stats&) = delete;
+
+  // the counters everybody shares unless a container is given its own
+  static alloc_stats& global() noexcept {
+    static alloc_stats stats("global");
+    return stats;
+  }
+
+  const char* name() const noexcept { return name_; }
+
+#if TRACYSTL_ALLOC_STATS
+  void record_allocate(size_t bytes) noexcept {
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    histogram_[bucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+    const size_t live =
+        live_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t peak = peak_bytes_.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !peak_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+  }
+  void record_deallocate(size_t bytes) noexcept {
+    deallocations_.fetch_add(1, std::memory_order_relaxed);
+    live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+  void record_reallocate(size_t old_bytes, size_t) noexcept {
+    // the first buffer of a container is an allocation, not a reallocation
+    if (old_bytes != 0) {
+      reallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  size_t live_bytes() const noexcept { return live_bytes_.load(std::memory_order_relaxed); }
+  size_t peak_bytes() const noexcept { return peak_bytes_.load(std::memory_order_relaxed); }
+  size_t allocations() const noexcept { return allocations_.load(std::memory_order_relaxed); }
+  size_t deallocations() const noexcept { return deallocations_.load(std::memory_order_relaxed); }
+  size_t reallocations() const noexcept { return reallocations_.load(std::memory_order_relaxed); }
+  size_t histogram(size_t bucket) const noexcept {
+    return histogram_[bucket].load(std::memory_order_relaxed);
+  }
+
+  void reset() noexcept {
+    live_bytes_.store(0, std::memory_order_relaxed);
+    peak_bytes_.store(0, std::memory_order_relaxed);
+    allocations_.store(0, std::memory_order_relaxed);
+    deallocations_.store(0, std::memory_order_relaxed);
+    reallocations_.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < kHistogramBuckets; ++i) {
+      histogram_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // writes a human readable report, only the non-empty histogram buckets
+  void report(std::FILE* out = stderr) const {
+    std::fprintf(out, "[tracystl] allocation report: %s\n", name_);
+    std::fprintf(out, "  live bytes      %zu\n", live_bytes());
+    std::fprintf(out, "  peak bytes      %zu\n", peak_bytes());
+    std::fprintf(out, "  allocations     %zu\n", allocations());
+    std::fprintf(out, "  deallocations   %zu\n", deallocations());
+    std::fprintf(out, "  reallocations   %zu\n", reallocations());
+    std::fprintf(out, "  size histogram (bytes: count)\n");
+    for (size_t i = 0; i < kHistogramBuckets; ++i) {
+      const size_t count = histogram(i);
+      if (count != 0) {
+        std::fprintf(out, "    [%zu, %zu): %zu\n", size_t(1) << i, size_t(1) << (i + 1),
+                     count);
+      }
+    }
+  }
+
+  // appends the report to a file, returns false if it cannot be opened
+  bool report(const char* path) const {
+    std::FILE* out = std::fopen(path, "a");
+    if (out == nullptr) {
+      return false;
+    }
+    report(out);
+    std::fclose(out);
+    return true;
+  }
+
+ private:
+  static size_t bucket(size_t bytes) noexcept {
+    size_t b = 0;
+    while (bytes > 1 && b + 1 < kHistogramBuckets) {
+      bytes >>= 1;
+      ++b;
+    }
+    return b;
+  }
+
+  const char* name_;
+  std::atomic<size_t> live_bytes_{0};
+  std::atomic<size_t> peak_bytes_{0};
+  std::atomic<size_t> allocations_{0};
+  std::atomic<size_t> deallocations_{0};
+  std::atomic<size_t> reallocations_{0};
+  std::atomic<size_t> histogram_[kHistogramBuckets] = {};
+#else
+  void record_allocate(size_t) noexcept {}
+  void record_deallocate(size_t) noexcept {}
+  void record_reallocate(size_t, size_t) noexcept {}
+
+  size_t live_bytes() const noexcept { return 0; }
+  size_t peak_bytes() const noexcept { return 0; }
+  size_t allocations() const noexcept { return 0; }
+  size_t deallocations() const noexcept { return 0; }
+  size_t reallocations() const noexcept { return 0; }
+  size_t histogram(size_t) const noexcept { return 0; }
+
+  void reset() noexcept {}
+  void report(std::FILE* = stderr) const {}
+  bool report(const char*) const { return true; }
+
+ private:
+  const char* name_;
+#endif
+};
+
+#if TRACYSTL_ALLOC_STATS
+
+// Forwards to Base and records every allocation in an alloc_stats instance
+// (alloc_stats::global() unless one is passed in). Rebound copies, like the
+// node allocator of a List, report to the same instance.
+template <class T, class Base = tracystl::Allocator<T>>
+class InstrumentedAllocator : private Base {
+ public:
+  typedef typename Base::value_type value_type;
+  typedef typename Base::pointer pointer;
+  typedef typename Base::const_pointer const_pointer;
+  typedef typename Base::reference reference;
+  typedef typename Base::const_reference const_reference;
+  typedef typename Base::size_type size_type;
+  typedef typename Base::difference_type difference_type;
+
+  template <class U>
+  struct rebind {
+    typedef InstrumentedAllocator<U, typename Base::template rebind<U>::other> other;
+  };
+
+  InstrumentedAllocator() noexcept : stats_(&alloc_stats::global()) {}
+  explicit InstrumentedAllocator(alloc_stats& stats, const Base& base = Base())
+      : Base(base), stats_(&stats) {}
+  template <class U, class B>
+  InstrumentedAllocator(const InstrumentedAllocator<U, B>& rhs)
+      : Base(rhs.base()), stats_(&rhs.stats()) {}
+
+  T* allocate() { return allocate(1); }
+  T* allocate(size_t n) {
+    T* ptr = Base::allocate(n);
+    if (ptr != nullptr) {
+      stats_->record_allocate(n * sizeof(T));
+    }
+    return ptr;
+  }
+
+  void deallocate(T* ptr) { deallocate(ptr, 1); }
+  void deallocate(T* ptr, size_type n) {
+    if (ptr == nullptr) {
+      return;
+    }
+    stats_->record_deallocate(n * sizeof(T));
+    Base::deallocate(ptr, n);
+  }
+
+  void on_reallocate(size_t old_bytes, size_t new_bytes) {
+    stats_->record_reallocate(old_bytes, new_bytes);
+    tracystl::notify_reallocate(base(), old_bytes, new_bytes);
+  }
+
+  using Base::construct;
+  using Base::destroy;
+
+  alloc_stats& stats() const noexcept { return *stats_; }
+  Base& base() noexcept { return *this; }
+  const Base& base() const noexcept { return *this; }
+
+  bool operator==(const InstrumentedAllocator& rhs) const {
+    return base() == rhs.base();
+  }
+  bool operator!=(const InstrumentedAllocator& rhs) const { return !(*this == rhs); }
+
+ private:
+  alloc_stats* stats_;
+};
+
+#else
+
+// Instrumentation disabled: behave exactly like Base.
+template <class T, class Base = tracystl::Allocator<T>>
+class InstrumentedAllocator : public Base {
+ public:
+  template <class U>
+  struct rebind {
+    typedef InstrumentedAllocator<U, typename Base::template rebind<U>::other> other;
+  };
+
+  InstrumentedAllocator() = default;
+  explicit InstrumentedAllocator(alloc_stats&, const Base& base = Base()) : Base(base) {}
+  template <class U, class B>
+  InstrumentedAllocator(const InstrumentedAllocator<U, B>& rhs) : Base(rhs.base()) {}
+
+  alloc_stats& stats() const noexcept { return alloc_stats::global(); }
+  Base& base() noexcept { return *this; }
+  const Base& base() const noexcept { return *this; }
+};
+
+#endif  // TRACYSTL_ALLOC_STATS
+
+}  // inline namespace alloc_stats_enabled / alloc_stats_disabled
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_INSTRUMENTED_ALLOCATOR_H_
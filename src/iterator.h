@@ -1,6 +1,8 @@
 #ifndef _TRACYSTL_ITERATOR_H_
 #define _TRACYSTL_ITERATOR_H_
 #include <cstddef>
+#include <iterator>
+#include <type_traits>
 
 namespace tracystl {
 
@@ -10,6 +12,12 @@ namespace tracystl {
     struct forward_iterator_tag : public input_iterator_tag {};
     struct bidirectional_iterator_tag : public forward_iterator_tag {};
     struct random_access_iterator_tag : public bidirectional_iterator_tag {};
+    // Random access iterators whose elements are adjacent in memory, so a
+    // range [first, last) is the array [&*first, &*first + (last - first)).
+    // Algorithms use this to lower copy/fill/find loops to memmove/memset.
+    // Reported as iterator_concept, like C++20, so code that compares
+    // iterator_category with random_access_iterator_tag keeps working.
+    struct contiguous_iterator_tag : public random_access_iterator_tag {};
 
     template<class Category, class T, class Distance = ptrdiff_t,
              class Pointer = T*, class Reference = T&>
@@ -34,8 +42,9 @@ namespace tracystl {
     template<class T>
     struct iterator_traits<T*> {
         typedef random_access_iterator_tag  iterator_category;
+        typedef contiguous_iterator_tag     iterator_concept;
         typedef T                           value_type;
-        typedef std::size_t                 difference_type;
+        typedef std::ptrdiff_t              difference_type;
         typedef T*                          pointer;
         typedef T&                          reference;
     };
@@ -43,11 +52,101 @@ namespace tracystl {
     template<class T>
     struct iterator_traits<const T*> {
         typedef random_access_iterator_tag  iterator_category;
+        typedef contiguous_iterator_tag     iterator_concept;
         typedef T                           value_type;
-        typedef std::size_t                 difference_type;
+        typedef std::ptrdiff_t              difference_type;
         typedef const T*                    pointer;
         typedef const T&                    reference;
     };
+
+    // True for pointers and for iterator classes that declare
+    // iterator_concept as contiguous_iterator_tag.
+    template<class Iterator, class = void>
+    struct is_contiguous_iterator : std::false_type {};
+
+    template<class T>
+    struct is_contiguous_iterator<T*> : std::true_type {};
+
+    template<class Iterator>
+    struct is_contiguous_iterator<Iterator,
+                                  std::void_t<typename Iterator::iterator_concept>>
+        : std::is_base_of<contiguous_iterator_tag,
+                          typename Iterator::iterator_concept> {};
+
+    template<class Iterator>
+    inline constexpr bool is_contiguous_iterator_v =
+        is_contiguous_iterator<Iterator>::value;
+
+    namespace iterator_detail {
+        // Some containers (list, deque) tag their iterators with the std::
+        // categories, so both families are accepted.
+        template<class Iterator>
+        inline constexpr bool is_random_access =
+            std::is_base_of_v<random_access_iterator_tag,
+                typename iterator_traits<Iterator>::iterator_category> ||
+            std::is_base_of_v<std::random_access_iterator_tag,
+                typename iterator_traits<Iterator>::iterator_category>;
+
+        template<class Iterator>
+        inline constexpr bool is_bidirectional =
+            std::is_base_of_v<bidirectional_iterator_tag,
+                typename iterator_traits<Iterator>::iterator_category> ||
+            std::is_base_of_v<std::bidirectional_iterator_tag,
+                typename iterator_traits<Iterator>::iterator_category>;
+    }
+
+    // Moves it by n steps: O(1) for random access iterators, |n| increments
+    // or decrements otherwise. n may only be negative for bidirectional
+    // iterators.
+    template<class InputIterator, class Distance>
+    constexpr void advance(InputIterator& it, Distance n) {
+        if constexpr (iterator_detail::is_random_access<InputIterator>) {
+            it += n;
+        } else if constexpr (iterator_detail::is_bidirectional<InputIterator>) {
+            for (; n > 0; --n) {
+                ++it;
+            }
+            for (; n < 0; ++n) {
+                --it;
+            }
+        } else {
+            for (; n > 0; --n) {
+                ++it;
+            }
+        }
+    }
+
+    // Number of steps from first to last: O(1) for random access iterators,
+    // otherwise last must be reachable from first.
+    template<class InputIterator>
+    constexpr typename iterator_traits<InputIterator>::difference_type
+    distance(InputIterator first, InputIterator last) {
+        if constexpr (iterator_detail::is_random_access<InputIterator>) {
+            return last - first;
+        } else {
+            typename iterator_traits<InputIterator>::difference_type n = 0;
+            for (; first != last; ++first) {
+                ++n;
+            }
+            return n;
+        }
+    }
+
+    template<class InputIterator>
+    constexpr InputIterator next(
+        InputIterator it,
+        typename iterator_traits<InputIterator>::difference_type n = 1) {
+        tracystl::advance(it, n);
+        return it;
+    }
+
+    template<class BidirectionalIterator>
+    constexpr BidirectionalIterator prev(
+        BidirectionalIterator it,
+        typename iterator_traits<BidirectionalIterator>::difference_type n = 1) {
+        tracystl::advance(it, -n);
+        return it;
+    }
 }
 
 #endif
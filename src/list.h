@@ -4,6 +4,10 @@
 #include "allocator.h"
 #include "iterator.h"
 #include <cstddef> // For std::size_t
+#include <functional> // For std::less
+#include <iterator> // For std::bidirectional_iterator_tag
+#include <type_traits>
+#include <utility> // For std::move, std::swap
 
 namespace tracystl {
 
@@ -80,6 +84,7 @@ struct  list_iterator: public tracystl::iterator<tracystl::bidirectional_iterato
   // TODO: Why not use x->as_base()
   list_iterator(node_ptr x) : node_(x->as_base()) {}
   list_iterator(const self& x) : node_(x.node_) {}
+  self& operator=(const self& x) = default;
 
   bool operator==(const self& x) const { return node_ == x.node_; }
   bool operator!=(const self& x) const { return node_ != x.node_; }
@@ -123,17 +128,18 @@ struct  list_const_iterator{
   list_const_iterator() : node_(nullptr) {}
   list_const_iterator(base_ptr x) : node_(x) {}
   list_const_iterator(node_ptr x) : node_(x->as_base()) {}
-  list_const_iterator(const self& x) : node_(x.node) {}
-  list_const_iterator(const list_iterator<T>& x) : node_(x.node) {}
+  list_const_iterator(const self& x) : node_(x.node_) {}
+  self& operator=(const self& x) = default;
+  list_const_iterator(const list_iterator<T>& x) : node_(x.node_) {}
 
   bool operator==(const self& x) const { return node_ == x.node_; }
   bool operator!=(const self& x) const { return node_ != x.node_; }
 
-  reference operator*() const { return node_->as_node()->data; }
+  reference operator*() const { return node_->as_node()->data_; }
   pointer operator->() const { return &(operator*()); }
 
   self& operator++() {
-    node_ = node_->next;
+    node_ = node_->next_;
     return *this;
   }
   self operator++(int) {
@@ -142,7 +148,7 @@ struct  list_const_iterator{
     return tmp;
   }
   self& operator--() {
-    node_ = node_->prev;
+    node_ = node_->prev_;
     return *this;
   }
   self operator--(int) {
@@ -152,8 +158,11 @@ struct  list_const_iterator{
   }
 };
 
-template <class T>
-class List{
+// Alloc is rebound to list_node<T>, e.g. List<int, PoolAllocator<int>> takes
+// its nodes from a slab pool owned by the list.
+template <class T, class Alloc = tracystl::Allocator<T>>
+class List : private allocator_holder<
+                 typename Alloc::template rebind<list_node<T>>::other> {
 public:
   typedef typename node_traits<T>::base_ptr base_ptr;
   typedef typename node_traits<T>::node_ptr node_ptr;
@@ -164,32 +173,57 @@ public:
   typedef const T& const_reference;
   typedef std::size_t size_type;
   typedef std::ptrdiff_t difference_type;
-  typedef tracystl::Allocator<T> allocator_type;
-  typedef tracystl::Allocator<T> data_allocator;
-  typedef tracystl::Allocator<list_node_base<T>> base_allocator;
-  typedef tracystl::Allocator<list_node<T>> node_allocator;
+  typedef Alloc allocator_type;
+  typedef Alloc data_allocator;
+  typedef typename Alloc::template rebind<list_node<T>>::other node_allocator;
 
 private:
+  typedef allocator_holder<node_allocator> alloc_base;
+
   size_type size_;
+  // The sentinel lives inside the List rather than in node_allocator, so a
+  // pool allocator can drop all of its slabs without taking the sentinel along.
+  list_node_base<T> head_;
   base_ptr node_;
 
+  node_allocator& node_alloc() { return alloc_base::alloc(); }
+
 public:
-  List() : size_(0) {
-    node_ = node_allocator::allocate();
+  List() : size_(0), head_(), node_(&head_) {
     node_->next_ = node_;
     node_->prev_ = node_;
   }
+  explicit List(const allocator_type& a)
+      : alloc_base(node_allocator(a)), size_(0), head_(), node_(&head_) {
+    node_->next_ = node_;
+    node_->prev_ = node_;
+  }
+  // the sentinel's address is part of the list, it cannot be copied bitwise
+  List(const List&) = delete;
+  List& operator=(const List&) = delete;
   ~List(){
     clear();
-    node_allocator::deallocate(node_->as_node());
   }
   void clear(){
     base_ptr cur = node_->next_;
-    while(cur != node_){
-      base_ptr tmp = cur;
-      cur = cur->next_;
-      node_allocator::destroy(tmp->as_node());
-      node_allocator::deallocate(tmp->as_node());
+    if constexpr (has_bulk_release<node_allocator>::value) {
+      // every node came from our own pool: run the destructors (if any) and
+      // hand the whole slab chain back at once.
+      if constexpr (!std::is_trivially_destructible<T>::value) {
+        while(cur != node_){
+          base_ptr tmp = cur;
+          cur = cur->next_;
+          node_alloc().destroy(tmp->as_node());
+        }
+      }
+      node_alloc().release();
+    } else {
+      while(cur != node_){
+        base_ptr tmp = cur;
+        cur = cur->next_;
+        node_alloc().destroy(tmp->as_node());
+        node_alloc().deallocate(tmp->as_node());
+      }
     }
     node_->unlink();
     size_ = 0;
@@ -219,6 +253,10 @@ public:
     erase(begin());
   }
 
+  allocator_type get_allocator() const {
+    return allocator_type(alloc_base::alloc());
+  }
+
   iterator begin(){
     return node_->next_;
   }
@@ -269,7 +307,7 @@ public:
     return new_node;
   }
 
-  iterator insert(iterator pos, const value_type&& value){
+  iterator insert(iterator pos, value_type&& value){
     node_ptr new_node = create_node(std::move(value));
     new_node->next_ = pos.node_;
     new_node->prev_ = pos.node_->prev_;
@@ -284,8 +322,8 @@ public:
     base_ptr prev_node = pos.node_->prev_;
     prev_node->next_ = next_node;
     next_node->prev_ = prev_node;
-    node_allocator::destroy(pos.node_->as_node());
-    node_allocator::deallocate(pos.node_->as_node());
+    node_alloc().destroy(pos.node_->as_node());
+    node_alloc().deallocate(pos.node_->as_node());
     --size_;
     return next_node->as_node();
   }
@@ -298,8 +336,8 @@ public:
     while(first != last){
       base_ptr tmp = first.node_;
       ++first;
-      node_allocator::destroy(tmp->as_node());
-      node_allocator::deallocate(tmp->as_node());
+      node_alloc().destroy(tmp->as_node());
+      node_alloc().deallocate(tmp->as_node());
       --size_;
     }
     return next_node->as_node();
@@ -323,134 +361,423 @@ public:
   //   }
   // }
 
-  // void swap(List& rhs){
-  //   std::swap(node_, rhs.node_);
-  //   std::swap(size_, rhs.size_);
-  // }
+  // The operations below relink nodes and never allocate, copy or move a T.
+  // swap exchanges the allocators along with the nodes, so a pool-backed list
+  // takes the other list's pool with it. splice and merge relink only between
+  // lists whose allocators compare equal; otherwise, e.g. between two lists
+  // that each own a PoolAllocator, every element that changes lists is moved
+  // into a new node of the destination and its old node freed by the source.
+  // Iterators to those elements are invalidated, and if allocating throws,
+  // the elements moved so far stay in the destination.
+
+  void swap(List& rhs){
+    if(this == &rhs){
+      return;
+    }
+    using std::swap;
+    swap(node_alloc(), rhs.node_alloc());
+    list_node_base<T> tmp;
+    take_nodes(node_, &tmp);
+    take_nodes(rhs.node_, node_);
+    take_nodes(&tmp, rhs.node_);
+    std::swap(size_, rhs.size_);
+  }
+
+  // moves all of rhs before pos, O(1)
+  void splice(const_iterator pos, List& rhs){
+    if(this == &rhs || rhs.empty()){
+      return;
+    }
+    if(!same_allocator(rhs)){
+      while(!rhs.empty()){
+        move_node(pos.node_, rhs, rhs.node_->next_);
+      }
+      return;
+    }
+    transfer(pos.node_, rhs.node_->next_, rhs.node_);
+    size_ += rhs.size_;
+    rhs.size_ = 0;
+  }
 
-  // void merge(List& rhs){
-  //   iterator first1 = begin();
-  //   iterator last1 = end();
-  //   iterator first2 = rhs.begin();
-  //   iterator last2 = rhs.end();
-  //   while(first1 != last1 && first2 != last2){
-  //     if(*first2 < *first1){
-  //       iterator next = first2;
-  //       transfer(first1, first2, ++next);
-  //       first2 = next;
-  //     }else{
-  //       ++first1;
-  //     }
-  //   }
-  //   if(first2 != last2){
-  //     transfer(last1, first2, last2);
-  //   }
-  //   size_ += rhs.size_;
-  //   rhs.size_ = 0;
-  //   rhs.node_->unlink();
-  // }
+  // moves *it from rhs, which may be this list, before pos, O(1)
+  void splice(const_iterator pos, List& rhs, const_iterator it){
+    if(!same_allocator(rhs)){
+      move_node(pos.node_, rhs, it.node_);
+      return;
+    }
+    base_ptr next = it.node_->next_;
+    if(pos.node_ == it.node_ || pos.node_ == next){
+      return;
+    }
+    transfer(pos.node_, it.node_, next);
+    ++size_;
+    --rhs.size_;
+  }
 
-  // void splice(iterator pos, List& rhs){
-  //   if(!rhs.empty()){
-  //     transfer(pos, rhs.begin(), rhs.end());
-  //     size_ += rhs.size_;
-  //     rhs.size_ = 0;
-  //     rhs.node_->unlink();
-  //   }
-  // }
+  // moves [first, last) from rhs before pos, which must not be in the range.
+  // O(1) within a list, linear in the range's length across lists.
+  void splice(const_iterator pos, List& rhs, const_iterator first,
+              const_iterator last){
+    if(first == last){
+      return;
+    }
+    if(!same_allocator(rhs)){
+      for(base_ptr cur = first.node_; cur != last.node_;){
+        base_ptr next = cur->next_;
+        move_node(pos.node_, rhs, cur);
+        cur = next;
+      }
+      return;
+    }
+    if(this != &rhs){
+      size_type n = 0;
+      for(base_ptr cur = first.node_; cur != last.node_; cur = cur->next_){
+        ++n;
+      }
+      size_ += n;
+      rhs.size_ -= n;
+    }
+    transfer(pos.node_, first.node_, last.node_);
+  }
 
-  // void splice(iterator pos, List& rhs, iterator it){
-  //   iterator next = it;
-  //   ++next;
-  //   if(pos == it || pos == next){
-  //     return;
-  //   }
-  //   transfer(pos, it, next);
-  //   ++size_;
-  //   --rhs.size_;
-  // }
+  // Merges the sorted rhs into this sorted list, leaving rhs empty. Stable:
+  // of equal elements, this list's come first.
+  void merge(List& rhs){
+    merge(rhs, std::less<T>());
+  }
 
-  // void splice(iterator pos, List& rhs, iterator first, iterator last){
-  //   if(first != last){
-  //     transfer(pos, first, last);
-  //     size_ += last - first;
-  //     rhs.size_ -= last - first;
-  //   }
-  // }
+  template <class Compare>
+  void merge(List& rhs, Compare comp){
+    if(this == &rhs){
+      return;
+    }
+    if(!same_allocator(rhs)){
+      base_ptr first1 = node_->next_;
+      while(!rhs.empty()){
+        base_ptr first2 = rhs.node_->next_;
+        while(first1 != node_ &&
+              !comp(first2->as_node()->data_, first1->as_node()->data_)){
+          first1 = first1->next_;
+        }
+        move_node(first1, rhs, first2);
+      }
+      return;
+    }
+    base_ptr first1 = node_->next_;
+    base_ptr first2 = rhs.node_->next_;
+    while(first1 != node_ && first2 != rhs.node_){
+      if(comp(first2->as_node()->data_, first1->as_node()->data_)){
+        // move the whole run of rhs's elements that goes before *first1
+        base_ptr next = first2->next_;
+        size_type n = 1;
+        while(next != rhs.node_ &&
+              comp(next->as_node()->data_, first1->as_node()->data_)){
+          next = next->next_;
+          ++n;
+        }
+        transfer(first1, first2, next);
+        size_ += n;
+        rhs.size_ -= n;
+        first2 = next;
+      }else{
+        first1 = first1->next_;
+      }
+    }
+    if(first2 != rhs.node_){
+      transfer(node_, first2, rhs.node_);
+      size_ += rhs.size_;
+      rhs.size_ = 0;
+    }
+  }
 
-  // void remove(const T& value){
-  //   iterator first = begin();
-  //   iterator last = end();
-  //   while(first != last){
-  //     iterator next = first;
-  //     ++next;
-  //     if(*first == value){
-  //       erase(first);
-  //     }
-  //     first = next;
-  //   }
-  // }
+  // return the number of elements removed. value may be one of them.
+  size_type remove(const T& value){
+    return remove_if([&value](const T& x){ return x == value; });
+  }
 
-  // void reverse(){
-  //   if(size_ == 0 || size_ == 1){
-  //     return;
-  //   }
-  //   iterator first = begin();
-  //   ++first;
-  //   while(first != end()){
-  //     iterator old = first;
-  //     ++first;
-  //     transfer(begin(), old, first);
-  //   }
-  // }
+  template <class Predicate>
+  size_type remove_if(Predicate pred){
+    removed_nodes removed(*this);
+    for(base_ptr cur = node_->next_; cur != node_;){
+      base_ptr next = cur->next_;
+      if(pred(cur->as_node()->data_)){
+        removed.take(cur);
+      }
+      cur = next;
+    }
+    return removed.count_;
+  }
 
-  // void unique(){
-  //   iterator first = begin();
-  //   iterator last = end();
-  //   if(first == last){
-  //     return;
-  //   }
-  //   iterator next = first;
-  //   while(++next != last){
-  //     if(*first == *next){
-  //       erase(next);
-  //     }else{
-  //       first = next;
-  //     }
-  //     next = first;
-  //   }
-  // }
+  // keeps the first of every run of equal consecutive elements
+  size_type unique(){
+    return unique(std::equal_to<T>());
+  }
+
+  template <class BinaryPredicate>
+  size_type unique(BinaryPredicate pred){
+    removed_nodes removed(*this);
+    if(size_ < 2){
+      return 0;
+    }
+    base_ptr kept = node_->next_;
+    for(base_ptr cur = kept->next_; cur != node_;){
+      base_ptr next = cur->next_;
+      if(pred(kept->as_node()->data_, cur->as_node()->data_)){
+        removed.take(cur);
+      }else{
+        kept = cur;
+      }
+      cur = next;
+    }
+    return removed.count_;
+  }
+
+  void reverse() noexcept {
+    base_ptr cur = node_;
+    do{
+      std::swap(cur->next_, cur->prev_);
+      cur = cur->prev_;
+    }while(cur != node_);
+  }
+
+  // Stable bottom-up merge sort, O(n log n) comparisons and O(1) memory.
+  //
+  // Ascending runs are cut off the front of the list and merged
+  // binary-counter style, bins[i] holding a merge of about 2^i runs, so
+  // sorted input is a single run and takes one pass. Merges write links
+  // only where they switch between their inputs. If comp throws, every
+  // node is put back in the list, in unspecified order.
+  void sort(){
+    sort(std::less<T>());
+  }
+
+  template <class Compare>
+  void sort(Compare comp){
+    if(size_ < 2){
+      return;
+    }
+    chain bins[64];
+    int used = 0;
+    chain run;
+    base_ptr rest = node_->next_;
+    node_->prev_->next_ = nullptr;
+    try{
+      while(rest != nullptr){
+        base_ptr run_last = rest;
+        while(run_last->next_ != nullptr &&
+              !comp(run_last->next_->as_node()->data_,
+                    run_last->as_node()->data_)){
+          run_last = run_last->next_;
+        }
+        run.first_ = rest;
+        run.last_ = run_last;
+        rest = run_last->next_;
+        run_last->next_ = nullptr;
+        int i = 0;
+        for(; i < used && bins[i].first_ != nullptr; ++i){
+          // bins[i] holds earlier elements: it goes on the left
+          merge_chains(bins[i], run, comp);
+          run = bins[i];
+          bins[i] = chain();
+        }
+        if(i == used){
+          ++used;
+        }
+        bins[i] = run;
+        run = chain();
+      }
+      for(int i = 0; i < used; ++i){
+        if(bins[i].first_ != nullptr){
+          if(run.first_ != nullptr){
+            merge_chains(bins[i], run, comp);
+          }
+          run = bins[i];
+          bins[i] = chain();
+        }
+      }
+    }catch(...){
+      base_ptr all = concat_chains(run.first_, rest);
+      for(int i = 0; i < used; ++i){
+        all = concat_chains(bins[i].first_, all);
+      }
+      relink_chain(all);
+      throw;
+    }
+    node_->next_ = run.first_;
+    run.first_->prev_ = node_;
+    node_->prev_ = run.last_;
+    run.last_->next_ = node_;
+  }
 
-  // void sort(){
-  //   if(size_ == 0 || size_ == 1){
-  //     return;
-  //   }
-  //   List carry;
-  //   List counter[64];
-  //   int fill = 0;
-  //   while(!empty()){
-  //     carry.splice(carry.begin(), *this, begin());
-  //     int i = 0;
-  //     while(i < fill && !counter[i].empty()){
-  //       counter[i].merge(carry);
-  //       carry.swap(counter[i++]);
-  //     }
-  //     carry.swap(counter[i]);
-  //     if(i == fill){
-  //       ++fill;
-  //     }
-  //   }
-  //   for(int i = 1; i < fill; ++i){
-  //     counter[i].merge(counter[i - 1]);
-  //   }
-  //   swap(counter[fill - 1]);
-  // }
 private:
+  // Moves [first, last) before pos. pos must not be inside the range.
+  static void transfer(base_ptr pos, base_ptr first, base_ptr last){
+    if(pos == last || pos == first){
+      return;
+    }
+    base_ptr range_last = last->prev_;
+    first->prev_->next_ = last;
+    last->prev_ = first->prev_;
+    base_ptr prev = pos->prev_;
+    prev->next_ = first;
+    first->prev_ = prev;
+    range_last->next_ = pos;
+    pos->prev_ = range_last;
+  }
+
+  // hands from's nodes over to the sentinel to, leaving from empty
+  static void take_nodes(base_ptr from, base_ptr to){
+    if(from->next_ == from){
+      to->unlink();
+      return;
+    }
+    to->next_ = from->next_;
+    to->prev_ = from->prev_;
+    to->next_->prev_ = to;
+    to->prev_->next_ = to;
+    from->unlink();
+  }
+
+  // A null-terminated run of nodes whose prev_ links are valid except for
+  // the first one's. Used by sort.
+  struct chain{
+    base_ptr first_ = nullptr;
+    base_ptr last_ = nullptr;
+  };
+
+  // Merges the sorted chain right into left, taking from left on ties.
+  // right is emptied. If comp throws, left holds every node of both, in
+  // some order, with only its next_ links valid.
+  template <class Compare>
+  static void merge_chains(chain& left, chain& right, Compare& comp){
+    list_node_base<T> head;
+    base_ptr tail = &head;
+    base_ptr a = left.first_;
+    base_ptr b = right.first_;
+    const base_ptr b_last = right.last_;
+    right = chain();
+    try{
+      while(a != nullptr && b != nullptr){
+        if(comp(b->as_node()->data_, a->as_node()->data_)){
+          tail->next_ = b;
+          b->prev_ = tail;
+          do{
+            tail = b;
+            b = b->next_;
+          }while(b != nullptr &&
+                 comp(b->as_node()->data_, a->as_node()->data_));
+        }else{
+          tail->next_ = a;
+          a->prev_ = tail;
+          do{
+            tail = a;
+            a = a->next_;
+          }while(a != nullptr &&
+                 !comp(b->as_node()->data_, a->as_node()->data_));
+        }
+      }
+    }catch(...){
+      tail->next_ = concat_chains(a, b);
+      left.first_ = head.next_;
+      throw;
+    }
+    if(a != nullptr){
+      tail->next_ = a;
+      a->prev_ = tail;
+    }else{
+      tail->next_ = b;
+      b->prev_ = tail;
+      left.last_ = b_last;
+    }
+    left.first_ = head.next_;
+  }
+
+  static base_ptr concat_chains(base_ptr first, base_ptr second){
+    if(first == nullptr){
+      return second;
+    }
+    base_ptr last = first;
+    while(last->next_ != nullptr){
+      last = last->next_;
+    }
+    last->next_ = second;
+    return first;
+  }
+
+  // makes the null-terminated chain first the list's nodes again
+  void relink_chain(base_ptr first){
+    base_ptr prev = node_;
+    for(base_ptr cur = first; cur != nullptr; cur = cur->next_){
+      cur->prev_ = prev;
+      prev->next_ = cur;
+      prev = cur;
+    }
+    prev->next_ = node_;
+    node_->prev_ = prev;
+  }
+
+  // Nodes unlinked by remove_if and unique, destroyed only when it goes out
+  // of scope: the value compared against may live in one of them.
+  struct removed_nodes{
+    List& list_;
+    base_ptr first_ = nullptr;
+    size_type count_ = 0;
+
+    explicit removed_nodes(List& list) : list_(list) {}
+    removed_nodes(const removed_nodes&) = delete;
+    removed_nodes& operator=(const removed_nodes&) = delete;
+
+    void take(base_ptr x){
+      x->prev_->next_ = x->next_;
+      x->next_->prev_ = x->prev_;
+      x->next_ = first_;
+      first_ = x;
+      --list_.size_;
+      ++count_;
+    }
+
+    ~removed_nodes(){
+      while(first_ != nullptr){
+        base_ptr tmp = first_;
+        first_ = first_->next_;
+        list_.node_alloc().destroy(tmp->as_node());
+        list_.node_alloc().deallocate(tmp->as_node());
+      }
+    }
+  };
+
   node_ptr create_node(const T& value){
-    node_ptr new_node = node_allocator::allocate(1);
-    node_allocator::construct(new_node, value);
+    node_ptr new_node = node_alloc().allocate(1);
+    try {
+      node_alloc().construct(new_node, value);
+    } catch (...) {
+      node_alloc().deallocate(new_node);
+      throw;
+    }
     return new_node;
   }
+
+  node_ptr create_node(T&& value){
+    node_ptr new_node = node_alloc().allocate(1);
+    try {
+      node_alloc().construct(new_node, std::move(value));
+    } catch (...) {
+      node_alloc().deallocate(new_node);
+      throw;
+    }
+    return new_node;
+  }
+
+  bool same_allocator(List& rhs){
+    return node_alloc() == rhs.node_alloc();
+  }
+
+  // moves x's element out of rhs into a new node of ours before pos, for
+  // lists whose allocators cannot free each other's nodes
+  void move_node(base_ptr pos, List& rhs, base_ptr x){
+    insert(iterator(pos), std::move(x->as_node()->data_));
+    rhs.erase(iterator(x));
+  }
   
 };
 
@@ -0,0 +1,242 @@
+#ifndef _TRACYSTL_MPMC_QUEUE_H_
+#define _TRACYSTL_MPMC_QUEUE_H_
+
+#include "allocator.h"
+#include "vector.h"
+#include <atomic>
+#include <cstddef> // For std::size_t
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tracystl {
+
+// Bounded multi-producer multi-consumer queue (Dmitry Vyukov's design).
+//
+// Every slot carries a sequence number telling whose turn it is:
+//   seq == pos            free, the producer holding ticket `pos` may write
+//   seq == pos + 1        full, the consumer holding ticket `pos` may read
+//   seq == pos + capacity free again, for the producer one lap later
+// Producers and consumers each share one counter. try_enqueue/try_dequeue
+// claim a ticket with a CAS only once the slot is ready, so they never block
+// and contend on a single cache line per side. enqueue/dequeue take a ticket
+// unconditionally and then sleep on the slot's sequence number with
+// std::atomic::wait (a futex on Linux) until its turn comes.
+//
+// The slots live in a Vector that is sized once in the constructor.
+template <class T, class Alloc = tracystl::Allocator<T>>
+class MpmcQueue {
+ public:
+  typedef T value_type;
+  typedef size_t size_type;
+  typedef Alloc allocator_type;
+
+ private:
+  struct slot {
+    std::atomic<size_type> seq_;
+    alignas(T) unsigned char storage_[sizeof(T)];
+
+    slot() noexcept : seq_(0) {}
+    // only used while the slot Vector is being built, before any element
+    // is stored, so there is no payload to carry over
+    slot(slot&& rhs) noexcept : seq_(rhs.seq_.load(std::memory_order_relaxed)) {}
+
+    T* value() noexcept { return reinterpret_cast<T*>(storage_); }
+  };
+  typedef typename Alloc::template rebind<slot>::other slot_allocator;
+
+  // once a ticket is claimed the slot has to be filled/emptied, there is no
+  // way to hand it back; throwing elements are built before claiming one
+  static_assert(std::is_nothrow_move_constructible<T>::value &&
+                    std::is_nothrow_move_assignable<T>::value,
+                "MpmcQueue elements must be nothrow movable");
+
+ public:
+  // capacity is rounded up to a power of two (at least 2)
+  explicit MpmcQueue(size_type capacity, const Alloc& alloc = Alloc());
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+  ~MpmcQueue();
+
+  size_type capacity() const noexcept { return mask_ + 1; }
+
+  // a snapshot, may be stale by the time it returns
+  size_type size_approx() const noexcept {
+    const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+    const size_type head = dequeue_pos_.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+  // non-blocking: false if the queue is full / empty
+  bool try_enqueue(const T& value) { return try_emplace(value); }
+  bool try_enqueue(T&& value) { return try_emplace(std::move(value)); }
+  template <class... Args>
+  bool try_emplace(Args&&... args);
+  bool try_dequeue(T& out);
+
+  // blocking: wait until there is room / an element
+  void enqueue(const T& value) { emplace(value); }
+  void enqueue(T&& value) { emplace(std::move(value)); }
+  template <class... Args>
+  void emplace(Args&&... args);
+  T dequeue();
+
+ private:
+  slot& slot_at(size_type pos) noexcept { return slots_[pos & mask_]; }
+
+  // blocks until s.seq_ == expected
+  void wait_for(slot& s, size_type expected) noexcept;
+  // publishes a new sequence number and wakes sleepers, if there are any
+  void publish(slot& s, size_type seq) noexcept;
+
+  Vector<slot, slot_allocator> slots_;
+  size_type mask_;
+  // number of threads sleeping in wait_for, so publish can skip the notify
+  std::atomic<size_type> waiters_;
+
+  alignas(TRACYSTL_CACHE_LINE_SIZE) std::atomic<size_type> enqueue_pos_;
+  alignas(TRACYSTL_CACHE_LINE_SIZE) std::atomic<size_type> dequeue_pos_;
+  alignas(TRACYSTL_CACHE_LINE_SIZE) char pad_[1] = {};
+};
+
+template <class T, class Alloc>
+MpmcQueue<T, Alloc>::MpmcQueue(size_type capacity, const Alloc& alloc)
+    : slots_(slot_allocator(alloc)), mask_(0), waiters_(0), enqueue_pos_(0),
+      dequeue_pos_(0) {
+  size_type rounded = 2;
+  while (rounded < capacity) {
+    rounded <<= 1;
+  }
+  slots_.resize(rounded);
+  for (size_type i = 0; i < rounded; ++i) {
+    slots_[i].seq_.store(i, std::memory_order_relaxed);
+  }
+  mask_ = rounded - 1;
+}
+
+template <class T, class Alloc>
+MpmcQueue<T, Alloc>::~MpmcQueue() {
+  // no other thread may use the queue any more: destroy what is left
+  const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+  for (size_type pos = dequeue_pos_.load(std::memory_order_relaxed); pos < tail;
+       ++pos) {
+    slot& s = slot_at(pos);
+    if (s.seq_.load(std::memory_order_relaxed) == pos + 1) {
+      s.value()->~T();
+    }
+  }
+}
+
+template <class T, class Alloc>
+template <class... Args>
+bool MpmcQueue<T, Alloc>::try_emplace(Args&&... args) {
+  if constexpr (!std::is_nothrow_constructible<T, Args&&...>::value) {
+    T value(std::forward<Args>(args)...);
+    return try_emplace(std::move(value));
+  } else {
+    size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      slot& s = slot_at(pos);
+      const size_type seq = s.seq_.load(std::memory_order_acquire);
+      const std::ptrdiff_t diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          ::new (static_cast<void*>(s.value())) T(std::forward<Args>(args)...);
+          publish(s, pos + 1);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;  // the slot still holds last lap's element: full
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+template <class T, class Alloc>
+bool MpmcQueue<T, Alloc>::try_dequeue(T& out) {
+  size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    slot& s = slot_at(pos);
+    const size_type seq = s.seq_.load(std::memory_order_acquire);
+    const std::ptrdiff_t diff =
+        static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+    if (diff == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        out = std::move(*s.value());
+        s.value()->~T();
+        publish(s, pos + capacity());
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;  // nothing written here yet: empty
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+template <class T, class Alloc>
+template <class... Args>
+void MpmcQueue<T, Alloc>::emplace(Args&&... args) {
+  if constexpr (!std::is_nothrow_constructible<T, Args&&...>::value) {
+    T value(std::forward<Args>(args)...);
+    emplace(std::move(value));
+  } else {
+    const size_type pos = enqueue_pos_.fetch_add(1, std::memory_order_relaxed);
+    slot& s = slot_at(pos);
+    wait_for(s, pos);
+    ::new (static_cast<void*>(s.value())) T(std::forward<Args>(args)...);
+    publish(s, pos + 1);
+  }
+}
+
+template <class T, class Alloc>
+T MpmcQueue<T, Alloc>::dequeue() {
+  const size_type pos = dequeue_pos_.fetch_add(1, std::memory_order_relaxed);
+  slot& s = slot_at(pos);
+  wait_for(s, pos + 1);
+  T result(std::move(*s.value()));
+  s.value()->~T();
+  publish(s, pos + capacity());
+  return result;
+}
+
+template <class T, class Alloc>
+void MpmcQueue<T, Alloc>::wait_for(slot& s, size_type expected) noexcept {
+  // a short spin first: under load the slot is usually ready within a few
+  // hundred cycles and sleeping would cost far more
+  for (int spin = 0; spin < 64; ++spin) {
+    if (s.seq_.load(std::memory_order_acquire) == expected) {
+      return;
+    }
+  }
+  // Registering as a waiter and re-reading seq_ are both seq_cst, as are the
+  // store and the waiters_ check in publish(), so either we see the new seq_
+  // or the publisher sees us and notifies.
+  waiters_.fetch_add(1, std::memory_order_seq_cst);
+  for (;;) {
+    const size_type seq = s.seq_.load(std::memory_order_seq_cst);
+    if (seq == expected) {
+      break;
+    }
+    s.seq_.wait(seq, std::memory_order_seq_cst);
+  }
+  waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template <class T, class Alloc>
+void MpmcQueue<T, Alloc>::publish(slot& s, size_type seq) noexcept {
+  s.seq_.store(seq, std::memory_order_seq_cst);
+  if (waiters_.load(std::memory_order_seq_cst) != 0) {
+    s.seq_.notify_all();
+  }
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_MPMC_QUEUE_H_
@@ -0,0 +1,405 @@
+#ifndef _TRACYSTL_PRIORITY_QUEUE_H_
+#define _TRACYSTL_PRIORITY_QUEUE_H_
+
+#include "allocator.h"
+#include "vector.h"
+#include <cassert>
+#include <cstddef> // For std::size_t
+#include <functional>
+#include <utility>
+
+namespace tracystl {
+
+namespace heap_detail {
+
+// D-ary max-heap primitives on a plain array: the children of i are
+// D * i + 1 ... D * i + D. A wider node makes the heap shallower, so a push
+// does fewer comparisons and a pop touches fewer cache lines: the D children
+// sit next to each other, one or two lines for small elements.
+//
+// Both sifts carry the moving value in a hole instead of swapping, one move
+// per level. moved(i) is called after every element that lands on index i,
+// so the indexed queue can keep its position table current.
+
+template <size_t D>
+constexpr size_t parent(size_t i) noexcept {
+  return (i - 1) / D;
+}
+
+template <size_t D, class T, class Less, class Moved>
+void sift_up(T* heap, size_t hole, T&& value, Less& less, Moved&& moved) {
+  while (hole > 0) {
+    const size_t p = parent<D>(hole);
+    if (!less(heap[p], value)) {
+      break;
+    }
+    heap[hole] = std::move(heap[p]);
+    moved(hole);
+    hole = p;
+  }
+  heap[hole] = std::move(value);
+  moved(hole);
+}
+
+// Index of the greatest of the children of hole; there is at least one.
+// The running best is picked with a select rather than a branch, since on
+// random keys the outcome of each comparison is a coin flip.
+template <size_t D, class T, class Less>
+size_t greatest_child(const T* heap, size_t n, size_t hole, Less& less) {
+  const size_t first = D * hole + 1;
+  size_t best = first;
+  if (first + D <= n) {
+    // a full set of children: a fixed trip count the compiler unrolls
+    for (size_t c = first + 1; c < first + D; ++c) {
+      best = less(heap[best], heap[c]) ? c : best;
+    }
+  } else {
+    for (size_t c = first + 1; c < n; ++c) {
+      best = less(heap[best], heap[c]) ? c : best;
+    }
+  }
+  return best;
+}
+
+template <size_t D, class T, class Less, class Moved>
+void sift_down(T* heap, size_t n, size_t hole, T&& value, Less& less,
+               Moved&& moved) {
+  while (D * hole + 1 < n) {
+    const size_t best = greatest_child<D>(heap, n, hole, less);
+    if (!less(value, heap[best])) {
+      break;
+    }
+    heap[hole] = std::move(heap[best]);
+    moved(hole);
+    hole = best;
+  }
+  heap[hole] = std::move(value);
+  moved(hole);
+}
+
+// sift_down for a value that most likely belongs near the bottom, such as
+// the last leaf that replaces a popped top: move the hole all the way down
+// along the greatest children without comparing against value, then sift
+// value up from there (Floyd). Saves one comparison per level.
+template <size_t D, class T, class Less, class Moved>
+void sift_down_from_leaf(T* heap, size_t n, size_t hole, T&& value,
+                         Less& less, Moved&& moved) {
+  const size_t start = hole;
+  while (D * hole + 1 < n) {
+    const size_t best = greatest_child<D>(heap, n, hole, less);
+    heap[hole] = std::move(heap[best]);
+    moved(hole);
+    hole = best;
+  }
+  while (hole > start) {
+    const size_t p = parent<D>(hole);
+    if (!less(heap[p], value)) {
+      break;
+    }
+    heap[hole] = std::move(heap[p]);
+    moved(hole);
+    hole = p;
+  }
+  heap[hole] = std::move(value);
+  moved(hole);
+}
+
+struct no_op {
+  void operator()(size_t) const noexcept {}
+};
+
+// Floyd's bottom-up construction, O(n)
+template <size_t D, class T, class Less>
+void make_heap(T* heap, size_t n, Less& less) {
+  if (n < 2) {
+    return;
+  }
+  for (size_t i = parent<D>(n - 1) + 1; i-- > 0;) {
+    T value = std::move(heap[i]);
+    sift_down<D>(heap, n, i, std::move(value), less, no_op());
+  }
+}
+
+}  // namespace heap_detail
+
+// A priority queue in a D-ary heap stored in a Vector. Like
+// std::priority_queue, top() is the greatest element under Compare, so
+// std::greater gives a min-queue (earliest deadline first).
+//
+// D = 4 halves the depth of a binary heap; a pop compares all four
+// children per level but they share a cache line, and a push, which only
+// walks up, does half the comparisons. Timer-like workloads, where most
+// pushes land near the bottom, profit most.
+template <class T, class Compare = std::less<T>, size_t D = 4,
+          class Alloc = tracystl::Allocator<T>>
+class PriorityQueue {
+  static_assert(D >= 2, "a heap needs at least two children per node");
+
+ public:
+  typedef T value_type;
+  typedef Compare value_compare;
+  typedef Vector<T, Alloc> container_type;
+  typedef size_t size_type;
+  typedef const T& const_reference;
+
+  static constexpr size_type arity = D;
+
+  PriorityQueue() = default;
+  explicit PriorityQueue(const Compare& comp) : comp_(comp) {}
+  // takes the elements over and heapifies them in O(n)
+  explicit PriorityQueue(container_type&& values,
+                         const Compare& comp = Compare())
+      : heap_(std::move(values)), comp_(comp) {
+    make_heap();
+  }
+  template <class InputIt>
+  PriorityQueue(InputIt first, InputIt last, const Compare& comp = Compare())
+      : comp_(comp) {
+    for (; first != last; ++first) {
+      heap_.push_back(*first);
+    }
+    make_heap();
+  }
+
+  bool empty() const noexcept { return heap_.empty(); }
+  size_type size() const noexcept { return heap_.size(); }
+  const_reference top() const noexcept {
+    assert(!empty());
+    return heap_.front();
+  }
+  void reserve(size_type n) { heap_.reserve(n); }
+  void clear() { heap_.clear(); }
+  // the heap in array order, e.g. to iterate without popping
+  const container_type& container() const noexcept { return heap_; }
+
+  void push(const T& value) { emplace(value); }
+  void push(T&& value) { emplace(std::move(value)); }
+  template <class... Args>
+  void emplace(Args&&... args) {
+    heap_.emplace_back(std::forward<Args>(args)...);
+    // the new slot becomes the hole that sift_up carries upward
+    T value = std::move(heap_.back());
+    heap_detail::sift_up<D>(&heap_[0], heap_.size() - 1, std::move(value),
+                            comp_, heap_detail::no_op());
+  }
+  void pop() {
+    assert(!empty());
+    T last = std::move(heap_.back());
+    heap_.pop_back();
+    if (!heap_.empty()) {
+      heap_detail::sift_down_from_leaf<D>(&heap_[0], heap_.size(), 0,
+                                          std::move(last), comp_,
+                                          heap_detail::no_op());
+    }
+  }
+  // removes the top element and returns it, for move-only element types
+  T take_top() {
+    assert(!empty());
+    T result = std::move(heap_[0]);
+    pop();
+    return result;
+  }
+
+ private:
+  void make_heap() {
+    heap_detail::make_heap<D>(heap_.empty() ? nullptr : &heap_[0],
+                              heap_.size(), comp_);
+  }
+
+  container_type heap_;
+  Compare comp_;
+};
+
+// A PriorityQueue whose push returns a handle that stays valid until the
+// element leaves the queue, so an element can be re-prioritized or removed
+// in O(log n) without searching for it: a timer keeps the handle of its
+// expiry and cancels or reschedules through it.
+//
+// A position table maps each handle to the element's index in the heap and
+// is updated on every move; handles of removed elements are reused.
+// decrease_key moves an element toward the top, i.e. to a smaller key in a
+// min-queue (Compare = std::greater); increase_key moves it away from it;
+// update does either.
+template <class T, class Compare = std::less<T>, size_t D = 4,
+          class Alloc = tracystl::Allocator<T>>
+class IndexedPriorityQueue {
+  static_assert(D >= 2, "a heap needs at least two children per node");
+
+ public:
+  typedef T value_type;
+  typedef Compare value_compare;
+  typedef size_t size_type;
+  typedef size_t handle;
+  typedef const T& const_reference;
+
+  static constexpr size_type arity = D;
+
+  IndexedPriorityQueue() = default;
+  explicit IndexedPriorityQueue(const Compare& comp) : less_{comp} {}
+
+  bool empty() const noexcept { return heap_.empty(); }
+  size_type size() const noexcept { return heap_.size(); }
+  const_reference top() const noexcept {
+    assert(!empty());
+    return heap_.front().value;
+  }
+  handle top_handle() const noexcept {
+    assert(!empty());
+    return heap_.front().id;
+  }
+  // whether h names an element that is still in the queue
+  bool contains(handle h) const noexcept {
+    return h < position_.size() && position_[h] != free_slot;
+  }
+  const_reference operator[](handle h) const noexcept {
+    assert(contains(h));
+    return heap_[position_[h]].value;
+  }
+  void reserve(size_type n) {
+    heap_.reserve(n);
+    position_.reserve(n);
+    free_.reserve(n);
+  }
+  void clear();
+
+  handle push(const T& value) { return emplace(value); }
+  handle push(T&& value) { return emplace(std::move(value)); }
+  template <class... Args>
+  handle emplace(Args&&... args);
+  void pop() { erase(top_handle()); }
+  T take_top() {
+    assert(!empty());
+    T result = std::move(heap_[0].value);
+    pop();
+    return result;
+  }
+
+  // removes the element named by h; h may be reused by a later push
+  void erase(handle h);
+  // value must not be ordered below the current one
+  void decrease_key(handle h, T value) {
+    assert(contains(h) && !less_.comp(value, (*this)[h]));
+    entry e{std::move(value), h};
+    sift_up(position_[h], std::move(e));
+  }
+  // value must not be ordered above the current one
+  void increase_key(handle h, T value) {
+    assert(contains(h) && !less_.comp((*this)[h], value));
+    entry e{std::move(value), h};
+    sift_down(position_[h], std::move(e));
+  }
+  void update(handle h, T value) {
+    assert(contains(h));
+    const size_t i = position_[h];
+    entry e{std::move(value), h};
+    if (i > 0 && less_(heap_[heap_detail::parent<D>(i)], e)) {
+      sift_up(i, std::move(e));
+    } else {
+      sift_down(i, std::move(e));
+    }
+  }
+
+ private:
+  static constexpr size_t free_slot = static_cast<size_t>(-1);
+
+  struct entry {
+    T value;
+    handle id;
+  };
+  typedef typename Alloc::template rebind<entry>::other entry_allocator;
+  typedef typename Alloc::template rebind<size_t>::other index_allocator;
+
+  struct entry_less {
+    bool operator()(const entry& a, const entry& b) const {
+      return comp(a.value, b.value);
+    }
+    Compare comp;
+  };
+
+  // records where the entry now at index i lives
+  struct track {
+    void operator()(size_t i) const noexcept {
+      position[heap[i].id] = i;
+    }
+    entry* heap;
+    size_t* position;
+  };
+  track tracker() noexcept { return track{&heap_[0], &position_[0]}; }
+
+  void sift_up(size_t hole, entry&& e) {
+    heap_detail::sift_up<D>(&heap_[0], hole, std::move(e), less_, tracker());
+  }
+  void sift_down(size_t hole, entry&& e) {
+    heap_detail::sift_down<D>(&heap_[0], heap_.size(), hole, std::move(e),
+                              less_, tracker());
+  }
+
+  Vector<entry, entry_allocator> heap_;
+  // handle -> index in heap_, or free_slot
+  Vector<size_t, index_allocator> position_;
+  // handles whose elements are gone, for reuse; kept at least as large as
+  // position_'s capacity so that erase never allocates
+  Vector<size_t, index_allocator> free_;
+  entry_less less_{};
+};
+
+template <class T, class Compare, size_t D, class Alloc>
+template <class... Args>
+typename IndexedPriorityQueue<T, Compare, D, Alloc>::handle
+IndexedPriorityQueue<T, Compare, D, Alloc>::emplace(Args&&... args) {
+  entry e{T(std::forward<Args>(args)...), 0};
+  if (free_.empty()) {
+    position_.push_back(free_slot);
+    e.id = position_.size() - 1;
+  } else {
+    e.id = free_.back();
+  }
+  const handle h = e.id;
+  try {
+    free_.reserve(position_.capacity());
+    heap_.emplace_back(std::move(e));
+  } catch (...) {
+    if (free_.empty()) {
+      position_.pop_back();
+    }
+    throw;
+  }
+  if (!free_.empty()) {
+    free_.pop_back();
+  }
+  entry moving = std::move(heap_.back());
+  sift_up(heap_.size() - 1, std::move(moving));
+  return h;
+}
+
+template <class T, class Compare, size_t D, class Alloc>
+void IndexedPriorityQueue<T, Compare, D, Alloc>::erase(handle h) {
+  assert(contains(h));
+  const size_t i = position_[h];
+  position_[h] = free_slot;
+  free_.push_back(h);
+  entry last = std::move(heap_.back());
+  heap_.pop_back();
+  if (i == heap_.size()) {
+    return;
+  }
+  // the last entry fills the gap and may need to go either way; coming
+  // from the bottom, it most likely goes back down all the way
+  if (i > 0 && less_(heap_[heap_detail::parent<D>(i)], last)) {
+    sift_up(i, std::move(last));
+  } else {
+    heap_detail::sift_down_from_leaf<D>(&heap_[0], heap_.size(), i,
+                                        std::move(last), less_, tracker());
+  }
+}
+
+template <class T, class Compare, size_t D, class Alloc>
+void IndexedPriorityQueue<T, Compare, D, Alloc>::clear() {
+  heap_.clear();
+  position_.clear();
+  free_.clear();
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_PRIORITY_QUEUE_H_
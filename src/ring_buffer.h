@@ -0,0 +1,251 @@
+#ifndef _TRACYSTL_RING_BUFFER_H_
+#define _TRACYSTL_RING_BUFFER_H_
+
+#include "allocator.h"
+#include "type_traits.h"
+#include <atomic>
+#include <cstddef> // For std::size_t
+#include <cstring> // For std::memcpy
+#include <new>
+#include <utility>
+
+namespace tracystl {
+
+// Bounded single-producer single-consumer queue over a power-of-two array of
+// slots. Exactly one thread may call the try_push* functions and exactly one
+// (other) thread the try_pop* functions.
+//
+// head_ and tail_ are free running counters (slot = counter & mask_), so full
+// and empty are told apart without wasting a slot. The producer publishes
+// elements with a release store of tail_ and the consumer frees slots with a
+// release store of head_; each side reads the other's counter with acquire.
+// Each side also caches the last value it saw of the other side's counter and
+// only reloads it (a cache miss on the shared line) when the cached value says
+// the queue is full/empty.
+//
+// spsc_ring holds the algorithm; RingBuffer<T, N> and SpscQueue<T> only
+// provide the slot storage. Queues are neither copyable nor movable.
+template <class T>
+class spsc_ring {
+ public:
+  typedef T value_type;
+  typedef size_t size_type;
+
+  spsc_ring(const spsc_ring&) = delete;
+  spsc_ring& operator=(const spsc_ring&) = delete;
+
+  size_type capacity() const noexcept { return mask_ + 1; }
+
+  // exact when called from either end while the other end is idle,
+  // otherwise a snapshot
+  size_type size_approx() const noexcept {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+  bool empty_approx() const noexcept { return size_approx() == 0; }
+
+  // producer side
+  bool try_push(const T& value) { return try_emplace(value); }
+  bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  template <class... Args>
+  bool try_emplace(Args&&... args);
+
+  // Pushes up to n elements moved from [src, src + n) and returns how many
+  // fit. They are copied as at most two contiguous spans (memcpy for
+  // trivially copyable T) and published with a single release store.
+  size_type try_push_n(T* src, size_type n);
+
+  // consumer side
+  bool try_pop(T& out);
+
+  // Pops up to n elements into raw storage at dst (they are move
+  // constructed there) and returns how many were popped.
+  size_type try_pop_n(T* dst, size_type n);
+
+  // the oldest element, or nullptr if empty; valid until the next pop
+  T* front() noexcept {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return nullptr;
+      }
+    }
+    return slot(head);
+  }
+
+ protected:
+  spsc_ring(T* slots, size_type capacity) noexcept
+      : slots_(slots), mask_(capacity - 1), head_(0), cached_tail_(0),
+        tail_(0), cached_head_(0) {}
+  ~spsc_ring() { destroy_all(); }
+
+  // destroys the queued elements; no other thread may touch the queue
+  void destroy_all() noexcept {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    size_type head = head_.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+      slot(head)->~T();
+    }
+    head_.store(head, std::memory_order_relaxed);
+  }
+
+  T* slots() const noexcept { return slots_; }
+
+ private:
+  T* slot(size_type index) const noexcept { return slots_ + (index & mask_); }
+
+  // moves n elements between the ring and a plain array
+  static void move_into_raw(T* dst, T* src, size_type n) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      if (n != 0) {
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                    n * sizeof(T));
+      }
+    } else {
+      for (size_type i = 0; i < n; ++i) {
+        ::new (static_cast<void*>(dst + i)) T(std::move(src[i]));
+      }
+    }
+  }
+
+  // shared, read-only after construction
+  T* const slots_;
+  const size_type mask_;
+
+  // consumer line
+  alignas(TRACYSTL_CACHE_LINE_SIZE) std::atomic<size_type> head_;
+  size_type cached_tail_;
+
+  // producer line
+  alignas(TRACYSTL_CACHE_LINE_SIZE) std::atomic<size_type> tail_;
+  size_type cached_head_;
+
+  // keep whatever follows the queue off the producer line
+  alignas(TRACYSTL_CACHE_LINE_SIZE) char pad_[1] = {};
+};
+
+template <class T>
+template <class... Args>
+bool spsc_ring<T>::try_emplace(Args&&... args) {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  if (tail - cached_head_ == capacity()) {
+    cached_head_ = head_.load(std::memory_order_acquire);
+    if (tail - cached_head_ == capacity()) {
+      return false;
+    }
+  }
+  ::new (static_cast<void*>(slot(tail))) T(std::forward<Args>(args)...);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template <class T>
+typename spsc_ring<T>::size_type spsc_ring<T>::try_push_n(T* src, size_type n) {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  size_type free_slots = capacity() - (tail - cached_head_);
+  if (free_slots < n) {
+    cached_head_ = head_.load(std::memory_order_acquire);
+    free_slots = capacity() - (tail - cached_head_);
+  }
+  if (n > free_slots) {
+    n = free_slots;
+  }
+  if (n == 0) {
+    return 0;
+  }
+  // [tail, tail + n) may wrap around the end of the array
+  const size_type first = tail & mask_;
+  const size_type first_span = n < capacity() - first ? n : capacity() - first;
+  move_into_raw(slots_ + first, src, first_span);
+  move_into_raw(slots_, src + first_span, n - first_span);
+  tail_.store(tail + n, std::memory_order_release);
+  return n;
+}
+
+template <class T>
+bool spsc_ring<T>::try_pop(T& out) {
+  T* value = front();
+  if (value == nullptr) {
+    return false;
+  }
+  out = std::move(*value);
+  value->~T();
+  head_.store(head_.load(std::memory_order_relaxed) + 1,
+              std::memory_order_release);
+  return true;
+}
+
+template <class T>
+typename spsc_ring<T>::size_type spsc_ring<T>::try_pop_n(T* dst, size_type n) {
+  const size_type head = head_.load(std::memory_order_relaxed);
+  size_type available = cached_tail_ - head;
+  if (available < n) {
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    available = cached_tail_ - head;
+  }
+  if (n > available) {
+    n = available;
+  }
+  if (n == 0) {
+    return 0;
+  }
+  const size_type first = head & mask_;
+  const size_type first_span = n < capacity() - first ? n : capacity() - first;
+  move_into_raw(dst, slots_ + first, first_span);
+  move_into_raw(dst + first_span, slots_, n - first_span);
+  if constexpr (!std::is_trivially_destructible<T>::value) {
+    for (size_type i = 0; i < n; ++i) {
+      slot(head + i)->~T();
+    }
+  }
+  head_.store(head + n, std::memory_order_release);
+  return n;
+}
+
+// A ring with N inline slots, N a power of two. No allocation at all.
+template <class T, size_t N>
+class RingBuffer : public spsc_ring<T> {
+  static_assert(N != 0 && (N & (N - 1)) == 0, "N must be a power of two");
+
+ public:
+  RingBuffer() noexcept
+      : spsc_ring<T>(reinterpret_cast<T*>(storage_), N) {}
+  // the elements must go while storage_ is still alive
+  ~RingBuffer() { this->destroy_all(); }
+
+ private:
+  alignas(T) unsigned char storage_[N * sizeof(T)];
+};
+
+// A ring whose capacity is chosen at run time (rounded up to a power of two)
+// and allocated once through Alloc.
+template <class T, class Alloc = tracystl::Allocator<T>>
+class SpscQueue : private allocator_holder<Alloc>, public spsc_ring<T> {
+ public:
+  typedef Alloc allocator_type;
+
+  explicit SpscQueue(size_t capacity, const Alloc& alloc = Alloc())
+      : allocator_holder<Alloc>(alloc),
+        spsc_ring<T>(allocator_holder<Alloc>::alloc().allocate(round_up(capacity)),
+                     round_up(capacity)) {}
+  ~SpscQueue() {
+    // the elements must go before the slots do
+    this->destroy_all();
+    allocator_holder<Alloc>::alloc().deallocate(this->slots(), this->capacity());
+  }
+
+ private:
+  static size_t round_up(size_t n) {
+    size_t capacity = 1;
+    while (capacity < n) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+};
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_RING_BUFFER_H_
@@ -0,0 +1,345 @@
+#ifndef _TRACYSTL_SMALL_VECTOR_H_
+#define _TRACYSTL_SMALL_VECTOR_H_
+
+#include "allocator.h"
+#include "uninitialized.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstddef> // For std::size_t
+#include <utility>
+
+namespace tracystl {
+
+// A Vector that keeps its first N elements inside the object itself and only
+// allocates once it grows past N. The interface is the one of Vector, so a
+// typedef is enough to switch a call site over.
+//
+// Moving a SmallVector whose elements are inline has to relocate them (O(N))
+// instead of stealing a pointer; and swap is three moves. Iterators are
+// invalidated by a move, even for heap storage.
+template <class T, size_t N, class Alloc = tracystl::Allocator<T>,
+          class GrowthPolicy = vector_growth_2x>
+class SmallVector : private allocator_holder<Alloc> {
+  static_assert(N > 0, "use Vector for N == 0");
+
+ public:
+  typedef T value_type;
+  typedef value_type* iterator;
+  typedef Alloc allocator_type;
+  typedef typename allocator_type::size_type size_type;
+  typedef typename allocator_type::reference reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+  typedef Alloc data_allocator;
+  typedef const value_type* const_iterator;
+  typedef GrowthPolicy growth_policy;
+
+  static constexpr size_type inline_capacity = N;
+
+ private:
+  typedef allocator_holder<Alloc> alloc_base;
+  using alloc_base::alloc;
+
+  iterator begin_;
+  iterator end_;
+  iterator capacity_;
+  alignas(T) unsigned char inline_[N * sizeof(T)];
+
+ public:
+  SmallVector() noexcept
+      : begin_(inline_data()), end_(begin_), capacity_(begin_ + N) {}
+  explicit SmallVector(const allocator_type& a)
+      : alloc_base(a), begin_(inline_data()), end_(begin_),
+        capacity_(begin_ + N) {}
+  explicit SmallVector(size_type n, const allocator_type& a = allocator_type())
+      : SmallVector(a) {
+    resize(n);
+  }
+  SmallVector(size_type n, const value_type& value,
+              const allocator_type& a = allocator_type())
+      : SmallVector(a) {
+    resize(n, value);
+  }
+  SmallVector(const SmallVector& rhs) : SmallVector(rhs.alloc()) {
+    reserve(rhs.size());
+    for (const_iterator it = rhs.begin(); it != rhs.end(); ++it) {
+      alloc().construct(end_, *it);
+      ++end_;
+    }
+  }
+  SmallVector(SmallVector&& rhs) noexcept(
+      std::is_nothrow_move_constructible<T>::value)
+      : alloc_base(std::move(rhs.alloc())), begin_(inline_data()),
+        end_(begin_), capacity_(begin_ + N) {
+    take(rhs);
+  }
+  ~SmallVector() {
+    alloc().destroy(begin_, end_);
+    free_heap();
+  }
+
+  SmallVector& operator=(const SmallVector& rhs);
+  SmallVector& operator=(SmallVector&& rhs) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this != &rhs) {
+      clear();
+      free_heap();
+      begin_ = end_ = inline_data();
+      capacity_ = begin_ + N;
+      alloc() = std::move(rhs.alloc());
+      take(rhs);
+    }
+    return *this;
+  }
+
+  void swap(SmallVector& rhs) {
+    SmallVector tmp(std::move(rhs));
+    rhs = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  allocator_type get_allocator() const { return alloc(); }
+
+  iterator begin() { return begin_; }
+  const_iterator begin() const noexcept { return begin_; }
+
+  iterator end() { return end_; }
+  const_iterator end() const noexcept { return end_; }
+
+  pointer data() noexcept { return begin_; }
+  const_pointer data() const noexcept { return begin_; }
+
+  size_t size() const { return static_cast<size_type>(end_ - begin_); }
+  size_t capacity() const { return static_cast<size_type>(capacity_ - begin_); }
+
+  bool empty() const { return begin_ == end_; }
+
+  // true while the elements live in the inline buffer
+  bool is_inline() const noexcept { return begin_ == inline_data(); }
+
+  reference operator[](size_t n) { return *(begin_ + n); }
+  const_reference operator[](size_t n) const { return *(begin_ + n); }
+
+  // capacity
+  void reserve(size_type n) {
+    if (n > capacity()) {
+      reallocate(n);
+    }
+  }
+  // moves the elements back inline when they fit
+  void shrink_to_fit() {
+    if (is_inline() || end_ == capacity_) {
+      return;
+    }
+    if (size() <= N) {
+      move_to(inline_data(), N);
+    } else {
+      reallocate(size());
+    }
+  }
+  void resize(size_type n);
+  void resize(size_type n, const value_type& value);
+
+  // destroys the elements but keeps the buffer
+  void clear() {
+    alloc().destroy(begin_, end_);
+    end_ = begin_;
+  }
+
+  void push_back(const value_type& value) { emplace_back(value); }
+  void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+  template <class... Args>
+  reference emplace_back(Args&&... args);
+
+  void pop_back() {
+    --end_;
+    alloc().destroy(end_);
+  }
+
+  reference front() { return *begin_; }
+  const_reference front() const { return *begin_; }
+  reference back() { return *(end_ - 1); }
+  const_reference back() const { return *(end_ - 1); }
+
+  // Same as Vector: inserts before pos and returns an iterator to the new
+  // element, shifting the tail up by one.
+  iterator insert(const_iterator pos, const value_type& value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, value_type&& value) {
+    return emplace(pos, std::move(value));
+  }
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+
+  // erase returns an iterator to the element that followed the erased ones
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last);
+
+ private:
+  iterator inline_data() noexcept { return reinterpret_cast<iterator>(inline_); }
+  const_iterator inline_data() const noexcept {
+    return reinterpret_cast<const_iterator>(inline_);
+  }
+
+  void free_heap() noexcept {
+    if (!is_inline()) {
+      alloc().deallocate(begin_, capacity());
+    }
+  }
+
+  // *this is empty and inline: adopt rhs's heap buffer or relocate its
+  // inline elements, leaving rhs empty and inline
+  void take(SmallVector& rhs) {
+    if (rhs.is_inline()) {
+      end_ = tracystl::uninitialized_relocate(rhs.begin_, rhs.end_, begin_);
+    } else {
+      begin_ = rhs.begin_;
+      end_ = rhs.end_;
+      capacity_ = rhs.capacity_;
+      rhs.begin_ = rhs.inline_data();
+      rhs.capacity_ = rhs.begin_ + N;
+    }
+    rhs.end_ = rhs.begin_;
+  }
+
+  // relocates the elements into new_begin (inline or freshly allocated)
+  void move_to(iterator new_begin, size_type new_capacity) {
+    const size_type old_size = size();
+    tracystl::uninitialized_relocate(begin_, end_, new_begin);
+    tracystl::notify_reallocate(alloc(), capacity() * sizeof(T),
+                                new_capacity * sizeof(T));
+    free_heap();
+    begin_ = new_begin;
+    end_ = new_begin + old_size;
+    capacity_ = new_begin + new_capacity;
+  }
+
+  void reallocate(size_type new_capacity) {
+    iterator new_begin = alloc().allocate(new_capacity);
+    try {
+      move_to(new_begin, new_capacity);
+    } catch (...) {
+      alloc().deallocate(new_begin, new_capacity);
+      throw;
+    }
+  }
+};
+
+template <class T, size_t N, class Alloc, class GrowthPolicy>
+SmallVector<T, N, Alloc, GrowthPolicy>&
+SmallVector<T, N, Alloc, GrowthPolicy>::operator=(const SmallVector& rhs) {
+  if (this != &rhs) {
+    if (rhs.size() > capacity()) {
+      SmallVector tmp(rhs);
+      *this = std::move(tmp);
+    } else {
+      clear();
+      for (const_iterator it = rhs.begin(); it != rhs.end(); ++it) {
+        alloc().construct(end_, *it);
+        ++end_;
+      }
+    }
+  }
+  return *this;
+}
+
+template <class T, size_t N, class Alloc, class GrowthPolicy>
+void SmallVector<T, N, Alloc, GrowthPolicy>::resize(size_type n) {
+  if (n < size()) {
+    alloc().destroy(begin_ + n, end_);
+    end_ = begin_ + n;
+    return;
+  }
+  reserve(n);
+  for (; end_ != begin_ + n; ++end_) {
+    alloc().construct(end_);
+  }
+}
+
+template <class T, size_t N, class Alloc, class GrowthPolicy>
+void SmallVector<T, N, Alloc, GrowthPolicy>::resize(size_type n,
+                                                    const value_type& value) {
+  if (n < size()) {
+    alloc().destroy(begin_ + n, end_);
+    end_ = begin_ + n;
+    return;
+  }
+  // value may live in our buffer, so copy it before the buffer moves
+  value_type copy(value);
+  reserve(n);
+  for (; end_ != begin_ + n; ++end_) {
+    alloc().construct(end_, copy);
+  }
+}
+
+// Same as Vector: the new element is built before the old ones are
+// relocated, since args may point into the buffer.
+template <class T, size_t N, class Alloc, class GrowthPolicy>
+template <class... Args>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::reference
+SmallVector<T, N, Alloc, GrowthPolicy>::emplace_back(Args&&... args) {
+  if (end_ != capacity_) {
+    alloc().construct(end_, std::forward<Args>(args)...);
+    ++end_;
+    return back();
+  }
+  const size_type old_size = size();
+  const size_type new_capacity =
+      GrowthPolicy::next_capacity(capacity(), old_size + 1);
+  iterator new_begin = alloc().allocate(new_capacity);
+  try {
+    alloc().construct(new_begin + old_size, std::forward<Args>(args)...);
+  } catch (...) {
+    alloc().deallocate(new_begin, new_capacity);
+    throw;
+  }
+  try {
+    move_to(new_begin, new_capacity);
+  } catch (...) {
+    alloc().destroy(new_begin + old_size);
+    alloc().deallocate(new_begin, new_capacity);
+    throw;
+  }
+  ++end_;
+  return back();
+}
+
+template <class T, size_t N, class Alloc, class GrowthPolicy>
+template <class... Args>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::iterator
+SmallVector<T, N, Alloc, GrowthPolicy>::emplace(const_iterator pos,
+                                                Args&&... args) {
+  const size_type index = static_cast<size_type>(pos - begin_);
+  if (pos == end_) {
+    emplace_back(std::forward<Args>(args)...);
+    return begin_ + index;
+  }
+  // args may refer to an element that is about to be shifted
+  value_type value(std::forward<Args>(args)...);
+  if (end_ == capacity_) {
+    reserve(GrowthPolicy::next_capacity(capacity(), size() + 1));
+  }
+  iterator p = begin_ + index;
+  tracystl::shift_insert(p, end_, std::move(value));
+  ++end_;
+  return p;
+}
+
+template <class T, size_t N, class Alloc, class GrowthPolicy>
+typename SmallVector<T, N, Alloc, GrowthPolicy>::iterator
+SmallVector<T, N, Alloc, GrowthPolicy>::erase(const_iterator first,
+                                              const_iterator last) {
+  iterator f = begin_ + (first - begin_);
+  iterator l = begin_ + (last - begin_);
+  if (f != l) {
+    end_ = tracystl::shift_erase(f, l, end_);
+  }
+  return f;
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_SMALL_VECTOR_H_
@@ -0,0 +1,709 @@
+#ifndef _TRACYSTL_SORT_H_
+#define _TRACYSTL_SORT_H_
+
+#include "allocator.h"
+#include "iterator.h"
+#include "vector.h"
+#include <algorithm> // For std::reverse
+#include <cstddef> // For std::size_t, std::ptrdiff_t
+#include <cstdint>
+#include <cstring> // For std::memcpy
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace tracystl {
+
+// Sorting for random access iterators (Vector iterators, raw pointers,
+// Deque iterators):
+//
+//   sort         pattern-defeating quicksort (pdqsort): introsort whose
+//                partitions detect sorted runs and equal keys, and shuffle
+//                inputs that keep producing bad pivots before falling back
+//                to heapsort. Arithmetic keys with std::less/std::greater
+//                are partitioned without data dependent branches.
+//   stable_sort  merge sort with a buffer of n/2 elements from the
+//                allocator; already ordered halves are not merged.
+//   radix_sort   LSD radix sort for integer and floating point values of
+//                contiguous ranges; digits that are the same in every key
+//                are skipped.
+
+namespace sort_detail {
+
+// below this size insertion sort beats partitioning
+constexpr std::ptrdiff_t insertion_sort_threshold = 24;
+// above this size the pivot is a median of three medians of three
+constexpr std::ptrdiff_t ninther_threshold = 128;
+// moves partial_insertion_sort may make before it gives up
+constexpr std::ptrdiff_t partial_insertion_sort_limit = 8;
+// elements classified per block by the branchless partition
+constexpr std::ptrdiff_t block_size = 64;
+
+template <class It>
+using value_type_t = typename iterator_traits<It>::value_type;
+
+// Comparators for which the branchless partition pays off: comparing is
+// cheap and branch free, so only the branch on its result is left to avoid.
+template <class Compare, class T>
+constexpr bool is_cheap_comparison =
+    std::is_arithmetic<T>::value &&
+    (std::is_same<Compare, std::less<T>>::value ||
+     std::is_same<Compare, std::less<>>::value ||
+     std::is_same<Compare, std::greater<T>>::value ||
+     std::is_same<Compare, std::greater<>>::value);
+
+inline int log2(size_t n) {
+  int log = 0;
+  while (n >>= 1) {
+    ++log;
+  }
+  return log;
+}
+
+template <class It, class Compare>
+void insertion_sort(It begin, It end, Compare& comp) {
+  if (begin == end) {
+    return;
+  }
+  for (It cur = begin + 1; cur != end; ++cur) {
+    It sift = cur;
+    It sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      value_type_t<It> tmp(std::move(*sift));
+      do {
+        *sift-- = std::move(*sift_1);
+      } while (sift != begin && comp(tmp, *--sift_1));
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+// Same, but *(begin - 1) must not be greater than any element of the range,
+// so it stops the sifting without a bounds check.
+template <class It, class Compare>
+void unguarded_insertion_sort(It begin, It end, Compare& comp) {
+  if (begin == end) {
+    return;
+  }
+  for (It cur = begin + 1; cur != end; ++cur) {
+    It sift = cur;
+    It sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      value_type_t<It> tmp(std::move(*sift));
+      do {
+        *sift-- = std::move(*sift_1);
+      } while (comp(tmp, *--sift_1));
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+// Insertion sort that gives up, returning false, once it has moved more
+// than partial_insertion_sort_limit elements. Cheap on nearly sorted input.
+template <class It, class Compare>
+bool partial_insertion_sort(It begin, It end, Compare& comp) {
+  if (begin == end) {
+    return true;
+  }
+  std::ptrdiff_t moved = 0;
+  for (It cur = begin + 1; cur != end; ++cur) {
+    It sift = cur;
+    It sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      value_type_t<It> tmp(std::move(*sift));
+      do {
+        *sift-- = std::move(*sift_1);
+      } while (sift != begin && comp(tmp, *--sift_1));
+      *sift = std::move(tmp);
+      moved += cur - sift;
+      if (moved > partial_insertion_sort_limit) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <class It, class Compare>
+void sort2(It a, It b, Compare& comp) {
+  if (comp(*b, *a)) {
+    std::iter_swap(a, b);
+  }
+}
+
+template <class It, class Compare>
+void sort3(It a, It b, It c, Compare& comp) {
+  sort2(a, b, comp);
+  sort2(b, c, comp);
+  sort2(a, b, comp);
+}
+
+template <class It, class Compare>
+void sift_down(It begin, std::ptrdiff_t size, std::ptrdiff_t hole,
+               Compare& comp) {
+  value_type_t<It> value(std::move(begin[hole]));
+  for (std::ptrdiff_t child = 2 * hole + 1; child < size;
+       child = 2 * hole + 1) {
+    if (child + 1 < size && comp(begin[child], begin[child + 1])) {
+      ++child;
+    }
+    if (!comp(value, begin[child])) {
+      break;
+    }
+    begin[hole] = std::move(begin[child]);
+    hole = child;
+  }
+  begin[hole] = std::move(value);
+}
+
+// the O(n log n) guarantee once pivots keep going bad
+template <class It, class Compare>
+void heap_sort(It begin, It end, Compare& comp) {
+  const std::ptrdiff_t size = end - begin;
+  for (std::ptrdiff_t i = size / 2; i-- > 0;) {
+    sift_down(begin, size, i, comp);
+  }
+  for (std::ptrdiff_t last = size - 1; last > 0; --last) {
+    std::iter_swap(begin, begin + last);
+    sift_down(begin, last, 0, comp);
+  }
+}
+
+// Partitions [begin, end) around the pivot *begin: elements less than it
+// end up on its left, the others on its right. Returns the pivot's final
+// position and whether the range was already partitioned (no swaps).
+// Needs an element not less than the pivot somewhere after it, which
+// median of three selection guarantees.
+template <class It, class Compare>
+std::pair<It, bool> partition_right(It begin, It end, Compare& comp) {
+  value_type_t<It> pivot(std::move(*begin));
+  It first = begin;
+  It last = end;
+  while (comp(*++first, pivot)) {
+  }
+  // nothing guarantees an element less than the pivot if *first was the
+  // very first one looked at
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+  const bool already_partitioned = first >= last;
+  while (first < last) {
+    std::iter_swap(first, last);
+    while (comp(*++first, pivot)) {
+    }
+    while (!comp(*--last, pivot)) {
+    }
+  }
+  It pivot_pos = first - 1;
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return std::pair<It, bool>(pivot_pos, already_partitioned);
+}
+
+// Swaps the elements at first + offsets_l[i] and last - offsets_r[i]. When
+// the counts differ a cyclic permutation does the same with fewer moves.
+template <class It>
+void swap_offsets(It first, It last, const unsigned char* offsets_l,
+                  const unsigned char* offsets_r, size_t num,
+                  bool use_swaps) {
+  if (use_swaps) {
+    for (size_t i = 0; i < num; ++i) {
+      std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+    }
+  } else if (num > 0) {
+    It l = first + offsets_l[0];
+    It r = last - offsets_r[0];
+    value_type_t<It> tmp(std::move(*l));
+    *l = std::move(*r);
+    for (size_t i = 1; i < num; ++i) {
+      l = first + offsets_l[i];
+      *r = std::move(*l);
+      r = last - offsets_r[i];
+      *l = std::move(*r);
+    }
+    *r = std::move(tmp);
+  }
+}
+
+// partition_right without branching on comparison results (BlockQuicksort,
+// Edelkamp and Weiss): a block of elements is classified first, storing the
+// offsets of misplaced ones, then the misplaced elements are swapped.
+template <class It, class Compare>
+std::pair<It, bool> partition_right_branchless(It begin, It end,
+                                               Compare& comp) {
+  value_type_t<It> pivot(std::move(*begin));
+  It first = begin;
+  It last = end;
+  while (comp(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+  const bool already_partitioned = first >= last;
+  if (!already_partitioned) {
+    std::iter_swap(first, last);
+    ++first;
+
+    alignas(64) unsigned char offsets_l[block_size];
+    alignas(64) unsigned char offsets_r[block_size];
+    It offsets_l_base = first;
+    It offsets_r_base = last;
+    size_t num_l = 0;
+    size_t num_r = 0;
+    size_t start_l = 0;
+    size_t start_r = 0;
+    while (first < last) {
+      // refill whichever offset block is empty, splitting the unknown
+      // elements between both sides if both are
+      const size_t num_unknown = static_cast<size_t>(last - first);
+      const size_t left_split =
+          num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+      const size_t right_split = num_r == 0 ? num_unknown - left_split : 0;
+
+      if (left_split >= static_cast<size_t>(block_size)) {
+        for (unsigned char i = 0; i < block_size;) {
+          for (int unroll = 0; unroll < 8; ++unroll) {
+            offsets_l[num_l] = i++;
+            num_l += !comp(*first, pivot);
+            ++first;
+          }
+        }
+      } else {
+        for (unsigned char i = 0; i < left_split;) {
+          offsets_l[num_l] = i++;
+          num_l += !comp(*first, pivot);
+          ++first;
+        }
+      }
+      if (right_split >= static_cast<size_t>(block_size)) {
+        for (unsigned char i = 0; i < block_size;) {
+          for (int unroll = 0; unroll < 8; ++unroll) {
+            offsets_r[num_r] = ++i;
+            num_r += comp(*--last, pivot);
+          }
+        }
+      } else {
+        for (unsigned char i = 0; i < right_split;) {
+          offsets_r[num_r] = ++i;
+          num_r += comp(*--last, pivot);
+        }
+      }
+
+      const size_t num = num_l < num_r ? num_l : num_r;
+      swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                   offsets_r + start_r, num, num_l == num_r);
+      num_l -= num;
+      num_r -= num;
+      start_l += num;
+      start_r += num;
+      if (num_l == 0) {
+        start_l = 0;
+        offsets_l_base = first;
+      }
+      if (num_r == 0) {
+        start_r = 0;
+        offsets_r_base = last;
+      }
+    }
+
+    // one side still has misplaced elements; the rest is known by now
+    if (num_l != 0) {
+      const unsigned char* offsets = offsets_l + start_l;
+      while (num_l-- != 0) {
+        std::iter_swap(offsets_l_base + offsets[num_l], --last);
+      }
+      first = last;
+    }
+    if (num_r != 0) {
+      const unsigned char* offsets = offsets_r + start_r;
+      while (num_r-- != 0) {
+        std::iter_swap(offsets_r_base - offsets[num_r], first);
+        ++first;
+      }
+      last = first;
+    }
+  }
+  It pivot_pos = first - 1;
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return std::pair<It, bool>(pivot_pos, already_partitioned);
+}
+
+// Partitions around the pivot *begin putting the elements equal to it on
+// its left. Used when the pivot equals the element before the range, i.e.
+// the range holds no smaller element: the left part is then all equal and
+// done.
+template <class It, class Compare>
+It partition_left(It begin, It end, Compare& comp) {
+  value_type_t<It> pivot(std::move(*begin));
+  It first = begin;
+  It last = end;
+  while (comp(pivot, *--last)) {
+  }
+  if (last + 1 == end) {
+    while (first < last && !comp(pivot, *++first)) {
+    }
+  } else {
+    while (!comp(pivot, *++first)) {
+    }
+  }
+  while (first < last) {
+    std::iter_swap(first, last);
+    while (comp(pivot, *--last)) {
+    }
+    while (!comp(pivot, *++first)) {
+    }
+  }
+  It pivot_pos = last;
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return pivot_pos;
+}
+
+template <bool Branchless, class It, class Compare>
+void pdqsort_loop(It begin, It end, Compare& comp, int bad_allowed,
+                  bool leftmost) {
+  while (true) {
+    const std::ptrdiff_t size = end - begin;
+    if (size < insertion_sort_threshold) {
+      if (leftmost) {
+        insertion_sort(begin, end, comp);
+      } else {
+        unguarded_insertion_sort(begin, end, comp);
+      }
+      return;
+    }
+
+    // the pivot ends up in *begin
+    const std::ptrdiff_t s2 = size / 2;
+    if (size > ninther_threshold) {
+      sort3(begin, begin + s2, end - 1, comp);
+      sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+      sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+      sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+      std::iter_swap(begin, begin + s2);
+    } else {
+      sort3(begin + s2, begin, end - 1, comp);
+    }
+
+    // *(begin - 1) closes the left part of an earlier partition, so nothing
+    // here is smaller. A pivot equal to it means many equal keys: move them
+    // all to the left, where they are already sorted.
+    if (!leftmost && !comp(*(begin - 1), *begin)) {
+      begin = partition_left(begin, end, comp) + 1;
+      continue;
+    }
+
+    const std::pair<It, bool> part =
+        Branchless ? partition_right_branchless(begin, end, comp)
+                   : partition_right(begin, end, comp);
+    const It pivot_pos = part.first;
+    const std::ptrdiff_t l_size = pivot_pos - begin;
+    const std::ptrdiff_t r_size = end - (pivot_pos + 1);
+    const bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+    if (highly_unbalanced) {
+      // too many bad pivots: the input is adversarial, use heapsort
+      if (--bad_allowed == 0) {
+        heap_sort(begin, end, comp);
+        return;
+      }
+      // otherwise shuffle some elements to break the pattern
+      if (l_size >= insertion_sort_threshold) {
+        std::iter_swap(begin, begin + l_size / 4);
+        std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+        if (l_size > ninther_threshold) {
+          std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+          std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+          std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+          std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+      }
+      if (r_size >= insertion_sort_threshold) {
+        std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        std::iter_swap(end - 1, end - r_size / 4);
+        if (r_size > ninther_threshold) {
+          std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+          std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+          std::iter_swap(end - 2, end - (1 + r_size / 4));
+          std::iter_swap(end - 3, end - (2 + r_size / 4));
+        }
+      }
+    } else if (part.second &&
+               partial_insertion_sort(begin, pivot_pos, comp) &&
+               partial_insertion_sort(pivot_pos + 1, end, comp)) {
+      // a balanced partition that moved nothing: likely (nearly) sorted
+      return;
+    }
+
+    // recurse into the left part, loop on the right one
+    pdqsort_loop<Branchless>(begin, pivot_pos, comp, bad_allowed, leftmost);
+    begin = pivot_pos + 1;
+    leftmost = false;
+  }
+}
+
+// stable_sort sorts runs up to this size by insertion
+constexpr std::ptrdiff_t stable_run = 32;
+
+// Merges the sorted [first, mid) and [mid, last) through buffer, which has
+// room for mid - first elements. Ties are taken from the left half first.
+template <class It, class T, class Compare>
+void merge_with_buffer(It first, It mid, It last, T* buffer, Compare& comp) {
+  T* const buffer_begin = buffer;
+  T* buffer_end = buffer;
+  // destroys whatever was moved into the buffer, also if comp throws
+  struct guard {
+    T* const& begin;
+    T*& end;
+    ~guard() {
+      for (T* p = begin; p != end; ++p) {
+        p->~T();
+      }
+    }
+  } cleanup{buffer_begin, buffer_end};
+  for (It it = first; it != mid; ++it, ++buffer_end) {
+    ::new (static_cast<void*>(buffer_end)) T(std::move(*it));
+  }
+  T* left = buffer_begin;
+  It right = mid;
+  It out = first;
+  while (left != buffer_end && right != last) {
+    if (comp(*right, *left)) {
+      *out = std::move(*right);
+      ++right;
+    } else {
+      *out = std::move(*left);
+      ++left;
+    }
+    ++out;
+  }
+  for (; left != buffer_end; ++left, ++out) {
+    *out = std::move(*left);
+  }
+}
+
+template <class It, class T, class Compare>
+void merge_sort(It first, It last, T* buffer, Compare& comp) {
+  const std::ptrdiff_t size = last - first;
+  if (size <= stable_run) {
+    insertion_sort(first, last, comp);
+    return;
+  }
+  const It mid = first + size / 2;
+  merge_sort(first, mid, buffer, comp);
+  merge_sort(mid, last, buffer, comp);
+  // sorted and reversed-then-sorted halves are common: skip the merge
+  if (!comp(*mid, *(mid - 1))) {
+    return;
+  }
+  merge_with_buffer(first, mid, last, buffer, comp);
+}
+
+// Maps a value to an unsigned integer with the same order: the sign bit
+// of signed integers is flipped, negative floats have all bits flipped.
+template <class T>
+struct radix_traits {
+  static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                "radix_sort sorts integers and floating point values");
+  typedef typename std::conditional<
+      sizeof(T) == 1, uint8_t,
+      typename std::conditional<
+          sizeof(T) == 2, uint16_t,
+          typename std::conditional<sizeof(T) == 4, uint32_t,
+                                    uint64_t>::type>::type>::type key_type;
+  static_assert(sizeof(key_type) == sizeof(T), "unsupported value size");
+  static constexpr key_type sign_bit = key_type(key_type(1)
+                                                << (8 * sizeof(T) - 1));
+
+  static key_type key(T value) noexcept {
+    key_type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    if constexpr (std::is_floating_point<T>::value) {
+      return (bits & sign_bit) != 0 ? key_type(~bits) : key_type(bits ^ sign_bit);
+    } else if constexpr (std::is_signed<T>::value) {
+      return key_type(bits ^ sign_bit);
+    } else {
+      return bits;
+    }
+  }
+};
+
+// 11-bit digits take three passes over 32-bit keys instead of four 8-bit
+// ones, and the 2048-entry counters still fit in L1.
+template <class T>
+constexpr int radix_digit_bits = sizeof(T) >= 4 ? 11 : 8;
+
+template <class T>
+constexpr int radix_digits =
+    (8 * sizeof(T) + radix_digit_bits<T> - 1) / radix_digit_bits<T>;
+
+template <class T>
+constexpr size_t radix_buckets = size_t(1) << radix_digit_bits<T>;
+
+// Sorts data[0, n) using scratch[0, n) as the second buffer and counts[0,
+// digits * buckets), zeroed, for the digit histograms.
+template <class T, class Count>
+void radix_sort_passes(T* data, T* scratch, size_t n, Count* counts) {
+  typedef radix_traits<T> traits;
+  typedef typename traits::key_type key_type;
+  constexpr int digit_bits = radix_digit_bits<T>;
+  constexpr int digits = radix_digits<T>;
+  constexpr size_t buckets = radix_buckets<T>;
+  constexpr key_type mask = key_type(buckets - 1);
+
+  // all the digit histograms in a single pass
+  for (size_t i = 0; i < n; ++i) {
+    const key_type key = traits::key(data[i]);
+    for (int d = 0; d < digits; ++d) {
+      ++counts[d * buckets + ((key >> (d * digit_bits)) & mask)];
+    }
+  }
+
+  T* from = data;
+  T* to = scratch;
+  const key_type first_key = traits::key(data[0]);
+  for (int d = 0; d < digits; ++d) {
+    Count* count = &counts[d * buckets];
+    const int shift = d * digit_bits;
+    // every key has the same digit: this pass would not move anything
+    if (count[(first_key >> shift) & mask] == n) {
+      continue;
+    }
+    Count offset = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+      const Count c = count[b];
+      count[b] = offset;
+      offset += c;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const T value = from[i];
+      to[count[(traits::key(value) >> shift) & mask]++] = value;
+    }
+    std::swap(from, to);
+  }
+  if (from != data) {
+    std::memcpy(static_cast<void*>(data), static_cast<const void*>(from),
+                n * sizeof(T));
+  }
+}
+
+// The histograms live on the stack, with 32-bit counters: 24 KB for 32-bit
+// keys, 48 KB for 64-bit ones. Only a range of 4G elements or more, where one
+// allocation no longer matters, counts in a heap buffer of size_t.
+template <class T>
+void radix_sort(T* data, T* scratch, size_t n) {
+  constexpr size_t histogram_size = radix_digits<T> * radix_buckets<T>;
+  if (n <= std::numeric_limits<uint32_t>::max()) {
+    uint32_t counts[histogram_size] = {};
+    radix_sort_passes(data, scratch, n, counts);
+  } else {
+    Vector<size_t> counts(histogram_size, 0);
+    radix_sort_passes(data, scratch, n, counts.data());
+  }
+}
+
+}  // namespace sort_detail
+
+template <class RandomIt, class Compare>
+void sort(RandomIt first, RandomIt last, Compare comp) {
+  typedef sort_detail::value_type_t<RandomIt> T;
+  const std::ptrdiff_t size = last - first;
+  if (size < 2) {
+    return;
+  }
+  sort_detail::pdqsort_loop<sort_detail::is_cheap_comparison<Compare, T>>(
+      first, last, comp, sort_detail::log2(static_cast<size_t>(size)), true);
+}
+
+template <class RandomIt>
+void sort(RandomIt first, RandomIt last) {
+  tracystl::sort(first, last, std::less<sort_detail::value_type_t<RandomIt>>());
+}
+
+// Stable: equal elements keep their order. The n/2 element buffer comes
+// from alloc, rebound to the value type.
+template <class RandomIt, class Compare, class Alloc>
+void stable_sort(RandomIt first, RandomIt last, Compare comp,
+                 const Alloc& alloc) {
+  typedef sort_detail::value_type_t<RandomIt> T;
+  typedef typename Alloc::template rebind<T>::other allocator_type;
+  const std::ptrdiff_t size = last - first;
+  if (size <= sort_detail::stable_run) {
+    sort_detail::insertion_sort(first, last, comp);
+    return;
+  }
+  // a strictly descending range only needs reversing, which keeps it
+  // stable as no two elements are equal
+  RandomIt run = first + 1;
+  while (run != last && comp(*run, *(run - 1))) {
+    ++run;
+  }
+  if (run == last) {
+    std::reverse(first, last);
+    return;
+  }
+  allocator_type a(alloc);
+  const size_t buffer_size = static_cast<size_t>(size / 2);
+  T* buffer = a.allocate(buffer_size);
+  try {
+    sort_detail::merge_sort(first, last, buffer, comp);
+  } catch (...) {
+    a.deallocate(buffer, buffer_size);
+    throw;
+  }
+  a.deallocate(buffer, buffer_size);
+}
+
+template <class RandomIt, class Compare>
+void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+  tracystl::stable_sort(first, last, comp,
+                        Allocator<sort_detail::value_type_t<RandomIt>>());
+}
+
+template <class RandomIt>
+void stable_sort(RandomIt first, RandomIt last) {
+  tracystl::stable_sort(first, last,
+                        std::less<sort_detail::value_type_t<RandomIt>>());
+}
+
+// Ascending LSD radix sort of integers or floating point values (-0.0
+// sorts before +0.0, NaNs with the sign bit set first and the others
+// last). scratch is resized to the range and can be kept across calls so
+// that repeated sorts do not allocate; the digit histograms are on the stack.
+template <class ContiguousIt, class T, class ScratchAlloc, class Growth>
+void radix_sort(ContiguousIt first, ContiguousIt last,
+                Vector<T, ScratchAlloc, Growth>& scratch) {
+  static_assert(is_contiguous_iterator_v<ContiguousIt>,
+                "radix_sort needs contiguous iterators");
+  static_assert(
+      std::is_same<T, sort_detail::value_type_t<ContiguousIt>>::value,
+      "scratch must hold the range's value type");
+  const std::ptrdiff_t size = last - first;
+  if (size < 2) {
+    return;
+  }
+  if (scratch.size() < static_cast<size_t>(size)) {
+    scratch.resize(static_cast<size_t>(size));
+  }
+  sort_detail::radix_sort(&*first, scratch.data(), static_cast<size_t>(size));
+}
+
+template <class ContiguousIt>
+void radix_sort(ContiguousIt first, ContiguousIt last) {
+  Vector<sort_detail::value_type_t<ContiguousIt>> scratch;
+  tracystl::radix_sort(first, last, scratch);
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_SORT_H_
@@ -0,0 +1,291 @@
+#ifndef _TRACYSTL_STATIC_VECTOR_H_
+#define _TRACYSTL_STATIC_VECTOR_H_
+
+#include "uninitialized.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef> // For std::size_t
+#include <memory>  // For std::construct_at
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tracystl {
+
+// The elements live in a union so that no T is constructed up front and the
+// storage stays usable in constant evaluation (a byte buffer would need a
+// reinterpret_cast). The destructor loop only exists when T needs it: for
+// trivially destructible T the storage, and so StaticVector, is trivially
+// destructible itself.
+template <class T, size_t N, bool = std::is_trivially_destructible<T>::value>
+struct static_vector_storage {
+  union {
+    char dummy_;
+    T data_[N];
+  };
+  size_t size_;
+
+  constexpr static_vector_storage() noexcept : dummy_(), size_(0) {}
+};
+
+template <class T, size_t N>
+struct static_vector_storage<T, N, false> {
+  union {
+    char dummy_;
+    T data_[N];
+  };
+  size_t size_;
+
+  constexpr static_vector_storage() noexcept : dummy_(), size_(0) {}
+  TRACYSTL_CONSTEXPR20 ~static_vector_storage() {
+    for (size_t i = 0; i < size_; ++i) {
+      data_[i].~T();
+    }
+  }
+};
+
+// A vector with room for exactly N elements inside the object and no
+// allocator at all. It has the modifiers of Vector, but exceeding N is a
+// precondition violation (checked with assert) instead of a reallocation.
+// Under C++20 every member is constexpr.
+template <class T, size_t N>
+class StaticVector {
+  static_assert(N > 0, "StaticVector needs a capacity");
+
+ public:
+  typedef T value_type;
+  typedef value_type* iterator;
+  typedef const value_type* const_iterator;
+  typedef size_t size_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+
+  TRACYSTL_CONSTEXPR20 StaticVector() noexcept {}
+  TRACYSTL_CONSTEXPR20 explicit StaticVector(size_type n) { resize(n); }
+  TRACYSTL_CONSTEXPR20 StaticVector(size_type n, const value_type& value) {
+    resize(n, value);
+  }
+  TRACYSTL_CONSTEXPR20 StaticVector(const StaticVector& rhs) {
+    for (const_iterator it = rhs.begin(); it != rhs.end(); ++it) {
+      construct_back(*it);
+    }
+  }
+  TRACYSTL_CONSTEXPR20 StaticVector(StaticVector&& rhs) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    for (iterator it = rhs.begin(); it != rhs.end(); ++it) {
+      construct_back(std::move(*it));
+    }
+  }
+
+  TRACYSTL_CONSTEXPR20 StaticVector& operator=(const StaticVector& rhs) {
+    if (this != &rhs) {
+      assign_from(rhs.begin(), rhs.size(),
+                  [](const T& v) -> const T& { return v; });
+    }
+    return *this;
+  }
+  TRACYSTL_CONSTEXPR20 StaticVector& operator=(StaticVector&& rhs) noexcept(
+      std::is_nothrow_move_constructible<T>::value &&
+      std::is_nothrow_move_assignable<T>::value) {
+    if (this != &rhs) {
+      assign_from(rhs.begin(), rhs.size(),
+                  [](T& v) -> T&& { return std::move(v); });
+    }
+    return *this;
+  }
+
+  TRACYSTL_CONSTEXPR20 void swap(StaticVector& rhs) {
+    StaticVector& longer = size() < rhs.size() ? rhs : *this;
+    StaticVector& shorter = size() < rhs.size() ? *this : rhs;
+    const size_type common = shorter.size();
+    for (size_type i = 0; i < common; ++i) {
+      using std::swap;
+      swap(longer[i], shorter[i]);
+    }
+    for (size_type i = common; i < longer.size(); ++i) {
+      shorter.construct_back(std::move(longer[i]));
+    }
+    longer.destroy_tail(common);
+  }
+
+  TRACYSTL_CONSTEXPR20 iterator begin() noexcept { return storage_.data_; }
+  TRACYSTL_CONSTEXPR20 const_iterator begin() const noexcept {
+    return storage_.data_;
+  }
+
+  TRACYSTL_CONSTEXPR20 iterator end() noexcept {
+    return storage_.data_ + storage_.size_;
+  }
+  TRACYSTL_CONSTEXPR20 const_iterator end() const noexcept {
+    return storage_.data_ + storage_.size_;
+  }
+
+  TRACYSTL_CONSTEXPR20 pointer data() noexcept { return storage_.data_; }
+  TRACYSTL_CONSTEXPR20 const_pointer data() const noexcept {
+    return storage_.data_;
+  }
+
+  constexpr size_t size() const noexcept { return storage_.size_; }
+  static constexpr size_t capacity() noexcept { return N; }
+  static constexpr size_t max_size() noexcept { return N; }
+
+  constexpr bool empty() const noexcept { return storage_.size_ == 0; }
+  constexpr bool full() const noexcept { return storage_.size_ == N; }
+
+  TRACYSTL_CONSTEXPR20 reference operator[](size_t n) {
+    return storage_.data_[n];
+  }
+  TRACYSTL_CONSTEXPR20 const_reference operator[](size_t n) const {
+    return storage_.data_[n];
+  }
+
+  // capacity is fixed: reserve only checks, shrink_to_fit does nothing;
+  // both are here so a StaticVector can stand in for a Vector
+  TRACYSTL_CONSTEXPR20 void reserve(size_type n) noexcept {
+    assert(n <= N);
+    (void)n;
+  }
+  TRACYSTL_CONSTEXPR20 void shrink_to_fit() noexcept {}
+
+  TRACYSTL_CONSTEXPR20 void resize(size_type n) {
+    assert(n <= N);
+    if (n < size()) {
+      destroy_tail(n);
+      return;
+    }
+    while (size() != n) {
+      construct_back();
+    }
+  }
+  TRACYSTL_CONSTEXPR20 void resize(size_type n, const value_type& value) {
+    assert(n <= N);
+    if (n < size()) {
+      destroy_tail(n);
+      return;
+    }
+    // there is no reallocation, so value stays valid even if it is ours
+    while (size() != n) {
+      construct_back(value);
+    }
+  }
+
+  TRACYSTL_CONSTEXPR20 void clear() noexcept { destroy_tail(0); }
+
+  TRACYSTL_CONSTEXPR20 void push_back(const value_type& value) {
+    emplace_back(value);
+  }
+  TRACYSTL_CONSTEXPR20 void push_back(value_type&& value) {
+    emplace_back(std::move(value));
+  }
+
+  template <class... Args>
+  TRACYSTL_CONSTEXPR20 reference emplace_back(Args&&... args) {
+    assert(!full());
+    construct_back(std::forward<Args>(args)...);
+    return back();
+  }
+
+  TRACYSTL_CONSTEXPR20 void pop_back() {
+    assert(!empty());
+    destroy_tail(size() - 1);
+  }
+
+  TRACYSTL_CONSTEXPR20 reference front() { return storage_.data_[0]; }
+  TRACYSTL_CONSTEXPR20 const_reference front() const {
+    return storage_.data_[0];
+  }
+  TRACYSTL_CONSTEXPR20 reference back() {
+    return storage_.data_[storage_.size_ - 1];
+  }
+  TRACYSTL_CONSTEXPR20 const_reference back() const {
+    return storage_.data_[storage_.size_ - 1];
+  }
+
+  // Inserts before pos, shifting the tail up by one like Vector does (move
+  // assignment only in constant evaluation), and returns an iterator to the
+  // new element.
+  TRACYSTL_CONSTEXPR20 iterator insert(const_iterator pos,
+                                       const value_type& value) {
+    return emplace(pos, value);
+  }
+  TRACYSTL_CONSTEXPR20 iterator insert(const_iterator pos,
+                                       value_type&& value) {
+    return emplace(pos, std::move(value));
+  }
+  template <class... Args>
+  TRACYSTL_CONSTEXPR20 iterator emplace(const_iterator pos, Args&&... args) {
+    assert(!full());
+    const size_type index = static_cast<size_type>(pos - begin());
+    if (index == size()) {
+      construct_back(std::forward<Args>(args)...);
+      return begin() + index;
+    }
+    // args may refer to an element that is about to be shifted
+    value_type value(std::forward<Args>(args)...);
+    iterator p = begin() + index;
+    tracystl::shift_insert(p, end(), std::move(value));
+    ++storage_.size_;
+    return p;
+  }
+
+  // erase returns an iterator to the element that followed the erased ones
+  TRACYSTL_CONSTEXPR20 iterator erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+  }
+  TRACYSTL_CONSTEXPR20 iterator erase(const_iterator first,
+                                      const_iterator last) {
+    iterator f = begin() + (first - begin());
+    iterator l = begin() + (last - begin());
+    if (f != l) {
+      storage_.size_ =
+          static_cast<size_type>(tracystl::shift_erase(f, l, end()) - begin());
+    }
+    return f;
+  }
+
+ private:
+  template <class... Args>
+  TRACYSTL_CONSTEXPR20 void construct_back(Args&&... args) {
+    T* slot = storage_.data_ + storage_.size_;
+#if __cplusplus >= 202002L
+    std::construct_at(slot, std::forward<Args>(args)...);
+#else
+    ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+#endif
+    ++storage_.size_;
+  }
+
+  // destroys [n, size())
+  TRACYSTL_CONSTEXPR20 void destroy_tail(size_type n) noexcept {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for (size_type i = n; i < storage_.size_; ++i) {
+        storage_.data_[i].~T();
+      }
+    }
+    storage_.size_ = n;
+  }
+
+  // element-wise assignment over the common prefix, then construct or
+  // destroy the rest; get(x) yields a copy or an rvalue of x
+  template <class Src, class Get>
+  TRACYSTL_CONSTEXPR20 void assign_from(Src* src, size_type n, Get get) {
+    const size_type common = n < size() ? n : size();
+    for (size_type i = 0; i < common; ++i) {
+      storage_.data_[i] = get(src[i]);
+    }
+    if (n < size()) {
+      destroy_tail(n);
+    }
+    for (size_type i = common; i < n; ++i) {
+      construct_back(get(src[i]));
+    }
+  }
+
+  static_vector_storage<T, N> storage_;
+};
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_STATIC_VECTOR_H_
@@ -0,0 +1,375 @@
+#ifndef _TRACYSTL_STRING_VIEW_H_
+#define _TRACYSTL_STRING_VIEW_H_
+
+#include "algorithm.h"
+#include <cassert>
+#include <cstddef> // For std::size_t
+#include <cstdint>
+#include <cstring> // For std::memchr, std::memcmp
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace tracystl {
+
+namespace string_detail {
+
+constexpr size_t npos = static_cast<size_t>(-1);
+
+// Every search below returns an index into haystack, or npos. The needle is
+// at least two characters and no longer than the haystack.
+
+// memchr for the first character, then memcmp for the rest
+inline size_t find_scalar(const char* haystack, size_t n, const char* needle,
+                          size_t m, size_t from) noexcept {
+  const char* const stop = haystack + (n - m + 1);
+  for (const char* p = haystack + from; p < stop; ++p) {
+    p = static_cast<const char*>(
+        std::memchr(p, static_cast<unsigned char>(needle[0]),
+                    static_cast<size_t>(stop - p)));
+    if (p == nullptr) {
+      return npos;
+    }
+    if (std::memcmp(p + 1, needle + 1, m - 1) == 0) {
+      return static_cast<size_t>(p - haystack);
+    }
+  }
+  return npos;
+}
+
+#if TRACYSTL_ALGORITHM_X86
+
+// Substring search a vector of start positions at a time: compare one
+// vector of the haystack with the needle's first character and the vector
+// m - 1 bytes further on with its last character. Only positions where both
+// match are verified with memcmp, which on text is rarely more than the true
+// matches.
+namespace sse2 {
+
+inline size_t find(const char* haystack, size_t n, const char* needle,
+                   size_t m) noexcept {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[m - 1]);
+  size_t i = 0;
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+    const __m128i b = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(haystack + i + m - 1));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+    while (mask != 0) {
+      const size_t at = i + static_cast<size_t>(__builtin_ctz(mask));
+      if (std::memcmp(haystack + at + 1, needle + 1, m - 2) == 0) {
+        return at;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return find_scalar(haystack, n, needle, m, i);
+}
+
+}  // namespace sse2
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace avx2 {
+
+inline size_t find(const char* haystack, size_t n, const char* needle,
+                   size_t m) noexcept {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+  size_t i = 0;
+  for (; i + m - 1 + 32 <= n; i += 32) {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+    const __m256i b = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(haystack + i + m - 1));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                         _mm256_cmpeq_epi8(b, last))));
+    while (mask != 0) {
+      const size_t at = i + static_cast<size_t>(__builtin_ctz(mask));
+      if (std::memcmp(haystack + at + 1, needle + 1, m - 2) == 0) {
+        return at;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return find_scalar(haystack, n, needle, m, i);
+}
+
+}  // namespace avx2
+
+#pragma GCC pop_options
+
+#endif  // TRACYSTL_ALGORITHM_X86
+
+inline size_t find(const char* haystack, size_t n, const char* needle,
+                   size_t m, size_t pos) noexcept {
+  if (pos > n || m > n - pos) {
+    return npos;
+  }
+  if (m == 0) {
+    return pos;
+  }
+  const char* h = haystack + pos;
+  const size_t rest = n - pos;
+  size_t found;
+  if (m == 1) {
+    const void* p =
+        std::memchr(h, static_cast<unsigned char>(needle[0]), rest);
+    found = p != nullptr
+                ? static_cast<size_t>(static_cast<const char*>(p) - h)
+                : npos;
+  } else {
+#if TRACYSTL_ALGORITHM_X86
+    switch (active_simd_level()) {
+      case simd_level::avx2:
+        found = avx2::find(h, rest, needle, m);
+        break;
+      case simd_level::sse2:
+        found = sse2::find(h, rest, needle, m);
+        break;
+      default:
+        found = find_scalar(h, rest, needle, m, 0);
+        break;
+    }
+#else
+    found = find_scalar(h, rest, needle, m, 0);
+#endif
+  }
+  return found == npos ? npos : found + pos;
+}
+
+// A 256-bit membership set for find_first_of and friends.
+struct char_set {
+  explicit char_set(const char* chars, size_t n) noexcept : bits{} {
+    for (size_t i = 0; i < n; ++i) {
+      const unsigned char c = static_cast<unsigned char>(chars[i]);
+      bits[c >> 6] |= uint64_t(1) << (c & 63);
+    }
+  }
+  bool contains(char ch) const noexcept {
+    const unsigned char c = static_cast<unsigned char>(ch);
+    return (bits[c >> 6] >> (c & 63)) & 1;
+  }
+  uint64_t bits[4];
+};
+
+}  // namespace string_detail
+
+// A non-owning view of a character range, like std::string_view. Slicing and
+// tokenizing (substr, remove_prefix, pop_token) never copy characters, so a
+// parser can carve a received buffer into keys and values that point into
+// it. The viewed characters must outlive the view.
+//
+// find(char) and compare go through memchr and memcmp, which the C library
+// vectorizes; find(StringView) filters candidate positions with SSE2/AVX2
+// (whichever set_simd_level allows, see algorithm.h).
+class StringView {
+ public:
+  typedef char value_type;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const char& reference;
+  typedef const char& const_reference;
+  typedef const char* pointer;
+  typedef const char* const_pointer;
+  typedef const char* iterator;
+  typedef const char* const_iterator;
+
+  static constexpr size_type npos = string_detail::npos;
+
+  constexpr StringView() noexcept : data_(nullptr), size_(0) {}
+  constexpr StringView(const char* s, size_type n) noexcept
+      : data_(s), size_(n) {}
+  constexpr StringView(const char* s) noexcept
+      : data_(s), size_(std::char_traits<char>::length(s)) {}
+  StringView(const std::string& s) noexcept
+      : data_(s.data()), size_(s.size()) {}
+  constexpr explicit StringView(std::string_view s) noexcept
+      : data_(s.data()), size_(s.size()) {}
+
+  constexpr operator std::string_view() const noexcept {
+    return std::string_view(data_, size_);
+  }
+
+  constexpr const_iterator begin() const noexcept { return data_; }
+  constexpr const_iterator end() const noexcept { return data_ + size_; }
+  constexpr const char* data() const noexcept { return data_; }
+  constexpr size_type size() const noexcept { return size_; }
+  constexpr size_type length() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr const char& operator[](size_type i) const noexcept {
+    assert(i < size_);
+    return data_[i];
+  }
+  constexpr const char& front() const noexcept { return (*this)[0]; }
+  constexpr const char& back() const noexcept { return (*this)[size_ - 1]; }
+
+  constexpr void remove_prefix(size_type n) noexcept {
+    assert(n <= size_);
+    data_ += n;
+    size_ -= n;
+  }
+  constexpr void remove_suffix(size_type n) noexcept {
+    assert(n <= size_);
+    size_ -= n;
+  }
+  // the characters [pos, pos + n), clipped to the view
+  constexpr StringView substr(size_type pos, size_type n = npos) const
+      noexcept {
+    assert(pos <= size_);
+    return StringView(data_ + pos, n < size_ - pos ? n : size_ - pos);
+  }
+
+  // Returns the characters up to the first delimiter and drops them and
+  // the delimiter from the view; the whole view if there is no delimiter.
+  // An empty view stays empty, so `while (!rest.empty())` visits each token
+  // once.
+  StringView pop_token(char delimiter) noexcept {
+    const size_type at = find(delimiter);
+    StringView token = substr(0, at);
+    remove_prefix(at == npos ? size_ : at + 1);
+    return token;
+  }
+
+  int compare(StringView rhs) const noexcept {
+    const size_type n = size_ < rhs.size_ ? size_ : rhs.size_;
+    const int r = n == 0 ? 0 : std::memcmp(data_, rhs.data_, n);
+    if (r != 0) {
+      return r;
+    }
+    return size_ < rhs.size_ ? -1 : size_ > rhs.size_ ? 1 : 0;
+  }
+  bool starts_with(StringView prefix) const noexcept {
+    return size_ >= prefix.size_ &&
+           (prefix.size_ == 0 ||
+            std::memcmp(data_, prefix.data_, prefix.size_) == 0);
+  }
+  bool starts_with(char ch) const noexcept {
+    return size_ != 0 && data_[0] == ch;
+  }
+  bool ends_with(StringView suffix) const noexcept {
+    return size_ >= suffix.size_ &&
+           (suffix.size_ == 0 ||
+            std::memcmp(data_ + size_ - suffix.size_, suffix.data_,
+                        suffix.size_) == 0);
+  }
+  bool ends_with(char ch) const noexcept {
+    return size_ != 0 && data_[size_ - 1] == ch;
+  }
+
+  size_type find(char ch, size_type pos = 0) const noexcept {
+    if (pos >= size_) {
+      return npos;
+    }
+    const void* p =
+        std::memchr(data_ + pos, static_cast<unsigned char>(ch), size_ - pos);
+    return p != nullptr ? static_cast<size_type>(static_cast<const char*>(p) -
+                                                 data_)
+                        : npos;
+  }
+  size_type find(StringView needle, size_type pos = 0) const noexcept {
+    return string_detail::find(data_, size_, needle.data_, needle.size_, pos);
+  }
+  size_type rfind(char ch, size_type pos = npos) const noexcept {
+    for (size_type i = pos < size_ ? pos + 1 : size_; i-- > 0;) {
+      if (data_[i] == ch) {
+        return i;
+      }
+    }
+    return npos;
+  }
+  size_type rfind(StringView needle, size_type pos = npos) const noexcept {
+    if (needle.size_ > size_) {
+      return npos;
+    }
+    size_type i = size_ - needle.size_;
+    if (pos < i) {
+      i = pos;
+    }
+    for (;; --i) {
+      if (needle.size_ == 0 ||
+          std::memcmp(data_ + i, needle.data_, needle.size_) == 0) {
+        return i;
+      }
+      if (i == 0) {
+        return npos;
+      }
+    }
+  }
+  bool contains(char ch) const noexcept { return find(ch) != npos; }
+  bool contains(StringView needle) const noexcept {
+    return find(needle) != npos;
+  }
+
+  size_type find_first_of(StringView chars, size_type pos = 0) const
+      noexcept {
+    if (chars.size_ == 1) {
+      return find(chars.data_[0], pos);
+    }
+    const string_detail::char_set set(chars.data_, chars.size_);
+    for (size_type i = pos; i < size_; ++i) {
+      if (set.contains(data_[i])) {
+        return i;
+      }
+    }
+    return npos;
+  }
+  size_type find_first_not_of(StringView chars, size_type pos = 0) const
+      noexcept {
+    const string_detail::char_set set(chars.data_, chars.size_);
+    for (size_type i = pos; i < size_; ++i) {
+      if (!set.contains(data_[i])) {
+        return i;
+      }
+    }
+    return npos;
+  }
+
+ private:
+  const char* data_;
+  size_type size_;
+};
+
+inline bool operator==(StringView lhs, StringView rhs) noexcept {
+  return lhs.size() == rhs.size() &&
+         (lhs.size() == 0 ||
+          std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+inline bool operator!=(StringView lhs, StringView rhs) noexcept {
+  return !(lhs == rhs);
+}
+inline bool operator<(StringView lhs, StringView rhs) noexcept {
+  return lhs.compare(rhs) < 0;
+}
+inline bool operator>(StringView lhs, StringView rhs) noexcept {
+  return lhs.compare(rhs) > 0;
+}
+inline bool operator<=(StringView lhs, StringView rhs) noexcept {
+  return lhs.compare(rhs) <= 0;
+}
+inline bool operator>=(StringView lhs, StringView rhs) noexcept {
+  return lhs.compare(rhs) >= 0;
+}
+
+inline std::ostream& operator<<(std::ostream& os, StringView s) {
+  return os << std::string_view(s);
+}
+
+}  // namespace tracystl
+
+// hashes like the std::string with the same characters
+template <>
+struct std::hash<tracystl::StringView> {
+  size_t operator()(tracystl::StringView s) const noexcept {
+    return std::hash<std::string_view>()(s);
+  }
+};
+
+#endif  // _TRACYSTL_STRING_VIEW_H_
@@ -0,0 +1,289 @@
+#ifndef _TRACYSTL_THREAD_CACHE_ALLOCATOR_H_
+#define _TRACYSTL_THREAD_CACHE_ALLOCATOR_H_
+
+#include "allocator.h"
+#include <cstddef> // For std::size_t
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace tracystl {
+
+// A tcmalloc-style small object allocator.
+//
+// Requests up to kMaxSmallSize bytes are rounded up to one of kNumClasses size
+// classes (multiples of 16). Each thread keeps a free list per class
+// (thread_cache), so the common allocate/deallocate is a pointer pop/push with
+// no locking. When a thread's list runs dry it grabs a whole batch of objects
+// from the central transfer cache, and when it grows too long it gives a batch
+// back; only the central cache takes a lock, once per kBatchSize objects.
+// The central cache refills itself by carving kSpanSize chunks from
+// ::operator new. Larger requests go straight to ::operator new.
+//
+// Objects do not belong to the thread that allocated them: freeing on another
+// thread simply puts the object into that thread's cache, from where it
+// travels back to the central cache like any other object. A thread that exits
+// flushes its whole cache to the central cache; allocations made later during
+// its exit (from other thread_local destructors) go to the central cache one
+// object at a time.
+//
+// The chunks are never returned to the system; the allocator is designed for
+// long running servers with a steady working set.
+namespace thread_cache_detail {
+
+constexpr std::size_t kAlignment = 16;
+constexpr std::size_t kMaxSmallSize = 1024;
+constexpr std::size_t kNumClasses = kMaxSmallSize / kAlignment;
+constexpr std::size_t kBatchSize = 32;
+constexpr std::size_t kSpanSize = 64 * 1024;
+
+struct free_object {
+  free_object* next_;
+};
+
+inline std::size_t size_class(std::size_t bytes) {
+  return (bytes + kAlignment - 1) / kAlignment - 1;
+}
+
+inline std::size_t class_size(std::size_t cls) { return (cls + 1) * kAlignment; }
+
+// A singly linked batch of free objects.
+struct batch {
+  free_object* head_ = nullptr;
+  free_object* tail_ = nullptr;
+  std::size_t count_ = 0;
+
+  void push(free_object* obj) {
+    obj->next_ = head_;
+    head_ = obj;
+    if (tail_ == nullptr) {
+      tail_ = obj;
+    }
+    ++count_;
+  }
+  free_object* pop() {
+    free_object* obj = head_;
+    head_ = obj->next_;
+    if (head_ == nullptr) {
+      tail_ = nullptr;
+    }
+    --count_;
+    return obj;
+  }
+  // splices the whole of rhs in front of this batch
+  void splice(batch& rhs) {
+    if (rhs.head_ == nullptr) {
+      return;
+    }
+    rhs.tail_->next_ = head_;
+    if (tail_ == nullptr) {
+      tail_ = rhs.tail_;
+    }
+    head_ = rhs.head_;
+    count_ += rhs.count_;
+    rhs = batch();
+  }
+  // detaches the first n objects (n <= count_)
+  batch take(std::size_t n) {
+    batch result;
+    if (n == 0) {
+      return result;
+    }
+    result.head_ = head_;
+    free_object* last = head_;
+    for (std::size_t i = 1; i < n; ++i) {
+      last = last->next_;
+    }
+    head_ = last->next_;
+    last->next_ = nullptr;
+    result.tail_ = last;
+    result.count_ = n;
+    count_ -= n;
+    if (head_ == nullptr) {
+      tail_ = nullptr;
+    }
+    return result;
+  }
+};
+
+// The transfer cache shared by all threads, one locked free list per class.
+class central_cache {
+ public:
+  static central_cache& instance() {
+    // intentionally leaked: thread caches may flush into it during exit
+    static central_cache* cache = new central_cache();
+    return *cache;
+  }
+
+  // up to n objects; a new span is carved only when none are free
+  batch fetch(std::size_t cls, std::size_t n = kBatchSize) {
+    std::lock_guard<std::mutex> lock(locks_[cls]);
+    if (lists_[cls].count_ == 0) {
+      refill(cls);
+    }
+    return lists_[cls].take(n < lists_[cls].count_ ? n : lists_[cls].count_);
+  }
+
+  void give_back(std::size_t cls, batch& objects) {
+    std::lock_guard<std::mutex> lock(locks_[cls]);
+    lists_[cls].splice(objects);
+  }
+
+  // single objects, for threads whose cache is already destroyed
+  void* allocate_one(std::size_t cls) { return fetch(cls, 1).pop(); }
+  void deallocate_one(void* ptr, std::size_t cls) {
+    batch one;
+    one.push(static_cast<free_object*>(ptr));
+    give_back(cls, one);
+  }
+
+ private:
+  central_cache() = default;
+
+  // carve a fresh span into objects of this class; called with the lock held
+  void refill(std::size_t cls) {
+    const std::size_t size = class_size(cls);
+    unsigned char* span = static_cast<unsigned char*>(::operator new(kSpanSize));
+    for (std::size_t offset = 0; offset + size <= kSpanSize; offset += size) {
+      lists_[cls].push(reinterpret_cast<free_object*>(span + offset));
+    }
+  }
+
+  std::mutex locks_[kNumClasses];
+  batch lists_[kNumClasses];
+};
+
+class thread_cache {
+ public:
+  ~thread_cache() {
+    destroyed() = true;
+    for (std::size_t cls = 0; cls < kNumClasses; ++cls) {
+      if (lists_[cls].count_ != 0) {
+        central_cache::instance().give_back(cls, lists_[cls]);
+      }
+    }
+  }
+
+  static thread_cache& local() {
+    static thread_local thread_cache cache;
+    return cache;
+  }
+
+  // Set once this thread's cache is gone. A trivially destructible
+  // thread_local, so it stays readable until the thread is fully gone.
+  static bool& destroyed() noexcept {
+    static thread_local bool flag = false;
+    return flag;
+  }
+
+  void* allocate(std::size_t cls) {
+    batch& list = lists_[cls];
+    if (list.count_ == 0) {
+      batch fresh = central_cache::instance().fetch(cls);
+      list.splice(fresh);
+    }
+    return list.pop();
+  }
+
+  void deallocate(void* ptr, std::size_t cls) {
+    batch& list = lists_[cls];
+    list.push(static_cast<free_object*>(ptr));
+    // keep at most two batches per class, hand one back to the central cache
+    if (list.count_ >= 2 * kBatchSize) {
+      batch extra = list.take(kBatchSize);
+      central_cache::instance().give_back(cls, extra);
+    }
+  }
+
+ private:
+  batch lists_[kNumClasses];
+};
+
+inline void* allocate_bytes(std::size_t bytes) {
+  if (bytes > kMaxSmallSize) {
+    return ::operator new(bytes);
+  }
+  if (thread_cache::destroyed()) {
+    return central_cache::instance().allocate_one(size_class(bytes));
+  }
+  return thread_cache::local().allocate(size_class(bytes));
+}
+
+inline void deallocate_bytes(void* ptr, std::size_t bytes) {
+  if (bytes > kMaxSmallSize) {
+    ::operator delete(ptr);
+    return;
+  }
+  if (thread_cache::destroyed()) {
+    central_cache::instance().deallocate_one(ptr, size_class(bytes));
+    return;
+  }
+  thread_cache::local().deallocate(ptr, size_class(bytes));
+}
+
+}  // namespace thread_cache_detail
+
+// The container-facing allocator. It is stateless (all state is per thread
+// or global), so it costs nothing inside a container, and any instance can
+// free memory allocated by any other instance, on any thread.
+// The size passed to deallocate must match the one passed to allocate.
+template <class T>
+class ThreadCacheAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <class U>
+  struct rebind {
+    typedef ThreadCacheAllocator<U> other;
+  };
+
+  static_assert(alignof(T) <= thread_cache_detail::kAlignment,
+                "over-aligned types are not supported");
+
+  ThreadCacheAllocator() noexcept {}
+  template <class U>
+  ThreadCacheAllocator(const ThreadCacheAllocator<U>&) noexcept {}
+
+  static T* allocate() { return allocate(1); }
+  static T* allocate(size_t n) {
+    if (n == 0) {
+      return nullptr;
+    }
+    return static_cast<T*>(thread_cache_detail::allocate_bytes(n * sizeof(T)));
+  }
+
+  static void deallocate(T* ptr) { deallocate(ptr, 1); }
+  static void deallocate(T* ptr, size_type n) {
+    if (ptr == nullptr) {
+      return;
+    }
+    thread_cache_detail::deallocate_bytes(ptr, n * sizeof(T));
+  }
+
+  template <class... Args>
+  static void construct(T* ptr, Args&&... args) {
+    new (ptr) T(std::forward<Args>(args)...);
+  }
+  static void destroy(T* ptr) { Allocator<T>::destroy(ptr); }
+  static void destroy(T* first, T* last) { Allocator<T>::destroy(first, last); }
+};
+
+template <class T, class U>
+bool operator==(const ThreadCacheAllocator<T>&, const ThreadCacheAllocator<U>&) noexcept {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const ThreadCacheAllocator<T>&, const ThreadCacheAllocator<U>&) noexcept {
+  return false;
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_THREAD_CACHE_ALLOCATOR_H_
@@ -0,0 +1,450 @@
+#ifndef _TRACYSTL_THREAD_POOL_H_
+#define _TRACYSTL_THREAD_POOL_H_
+
+#include "allocator.h"
+#include "deque.h"
+#include "vector.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // For std::size_t
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace tracystl {
+
+// Chase-Lev work-stealing deque ("Dynamic Circular Work-Stealing Deque",
+// Chase and Lev, 2005; memory orders after Le, Pop, Cohen and Zappa Nardelli,
+// 2013, with seq_cst accesses in place of their fences).
+//
+// The owning thread pushes and pops at the bottom, like a stack, without
+// any read-modify-write unless it races for the last element; other threads
+// steal from the top with one CAS. The ring grows by doubling when full.
+// Replaced rings are kept until the deque is destroyed, since a thief may
+// still be reading one.
+template <class T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "WorkStealingDeque holds pointers or small handles");
+
+  struct ring {
+    int64_t mask_;
+    std::unique_ptr<std::atomic<T>[]> slots_;
+
+    explicit ring(int64_t capacity)
+        : mask_(capacity - 1), slots_(new std::atomic<T>[capacity]) {}
+
+    int64_t capacity() const noexcept { return mask_ + 1; }
+    T get(int64_t i) const noexcept {
+      return slots_[i & mask_].load(std::memory_order_relaxed);
+    }
+    void put(int64_t i, T value) noexcept {
+      slots_[i & mask_].store(value, std::memory_order_relaxed);
+    }
+  };
+
+ public:
+  // capacity is rounded up to a power of two
+  explicit WorkStealingDeque(size_t capacity = 64) : top_(0), bottom_(0) {
+    int64_t rounded = 2;
+    while (rounded < static_cast<int64_t>(capacity)) {
+      rounded <<= 1;
+    }
+    rings_.push_back(std::make_unique<ring>(rounded));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+  }
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // a snapshot, may be stale by the time it returns
+  size_t size_approx() const noexcept {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0;
+  }
+
+  // owner only
+  void push(T value);
+  // owner only: the most recently pushed element, false if empty
+  bool pop(T& out) noexcept;
+  // any thread: the oldest element, false if empty or lost a race
+  bool steal(T& out) noexcept;
+
+ private:
+  alignas(TRACYSTL_CACHE_LINE_SIZE) std::atomic<int64_t> top_;
+  alignas(TRACYSTL_CACHE_LINE_SIZE) std::atomic<int64_t> bottom_;
+  std::atomic<ring*> ring_;
+  // owner only; the last one is the live ring
+  Vector<std::unique_ptr<ring>> rings_;
+};
+
+template <class T>
+void WorkStealingDeque<T>::push(T value) {
+  const int64_t b = bottom_.load(std::memory_order_relaxed);
+  const int64_t t = top_.load(std::memory_order_acquire);
+  ring* r = ring_.load(std::memory_order_relaxed);
+  if (b - t > r->mask_) {
+    auto bigger = std::make_unique<ring>(2 * r->capacity());
+    for (int64_t i = t; i != b; ++i) {
+      bigger->put(i, r->get(i));
+    }
+    rings_.push_back(std::move(bigger));
+    r = rings_.back().get();
+    ring_.store(r, std::memory_order_release);
+  }
+  r->put(b, value);
+  bottom_.store(b + 1, std::memory_order_release);
+}
+
+template <class T>
+bool WorkStealingDeque<T>::pop(T& out) noexcept {
+  const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+  ring* r = ring_.load(std::memory_order_relaxed);
+  // the store has to be visible before top is read, or the owner and a
+  // thief could both take the last element
+  bottom_.store(b, std::memory_order_seq_cst);
+  int64_t t = top_.load(std::memory_order_seq_cst);
+  if (t > b) {
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return false;
+  }
+  out = r->get(b);
+  if (t == b) {
+    // the last element: thieves may be after it too
+    const bool won = top_.compare_exchange_strong(
+        t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return won;
+  }
+  return true;
+}
+
+template <class T>
+bool WorkStealingDeque<T>::steal(T& out) noexcept {
+  int64_t t = top_.load(std::memory_order_seq_cst);
+  const int64_t b = bottom_.load(std::memory_order_seq_cst);
+  if (t >= b) {
+    return false;
+  }
+  ring* r = ring_.load(std::memory_order_acquire);
+  T value = r->get(t);
+  if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return false;
+  }
+  out = value;
+  return true;
+}
+
+// Fork-join thread pool with one WorkStealingDeque per worker.
+//
+// run(f) executes f on a worker and returns once f and everything it forked
+// have finished. Inside, fork_join(a, b) pushes b on the worker's deque,
+// runs a, then runs b itself unless another worker stole it meanwhile; while
+// a stolen b is still running the worker executes other tasks instead of
+// blocking. Tasks live on the stack of the thread that forks them, so
+// forking does not allocate.
+//
+// Idle workers steal from random victims, then take tasks submitted from
+// outside the pool, and finally sleep until new work is pushed. Exceptions
+// thrown by tasks propagate out of fork_join and run.
+class ThreadPool {
+  struct task {
+    std::atomic<bool> done_{false};
+    std::exception_ptr error_;
+
+    virtual void execute() = 0;
+    // the task must not be touched afterwards: its owner may free it
+    virtual void finish() noexcept {
+      done_.store(true, std::memory_order_release);
+    }
+
+    void run() noexcept {
+      try {
+        execute();
+      } catch (...) {
+        error_ = std::current_exception();
+      }
+      finish();
+    }
+
+   protected:
+    ~task() = default;
+  };
+
+  template <class F>
+  struct closure_task final : task {
+    F& f_;
+    explicit closure_task(F& f) : f_(f) {}
+    void execute() override { f_(); }
+  };
+
+  // submitted from outside the pool: the caller sleeps until it is done
+  template <class F>
+  struct root_task final : task {
+    F& f_;
+    std::mutex mutex_;
+    std::condition_variable finished_;
+    bool notified_ = false;
+
+    explicit root_task(F& f) : f_(f) {}
+    void execute() override { f_(); }
+    // notifying under the lock keeps the caller from returning, and
+    // destroying the task, before notify_one is done with it
+    void finish() noexcept override {
+      std::lock_guard<std::mutex> lock(mutex_);
+      notified_ = true;
+      finished_.notify_one();
+    }
+  };
+
+  struct alignas(TRACYSTL_CACHE_LINE_SIZE) worker {
+    ThreadPool* pool_;
+    size_t index_;
+    uint64_t rng_;
+    WorkStealingDeque<task*> deque_;
+
+    worker(ThreadPool* pool, size_t index)
+        : pool_(pool), index_(index), rng_(0x9e3779b97f4a7c15ull * (index + 1)) {}
+
+    size_t random_victim() noexcept {
+      rng_ ^= rng_ << 13;
+      rng_ ^= rng_ >> 7;
+      rng_ ^= rng_ << 17;
+      return static_cast<size_t>(rng_ % pool_->workers_.size());
+    }
+  };
+
+ public:
+  // threads == 0 picks std::thread::hardware_concurrency()
+  explicit ThreadPool(size_t threads = 0);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  size_t size() const noexcept { return workers_.size(); }
+
+  // the pool the parallel algorithms use unless told otherwise, with one
+  // worker per hardware thread; started on first use
+  static ThreadPool& default_pool() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  // true on the threads of this pool
+  bool in_pool() const noexcept {
+    return current_worker() != nullptr && current_worker()->pool_ == this;
+  }
+
+  template <class F>
+  void run(F&& f);
+
+  // runs a and b, in parallel if a worker is free, and returns when both
+  // have finished. Outside the pool they simply run one after the other.
+  template <class F1, class F2>
+  void fork_join(F1&& a, F2&& b);
+
+ private:
+  static worker*& current_worker() noexcept {
+    static thread_local worker* current = nullptr;
+    return current;
+  }
+
+  void worker_loop(worker& self);
+  // a task from another worker or from outside, nullptr if there is none
+  task* find_task(worker& self);
+  // executes other tasks until t is done
+  void help_until_done(worker& self, task& t);
+  void notify_work();
+
+  Vector<std::unique_ptr<worker>> workers_;
+  Vector<std::thread> threads_;
+
+  std::mutex injected_mutex_;
+  Deque<task*> injected_;
+  std::atomic<size_t> injected_count_{0};
+
+  // bumped whenever work is published; sleepers wait for it to change
+  alignas(TRACYSTL_CACHE_LINE_SIZE) std::atomic<uint32_t> epoch_{0};
+  std::atomic<size_t> sleepers_{0};
+  std::atomic<bool> stopping_{false};
+};
+
+inline ThreadPool::ThreadPool(size_t threads) {
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  if (threads == 0) {
+    threads = 1;
+  }
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.push_back(std::make_unique<worker>(this, i));
+  }
+  threads_.reserve(threads);
+  try {
+    for (size_t i = 0; i < threads; ++i) {
+      threads_.emplace_back([this, i] { worker_loop(*workers_[i]); });
+    }
+  } catch (...) {
+    stopping_.store(true);
+    epoch_.fetch_add(1);
+    epoch_.notify_all();
+    for (std::thread& t : threads_) {
+      t.join();
+    }
+    throw;
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  stopping_.store(true);
+  epoch_.fetch_add(1);
+  epoch_.notify_all();
+  for (std::thread& t : threads_) {
+    t.join();
+  }
+}
+
+template <class F>
+void ThreadPool::run(F&& f) {
+  if (in_pool()) {
+    f();
+    return;
+  }
+  root_task<F> root(f);
+  {
+    std::lock_guard<std::mutex> lock(injected_mutex_);
+    injected_.push_back(&root);
+  }
+  injected_count_.fetch_add(1);
+  notify_work();
+  {
+    std::unique_lock<std::mutex> lock(root.mutex_);
+    root.finished_.wait(lock, [&root] { return root.notified_; });
+  }
+  if (root.error_) {
+    std::rethrow_exception(root.error_);
+  }
+}
+
+template <class F1, class F2>
+void ThreadPool::fork_join(F1&& a, F2&& b) {
+  worker* self = current_worker();
+  if (self == nullptr || self->pool_ != this) {
+    a();
+    b();
+    return;
+  }
+  closure_task<F2> forked(b);
+  self->deque_.push(&forked);
+  notify_work();
+
+  // everything a() pushes is joined before it returns, so forked is back on
+  // top of the deque unless it was stolen
+  auto join = [&] {
+    task* top = nullptr;
+    if (self->deque_.pop(top)) {
+      top->run();
+    } else {
+      help_until_done(*self, forked);
+    }
+  };
+  try {
+    a();
+  } catch (...) {
+    join();
+    throw;
+  }
+  join();
+  if (forked.error_) {
+    std::rethrow_exception(forked.error_);
+  }
+}
+
+inline void ThreadPool::notify_work() {
+  epoch_.fetch_add(1);
+  if (sleepers_.load() != 0) {
+    epoch_.notify_one();
+  }
+}
+
+inline ThreadPool::task* ThreadPool::find_task(worker& self) {
+  task* t = nullptr;
+  const size_t n = workers_.size();
+  if (n > 1) {
+    const size_t start = self.random_victim();
+    for (size_t i = 0; i < n; ++i) {
+      worker& victim = *workers_[(start + i) % n];
+      if (&victim != &self && victim.deque_.steal(t)) {
+        return t;
+      }
+    }
+  }
+  if (injected_count_.load(std::memory_order_relaxed) != 0) {
+    std::lock_guard<std::mutex> lock(injected_mutex_);
+    if (!injected_.empty()) {
+      t = injected_.front();
+      injected_.pop_front();
+      injected_count_.fetch_sub(1, std::memory_order_relaxed);
+      return t;
+    }
+  }
+  return nullptr;
+}
+
+inline void ThreadPool::help_until_done(worker& self, task& t) {
+  unsigned idle = 0;
+  while (!t.done_.load(std::memory_order_acquire)) {
+    task* other = nullptr;
+    if (self.deque_.pop(other) || (other = find_task(self)) != nullptr) {
+      other->run();
+      idle = 0;
+    } else if (++idle > 64) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+inline void ThreadPool::worker_loop(worker& self) {
+  current_worker() = &self;
+  while (true) {
+    task* t = nullptr;
+    if (self.deque_.pop(t) || (t = find_task(self)) != nullptr) {
+      t->run();
+      continue;
+    }
+    // spin briefly, then sleep; announcing the sleeper before reading the
+    // epoch makes notify_work either see it or bump the epoch it waits on
+    bool found = false;
+    for (int spin = 0; spin < 64 && !found; ++spin) {
+      std::this_thread::yield();
+      found = (t = find_task(self)) != nullptr;
+    }
+    if (found) {
+      t->run();
+      continue;
+    }
+    sleepers_.fetch_add(1);
+    const uint32_t epoch = epoch_.load();
+    if (stopping_.load()) {
+      sleepers_.fetch_sub(1);
+      break;
+    }
+    if ((t = find_task(self)) != nullptr) {
+      sleepers_.fetch_sub(1);
+      t->run();
+      continue;
+    }
+    epoch_.wait(epoch);
+    sleepers_.fetch_sub(1);
+  }
+  current_worker() = nullptr;
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_THREAD_POOL_H_
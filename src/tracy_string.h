@@ -0,0 +1,572 @@
+#ifndef _TRACYSTL_TRACY_STRING_H_
+#define _TRACYSTL_TRACY_STRING_H_
+
+// Not called string.h: that name would shadow the C header for anyone who
+// puts src/ on the include path.
+
+#include "allocator.h"
+#include "string_view.h"
+#include <bit>
+#include <cassert>
+#include <cstddef> // For std::size_t
+#include <cstring> // For std::memcpy, std::memmove
+#include <functional>
+#include <ostream>
+#include <utility>
+
+namespace tracystl {
+
+// A contiguous, NUL-terminated character string. It is three words long and
+// keeps up to short_capacity characters (23 on 64-bit targets) inside the
+// object, so short keys never reach the allocator. Longer strings live in a
+// buffer from Alloc that grows geometrically, at least doubling each time.
+//
+// Short representation: the characters, then in the last byte the number of
+// unused inline characters. A 23-character string stores 0 there, which is
+// also its terminating NUL. Long representation: pointer, size and capacity,
+// with the capacity word encoded so that the top bit of the last byte is
+// set; that bit tells the two apart.
+//
+// Searching and comparing go through StringView.
+template <class Alloc = tracystl::Allocator<char>>
+class BasicString : private allocator_holder<Alloc> {
+ public:
+  typedef char value_type;
+  typedef Alloc allocator_type;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef char& reference;
+  typedef const char& const_reference;
+  typedef char* pointer;
+  typedef const char* const_pointer;
+  typedef char* iterator;
+  typedef const char* const_iterator;
+
+  static constexpr size_type npos = StringView::npos;
+  static constexpr size_type short_capacity = 3 * sizeof(size_t) - 1;
+
+ private:
+  typedef allocator_holder<Alloc> alloc_base;
+
+ public:
+  BasicString() noexcept { set_short_size(0); }
+  explicit BasicString(const Alloc& a) noexcept : alloc_base(a) {
+    set_short_size(0);
+  }
+  BasicString(const char* s, const Alloc& a = Alloc()) : alloc_base(a) {
+    init(s, std::char_traits<char>::length(s));
+  }
+  BasicString(const char* s, size_type n, const Alloc& a = Alloc())
+      : alloc_base(a) {
+    init(s, n);
+  }
+  explicit BasicString(StringView s, const Alloc& a = Alloc())
+      : alloc_base(a) {
+    init(s.data(), s.size());
+  }
+  BasicString(size_type n, char ch, const Alloc& a = Alloc())
+      : alloc_base(a) {
+    init_uninitialized(n);
+    std::memset(data(), ch, n);
+  }
+  BasicString(const BasicString& rhs) : alloc_base(rhs.alloc()) {
+    init(rhs.data(), rhs.size());
+  }
+  BasicString(BasicString&& rhs) noexcept
+      : alloc_base(std::move(rhs.alloc())) {
+    steal(rhs);
+  }
+  ~BasicString() { release(); }
+
+  BasicString& operator=(const BasicString& rhs) {
+    if (this != &rhs) {
+      assign(rhs.data(), rhs.size());
+    }
+    return *this;
+  }
+  BasicString& operator=(BasicString&& rhs) noexcept {
+    if (this != &rhs) {
+      BasicString tmp(std::move(rhs));
+      swap(tmp);
+    }
+    return *this;
+  }
+  BasicString& operator=(StringView s) { return assign(s.data(), s.size()); }
+  BasicString& operator=(const char* s) { return *this = StringView(s); }
+
+  void swap(BasicString& rhs) noexcept {
+    using std::swap;
+    swap(alloc(), rhs.alloc());
+    swap(rep_, rhs.rep_);
+  }
+
+  allocator_type get_allocator() const { return alloc(); }
+
+  operator StringView() const noexcept { return StringView(data(), size()); }
+  StringView view() const noexcept { return StringView(data(), size()); }
+
+  char* data() noexcept { return is_long() ? rep_.l.data : rep_.s; }
+  const char* data() const noexcept {
+    return is_long() ? rep_.l.data : rep_.s;
+  }
+  const char* c_str() const noexcept { return data(); }
+  iterator begin() noexcept { return data(); }
+  const_iterator begin() const noexcept { return data(); }
+  iterator end() noexcept { return data() + size(); }
+  const_iterator end() const noexcept { return data() + size(); }
+
+  size_type size() const noexcept {
+    return is_long() ? rep_.l.size
+                     : short_capacity - static_cast<unsigned char>(
+                                            rep_.s[short_capacity]);
+  }
+  size_type length() const noexcept { return size(); }
+  size_type capacity() const noexcept {
+    return is_long() ? decode_capacity(rep_.l.capacity) : short_capacity;
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  char& operator[](size_type i) noexcept {
+    assert(i <= size());
+    return data()[i];
+  }
+  const char& operator[](size_type i) const noexcept {
+    assert(i <= size());
+    return data()[i];
+  }
+  char& front() noexcept { return (*this)[0]; }
+  const char& front() const noexcept { return (*this)[0]; }
+  char& back() noexcept { return (*this)[size() - 1]; }
+  const char& back() const noexcept { return (*this)[size() - 1]; }
+
+  void reserve(size_type n) {
+    if (n > capacity()) {
+      reallocate(n);
+    }
+  }
+  // moves a long string back inside the object when it fits, else trims
+  // the buffer to the size
+  void shrink_to_fit();
+  void clear() noexcept { set_size(0); }
+  void resize(size_type n, char ch = '\0');
+
+  void push_back(char ch) {
+    const size_type n = size();
+    if (n == capacity()) {
+      grow(n + 1);
+    }
+    char* p = data();
+    p[n] = ch;
+    set_size(n + 1);
+  }
+  void pop_back() noexcept {
+    assert(!empty());
+    set_size(size() - 1);
+  }
+
+  BasicString& assign(const char* s, size_type n);
+  BasicString& assign(StringView s) { return assign(s.data(), s.size()); }
+  BasicString& append(const char* s, size_type n);
+  BasicString& append(StringView s) { return append(s.data(), s.size()); }
+  BasicString& append(size_type n, char ch);
+  BasicString& operator+=(StringView s) { return append(s); }
+  BasicString& operator+=(const char* s) { return append(StringView(s)); }
+  BasicString& operator+=(char ch) {
+    push_back(ch);
+    return *this;
+  }
+  // inserts s before the character at pos
+  BasicString& insert(size_type pos, StringView s);
+  // removes the characters [pos, pos + n), clipped to the string
+  BasicString& erase(size_type pos = 0, size_type n = npos) noexcept;
+
+  BasicString substr(size_type pos = 0, size_type n = npos) const {
+    return BasicString(view().substr(pos, n), alloc());
+  }
+
+  int compare(StringView s) const noexcept { return view().compare(s); }
+  bool starts_with(StringView s) const noexcept {
+    return view().starts_with(s);
+  }
+  bool starts_with(char ch) const noexcept { return view().starts_with(ch); }
+  bool ends_with(StringView s) const noexcept { return view().ends_with(s); }
+  bool ends_with(char ch) const noexcept { return view().ends_with(ch); }
+  bool contains(StringView s) const noexcept { return view().contains(s); }
+  bool contains(char ch) const noexcept { return view().contains(ch); }
+  size_type find(StringView s, size_type pos = 0) const noexcept {
+    return view().find(s, pos);
+  }
+  size_type find(char ch, size_type pos = 0) const noexcept {
+    return view().find(ch, pos);
+  }
+  size_type rfind(StringView s, size_type pos = npos) const noexcept {
+    return view().rfind(s, pos);
+  }
+  size_type rfind(char ch, size_type pos = npos) const noexcept {
+    return view().rfind(ch, pos);
+  }
+  size_type find_first_of(StringView chars, size_type pos = 0) const
+      noexcept {
+    return view().find_first_of(chars, pos);
+  }
+  size_type find_first_not_of(StringView chars, size_type pos = 0) const
+      noexcept {
+    return view().find_first_not_of(chars, pos);
+  }
+
+ private:
+  Alloc& alloc() noexcept { return alloc_base::alloc(); }
+  const Alloc& alloc() const noexcept { return alloc_base::alloc(); }
+
+  static constexpr size_t top_bit = size_t(1) << (8 * sizeof(size_t) - 1);
+  static_assert(std::endian::native == std::endian::little ||
+                    std::endian::native == std::endian::big,
+                "mixed-endian targets are not supported");
+
+  // The last byte of the capacity word is the object's last byte: its most
+  // significant byte on little-endian targets, its least significant one on
+  // big-endian targets.
+  static constexpr size_t encode_capacity(size_t capacity) noexcept {
+    return std::endian::native == std::endian::little ? capacity | top_bit
+                                                      : capacity << 8 | 0x80;
+  }
+  static constexpr size_t decode_capacity(size_t word) noexcept {
+    return std::endian::native == std::endian::little ? word & ~top_bit
+                                                      : word >> 8;
+  }
+
+  bool is_long() const noexcept {
+    return static_cast<unsigned char>(rep_.s[short_capacity]) & 0x80;
+  }
+  void set_short_size(size_type n) noexcept {
+    rep_.s[n] = '\0';
+    rep_.s[short_capacity] = static_cast<char>(short_capacity - n);
+  }
+  void set_size(size_type n) noexcept {
+    if (is_long()) {
+      rep_.l.size = n;
+      rep_.l.data[n] = '\0';
+    } else {
+      set_short_size(n);
+    }
+  }
+
+  char* allocate(size_type capacity) { return alloc().allocate(capacity + 1); }
+  void release() noexcept {
+    if (is_long()) {
+      alloc().deallocate(rep_.l.data, decode_capacity(rep_.l.capacity) + 1);
+    }
+  }
+  void set_long(char* p, size_type n, size_type capacity) noexcept {
+    rep_.l.data = p;
+    rep_.l.size = n;
+    rep_.l.capacity = encode_capacity(capacity);
+    p[n] = '\0';
+  }
+  // takes rhs's characters and leaves it empty; the allocators must match
+  void steal(BasicString& rhs) noexcept {
+    rep_ = rhs.rep_;
+    rhs.set_short_size(0);
+  }
+
+  // a string of n unspecified characters
+  void init_uninitialized(size_type n) {
+    if (n <= short_capacity) {
+      set_short_size(n);
+    } else {
+      set_long(allocate(n), n, n);
+    }
+  }
+  void init(const char* s, size_type n) {
+    init_uninitialized(n);
+    std::memcpy(data(), s, n);
+  }
+
+  // memcpy, minus the call for the single characters parsers and
+  // serializers append all the time
+  static void copy_chars(char* dst, const char* src, size_type n) noexcept {
+    if (n == 1) {
+      *dst = *src;
+    } else {
+      std::memcpy(dst, src, n);
+    }
+  }
+  // append() when the characters do not fit
+  BasicString& append_slow(const char* s, size_type n);
+  // moves the characters to a buffer of exactly this capacity
+  void reallocate(size_type capacity);
+  // makes room for at least n characters, at least doubling the capacity
+  void grow(size_type n) {
+    const size_type doubled = 2 * capacity();
+    reallocate(n > doubled ? n : doubled);
+  }
+
+  struct long_rep {
+    char* data;
+    size_t size;
+    size_t capacity;
+  };
+  union rep {
+    long_rep l;
+    char s[short_capacity + 1];
+  };
+  static_assert(sizeof(long_rep) == short_capacity + 1);
+
+  rep rep_;
+};
+
+typedef BasicString<> String;
+
+template <class Alloc>
+void BasicString<Alloc>::reallocate(size_type capacity) {
+  const size_type n = size();
+  assert(capacity >= n);
+  const bool was_long = is_long();
+  const size_type old_capacity = this->capacity();
+  char* p = allocate(capacity);
+  std::memcpy(p, data(), n);
+  if (was_long) {
+    tracystl::notify_reallocate(alloc(), old_capacity + 1, capacity + 1);
+    release();
+  }
+  set_long(p, n, capacity);
+}
+
+template <class Alloc>
+void BasicString<Alloc>::shrink_to_fit() {
+  if (!is_long()) {
+    return;
+  }
+  const size_type n = size();
+  if (n <= short_capacity) {
+    long_rep l = rep_.l;
+    std::memcpy(rep_.s, l.data, n);
+    set_short_size(n);
+    alloc().deallocate(l.data, decode_capacity(l.capacity) + 1);
+  } else if (n < capacity()) {
+    reallocate(n);
+  }
+}
+
+template <class Alloc>
+void BasicString<Alloc>::resize(size_type n, char ch) {
+  const size_type old = size();
+  if (n > old) {
+    append(n - old, ch);
+  } else {
+    set_size(n);
+  }
+}
+
+template <class Alloc>
+BasicString<Alloc>& BasicString<Alloc>::assign(const char* s, size_type n) {
+  if (n <= capacity()) {
+    // s may point into this string
+    std::memmove(data(), s, n);
+    set_size(n);
+    return *this;
+  }
+  char* p = allocate(n);
+  std::memcpy(p, s, n);
+  release();
+  set_long(p, n, n);
+  return *this;
+}
+
+template <class Alloc>
+BasicString<Alloc>& BasicString<Alloc>::append(const char* s, size_type n) {
+  // s lies before the end of the old characters if it points into this
+  // string, so it never overlaps the destination
+  if (is_long()) {
+    const size_type old = rep_.l.size;
+    if (n <= decode_capacity(rep_.l.capacity) - old) {
+      copy_chars(rep_.l.data + old, s, n);
+      rep_.l.size = old + n;
+      rep_.l.data[old + n] = '\0';
+      return *this;
+    }
+  } else {
+    const size_type old =
+        short_capacity - static_cast<unsigned char>(rep_.s[short_capacity]);
+    if (n <= short_capacity - old) {
+      copy_chars(rep_.s + old, s, n);
+      set_short_size(old + n);
+      return *this;
+    }
+  }
+  return append_slow(s, n);
+}
+
+template <class Alloc>
+BasicString<Alloc>& BasicString<Alloc>::append_slow(const char* s,
+                                                    size_type n) {
+  // s may point into this string, so copy it over before the old buffer
+  // goes away
+  const size_type old = size();
+  const size_type doubled = 2 * capacity();
+  const size_type capacity = old + n > doubled ? old + n : doubled;
+  char* p = allocate(capacity);
+  std::memcpy(p, data(), old);
+  std::memcpy(p + old, s, n);
+  if (is_long()) {
+    tracystl::notify_reallocate(alloc(), this->capacity() + 1, capacity + 1);
+  }
+  release();
+  set_long(p, old + n, capacity);
+  return *this;
+}
+
+template <class Alloc>
+BasicString<Alloc>& BasicString<Alloc>::append(size_type n, char ch) {
+  const size_type old = size();
+  if (n > capacity() - old) {
+    grow(old + n);
+  }
+  std::memset(data() + old, ch, n);
+  set_size(old + n);
+  return *this;
+}
+
+template <class Alloc>
+BasicString<Alloc>& BasicString<Alloc>::insert(size_type pos, StringView s) {
+  const size_type old = size();
+  assert(pos <= old);
+  if (s.size() > capacity() - old) {
+    // build the result in a new buffer; s may point into this string
+    const size_type doubled = 2 * capacity();
+    const size_type capacity =
+        old + s.size() > doubled ? old + s.size() : doubled;
+    char* p = allocate(capacity);
+    const char* d = data();
+    std::memcpy(p, d, pos);
+    std::memcpy(p + pos, s.data(), s.size());
+    std::memcpy(p + pos + s.size(), d + pos, old - pos);
+    if (is_long()) {
+      tracystl::notify_reallocate(alloc(), this->capacity() + 1,
+                                  capacity + 1);
+    }
+    release();
+    set_long(p, old + s.size(), capacity);
+    return *this;
+  }
+  char* d = data();
+  const char* src = s.data();
+  if (!std::less<const char*>()(src, d) &&
+      std::less<const char*>()(src, d + old)) {
+    // s is part of this string: insert a copy
+    BasicString copy(s, alloc());
+    return insert(pos, copy.view());
+  }
+  std::memmove(d + pos + s.size(), d + pos, old - pos);
+  std::memcpy(d + pos, src, s.size());
+  set_size(old + s.size());
+  return *this;
+}
+
+template <class Alloc>
+BasicString<Alloc>& BasicString<Alloc>::erase(size_type pos,
+                                              size_type n) noexcept {
+  const size_type old = size();
+  assert(pos <= old);
+  if (n > old - pos) {
+    n = old - pos;
+  }
+  char* d = data();
+  std::memmove(d + pos, d + pos + n, old - pos - n);
+  set_size(old - n);
+  return *this;
+}
+
+template <class Alloc>
+void swap(BasicString<Alloc>& lhs, BasicString<Alloc>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template <class Alloc>
+BasicString<Alloc> operator+(const BasicString<Alloc>& lhs, StringView rhs) {
+  BasicString<Alloc> result(lhs.get_allocator());
+  result.reserve(lhs.size() + rhs.size());
+  result.append(lhs.view()).append(rhs);
+  return result;
+}
+template <class Alloc>
+BasicString<Alloc> operator+(BasicString<Alloc>&& lhs, StringView rhs) {
+  lhs.append(rhs);
+  return std::move(lhs);
+}
+
+// Comparisons against strings, views and literals all go through StringView.
+// The BasicString pairs must be exact matches: otherwise the comparison of
+// two Allocator bases would be a better candidate.
+template <class Alloc>
+bool operator==(const BasicString<Alloc>& lhs,
+                const BasicString<Alloc>& rhs) noexcept {
+  return lhs.view() == rhs.view();
+}
+template <class Alloc>
+bool operator==(const BasicString<Alloc>& lhs, StringView rhs) noexcept {
+  return lhs.view() == rhs;
+}
+template <class Alloc>
+bool operator!=(const BasicString<Alloc>& lhs,
+                const BasicString<Alloc>& rhs) noexcept {
+  return lhs.view() != rhs.view();
+}
+template <class Alloc>
+bool operator!=(const BasicString<Alloc>& lhs, StringView rhs) noexcept {
+  return lhs.view() != rhs;
+}
+template <class Alloc>
+bool operator<(const BasicString<Alloc>& lhs,
+               const BasicString<Alloc>& rhs) noexcept {
+  return lhs.view() < rhs.view();
+}
+template <class Alloc>
+bool operator<(const BasicString<Alloc>& lhs, StringView rhs) noexcept {
+  return lhs.view() < rhs;
+}
+template <class Alloc>
+bool operator>(const BasicString<Alloc>& lhs,
+               const BasicString<Alloc>& rhs) noexcept {
+  return lhs.view() > rhs.view();
+}
+template <class Alloc>
+bool operator>(const BasicString<Alloc>& lhs, StringView rhs) noexcept {
+  return lhs.view() > rhs;
+}
+template <class Alloc>
+bool operator<=(const BasicString<Alloc>& lhs,
+                const BasicString<Alloc>& rhs) noexcept {
+  return lhs.view() <= rhs.view();
+}
+template <class Alloc>
+bool operator<=(const BasicString<Alloc>& lhs, StringView rhs) noexcept {
+  return lhs.view() <= rhs;
+}
+template <class Alloc>
+bool operator>=(const BasicString<Alloc>& lhs,
+                const BasicString<Alloc>& rhs) noexcept {
+  return lhs.view() >= rhs.view();
+}
+template <class Alloc>
+bool operator>=(const BasicString<Alloc>& lhs, StringView rhs) noexcept {
+  return lhs.view() >= rhs;
+}
+
+template <class Alloc>
+std::ostream& operator<<(std::ostream& os, const BasicString<Alloc>& s) {
+  return os << s.view();
+}
+
+}  // namespace tracystl
+
+// hashes like the std::string with the same characters, so String keys work
+// in HashMap (whose default hasher is std::hash)
+template <class Alloc>
+struct std::hash<tracystl::BasicString<Alloc>> {
+  size_t operator()(const tracystl::BasicString<Alloc>& s) const noexcept {
+    return std::hash<std::string_view>()(s.view());
+  }
+};
+
+#endif  // _TRACYSTL_TRACY_STRING_H_
@@ -0,0 +1,37 @@
+#ifndef _TRACYSTL_TYPE_TRAITS_H_
+#define _TRACYSTL_TYPE_TRAITS_H_
+
+#include <type_traits>
+#include <utility>
+
+namespace tracystl {
+
+// A type is trivially relocatable if moving an object to a new address and
+// ending the lifetime of the old one is equivalent to a plain memcpy of its
+// bytes. Every trivially copyable type qualifies. Many other types do as well
+// (e.g. a struct holding a heap pointer with no self-references), but the
+// compiler cannot prove it, so users opt in by specializing this trait:
+//
+//   template <> struct tracystl::is_trivially_relocatable<MyType>
+//       : std::true_type {};
+//
+// Containers use it to move whole buffers with memcpy/memmove when they grow.
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// std::pair is never trivially copyable (its assignment operators are
+// user-provided), but it is just its two members laid out side by side.
+template <class T1, class T2>
+struct is_trivially_relocatable<std::pair<T1, T2>>
+    : std::integral_constant<
+          bool, is_trivially_relocatable<std::remove_const_t<T1>>::value &&
+                    is_trivially_relocatable<std::remove_const_t<T2>>::value> {
+};
+
+template <class T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_TYPE_TRAITS_H_
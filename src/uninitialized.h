@@ -0,0 +1,173 @@
+#ifndef _TRACYSTL_UNINITIALIZED_H_
+#define _TRACYSTL_UNINITIALIZED_H_
+
+#include "type_traits.h"
+#include <algorithm>
+#include <cstddef> // For std::size_t
+#include <cstring> // For std::memcpy, std::memmove
+#include <memory>  // For std::construct_at
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// constexpr only from C++20 on: that is when placement construction
+// (std::construct_at), destructors and union member switching became
+// usable in constant evaluation.
+#ifndef TRACYSTL_CONSTEXPR20
+#if __cplusplus >= 202002L
+#define TRACYSTL_CONSTEXPR20 constexpr
+#else
+#define TRACYSTL_CONSTEXPR20
+#endif
+#endif
+
+namespace tracystl {
+
+// Relocation = "move the objects in [first, last) to raw memory at dest, then
+// end the lifetime of the originals". After the call [first, last) is raw
+// memory again and may be deallocated without running any destructor.
+//
+// For trivially relocatable types this is a single memcpy. Otherwise every
+// element is move constructed (or copy constructed, if its move constructor
+// may throw, so the strong exception guarantee holds) and the source is
+// destroyed afterwards.
+//
+// The ranges must not overlap. Returns the end of the destination range.
+template <class T>
+T* uninitialized_relocate(T* first, T* last, T* dest) {
+  if constexpr (is_trivially_relocatable_v<T>) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    // memcpy with a null pointer is undefined even when n == 0.
+    if (n != 0) {
+      std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                  n * sizeof(T));
+    }
+    return dest + n;
+  } else {
+    T* cur = dest;
+    try {
+      for (T* it = first; it != last; ++it, ++cur) {
+        ::new (static_cast<void*>(cur)) T(std::move_if_noexcept(*it));
+      }
+    } catch (...) {
+      // the source is still intact, only roll back what we built.
+      for (; dest != cur; ++dest) {
+        dest->~T();
+      }
+      throw;
+    }
+    for (; first != last; ++first) {
+      first->~T();
+    }
+    return cur;
+  }
+}
+
+// Same as uninitialized_relocate but the ranges may overlap. This is the
+// primitive used to open or close a gap inside one buffer (insert/erase) or
+// to move values between fixed-size nodes. Trivially relocatable types are
+// moved with one memmove; any other type one element at a time, front to
+// back or back to front so that no source is overwritten before it is read.
+// A relocation that fails halfway cannot be undone, so T's move constructor
+// must not throw.
+template <class T>
+T* uninitialized_relocate_overlapping(T* first, T* last, T* dest) noexcept {
+  const std::size_t n = static_cast<std::size_t>(last - first);
+  if (n == 0 || dest == first) {
+    return dest + n;
+  }
+  if constexpr (is_trivially_relocatable_v<T>) {
+    std::memmove(static_cast<void*>(dest), static_cast<const void*>(first),
+                 n * sizeof(T));
+  } else if (dest < first) {
+    for (std::size_t i = 0; i < n; ++i) {
+      ::new (static_cast<void*>(dest + i)) T(std::move(first[i]));
+      first[i].~T();
+    }
+  } else {
+    for (std::size_t i = n; i-- > 0;) {
+      ::new (static_cast<void*>(dest + i)) T(std::move(first[i]));
+      first[i].~T();
+    }
+  }
+  return dest + n;
+}
+
+template <class T>
+T* uninitialized_relocate_overlapping_n(T* first, std::size_t n,
+                                        T* dest) noexcept {
+  return uninitialized_relocate_overlapping(first, first + n, dest);
+}
+
+// memmove and memcpy are not allowed in constant evaluation
+constexpr bool in_constant_evaluation() noexcept {
+#if __cplusplus >= 202002L
+  return std::is_constant_evaluated();
+#else
+  return false;
+#endif
+}
+
+// The two halves of positional insert/erase shared by Vector, SmallVector and
+// StaticVector. They leave the size bookkeeping to the container.
+
+// Shifts [pos, end) up by one slot and puts value at pos; end is raw memory
+// with room for one element and pos != end. Trivially relocatable types are
+// moved with one memmove and value is constructed in the gap, which is closed
+// again if that throws. Other types are shifted by move construction of the
+// last element and move assignment of the rest; if an assignment throws,
+// every element keeps a valid value and end is raw memory again.
+template <class T>
+TRACYSTL_CONSTEXPR20 void shift_insert(T* pos, T* end, T&& value) {
+  if constexpr (is_trivially_relocatable_v<T>) {
+    if (!in_constant_evaluation()) {
+      uninitialized_relocate_overlapping(pos, end, pos + 1);
+      try {
+        ::new (static_cast<void*>(pos)) T(std::move(value));
+      } catch (...) {
+        uninitialized_relocate_overlapping(pos + 1, end + 1, pos);
+        throw;
+      }
+      return;
+    }
+  }
+#if __cplusplus >= 202002L
+  std::construct_at(end, std::move(*(end - 1)));
+#else
+  ::new (static_cast<void*>(end)) T(std::move(*(end - 1)));
+#endif
+  try {
+    std::move_backward(pos, end - 1, end);
+    *pos = std::move(value);
+  } catch (...) {
+    end->~T();
+    throw;
+  }
+}
+
+// Destroys [first, last) and shifts [last, end) down to first. Returns the
+// new end; the slots behind it are raw memory.
+template <class T>
+TRACYSTL_CONSTEXPR20 T* shift_erase(T* first, T* last, T* end) {
+  T* new_end = first + (end - last);
+  if constexpr (is_trivially_relocatable_v<T>) {
+    if (!in_constant_evaluation()) {
+      for (T* it = first; it != last; ++it) {
+        it->~T();
+      }
+      uninitialized_relocate_overlapping(last, end, first);
+      return new_end;
+    }
+  }
+  std::move(last, end, first);
+  if constexpr (!std::is_trivially_destructible<T>::value) {
+    for (T* it = new_end; it != end; ++it) {
+      it->~T();
+    }
+  }
+  return new_end;
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_UNINITIALIZED_H_
@@ -0,0 +1,439 @@
+#ifndef _TRACYSTL_UNROLLED_LIST_H_
+#define _TRACYSTL_UNROLLED_LIST_H_
+
+#include "allocator.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "uninitialized.h"
+#include <cassert>
+#include <cstddef> // For std::size_t
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tracystl {
+
+// Bytes per UnrolledList chunk, a few cache lines. A traversal touches one
+// chunk per node_values elements instead of one node per element.
+#ifndef TRACYSTL_UNROLLED_LIST_NODE_BYTES
+#define TRACYSTL_UNROLLED_LIST_NODE_BYTES 256
+#endif
+
+namespace unrolled_list_detail {
+
+// The sentinel is a bare node_base with count 0, so stepping past the last
+// value of the last chunk lands on (sentinel, 0), which is end().
+struct node_base {
+  node_base* prev;
+  node_base* next;
+  size_t count;
+};
+
+template <class T, size_t NodeBytes>
+struct node : node_base {
+  static constexpr size_t fitting =
+      NodeBytes > sizeof(node_base) ? (NodeBytes - sizeof(node_base)) / sizeof(T)
+                                    : 0;
+  // at least 4 values, so a split leaves two non-empty halves and the
+  // underflow threshold below is at least one
+  static constexpr size_t capacity = fitting < 4 ? 4 : fitting;
+  // an erase that leaves fewer values than this pulls values over from a
+  // neighbour
+  static constexpr size_t min_values = capacity / 4;
+
+  alignas(T) unsigned char storage[capacity * sizeof(T)];
+
+  T* values() noexcept { return reinterpret_cast<T*>(storage); }
+};
+
+}  // namespace unrolled_list_detail
+
+template <class T, size_t NodeBytes, class Ref, class Ptr>
+class unrolled_list_iterator
+    : public tracystl::iterator<tracystl::bidirectional_iterator_tag, T,
+                                std::ptrdiff_t, Ptr, Ref> {
+  typedef unrolled_list_detail::node_base base_type;
+  typedef unrolled_list_detail::node<T, NodeBytes> node_type;
+
+ public:
+  unrolled_list_iterator() noexcept : node_(nullptr), index_(0) {}
+  unrolled_list_iterator(base_type* n, size_t index) noexcept
+      : node_(n), index_(index) {}
+  // iterator -> const_iterator
+  template <class R, class P,
+            class = typename std::enable_if<
+                std::is_convertible<P, Ptr>::value>::type>
+  unrolled_list_iterator(
+      const unrolled_list_iterator<T, NodeBytes, R, P>& rhs) noexcept
+      : node_(rhs.node_), index_(rhs.index_) {}
+
+  Ref operator*() const noexcept {
+    return static_cast<node_type*>(node_)->values()[index_];
+  }
+  Ptr operator->() const noexcept {
+    return static_cast<node_type*>(node_)->values() + index_;
+  }
+
+  unrolled_list_iterator& operator++() noexcept {
+    if (++index_ == node_->count) {
+      node_ = node_->next;
+      index_ = 0;
+    }
+    return *this;
+  }
+  unrolled_list_iterator operator++(int) noexcept {
+    unrolled_list_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  unrolled_list_iterator& operator--() noexcept {
+    if (index_ == 0) {
+      node_ = node_->prev;
+      index_ = node_->count;
+    }
+    --index_;
+    return *this;
+  }
+  unrolled_list_iterator operator--(int) noexcept {
+    unrolled_list_iterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  template <class R, class P>
+  bool operator==(
+      const unrolled_list_iterator<T, NodeBytes, R, P>& rhs) const noexcept {
+    return node_ == rhs.node_ && index_ == rhs.index_;
+  }
+  template <class R, class P>
+  bool operator!=(
+      const unrolled_list_iterator<T, NodeBytes, R, P>& rhs) const noexcept {
+    return !(*this == rhs);
+  }
+
+ private:
+  template <class, size_t, class, class>
+  friend class unrolled_list_iterator;
+  template <class, class, size_t>
+  friend class UnrolledList;
+
+  base_type* node_;
+  size_t index_;
+};
+
+// A doubly linked list of chunks that each hold up to node_values elements
+// in order. Traversal walks contiguous values and follows one pointer per
+// chunk; inserting or erasing shifts at most one chunk's worth of values.
+//
+// Inserting into a full chunk splits it in half (or, at its front, starts a
+// new chunk), so push_back and push_front fill chunks completely. An erase
+// that leaves a chunk less than a quarter full merges it with a neighbour,
+// or evens the two out when they do not fit into one chunk. Any insertion or
+// erase invalidates all iterators except the one it returns. Values are
+// shifted within and between chunks by uninitialized_relocate_overlapping,
+// so T's move constructor must not throw.
+//
+// Alloc is rebound to the chunk type, so PoolAllocator works as for List.
+template <class T, class Alloc = tracystl::Allocator<T>,
+          size_t NodeBytes = TRACYSTL_UNROLLED_LIST_NODE_BYTES>
+class UnrolledList
+    : private allocator_holder<typename Alloc::template rebind<
+          unrolled_list_detail::node<T, NodeBytes>>::other> {
+ public:
+  typedef T value_type;
+  typedef Alloc allocator_type;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef unrolled_list_iterator<T, NodeBytes, T&, T*> iterator;
+  typedef unrolled_list_iterator<T, NodeBytes, const T&, const T*>
+      const_iterator;
+
+ private:
+  typedef unrolled_list_detail::node_base base_type;
+  typedef unrolled_list_detail::node<T, NodeBytes> node_type;
+  typedef typename Alloc::template rebind<node_type>::other node_allocator;
+  typedef allocator_holder<node_allocator> alloc_base;
+
+ public:
+  static constexpr size_type node_values = node_type::capacity;
+
+  UnrolledList() noexcept : head_{&head_, &head_, 0}, size_(0) {}
+  explicit UnrolledList(const allocator_type& a)
+      : alloc_base(node_allocator(a)), head_{&head_, &head_, 0}, size_(0) {}
+  UnrolledList(std::initializer_list<T> ilist,
+               const allocator_type& a = allocator_type())
+      : UnrolledList(a) {
+    for (const T& value : ilist) {
+      emplace_back(value);
+    }
+  }
+  // the sentinel's address is part of the list, it cannot be copied bitwise
+  UnrolledList(const UnrolledList&) = delete;
+  UnrolledList& operator=(const UnrolledList&) = delete;
+  ~UnrolledList() { clear(); }
+
+  allocator_type get_allocator() const {
+    return allocator_type(alloc_base::alloc());
+  }
+
+  iterator begin() noexcept { return iterator(head_.next, 0); }
+  const_iterator begin() const noexcept {
+    return const_iterator(head_.next, 0);
+  }
+  iterator end() noexcept { return iterator(&head_, 0); }
+  const_iterator end() const noexcept {
+    return const_iterator(const_cast<base_type*>(&head_), 0);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *--end(); }
+  const_reference back() const { return *--end(); }
+
+  void clear() noexcept;
+
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+  iterator insert(const_iterator pos, const T& value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, T&& value) {
+    return emplace(pos, std::move(value));
+  }
+  iterator erase(const_iterator pos);
+
+  template <class... Args>
+  reference emplace_back(Args&&... args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+  template <class... Args>
+  reference emplace_front(Args&&... args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+  }
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  void push_front(const T& value) { emplace_front(value); }
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+  void pop_back() { erase(--end()); }
+  void pop_front() { erase(begin()); }
+
+  // number of chunks in use, for tests and tuning
+  size_type node_count() const noexcept {
+    size_type n = 0;
+    for (const base_type* p = head_.next; p != &head_; p = p->next) {
+      ++n;
+    }
+    return n;
+  }
+
+ private:
+  node_allocator& node_alloc() noexcept { return alloc_base::alloc(); }
+
+  static T* values(base_type* n) noexcept {
+    return static_cast<node_type*>(n)->values();
+  }
+
+  static void destroy_values(base_type* n) noexcept {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for (size_t i = 0; i < n->count; ++i) {
+        values(n)[i].~T();
+      }
+    }
+  }
+  // a new empty chunk linked in before next
+  base_type* link_node_before(base_type* next);
+  void unlink_node(base_type* n) noexcept;
+  // moves the last count values of n to the front of n->next
+  static void shift_right(base_type* n, size_t count) noexcept;
+  // moves the first count values of n->next to the end of n
+  static void shift_left(base_type* n, size_t count) noexcept;
+  // refills n after an erase left it underfull; (n, index) is the erase's
+  // result and is returned updated
+  iterator rebalance(base_type* n, size_t index) noexcept;
+  // (n, index) with index == n->count moved on to the next chunk
+  iterator normalize(base_type* n, size_t index) noexcept {
+    return index == n->count ? iterator(n->next, 0) : iterator(n, index);
+  }
+
+  base_type head_;
+  size_type size_;
+};
+
+template <class T, class Alloc, size_t NodeBytes>
+void UnrolledList<T, Alloc, NodeBytes>::clear() noexcept {
+  base_type* cur = head_.next;
+  if constexpr (has_bulk_release<node_allocator>::value) {
+    // every chunk came from our own pool: run the destructors (if any) and
+    // hand the whole slab chain back at once
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for (; cur != &head_; cur = cur->next) {
+        destroy_values(cur);
+      }
+    }
+    node_alloc().release();
+  } else {
+    while (cur != &head_) {
+      base_type* next = cur->next;
+      destroy_values(cur);
+      node_alloc().deallocate(static_cast<node_type*>(cur), 1);
+      cur = next;
+    }
+  }
+  head_.prev = head_.next = &head_;
+  size_ = 0;
+}
+
+template <class T, class Alloc, size_t NodeBytes>
+typename UnrolledList<T, Alloc, NodeBytes>::base_type*
+UnrolledList<T, Alloc, NodeBytes>::link_node_before(base_type* next) {
+  base_type* n = node_alloc().allocate(1);
+  n->count = 0;
+  n->next = next;
+  n->prev = next->prev;
+  next->prev->next = n;
+  next->prev = n;
+  return n;
+}
+
+template <class T, class Alloc, size_t NodeBytes>
+void UnrolledList<T, Alloc, NodeBytes>::unlink_node(base_type* n) noexcept {
+  n->prev->next = n->next;
+  n->next->prev = n->prev;
+  node_alloc().deallocate(static_cast<node_type*>(n), 1);
+}
+
+template <class T, class Alloc, size_t NodeBytes>
+void UnrolledList<T, Alloc, NodeBytes>::shift_right(base_type* n,
+                                                    size_t count) noexcept {
+  base_type* next = n->next;
+  tracystl::uninitialized_relocate_overlapping_n(values(next), next->count,
+                                                 values(next) + count);
+  tracystl::uninitialized_relocate_overlapping_n(values(n) + n->count - count,
+                                                 count, values(next));
+  n->count -= count;
+  next->count += count;
+}
+
+template <class T, class Alloc, size_t NodeBytes>
+void UnrolledList<T, Alloc, NodeBytes>::shift_left(base_type* n,
+                                                   size_t count) noexcept {
+  base_type* next = n->next;
+  tracystl::uninitialized_relocate_overlapping_n(values(next), count,
+                                                 values(n) + n->count);
+  tracystl::uninitialized_relocate_overlapping_n(values(next) + count,
+                                                 next->count - count,
+                                                 values(next));
+  n->count += count;
+  next->count -= count;
+}
+
+template <class T, class Alloc, size_t NodeBytes>
+template <class... Args>
+typename UnrolledList<T, Alloc, NodeBytes>::iterator
+UnrolledList<T, Alloc, NodeBytes>::emplace(const_iterator pos,
+                                           Args&&... args) {
+  base_type* n = pos.node_;
+  size_t index = pos.index_;
+  if (index == 0 && n->prev != &head_ &&
+      n->prev->count < node_type::capacity) {
+    // append to the previous chunk instead of shifting this one
+    n = n->prev;
+    index = n->count;
+  } else if (n == &head_ || (index == 0 && n->count == node_type::capacity)) {
+    n = link_node_before(n);
+  } else if (n->count == node_type::capacity) {
+    link_node_before(n->next);
+    const size_t half = node_type::capacity / 2;
+    shift_right(n, node_type::capacity - half);
+    if (index > half) {
+      n = n->next;
+      index -= half;
+    }
+  }
+
+  T* slot = values(n) + index;
+  tracystl::uninitialized_relocate_overlapping_n(slot, n->count - index,
+                                                 slot + 1);
+  try {
+    ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+  } catch (...) {
+    tracystl::uninitialized_relocate_overlapping_n(slot + 1, n->count - index,
+                                                   slot);
+    if (n->count == 0) {
+      unlink_node(n);
+    }
+    throw;
+  }
+  ++n->count;
+  ++size_;
+  return iterator(n, index);
+}
+
+template <class T, class Alloc, size_t NodeBytes>
+typename UnrolledList<T, Alloc, NodeBytes>::iterator
+UnrolledList<T, Alloc, NodeBytes>::erase(const_iterator pos) {
+  assert(pos != end());
+  base_type* n = pos.node_;
+  const size_t index = pos.index_;
+  T* slot = values(n) + index;
+  slot->~T();
+  tracystl::uninitialized_relocate_overlapping_n(slot + 1, n->count - index - 1,
+                                                 slot);
+  --n->count;
+  --size_;
+  if (n->count == 0) {
+    base_type* next = n->next;
+    unlink_node(n);
+    return iterator(next, 0);
+  }
+  if (n->count < node_type::min_values) {
+    return rebalance(n, index);
+  }
+  return normalize(n, index);
+}
+
+template <class T, class Alloc, size_t NodeBytes>
+typename UnrolledList<T, Alloc, NodeBytes>::iterator
+UnrolledList<T, Alloc, NodeBytes>::rebalance(base_type* n,
+                                             size_t index) noexcept {
+  const size_t capacity = node_type::capacity;
+  if (n->next != &head_) {
+    // pull values from the next chunk; (n, index) stays put, and if it was
+    // one past n's last value it now names the first value pulled over
+    base_type* next = n->next;
+    if (n->count + next->count <= capacity) {
+      shift_left(n, next->count);
+      unlink_node(next);
+    } else {
+      shift_left(n, (next->count - n->count) / 2);
+    }
+    return normalize(n, index);
+  }
+  if (n->prev != &head_) {
+    // n is the last chunk: push its values into the previous one
+    base_type* prev = n->prev;
+    const size_t offset = prev->count;
+    if (n->count + prev->count <= capacity) {
+      const bool at_end = index == n->count;
+      shift_left(prev, n->count);
+      unlink_node(n);
+      return at_end ? end() : iterator(prev, offset + index);
+    }
+    const size_t moved = (prev->count - n->count) / 2;
+    shift_right(prev, moved);
+    return normalize(n, index + moved);
+  }
+  return normalize(n, index);
+}
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_UNROLLED_LIST_H_
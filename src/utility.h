@@ -0,0 +1,16 @@
+#ifndef _TRACYSTL_UTILITY_H_
+#define _TRACYSTL_UTILITY_H_
+
+namespace tracystl {
+
+// Tag for constructors and insert overloads of ordered containers: the
+// input is already sorted by the container's comparator and free of
+// duplicates, so it can be appended without searching.
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+}  // namespace tracystl
+
+#endif  // _TRACYSTL_UTILITY_H_
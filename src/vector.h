@@ -3,43 +3,102 @@
 
 #include "allocator.h"
 #include "iterator.h"
+#include "uninitialized.h"
+#include <algorithm>
 #include <cstddef> // For std::size_t
+#include <utility>
 
 namespace tracystl {
 
-template <class T>
-class Vector {
+// Growth policies decide the new capacity once a Vector runs out of room.
+// `required` is the smallest capacity that fits the pending insertion; the
+// result must be at least that large.
+
+// Double the capacity: fewest reallocations, up to 2x memory overhead.
+struct vector_growth_2x {
+  static size_t next_capacity(size_t capacity, size_t required) {
+    const size_t grown = capacity != 0 ? 2 * capacity : 1;
+    return grown > required ? grown : required;
+  }
+};
+
+// Grow by half: more reallocations, but at most 1.5x memory overhead and the
+// freed blocks can eventually be reused by the allocator.
+struct vector_growth_1_5x {
+  static size_t next_capacity(size_t capacity, size_t required) {
+    const size_t grown = capacity != 0 ? capacity + (capacity + 1) / 2 : 1;
+    return grown > required ? grown : required;
+  }
+};
+
+// Grow by a fixed number of elements: bounded waste, linear reallocations.
+template <size_t Chunk>
+struct vector_growth_chunk {
+  static_assert(Chunk > 0, "chunk size must be positive");
+  static size_t next_capacity(size_t capacity, size_t required) {
+    const size_t grown = capacity + Chunk;
+    return grown > required ? grown : required;
+  }
+};
+
+template <class T, class Alloc = tracystl::Allocator<T>,
+          class GrowthPolicy = vector_growth_2x>
+class Vector : private allocator_holder<Alloc> {
  public:
   typedef T value_type;
   typedef value_type* iterator;
-  typedef tracystl::Allocator<value_type> allocator_type;
+  typedef Alloc allocator_type;
   typedef typename allocator_type::size_type size_type;
   typedef typename allocator_type::reference reference;
   typedef typename allocator_type::const_reference const_reference;
-  // take advantage of static member function
-  typedef tracystl::Allocator<value_type> data_allocator;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+  typedef Alloc data_allocator;
   typedef const value_type* const_iterator;
+  typedef GrowthPolicy growth_policy;
 
  private:
+  typedef allocator_holder<Alloc> alloc_base;
+  using alloc_base::alloc;
+
   iterator begin_;
   iterator end_;
   iterator capacity_;
 
  public:
   Vector() : begin_(nullptr), end_(nullptr), capacity_(nullptr) {}
+  explicit Vector(const allocator_type& a)
+      : alloc_base(a), begin_(nullptr), end_(nullptr), capacity_(nullptr) {}
+  explicit Vector(size_type n, const allocator_type& a = allocator_type())
+      : Vector(a) {
+    resize(n);
+  }
+  Vector(size_type n, const value_type& value,
+         const allocator_type& a = allocator_type())
+      : Vector(a) {
+    resize(n, value);
+  }
   ~Vector() {
-    data_allocator::destroy(begin_, end_);
-    data_allocator::deallocate(begin_);
-  }
-  Vector(const Vector& rhs) {
-    const size_t size = rhs.size();
-    begin_ = data_allocator::allocate(size);
-    end_ = begin_ + size;
-    capacity_ = end_;
-    for (size_t i = 0; i < size; ++i) {
-      data_allocator::construct(begin_ + i, *(rhs.begin_ + i));
+    alloc().destroy(begin_, end_);
+    alloc().deallocate(begin_, capacity());
+  }
+  Vector(const Vector& rhs) : Vector(rhs.alloc()) {
+    reserve(rhs.size());
+    for (const_iterator it = rhs.begin(); it != rhs.end(); ++it) {
+      alloc().construct(end_, *it);
+      ++end_;
     }
   }
+  // steal the buffer, rhs is left empty
+  Vector(Vector&& rhs) noexcept
+      : alloc_base(std::move(rhs.alloc())),
+        begin_(rhs.begin_),
+        end_(rhs.end_),
+        capacity_(rhs.capacity_) {
+    rhs.begin_ = rhs.end_ = rhs.capacity_ = nullptr;
+  }
+
+  allocator_type get_allocator() const { return alloc(); }
 
   iterator begin() { return begin_; }
   const_iterator begin() const noexcept { return begin_; }
@@ -47,6 +106,9 @@ class Vector {
   iterator end() { return end_; }
   const_iterator end() const noexcept { return end_; }
 
+  pointer data() noexcept { return begin_; }
+  const_pointer data() const noexcept { return begin_; }
+
   size_t size() const { return static_cast<size_type>(end_ - begin_); }
   size_t capacity() const { return static_cast<size_type>(capacity_ - begin_); }
 
@@ -54,26 +116,56 @@ class Vector {
 
   // in fact, begin_[n] will also work.
   reference operator[](size_t n) { return *(begin_ + n); }
-  const reference operator[](size_t n) const { return *(begin_ + n); }
+  const_reference operator[](size_t n) const { return *(begin_ + n); }
   //assignment
-  Vector& operator=(const Vector& rhs){
-    if(this != &rhs){
-      const size_t size = rhs.size();
-      begin_ = data_allocator::allocate(size);
-      end_ = begin_ + size;
-      capacity_ = end_;
-      for (size_t i = 0; i < size; ++i) {
-        data_allocator::construct(begin_ + i, *(rhs.begin_ + i));
-      }
+  Vector& operator=(const Vector& rhs);
+  Vector& operator=(Vector&& rhs) noexcept {
+    if (this != &rhs) {
+      Vector tmp(std::move(rhs));
+      swap(tmp);
     }
     return *this;
   }
 
-  void clear(){end_ = begin_;}
+  void swap(Vector& rhs) noexcept {
+    using std::swap;
+    swap(alloc(), rhs.alloc());
+    std::swap(begin_, rhs.begin_);
+    std::swap(end_, rhs.end_);
+    std::swap(capacity_, rhs.capacity_);
+  }
+
+  // capacity
+  void reserve(size_type n) {
+    if (n > capacity()) {
+      reallocate(n);
+    }
+  }
+  void shrink_to_fit() {
+    if (end_ != capacity_) {
+      reallocate(size());
+    }
+  }
+  void resize(size_type n);
+  void resize(size_type n, const value_type& value);
+
+  // destroys the elements but keeps the buffer
+  void clear() {
+    alloc().destroy(begin_, end_);
+    end_ = begin_;
+  }
 
   void push_back(const value_type& value);
+  void push_back(value_type&& value);
+
+  // constructs the element in place, no temporary is created
+  template <class... Args>
+  reference emplace_back(Args&&... args);
 
-  void pop_back() { --end_; }
+  void pop_back() {
+    --end_;
+    alloc().destroy(end_);
+  }
 
   reference front() { return *begin_; }
 
@@ -83,32 +175,201 @@ class Vector {
 
   const_reference back() const { return *(end_ - 1); }
 
-  // iterator insert(iterator pos, const_reference value){
+  // Inserts before pos and returns an iterator to the new element. The
+  // elements after pos are shifted up by one: with a memmove for trivially
+  // relocatable types, by move assignment otherwise.
+  iterator insert(const_iterator pos, const value_type& value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, value_type&& value) {
+    return emplace(pos, std::move(value));
+  }
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
 
-  // }
+  // erase returns an iterator to the element that followed the erased ones
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last);
 
+ private:
+  size_type grow_capacity(size_type required) const {
+    return GrowthPolicy::next_capacity(capacity(), required);
+  }
+  void reallocate(size_type new_capacity);
+  template <class... Args>
+  void realloc_append(Args&&... args);
 };
 
-template <class T>
-void Vector<T>::push_back(const value_type& value) {
-  if(end_ == capacity_){
-    const size_t old_size = size();
-    const size_t new_size = old_size != 0 ? 2 * old_size : 1;
-    // printf("new_size: %zu\n", new_size);
-    iterator new_begin = data_allocator::allocate(new_size);
-
-    for(size_t i = 0; i < old_size; ++i){
-      data_allocator::construct(new_begin + i, *(begin_ + i));
-      data_allocator::destroy(begin_ + i);
+template <class T, class Alloc, class GrowthPolicy>
+Vector<T, Alloc, GrowthPolicy>&
+Vector<T, Alloc, GrowthPolicy>::operator=(const Vector& rhs) {
+  if (this != &rhs) {
+    if (rhs.size() > capacity()) {
+      // build the copy aside first so *this is untouched if a copy throws
+      Vector tmp(rhs);
+      swap(tmp);
+    } else {
+      // reuse the buffer we already own
+      clear();
+      for (const_iterator it = rhs.begin(); it != rhs.end(); ++it) {
+        alloc().construct(end_, *it);
+        ++end_;
+      }
+    }
+  }
+  return *this;
+}
+
+template <class T, class Alloc, class GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::resize(size_type n) {
+  if (n < size()) {
+    alloc().destroy(begin_ + n, end_);
+    end_ = begin_ + n;
+    return;
+  }
+  reserve(n);
+  for (; end_ != begin_ + n; ++end_) {
+    alloc().construct(end_);
+  }
+}
+
+template <class T, class Alloc, class GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::resize(size_type n,
+                                            const value_type& value) {
+  if (n < size()) {
+    alloc().destroy(begin_ + n, end_);
+    end_ = begin_ + n;
+    return;
+  }
+  if (n > capacity()) {
+    // value may live in our buffer, so copy it before the buffer moves
+    value_type copy(value);
+    reserve(n);
+    for (; end_ != begin_ + n; ++end_) {
+      alloc().construct(end_, copy);
     }
+    return;
+  }
+  for (; end_ != begin_ + n; ++end_) {
+    alloc().construct(end_, value);
+  }
+}
+
+template <class T, class Alloc, class GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::push_back(const value_type& value) {
+  if (end_ != capacity_) {
+    alloc().construct(end_, value);
+    ++end_;
+    return;
+  }
+  realloc_append(value);
+}
 
-    data_allocator::deallocate(begin_);
-    begin_ = new_begin;
-    end_ = new_begin + old_size;
-    capacity_ = new_begin + new_size;
+template <class T, class Alloc, class GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::push_back(value_type&& value) {
+  if (end_ != capacity_) {
+    alloc().construct(end_, std::move(value));
+    ++end_;
+    return;
   }
-  data_allocator::construct(end_, value);
-  end_++;
+  realloc_append(std::move(value));
+}
+
+template <class T, class Alloc, class GrowthPolicy>
+template <class... Args>
+typename Vector<T, Alloc, GrowthPolicy>::reference
+Vector<T, Alloc, GrowthPolicy>::emplace_back(Args&&... args) {
+  if (end_ != capacity_) {
+    alloc().construct(end_, std::forward<Args>(args)...);
+    ++end_;
+  } else {
+    realloc_append(std::forward<Args>(args)...);
+  }
+  return back();
+}
+
+template <class T, class Alloc, class GrowthPolicy>
+template <class... Args>
+typename Vector<T, Alloc, GrowthPolicy>::iterator
+Vector<T, Alloc, GrowthPolicy>::emplace(const_iterator pos, Args&&... args) {
+  const size_type index = static_cast<size_type>(pos - begin_);
+  if (pos == end_) {
+    emplace_back(std::forward<Args>(args)...);
+    return begin_ + index;
+  }
+  // args may refer to an element that is about to be shifted
+  value_type value(std::forward<Args>(args)...);
+  if (end_ == capacity_) {
+    reserve(grow_capacity(size() + 1));
+  }
+  iterator p = begin_ + index;
+  tracystl::shift_insert(p, end_, std::move(value));
+  ++end_;
+  return p;
+}
+
+template <class T, class Alloc, class GrowthPolicy>
+typename Vector<T, Alloc, GrowthPolicy>::iterator
+Vector<T, Alloc, GrowthPolicy>::erase(const_iterator first,
+                                      const_iterator last) {
+  iterator f = begin_ + (first - begin_);
+  iterator l = begin_ + (last - begin_);
+  if (f != l) {
+    end_ = tracystl::shift_erase(f, l, end_);
+  }
+  return f;
+}
+
+// Moves the elements into a buffer of exactly new_capacity slots.
+template <class T, class Alloc, class GrowthPolicy>
+void Vector<T, Alloc, GrowthPolicy>::reallocate(size_type new_capacity) {
+  const size_t old_size = size();
+  iterator new_begin = alloc().allocate(new_capacity);
+  try {
+    tracystl::uninitialized_relocate(begin_, end_, new_begin);
+  } catch (...) {
+    alloc().deallocate(new_begin, new_capacity);
+    throw;
+  }
+  tracystl::notify_reallocate(alloc(), capacity() * sizeof(T),
+                              new_capacity * sizeof(T));
+  alloc().deallocate(begin_, capacity());
+  begin_ = new_begin;
+  end_ = new_begin + old_size;
+  capacity_ = new_begin + new_capacity;
+}
+
+// Slow path of push_back: grow the buffer and append one element.
+// The new element is constructed first, while the old buffer is still alive,
+// because args may refer to an element of this very vector.
+// The old elements are then relocated (see uninitialized.h) instead of being
+// copied one by one, so for trivially relocatable types growth is one memcpy.
+template <class T, class Alloc, class GrowthPolicy>
+template <class... Args>
+void Vector<T, Alloc, GrowthPolicy>::realloc_append(Args&&... args) {
+  const size_t old_size = size();
+  const size_t new_size = grow_capacity(old_size + 1);
+  iterator new_begin = alloc().allocate(new_size);
+  try {
+    alloc().construct(new_begin + old_size, std::forward<Args>(args)...);
+  } catch (...) {
+    alloc().deallocate(new_begin, new_size);
+    throw;
+  }
+  try {
+    tracystl::uninitialized_relocate(begin_, end_, new_begin);
+  } catch (...) {
+    alloc().destroy(new_begin + old_size);
+    alloc().deallocate(new_begin, new_size);
+    throw;
+  }
+
+  tracystl::notify_reallocate(alloc(), capacity() * sizeof(T),
+                              new_size * sizeof(T));
+  alloc().deallocate(begin_, capacity());
+  begin_ = new_begin;
+  end_ = new_begin + old_size + 1;
+  capacity_ = new_begin + new_size;
 }
 
 }  // namespace tracystl
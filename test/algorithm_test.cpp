@@ -0,0 +1,192 @@
+#include "../src/algorithm.h"
+#include "../src/list.h"
+#include "../src/vector.h"
+#include "gtest/gtest.h"
+#include "simd_levels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using tracystl::simd_level;
+using tracystl::Vector;
+
+namespace {
+
+template <class T>
+Vector<T> random_vector(size_t n, int range, unsigned seed) {
+  std::mt19937 rng(seed);
+  Vector<T> vec;
+  for (size_t i = 0; i < n; ++i) {
+    vec.push_back(static_cast<T>(static_cast<int>(rng() % range) - range / 2));
+  }
+  return vec;
+}
+
+}  // namespace
+
+TEST(AlgorithmTest, SetSimdLevelIsClamped) {
+  tracystl::set_simd_level(simd_level::avx2);
+  EXPECT_EQ(tracystl::active_simd_level(), tracystl::cpu_simd_level());
+  tracystl::set_simd_level(simd_level::scalar);
+  EXPECT_EQ(tracystl::active_simd_level(), simd_level::scalar);
+  tracystl::set_simd_level(tracystl::cpu_simd_level());
+}
+
+TEST(AlgorithmTest, CopyMoveFill) {
+  Vector<int> src = random_vector<int>(100, 1000, 1);
+  Vector<int> dst(100);
+  EXPECT_EQ(tracystl::copy(src.begin(), src.end(), dst.begin()), dst.end());
+  EXPECT_TRUE(std::equal(src.begin(), src.end(), dst.begin()));
+  // overlapping, towards the front
+  tracystl::copy(dst.begin() + 10, dst.end(), dst.begin());
+  EXPECT_TRUE(std::equal(src.begin() + 10, src.end(), dst.begin()));
+
+  Vector<std::string> strings(3, "abc");
+  Vector<std::string> moved(3);
+  tracystl::move(strings.begin(), strings.end(), moved.begin());
+  EXPECT_EQ(moved[2], "abc");
+  EXPECT_TRUE(strings[2].empty());
+
+  tracystl::fill(dst.begin(), dst.end(), 0);
+  EXPECT_EQ(std::count(dst.begin(), dst.end(), 0), 100);
+  tracystl::fill(dst.begin(), dst.end(), 0x01020304);
+  EXPECT_EQ(std::count(dst.begin(), dst.end(), 0x01020304), 100);
+  Vector<float> floats(7);
+  tracystl::fill(floats.begin(), floats.end(), -0.0f);
+  EXPECT_TRUE(std::signbit(floats[6]));
+  Vector<char> chars(9);
+  tracystl::fill(chars.begin(), chars.end(), 'x');
+  EXPECT_EQ(std::string(chars.begin(), chars.end()), "xxxxxxxxx");
+
+  // non-contiguous iterators take the element loop
+  tracystl::List<int> list;
+  for (int i = 0; i < 5; ++i) {
+    list.push_back(i);
+  }
+  tracystl::copy(list.begin(), list.end(), dst.begin());
+  EXPECT_EQ(dst[4], 4);
+}
+
+TEST(AlgorithmTest, FindAndCountMatchStd) {
+  for_each_level([] {
+    for (size_t n : {0, 1, 3, 4, 7, 8, 15, 16, 31, 33, 64, 127, 300}) {
+      const Vector<int> ints = random_vector<int>(n, 40, n);
+      const Vector<float> floats = random_vector<float>(n, 40, n + 1);
+      const Vector<signed char> bytes = random_vector<signed char>(n, 40, n);
+      for (int v = -21; v <= 21; ++v) {
+        ASSERT_EQ(tracystl::find(ints.begin(), ints.end(), v),
+                  std::find(ints.begin(), ints.end(), v));
+        ASSERT_EQ(tracystl::count(ints.begin(), ints.end(), v),
+                  std::count(ints.begin(), ints.end(), v));
+        const float f = static_cast<float>(v);
+        ASSERT_EQ(tracystl::find(floats.begin(), floats.end(), f),
+                  std::find(floats.begin(), floats.end(), f));
+        ASSERT_EQ(tracystl::count(floats.begin(), floats.end(), f),
+                  std::count(floats.begin(), floats.end(), f));
+        const signed char c = static_cast<signed char>(v);
+        ASSERT_EQ(tracystl::find(bytes.begin(), bytes.end(), c),
+                  std::find(bytes.begin(), bytes.end(), c));
+        ASSERT_EQ(tracystl::count(bytes.begin(), bytes.end(), c),
+                  std::count(bytes.begin(), bytes.end(), c));
+      }
+    }
+    // more matches than a byte-sized counter can hold
+    const Vector<char> same(10000, 'a');
+    EXPECT_EQ(tracystl::count(same.begin(), same.end(), 'a'), 10000);
+  });
+  // a value of another type is compared with its own ==
+  Vector<int> ints(4, 1);
+  EXPECT_EQ(tracystl::find(ints.begin(), ints.end(), 1.5), ints.end());
+  EXPECT_EQ(tracystl::count(ints.begin(), ints.end(), 1L), 4);
+}
+
+TEST(AlgorithmTest, Equal) {
+  for_each_level([] {
+    for (size_t n : {0, 1, 5, 8, 17, 100}) {
+      Vector<float> a = random_vector<float>(n, 100, 3);
+      Vector<float> b = a;
+      EXPECT_TRUE(tracystl::equal(a.begin(), a.end(), b.begin()));
+      EXPECT_TRUE(tracystl::equal(a.begin(), a.end(), b.begin(), b.end()));
+      if (n != 0) {
+        b[n - 1] += 1.0f;
+        EXPECT_FALSE(tracystl::equal(a.begin(), a.end(), b.begin()));
+        // +0.0 == -0.0 although their bytes differ, NaN != NaN
+        a[n - 1] = 0.0f;
+        b[n - 1] = -0.0f;
+        EXPECT_TRUE(tracystl::equal(a.begin(), a.end(), b.begin()));
+        a[0] = b[0] = std::numeric_limits<float>::quiet_NaN();
+        EXPECT_FALSE(tracystl::equal(a.begin(), a.end(), b.begin()));
+      }
+    }
+  });
+  Vector<int> a = random_vector<int>(50, 100, 4);
+  Vector<int> b = a;
+  EXPECT_TRUE(tracystl::equal(a.begin(), a.end(), b.begin()));
+  EXPECT_FALSE(tracystl::equal(a.begin(), a.end(), b.begin(), b.end() - 1));
+  b[25] = -1000;
+  EXPECT_FALSE(tracystl::equal(a.begin(), a.end(), b.begin()));
+}
+
+TEST(AlgorithmTest, MinMaxElementMatchStd) {
+  for_each_level([] {
+    for (size_t n : {0, 1, 2, 7, 8, 9, 16, 33, 200}) {
+      // a small range makes the extreme values repeat: the first one wins
+      const Vector<int> ints = random_vector<int>(n, 10, n);
+      EXPECT_EQ(tracystl::min_element(ints.begin(), ints.end()),
+                std::min_element(ints.begin(), ints.end()));
+      EXPECT_EQ(tracystl::max_element(ints.begin(), ints.end()),
+                std::max_element(ints.begin(), ints.end()));
+      Vector<float> floats = random_vector<float>(n, 10, n);
+      EXPECT_EQ(tracystl::min_element(floats.begin(), floats.end()),
+                std::min_element(floats.begin(), floats.end()));
+      EXPECT_EQ(tracystl::max_element(floats.begin(), floats.end()),
+                std::max_element(floats.begin(), floats.end()));
+      if (n > 2) {
+        floats[n / 2] = std::numeric_limits<float>::quiet_NaN();
+        EXPECT_EQ(tracystl::min_element(floats.begin(), floats.end()),
+                  std::min_element(floats.begin(), floats.end()));
+        floats[0] = std::numeric_limits<float>::quiet_NaN();
+        EXPECT_EQ(tracystl::max_element(floats.begin(), floats.end()),
+                  std::max_element(floats.begin(), floats.end()));
+      }
+    }
+  });
+  Vector<int> extremes(20, 0);
+  extremes[13] = std::numeric_limits<int>::min();
+  extremes[17] = std::numeric_limits<int>::max();
+  EXPECT_EQ(tracystl::min_element(extremes.begin(), extremes.end()) -
+                extremes.begin(),
+            13);
+  EXPECT_EQ(tracystl::max_element(extremes.begin(), extremes.end()) -
+                extremes.begin(),
+            17);
+}
+
+TEST(AlgorithmTest, Accumulate) {
+  for_each_level([] {
+    for (size_t n : {0, 1, 15, 16, 17, 1000}) {
+      const Vector<int> ints = random_vector<int>(n, 2000, n);
+      EXPECT_EQ(tracystl::accumulate(ints.begin(), ints.end(), 7),
+                std::accumulate(ints.begin(), ints.end(), 7));
+      const Vector<unsigned> big(n, 0x80000001u);
+      EXPECT_EQ(tracystl::accumulate(big.begin(), big.end(), 0u),
+                std::accumulate(big.begin(), big.end(), 0u));
+    }
+  });
+  // a wider init sums in the wider type, as std::accumulate does
+  Vector<int> ints(4, std::numeric_limits<int>::max());
+  EXPECT_EQ(tracystl::accumulate(ints.begin(), ints.end(), int64_t{0}),
+            4 * int64_t{std::numeric_limits<int>::max()});
+  Vector<float> floats(3, 0.5f);
+  EXPECT_EQ(tracystl::accumulate(floats.begin(), floats.end(), 1.0f), 2.5f);
+  Vector<int> small(3, 2);
+  EXPECT_EQ(tracystl::accumulate(small.begin(), small.end(), 1,
+                                 [](int a, int b) { return a - b; }),
+            -5);
+}
@@ -1,7 +1,28 @@
 #include "../src/allocator.h"
+#include "../src/list.h"
+#include "../src/vector.h"
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+// count every global allocation made by this test binary
+static size_t global_news = 0;
+
+void* operator new(size_t size) {
+  ++global_news;
+  if (void* p = std::malloc(size != 0 ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
 // using tracystl::Allocator;
 typedef tracystl::Allocator<int> data_allocator;
 
@@ -40,3 +61,80 @@ TEST(AllocatorTest, ConstructAndDestroy) {
   data_allocator::destroy(ptr2);
   data_allocator::deallocate(ptr2, 1);
 }
+
+TEST(PoolAllocatorTest, CarvesSlotsFromSlabs) {
+  tracystl::PoolAllocator<double, 2> pool;
+  double* a = pool.allocate(1);
+  double* b = pool.allocate(1);
+  // consecutive slots of the same slab
+  EXPECT_EQ(b, a + 1);
+  double* c = pool.allocate(1);
+  EXPECT_NE(c, nullptr);
+
+  pool.deallocate(b, 1);
+  EXPECT_EQ(pool.allocate(1), b);
+
+  // bulk requests bypass the pool
+  double* many = pool.allocate(10);
+  pool.deallocate(many, 10);
+  pool.release();
+}
+
+TEST(ArenaTest, BumpAllocationAndAlignment) {
+  tracystl::MonotonicArena arena(64);
+  void* a = arena.allocate(3, 1);
+  void* b = arena.allocate(8, 8);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0u);
+  EXPECT_GT(b, a);
+  // bigger than a whole block
+  void* big = arena.allocate(1000, 64);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(big) % 64, 0u);
+}
+
+TEST(ArenaTest, ImpossibleSizesThrow) {
+  tracystl::MonotonicArena arena(64);
+  const size_t max = std::numeric_limits<size_t>::max();
+  // bytes + alignment would wrap around
+  EXPECT_THROW(arena.allocate(max), std::bad_alloc);
+  EXPECT_THROW(arena.allocate(max - 8, 16), std::bad_alloc);
+  // the arena is still usable
+  EXPECT_NE(arena.allocate(8), nullptr);
+}
+
+TEST(ArenaTest, InitialBufferIsUsedFirst) {
+  alignas(16) unsigned char buffer[128];
+  tracystl::MonotonicArena arena(buffer, sizeof(buffer));
+  const size_t before = global_news;
+  void* p = arena.allocate(100);
+  EXPECT_EQ(p, buffer);
+  EXPECT_EQ(global_news, before);
+  arena.allocate(100);  // spills into a heap block
+  EXPECT_EQ(global_news, before + 1);
+}
+
+TEST(ArenaTest, ContainersAllocateNothingAfterWarmUp) {
+  tracystl::MonotonicArena arena;
+  tracystl::ArenaAllocator<int> alloc(arena);
+  size_t warm_up_news = 0;
+  for (int request = 0; request < 3; ++request) {
+    const size_t before = global_news;
+    {
+      tracystl::Vector<int, tracystl::ArenaAllocator<int>> vec(alloc);
+      tracystl::List<int, tracystl::ArenaAllocator<int>> list(alloc);
+      for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+        list.push_back(i);
+      }
+      EXPECT_EQ(vec[999], 999);
+      EXPECT_EQ(list.back(), 999);
+    }
+    arena.reset();
+    if (request == 0) {
+      warm_up_news = global_news - before;
+      EXPECT_GT(warm_up_news, 0u);
+    } else {
+      // the blocks kept by reset() serve the whole request
+      EXPECT_EQ(global_news, before);
+    }
+  }
+}
@@ -0,0 +1,201 @@
+#include "../src/btree.h"
+#include "gtest/gtest.h"
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using tracystl::BTreeMap;
+using tracystl::BTreeSet;
+
+namespace {
+// walks the map both ways and compares it with the reference
+template <class Map, class Ref>
+void expect_same(const Map& map, const Ref& expected) {
+  ASSERT_EQ(map.size(), expected.size());
+  auto it = map.begin();
+  for (auto ex = expected.begin(); ex != expected.end(); ++ex, ++it) {
+    ASSERT_EQ(it->first, ex->first);
+    ASSERT_EQ(it->second, ex->second);
+  }
+  EXPECT_EQ(it, map.end());
+  for (auto ex = expected.rbegin(); ex != expected.rend(); ++ex) {
+    --it;
+    ASSERT_EQ(it->first, ex->first);
+  }
+  EXPECT_EQ(it, map.begin());
+}
+}  // namespace
+
+TEST(BTreeTest, IteratorCategory) {
+  typedef BTreeMap<int, int>::iterator iterator;
+  static_assert(std::is_same<iterator::iterator_category,
+                             tracystl::bidirectional_iterator_tag>::value);
+  // set elements are keys and cannot be modified in place
+  static_assert(std::is_same<BTreeSet<int>::iterator,
+                             BTreeSet<int>::const_iterator>::value);
+  static_assert(BTreeMap<int, int>::node_values >= 8);
+}
+
+TEST(BTreeTest, Empty) {
+  BTreeMap<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.lower_bound(1), map.end());
+  EXPECT_EQ(map.erase(1), 0);
+}
+
+TEST(BTreeTest, InsertFindBounds) {
+  BTreeMap<int, std::string> map;
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(map.insert({i * 2, std::to_string(i)}).second);
+  }
+  EXPECT_FALSE(map.insert({10, "x"}).second);
+  EXPECT_EQ(map.size(), 1000);
+  EXPECT_EQ(map.find(10)->second, "5");
+  EXPECT_EQ(map.find(11), map.end());
+  EXPECT_EQ(map.lower_bound(11)->first, 12);
+  EXPECT_EQ(map.lower_bound(12)->first, 12);
+  EXPECT_EQ(map.upper_bound(12)->first, 14);
+  EXPECT_EQ(map.upper_bound(1998), map.end());
+  map[7] = "seven";
+  EXPECT_EQ(map[7], "seven");
+  EXPECT_FALSE(map.insert_or_assign(7, "sept").second);
+  EXPECT_EQ(map.find(7)->second, "sept");
+}
+
+TEST(BTreeTest, MatchesStdMap) {
+  // 64-byte values give 3 values per node: deep trees, many splits/merges
+  BTreeMap<std::string, std::string> strings;
+  std::map<std::string, std::string> expected_strings;
+  BTreeMap<int, int> ints;
+  std::map<int, int> expected_ints;
+  std::mt19937 rng(11);
+  for (int i = 0; i < 40000; ++i) {
+    const int key = static_cast<int>(rng() % 2000);
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(ints.erase(key), expected_ints.erase(key));
+      EXPECT_EQ(strings.erase(std::to_string(key)),
+                expected_strings.erase(std::to_string(key)));
+    } else {
+      ints[key] = i;
+      expected_ints[key] = i;
+      strings[std::to_string(key)] = std::to_string(i);
+      expected_strings[std::to_string(key)] = std::to_string(i);
+    }
+  }
+  expect_same(ints, expected_ints);
+  expect_same(strings, expected_strings);
+}
+
+TEST(BTreeTest, EraseReturnsNext) {
+  BTreeMap<int, int> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 5000; ++i) {
+    map[i] = i;
+    expected[i] = i;
+  }
+  // erase every third element while walking, from internal nodes and leaves
+  auto it = map.begin();
+  int i = 0;
+  while (it != map.end()) {
+    if (i++ % 3 == 0) {
+      const int next = it->first + 1;
+      expected.erase(it->first);
+      it = map.erase(it);
+      if (it != map.end()) {
+        ASSERT_EQ(it->first, next);
+      }
+    } else {
+      ++it;
+    }
+  }
+  expect_same(map, expected);
+}
+
+TEST(BTreeTest, RangeErase) {
+  BTreeMap<int, int> map;
+  for (int i = 0; i < 10000; ++i) {
+    map[i] = i;
+  }
+  auto it = map.erase(map.lower_bound(1000), map.lower_bound(9000));
+  EXPECT_EQ(it->first, 9000);
+  EXPECT_EQ(map.size(), 2000);
+  --it;
+  EXPECT_EQ(it->first, 999);
+  map.erase(map.begin(), map.end());
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(BTreeTest, SortedBulkLoad) {
+  std::vector<std::pair<int, int>> sorted;
+  for (int i = 0; i < 100000; ++i) {
+    sorted.emplace_back(i, -i);
+  }
+  BTreeMap<int, int> map(tracystl::sorted_unique, sorted.begin(), sorted.end());
+  EXPECT_EQ(map.size(), sorted.size());
+  EXPECT_EQ(map.find(54321)->second, -54321);
+  // out-of-order input still ends up in the right place
+  std::vector<std::pair<int, int>> more = {{100005, 1}, {-1, 2}, {100010, 3}};
+  map.insert(tracystl::sorted_unique, more.begin(), more.end());
+  EXPECT_EQ(map.begin()->first, -1);
+  EXPECT_EQ((--map.end())->first, 100010);
+
+  std::vector<int> keys;
+  for (int i = 0; i < 1000; ++i) {
+    keys.push_back(i * 3);
+  }
+  BTreeSet<int> set(tracystl::sorted_unique, keys.begin(), keys.end());
+  EXPECT_EQ(set.size(), 1000);
+  EXPECT_EQ(*set.upper_bound(3), 6);
+}
+
+TEST(BTreeTest, Set) {
+  BTreeSet<std::string> set;
+  set.insert("b");
+  set.insert("a");
+  set.insert("c");
+  EXPECT_FALSE(set.insert("a").second);
+  std::string joined;
+  for (const std::string& s : set) {
+    joined += s;
+  }
+  EXPECT_EQ(joined, "abc");
+  set.erase(set.find("b"));
+  EXPECT_FALSE(set.contains("b"));
+  EXPECT_EQ(*set.lower_bound("b"), "c");
+}
+
+TEST(BTreeTest, CopyMove) {
+  BTreeMap<int, std::string> map;
+  for (int i = 0; i < 500; ++i) {
+    map[i] = std::to_string(i);
+  }
+  BTreeMap<int, std::string> copy(map);
+  map.clear();
+  EXPECT_EQ(copy.size(), 500);
+  EXPECT_EQ(copy[499], "499");
+  BTreeMap<int, std::string> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 500);
+  map = moved;
+  EXPECT_EQ(map.find(250)->second, "250");
+}
+
+TEST(BTreeTest, PoolAllocatedNodes) {
+  BTreeMap<int, int, std::less<int>,
+           tracystl::PoolAllocator<std::pair<const int, int>>>
+      map;
+  for (int i = 0; i < 20000; ++i) {
+    map[i * 7 % 20000] = i;
+  }
+  for (int i = 0; i < 20000; i += 2) {
+    map.erase(i);
+  }
+  EXPECT_EQ(map.size(), 10000);
+  EXPECT_EQ(map.begin()->first, 1);
+}
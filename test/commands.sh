@@ -15,4 +15,42 @@ g++ -std=c++17 iterator_test.cpp -lgtest -lgtest_main -pthread -o iterator_test
 #vector_test
 g++ -std=c++20 vector_test.cpp -lgtest -lgtest_main -pthread -o vector_test
 #list_test
-g++ -std=c++20 list_test.cpp -lgtest -lgtest_main -pthread -o list_test
\ No newline at end of file
+g++ -std=c++20 list_test.cpp -lgtest -lgtest_main -pthread -o list_test
+#thread_cache_allocator_test
+g++ -std=c++20 thread_cache_allocator_test.cpp -lgtest -lgtest_main -pthread -o thread_cache_allocator_test
+#instrumented_allocator_test
+g++ -std=c++20 -DTRACYSTL_ALLOC_STATS=1 instrumented_allocator_test.cpp -lgtest -lgtest_main -pthread -o instrumented_allocator_test
+#deque_test
+g++ -std=c++20 deque_test.cpp -lgtest -lgtest_main -pthread -o deque_test
+#ring_buffer_test
+g++ -std=c++20 ring_buffer_test.cpp -lgtest -lgtest_main -pthread -o ring_buffer_test
+#mpmc_queue_test
+g++ -std=c++20 mpmc_queue_test.cpp -lgtest -lgtest_main -pthread -o mpmc_queue_test
+#small_vector_test
+g++ -std=c++20 small_vector_test.cpp -lgtest -lgtest_main -pthread -o small_vector_test
+#static_vector_test
+g++ -std=c++20 static_vector_test.cpp -lgtest -lgtest_main -pthread -o static_vector_test
+#hash_map_test
+g++ -std=c++20 hash_map_test.cpp -lgtest -lgtest_main -pthread -o hash_map_test
+#btree_test
+g++ -std=c++20 btree_test.cpp -lgtest -lgtest_main -pthread -o btree_test
+#flat_map_test
+g++ -std=c++20 flat_map_test.cpp -lgtest -lgtest_main -pthread -o flat_map_test
+#algorithm_test
+g++ -std=c++20 algorithm_test.cpp -lgtest -lgtest_main -pthread -o algorithm_test
+#sort_test
+g++ -std=c++20 sort_test.cpp -lgtest -lgtest_main -pthread -o sort_test
+#thread_pool_test
+g++ -std=c++20 thread_pool_test.cpp -lgtest -lgtest_main -pthread -o thread_pool_test
+#execution_test
+g++ -std=c++20 execution_test.cpp -lgtest -lgtest_main -pthread -o execution_test
+#unrolled_list_test
+g++ -std=c++20 unrolled_list_test.cpp -lgtest -lgtest_main -pthread -o unrolled_list_test
+#string_view_test
+g++ -std=c++20 string_view_test.cpp -lgtest -lgtest_main -pthread -o string_view_test
+#tracy_string_test
+g++ -std=c++20 tracy_string_test.cpp -lgtest -lgtest_main -pthread -o tracy_string_test
+#priority_queue_test
+g++ -std=c++20 priority_queue_test.cpp -lgtest -lgtest_main -pthread -o priority_queue_test
+#dynamic_bitset_test
+g++ -std=c++20 dynamic_bitset_test.cpp -lgtest -lgtest_main -pthread -o dynamic_bitset_test
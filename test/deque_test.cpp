@@ -0,0 +1,132 @@
+#include "../src/deque.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <string>
+
+using tracystl::Deque;
+
+TEST(DequeTest, DefaultConstructor) {
+  Deque<int> dq;
+  EXPECT_TRUE(dq.empty());
+  EXPECT_EQ(dq.size(), 0);
+  EXPECT_EQ(dq.begin(), dq.end());
+}
+
+TEST(DequeTest, PushAndPopAtBothEnds) {
+  Deque<int> dq;
+  // far more than one block and the initial map in both directions
+  for (int i = 0; i < 100000; ++i) {
+    dq.push_back(i);
+    dq.push_front(-i - 1);
+  }
+  EXPECT_EQ(dq.size(), 200000);
+  EXPECT_EQ(dq.front(), -100000);
+  EXPECT_EQ(dq.back(), 99999);
+  for (int i = 0; i < 200000; ++i) {
+    ASSERT_EQ(dq[i], i - 100000);
+  }
+  for (int i = 0; i < 100000; ++i) {
+    dq.pop_front();
+    dq.pop_back();
+  }
+  EXPECT_TRUE(dq.empty());
+  dq.push_front(7);
+  EXPECT_EQ(dq.back(), 7);
+}
+
+TEST(DequeTest, MatchesStdDequeUnderRandomOperations) {
+  Deque<std::string> dq;
+  std::deque<std::string> expected;
+  std::mt19937 rng(42);
+  for (int step = 0; step < 50000; ++step) {
+    const std::string value(rng() % 40, static_cast<char>('a' + step % 26));
+    switch (rng() % 4) {
+      case 0: dq.push_back(value); expected.push_back(value); break;
+      case 1: dq.emplace_front(value); expected.push_front(value); break;
+      case 2: if (!expected.empty()) { dq.pop_back(); expected.pop_back(); } break;
+      case 3: if (!expected.empty()) { dq.pop_front(); expected.pop_front(); } break;
+    }
+    ASSERT_EQ(dq.size(), expected.size());
+  }
+  EXPECT_TRUE(std::equal(dq.begin(), dq.end(), expected.begin(), expected.end()));
+}
+
+TEST(DequeTest, RandomAccessIterator) {
+  Deque<int> dq;
+  for (int i = 0; i < 5000; ++i) {
+    dq.push_front(i);
+  }
+  Deque<int>::iterator it = dq.begin();
+  EXPECT_EQ(*(it + 4000), 999);
+  EXPECT_EQ((it + 4000) - it, 4000);
+  EXPECT_EQ(*((it + 4000) - 3000), 3999);
+  EXPECT_EQ(dq.end() - dq.begin(), 5000);
+  EXPECT_TRUE(it < it + 1);
+
+  std::sort(dq.begin(), dq.end());
+  for (int i = 0; i < 5000; ++i) {
+    ASSERT_EQ(dq[i], i);
+  }
+  Deque<int>::const_iterator cit = dq.begin();
+  EXPECT_EQ(cit[10], 10);
+}
+
+TEST(DequeTest, CopyMoveAndClear) {
+  Deque<std::string> dq(3000, "tracy");
+  Deque<std::string> copy(dq);
+  EXPECT_EQ(copy.size(), 3000);
+  EXPECT_EQ(copy[2999], "tracy");
+  Deque<std::string> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 3000);
+  moved.clear();
+  EXPECT_TRUE(moved.empty());
+  moved.push_back("again");
+  EXPECT_EQ(moved.front(), "again");
+  copy = moved;
+  EXPECT_EQ(copy.back(), "again");
+}
+
+namespace {
+template <class T>
+struct CountingAllocator : tracystl::Allocator<T> {
+  template <class U>
+  struct rebind {
+    typedef CountingAllocator<U> other;
+  };
+  int* calls;
+  explicit CountingAllocator(int* counter) : calls(counter) {}
+  template <class U>
+  CountingAllocator(const CountingAllocator<U>& rhs) : calls(rhs.calls) {}
+  T* allocate(size_t n) {
+    ++*calls;
+    return tracystl::Allocator<T>::allocate(n);
+  }
+};
+}  // namespace
+
+TEST(DequeTest, SteadyStateFifoDoesNotAllocate) {
+  int calls = 0;
+  Deque<int, CountingAllocator<int>> fifo{CountingAllocator<int>(&calls)};
+  for (int i = 0; i < 10000; ++i) {
+    fifo.push_back(i);
+  }
+  for (int i = 0; i < 10000; ++i) {
+    fifo.pop_front();
+    fifo.push_back(i);
+  }
+  const int warm = calls;
+  // the queue walks through the map: blocks are recycled from the spare list
+  // and the map is recentered in place
+  for (int i = 0; i < 1000000; ++i) {
+    fifo.pop_front();
+    fifo.push_back(i);
+  }
+  EXPECT_EQ(calls, warm);
+  EXPECT_EQ(fifo.size(), 10000);
+  EXPECT_EQ(fifo.back(), 999999);
+}
@@ -0,0 +1,236 @@
+#include "../src/dynamic_bitset.h"
+#include "gtest/gtest.h"
+#include "simd_levels.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using tracystl::DynamicBitset;
+
+namespace {
+
+DynamicBitset random_bitset(std::mt19937& rng, size_t n, unsigned density) {
+  DynamicBitset bits(n);
+  for (size_t i = 0; i < n; ++i) {
+    bits.set(i, rng() % 100 < density);
+  }
+  return bits;
+}
+
+std::vector<bool> to_vector(const DynamicBitset& bits) {
+  std::vector<bool> result(bits.size());
+  for (size_t i = 0; i < bits.size(); ++i) {
+    result[i] = bits[i];
+  }
+  return result;
+}
+
+// the bits past size() in the last word must stay zero
+void expect_clean_tail(const DynamicBitset& bits) {
+  if (bits.size() % 64 != 0) {
+    EXPECT_EQ(bits.data()[bits.num_words() - 1] >> (bits.size() % 64), 0u);
+  }
+}
+
+}  // namespace
+
+TEST(DynamicBitsetTest, SingleBits) {
+  DynamicBitset bits(130);
+  EXPECT_EQ(bits.size(), 130u);
+  EXPECT_EQ(bits.num_words(), 3u);
+  EXPECT_TRUE(bits.none());
+  bits.set(0).set(63).set(64).set(129);
+  EXPECT_TRUE(bits.test(63));
+  EXPECT_TRUE(bits[64]);
+  EXPECT_FALSE(bits[65]);
+  EXPECT_EQ(bits.count(), 4u);
+  bits.reset(63);
+  bits.flip(64);
+  bits.flip(65);
+  bits.set(1, true);
+  bits.set(0, false);
+  EXPECT_EQ(bits.count(), 3u);
+  EXPECT_FALSE(bits[0]);
+  EXPECT_TRUE(bits[1]);
+  EXPECT_TRUE(bits[65]);
+  EXPECT_TRUE(bits.any());
+  EXPECT_FALSE(bits.all());
+
+  bits.set();
+  EXPECT_TRUE(bits.all());
+  EXPECT_EQ(bits.count(), 130u);
+  expect_clean_tail(bits);
+  bits.flip();
+  EXPECT_TRUE(bits.none());
+  bits.flip();
+  expect_clean_tail(bits);
+  bits.reset();
+  EXPECT_EQ(bits.count(), 0u);
+  EXPECT_TRUE(DynamicBitset().all());
+}
+
+TEST(DynamicBitsetTest, ResizeAndPushBack) {
+  DynamicBitset bits;
+  std::vector<bool> expected;
+  std::mt19937 rng(1);
+  for (int i = 0; i < 300; ++i) {
+    const bool value = rng() % 2 != 0;
+    bits.push_back(value);
+    expected.push_back(value);
+  }
+  EXPECT_EQ(to_vector(bits), expected);
+  bits.resize(70);
+  expected.resize(70);
+  EXPECT_EQ(to_vector(bits), expected);
+  expect_clean_tail(bits);
+  bits.resize(200, true);
+  expected.resize(200, true);
+  EXPECT_EQ(to_vector(bits), expected);
+  expect_clean_tail(bits);
+  for (int i = 0; i < 137; ++i) {
+    bits.pop_back();
+    expected.pop_back();
+  }
+  EXPECT_EQ(to_vector(bits), expected);
+  EXPECT_EQ(bits.num_words(), 1u);
+  expect_clean_tail(bits);
+  bits.resize(64, true);
+  EXPECT_EQ(bits.num_words(), 1u);
+  bits.clear();
+  EXPECT_TRUE(bits.empty());
+
+  DynamicBitset ones(100, true);
+  EXPECT_TRUE(ones.all());
+  EXPECT_EQ(ones.count(), 100u);
+  expect_clean_tail(ones);
+}
+
+TEST(DynamicBitsetTest, FindAndIterateSetBits) {
+  std::mt19937 rng(2);
+  for (unsigned density : {0u, 1u, 30u, 100u}) {
+    for (size_t n : {0u, 1u, 63u, 64u, 65u, 1000u}) {
+      const DynamicBitset bits = random_bitset(rng, n, density);
+      std::vector<size_t> expected;
+      for (size_t i = 0; i < n; ++i) {
+        if (bits[i]) {
+          expected.push_back(i);
+        }
+      }
+
+      std::vector<size_t> found;
+      for (size_t i = bits.find_first(); i != DynamicBitset::npos;
+           i = bits.find_next(i)) {
+        found.push_back(i);
+      }
+      EXPECT_EQ(found, expected) << "n=" << n << " density=" << density;
+
+      std::vector<size_t> iterated(bits.set_bits().begin(),
+                                   bits.set_bits().end());
+      EXPECT_EQ(iterated, expected);
+
+      std::vector<size_t> visited;
+      bits.for_each_set_bit([&](size_t i) { visited.push_back(i); });
+      EXPECT_EQ(visited, expected);
+    }
+  }
+}
+
+TEST(DynamicBitsetTest, FindNextPastTheEnd) {
+  DynamicBitset bits(10);
+  bits.set(0);
+  EXPECT_EQ(bits.find_next(9), DynamicBitset::npos);
+  EXPECT_EQ(bits.find_next(10), DynamicBitset::npos);
+  // npos + 1 would wrap around to bit 0
+  EXPECT_EQ(bits.find_next(DynamicBitset::npos), DynamicBitset::npos);
+}
+
+TEST(DynamicBitsetTest, BulkOperationsMatchPerBit) {
+  std::mt19937 rng(3);
+  for_each_level([&] {
+    for (size_t n : {1u, 64u, 100u, 255u, 256u, 513u, 2000u}) {
+      const DynamicBitset a = random_bitset(rng, n, 40);
+      const DynamicBitset b = random_bitset(rng, n, 60);
+      const DynamicBitset and_result = a & b;
+      const DynamicBitset or_result = a | b;
+      const DynamicBitset xor_result = a ^ b;
+      DynamicBitset and_not_result = a;
+      and_not_result.and_not(b);
+      size_t expected_count = 0;
+      for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(and_result[i], a[i] && b[i]);
+        ASSERT_EQ(or_result[i], a[i] || b[i]);
+        ASSERT_EQ(xor_result[i], a[i] != b[i]);
+        ASSERT_EQ(and_not_result[i], a[i] && !b[i]);
+        expected_count += a[i];
+      }
+      ASSERT_EQ(a.count(), expected_count) << "n=" << n;
+      EXPECT_EQ(and_result.count() + xor_result.count(), or_result.count());
+      EXPECT_TRUE(and_result.is_subset_of(a));
+      EXPECT_TRUE(a.is_subset_of(or_result));
+      EXPECT_EQ(a.intersects(b), and_result.any());
+      EXPECT_FALSE(and_not_result.intersects(b));
+
+      DynamicBitset self = a;
+      self ^= self;
+      EXPECT_TRUE(self.none());
+    }
+  });
+}
+
+TEST(DynamicBitsetTest, DifferentLengths) {
+  for_each_level([] {
+    DynamicBitset longer(300, true);
+    DynamicBitset shorter(100);
+    shorter.set(5).set(99);
+
+    // the left operand keeps its size
+    DynamicBitset a = longer;
+    a &= shorter;
+    EXPECT_EQ(a.size(), 300u);
+    EXPECT_EQ(a.count(), 2u);
+    EXPECT_TRUE(a[5] && a[99]);
+
+    DynamicBitset b = shorter;
+    b |= longer;
+    EXPECT_EQ(b.size(), 100u);
+    EXPECT_TRUE(b.all());
+    expect_clean_tail(b);
+
+    DynamicBitset c = shorter;
+    c ^= longer;
+    EXPECT_EQ(c.count(), 98u);
+    expect_clean_tail(c);
+
+    DynamicBitset d = longer;
+    d.and_not(shorter);
+    EXPECT_EQ(d.count(), 298u);
+    EXPECT_FALSE(d[5]);
+    EXPECT_TRUE(d[100]);
+
+    EXPECT_TRUE(shorter.is_subset_of(longer));
+    EXPECT_FALSE(longer.is_subset_of(shorter));
+    EXPECT_TRUE(shorter.intersects(longer));
+    EXPECT_TRUE(DynamicBitset().is_subset_of(shorter));
+    EXPECT_FALSE(DynamicBitset(10, true).intersects(DynamicBitset()));
+  });
+}
+
+TEST(DynamicBitsetTest, CopyMoveCompare) {
+  DynamicBitset a(100);
+  a.set(3).set(97);
+  DynamicBitset b = a;
+  EXPECT_EQ(a, b);
+  b.flip(50);
+  EXPECT_NE(a, b);
+  EXPECT_NE(a, DynamicBitset(101));
+  DynamicBitset moved(std::move(b));
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(moved.count(), 3u);
+  swap(a, moved);
+  EXPECT_TRUE(a[50]);
+  b = std::move(a);
+  EXPECT_EQ(b.count(), 3u);
+  a = b;
+  EXPECT_EQ(a, b);
+}
@@ -0,0 +1,215 @@
+#include "../src/execution.h"
+#include "../src/deque.h"
+#include "../src/vector.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using tracystl::ThreadPool;
+using tracystl::Vector;
+namespace execution = tracystl::execution;
+
+namespace {
+
+// sizes below, at and well above the minimum grain
+const size_t sizes[] = {0, 1, 100, 4096, 4097, 50000, 300000};
+
+Vector<int> random_vector(size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  Vector<int> vec;
+  for (size_t i = 0; i < n; ++i) {
+    vec.push_back(static_cast<int>(rng() % 2001) - 1000);
+  }
+  return vec;
+}
+
+// runs body with par on pools of 1, 2 and 4 workers
+template <class Body>
+void for_each_pool(Body body) {
+  for (size_t threads : {1, 2, 4}) {
+    ThreadPool pool(threads);
+    SCOPED_TRACE(threads);
+    body(execution::par.on(pool));
+  }
+}
+
+}  // namespace
+
+TEST(ExecutionTest, Policies) {
+  static_assert(execution::is_execution_policy_v<decltype(execution::seq)>);
+  static_assert(execution::is_execution_policy_v<execution::parallel_policy&>);
+  static_assert(!execution::is_execution_policy_v<int>);
+  EXPECT_EQ(&execution::par.pool(), &ThreadPool::default_pool());
+  ThreadPool pool(2);
+  EXPECT_EQ(&execution::par.on(pool).pool(), &pool);
+}
+
+TEST(ExecutionTest, ForEachAndTransform) {
+  for_each_pool([](const execution::parallel_policy& par) {
+    for (size_t n : sizes) {
+      Vector<int> vec = random_vector(n, 1);
+      std::vector<int> expected(vec.begin(), vec.end());
+      for (int& x : expected) {
+        x = x * 3 + 1;
+      }
+      tracystl::for_each(par, vec.begin(), vec.end(),
+                         [](int& x) { x = x * 3 + 1; });
+      ASSERT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(),
+                             expected.end()));
+
+      Vector<long> out(n);
+      EXPECT_EQ(tracystl::transform(par, vec.begin(), vec.end(), out.begin(),
+                                    [](int x) { return 2L * x; }),
+                out.end());
+      Vector<long> sum(n);
+      tracystl::transform(par, vec.begin(), vec.end(), out.begin(),
+                          sum.begin(), [](int a, long b) { return a + b; });
+      for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(sum[i], 3L * expected[i]);
+      }
+    }
+  });
+  Vector<int> vec = random_vector(10, 2);
+  Vector<int> out(10);
+  tracystl::transform(execution::seq, vec.begin(), vec.end(), out.begin(),
+                      std::negate<int>());
+  EXPECT_EQ(out[3], -vec[3]);
+  tracystl::for_each(execution::seq, out.begin(), out.end(),
+                     [](int& x) { x = 0; });
+  EXPECT_EQ(std::count(out.begin(), out.end(), 0), 10);
+}
+
+TEST(ExecutionTest, Reduce) {
+  for_each_pool([](const execution::parallel_policy& par) {
+    for (size_t n : sizes) {
+      const Vector<int> vec = random_vector(n, 3);
+      const long expected = std::accumulate(vec.begin(), vec.end(), 5L);
+      EXPECT_EQ(tracystl::reduce(par, vec.begin(), vec.end(), 5L), expected);
+      EXPECT_EQ(tracystl::reduce(par, vec.begin(), vec.end()),
+                std::accumulate(vec.begin(), vec.end(), 0));
+      if (n != 0) {
+        EXPECT_EQ(tracystl::reduce(par, vec.begin(), vec.end(), -1000000,
+                                   [](int a, int b) { return std::max(a, b); }),
+                  *std::max_element(vec.begin(), vec.end()));
+      }
+    }
+  });
+  // strings concatenate in order: the grouping changes, the order does not
+  Vector<std::string> words(20000, "ab");
+  const std::string joined =
+      tracystl::reduce(execution::par, words.begin(), words.end(),
+                       std::string(), std::plus<>());
+  EXPECT_EQ(joined.size(), 40000u);
+  EXPECT_EQ(joined.find("aa"), std::string::npos);
+  EXPECT_EQ(tracystl::reduce(execution::seq, words.begin(), words.begin() + 2,
+                             std::string("x")),
+            "xabab");
+}
+
+TEST(ExecutionTest, Scans) {
+  for_each_pool([](const execution::parallel_policy& par) {
+    for (size_t n : sizes) {
+      const Vector<int> vec = random_vector(n, 4);
+      std::vector<int> expected(n);
+      std::inclusive_scan(vec.begin(), vec.end(), expected.begin());
+      Vector<int> out(n);
+      EXPECT_EQ(tracystl::inclusive_scan(par, vec.begin(), vec.end(),
+                                         out.begin()),
+                out.end());
+      ASSERT_TRUE(std::equal(out.begin(), out.end(), expected.begin(),
+                             expected.end()));
+
+      std::exclusive_scan(vec.begin(), vec.end(), expected.begin(), 7);
+      tracystl::exclusive_scan(par, vec.begin(), vec.end(), out.begin(), 7);
+      ASSERT_TRUE(std::equal(out.begin(), out.end(), expected.begin(),
+                             expected.end()));
+
+      // in place
+      Vector<int> in_place = vec;
+      tracystl::exclusive_scan(par, in_place.begin(), in_place.end(),
+                               in_place.begin(), 7);
+      ASSERT_TRUE(std::equal(in_place.begin(), in_place.end(),
+                             expected.begin(), expected.end()));
+      in_place = vec;
+      std::inclusive_scan(vec.begin(), vec.end(), expected.begin(),
+                          [](int a, int b) { return std::max(a, b); });
+      tracystl::inclusive_scan(par, in_place.begin(), in_place.end(),
+                               in_place.begin(),
+                               [](int a, int b) { return std::max(a, b); });
+      ASSERT_TRUE(std::equal(in_place.begin(), in_place.end(),
+                             expected.begin(), expected.end()));
+    }
+  });
+  Vector<int> vec(5, 1);
+  Vector<int> out(5);
+  tracystl::inclusive_scan(execution::seq, vec.begin(), vec.end(), out.begin());
+  EXPECT_EQ(out[4], 5);
+  tracystl::exclusive_scan(execution::seq, vec.begin(), vec.end(), out.begin(),
+                           10);
+  EXPECT_EQ(out[0], 10);
+  EXPECT_EQ(out[4], 14);
+}
+
+TEST(ExecutionTest, Sort) {
+  for_each_pool([](const execution::parallel_policy& par) {
+    for (size_t n : sizes) {
+      Vector<int> vec = random_vector(n, 5);
+      std::vector<int> expected(vec.begin(), vec.end());
+      std::sort(expected.begin(), expected.end());
+      tracystl::sort(par, vec.begin(), vec.end());
+      ASSERT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(),
+                             expected.end()));
+      tracystl::sort(par, vec.begin(), vec.end(), std::greater<int>());
+      ASSERT_TRUE(std::is_sorted(vec.begin(), vec.end(), std::greater<int>()));
+    }
+    // elements owning memory, and iterators that are not pointers
+    std::mt19937 rng(6);
+    Vector<std::string> strings;
+    tracystl::Deque<std::string> deque;
+    for (int i = 0; i < 100000; ++i) {
+      strings.push_back(std::to_string(rng() % 100000));
+      deque.push_back(strings.back());
+    }
+    std::vector<std::string> expected(strings.begin(), strings.end());
+    std::sort(expected.begin(), expected.end());
+    tracystl::sort(par, strings.begin(), strings.end());
+    tracystl::sort(par, deque.begin(), deque.end());
+    EXPECT_TRUE(std::equal(strings.begin(), strings.end(), expected.begin()));
+    EXPECT_TRUE(std::equal(deque.begin(), deque.end(), expected.begin()));
+  });
+  Vector<int> vec = random_vector(1000, 7);
+  tracystl::sort(execution::seq, vec.begin(), vec.end());
+  EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+}
+
+TEST(ExecutionTest, ExceptionsPropagate) {
+  ThreadPool pool(4);
+  const auto par = execution::par.on(pool);
+  Vector<int> vec = random_vector(100000, 8);
+  std::atomic<int> calls{0};
+  EXPECT_THROW(tracystl::for_each(par, vec.begin(), vec.end(),
+                                  [&](int) {
+                                    if (calls.fetch_add(1) == 70000) {
+                                      throw std::runtime_error("boom");
+                                    }
+                                  }),
+               std::runtime_error);
+  EXPECT_THROW(tracystl::sort(par, vec.begin(), vec.end(),
+                              [](int a, int b) {
+                                if (a == 999 || b == 999) {
+                                  throw std::runtime_error("compare");
+                                }
+                                return a < b;
+                              }),
+               std::runtime_error);
+  // the pool keeps working
+  EXPECT_EQ(tracystl::reduce(par, vec.begin(), vec.end(), 0L),
+            std::accumulate(vec.begin(), vec.end(), 0L));
+}
@@ -0,0 +1,139 @@
+#include "../src/flat_map.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using tracystl::FlatMap;
+using tracystl::FlatSet;
+
+TEST(FlatMapTest, Empty) {
+  FlatMap<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.lower_bound(1), map.end());
+  EXPECT_EQ(map.erase(1), 0);
+  // set elements are keys and cannot be modified in place
+  static_assert(std::is_same<FlatSet<int>::iterator,
+                             FlatSet<int>::const_iterator>::value);
+}
+
+TEST(FlatMapTest, LowerBoundMatchesStd) {
+  // every size up to 70 and every probe between and around the keys
+  for (int n = 0; n < 70; ++n) {
+    std::vector<int> keys;
+    for (int i = 0; i < n; ++i) {
+      keys.push_back(i * 2);
+    }
+    FlatSet<int> set(tracystl::sorted_unique, keys.begin(), keys.end());
+    for (int probe = -1; probe <= 2 * n; ++probe) {
+      const auto expected = std::lower_bound(keys.begin(), keys.end(), probe);
+      ASSERT_EQ(set.lower_bound(probe) - set.begin(), expected - keys.begin());
+      const auto upper = std::upper_bound(keys.begin(), keys.end(), probe);
+      ASSERT_EQ(set.upper_bound(probe) - set.begin(), upper - keys.begin());
+    }
+  }
+}
+
+TEST(FlatMapTest, InsertFind) {
+  FlatMap<std::string, int> map;
+  EXPECT_TRUE(map.insert({"b", 2}).second);
+  EXPECT_TRUE(map.emplace("a", 1).second);
+  EXPECT_FALSE(map.insert({"a", 10}).second);
+  map["c"] = 3;
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.find("a")->second, 1);
+  EXPECT_EQ(map["c"], 3);
+  EXPECT_FALSE(map.insert_or_assign("b", 20).second);
+  EXPECT_EQ(map.find("b")->second, 20);
+  EXPECT_TRUE(map.contains("c"));
+  EXPECT_EQ(map.count("d"), 0);
+  std::string keys;
+  for (const auto& kv : map) {
+    keys += kv.first;
+  }
+  EXPECT_EQ(keys, "abc");
+}
+
+TEST(FlatMapTest, BulkInsertMatchesStdMap) {
+  std::mt19937 rng(5);
+  std::vector<std::pair<int, int>> batch;
+  FlatMap<int, int> map;
+  std::map<int, int> expected;
+  for (int round = 0; round < 5; ++round) {
+    batch.clear();
+    for (int i = 0; i < 1000; ++i) {
+      batch.emplace_back(static_cast<int>(rng() % 3000), round * 1000 + i);
+    }
+    map.insert(batch.begin(), batch.end());
+    // like std::map, the first value inserted for a key wins
+    expected.insert(batch.begin(), batch.end());
+  }
+  ASSERT_EQ(map.size(), expected.size());
+  auto it = map.begin();
+  for (const auto& kv : expected) {
+    ASSERT_EQ(it->first, kv.first);
+    ASSERT_EQ(it->second, kv.second);
+    ++it;
+  }
+}
+
+TEST(FlatMapTest, SortedUnique) {
+  std::vector<std::pair<int, int>> sorted;
+  for (int i = 0; i < 100; ++i) {
+    sorted.emplace_back(i * 2, i);
+  }
+  FlatMap<int, int> map(tracystl::sorted_unique, sorted.begin(), sorted.end());
+  EXPECT_EQ(map.size(), 100);
+  // appending greater keys needs no merge
+  std::vector<std::pair<int, int>> tail = {{1000, 0}, {1001, 1}};
+  map.insert(tracystl::sorted_unique, tail.begin(), tail.end());
+  // overlapping keys are merged and existing ones kept
+  std::vector<std::pair<int, int>> mixed = {{-1, 0}, {2, -5}, {3, 0}};
+  map.insert(tracystl::sorted_unique, mixed.begin(), mixed.end());
+  EXPECT_EQ(map.size(), 104);
+  EXPECT_EQ(map.begin()->first, -1);
+  EXPECT_EQ(map.find(2)->second, 1);
+  EXPECT_EQ(map.find(3)->second, 0);
+  EXPECT_EQ((map.end() - 1)->first, 1001);
+  EXPECT_TRUE(std::is_sorted(map.begin(), map.end()));
+
+  // unsorted input with a duplicate, from a node based container
+  std::list<int> keys = {5, 1, 3, 1};
+  FlatSet<int> set(keys.begin(), keys.end());
+  EXPECT_EQ(set.size(), 3);
+  EXPECT_EQ(*set.begin(), 1);
+}
+
+TEST(FlatMapTest, Erase) {
+  FlatMap<int, std::string> map;
+  for (int i = 0; i < 10; ++i) {
+    map[i] = std::to_string(i);
+  }
+  EXPECT_EQ(map.erase(3), 1);
+  EXPECT_EQ(map.erase(3), 0);
+  auto it = map.erase(map.find(5));
+  EXPECT_EQ(it->first, 6);
+  it = map.erase(map.lower_bound(7), map.end());
+  EXPECT_EQ(it, map.end());
+  EXPECT_EQ(map.size(), 5);
+  EXPECT_EQ((map.end() - 1)->second, "6");
+}
+
+TEST(FlatMapTest, CustomCompare) {
+  FlatSet<int, std::greater<int>> set;
+  for (int i = 0; i < 10; ++i) {
+    set.insert(i);
+  }
+  EXPECT_EQ(*set.begin(), 9);
+  EXPECT_EQ(*set.lower_bound(4), 4);
+  EXPECT_EQ(*set.upper_bound(4), 3);
+  EXPECT_EQ(set.values().size(), 10);
+}
@@ -0,0 +1,168 @@
+#include "../src/hash_map.h"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using tracystl::HashMap;
+
+namespace {
+// every key collides: probing alone has to tell them apart
+struct ConstantHash {
+  size_t operator()(int) const noexcept { return 42; }
+};
+}  // namespace
+
+TEST(HashMapTest, DefaultConstructorDoesNotAllocate) {
+  HashMap<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.capacity(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(3), map.end());
+  EXPECT_EQ(map.erase(3), 0);
+}
+
+TEST(HashMapTest, InsertFindErase) {
+  HashMap<int, std::string> map;
+  EXPECT_TRUE(map.insert({1, "one"}).second);
+  EXPECT_FALSE(map.insert({1, "uno"}).second);
+  EXPECT_TRUE(map.try_emplace(2, 3, 'b').second);
+  map[3] = "three";
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.find(1)->second, "one");
+  EXPECT_EQ(map[2], "bbb");
+  EXPECT_TRUE(map.contains(3));
+  EXPECT_EQ(map.count(4), 0);
+
+  EXPECT_FALSE(map.insert_or_assign(1, "uno").second);
+  EXPECT_EQ(map[1], "uno");
+
+  EXPECT_EQ(map.erase(2), 1);
+  EXPECT_EQ(map.erase(2), 0);
+  map.erase(map.find(3));
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_FALSE(map.contains(3));
+}
+
+TEST(HashMapTest, MatchesUnorderedMap) {
+  HashMap<uint64_t, uint64_t> map;
+  std::unordered_map<uint64_t, uint64_t> expected;
+  std::mt19937_64 rng(7);
+  for (int i = 0; i < 200000; ++i) {
+    const uint64_t key = rng() % 5000;
+    switch (rng() % 3) {
+      case 0:
+        map[key] = i;
+        expected[key] = i;
+        break;
+      case 1:
+        EXPECT_EQ(map.erase(key), expected.erase(key));
+        break;
+      default: {
+        auto it = map.find(key);
+        auto ex = expected.find(key);
+        ASSERT_EQ(it == map.end(), ex == expected.end());
+        if (ex != expected.end()) {
+          EXPECT_EQ(it->second, ex->second);
+        }
+      }
+    }
+  }
+  EXPECT_EQ(map.size(), expected.size());
+  size_t visited = 0;
+  for (const auto& kv : map) {
+    EXPECT_EQ(expected.at(kv.first), kv.second);
+    ++visited;
+  }
+  EXPECT_EQ(visited, expected.size());
+}
+
+TEST(HashMapTest, ReserveAvoidsRehash) {
+  HashMap<int, int> map;
+  map.reserve(1000);
+  const size_t capacity = map.capacity();
+  EXPECT_GE(capacity, 1000);
+  for (int i = 0; i < 1000; ++i) {
+    map[i] = i;
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(HashMapTest, ReserveBeyondMaxSizeThrows) {
+  HashMap<int, int> map;
+  map[1] = 1;
+  EXPECT_GT(map.max_size(), size_t(1) << 40);
+  EXPECT_LT(map.max_size(),
+            static_cast<size_t>(-1) / sizeof(std::pair<int, int>));
+  EXPECT_THROW(map.reserve(map.max_size() + 1), std::length_error);
+  EXPECT_THROW(map.reserve(static_cast<size_t>(-1)), std::length_error);
+  EXPECT_EQ(map.size(), 1u);
+  EXPECT_EQ(map[1], 1);
+}
+
+TEST(HashMapTest, EraseInsertChurnDoesNotGrow) {
+  HashMap<int, int> map;
+  for (int i = 0; i < 80; ++i) {
+    map[i] = i;
+  }
+  const size_t capacity = map.capacity();
+  // a sliding window: the size stays at 80, tombstones are recycled or
+  // cleaned up by a same-size rehash
+  for (int i = 80; i < 100000; ++i) {
+    map.erase(i - 80);
+    map[i] = i;
+  }
+  EXPECT_EQ(map.size(), 80);
+  EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(HashMapTest, HeterogeneousLookup) {
+  HashMap<std::string, int> map;
+  map["alpha"] = 1;
+  map["beta"] = 2;
+  const std::string_view key = "alpha";
+  EXPECT_EQ(map.find(key)->second, 1);
+  EXPECT_TRUE(map.contains("beta"));
+  EXPECT_EQ(map.erase(std::string_view("beta")), 1);
+  EXPECT_EQ(map.size(), 1);
+}
+
+TEST(HashMapTest, PluggableHash) {
+  HashMap<int, int, ConstantHash> map;
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i * 2;
+  }
+  for (int i = 0; i < 100; i += 2) {
+    map.erase(i);
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map.contains(i), i % 2 == 1);
+  }
+  EXPECT_EQ(map[51], 102);
+}
+
+TEST(HashMapTest, CopyMoveClear) {
+  HashMap<std::string, std::unique_ptr<int>> owner;
+  owner.try_emplace("a", std::make_unique<int>(1));
+  HashMap<std::string, std::unique_ptr<int>> moved(std::move(owner));
+  EXPECT_TRUE(owner.empty());
+  EXPECT_EQ(*moved["a"], 1);
+
+  HashMap<std::string, std::string> map;
+  for (int i = 0; i < 50; ++i) {
+    map[std::to_string(i)] = std::string(30, 'x');
+  }
+  HashMap<std::string, std::string> copy(map);
+  EXPECT_EQ(copy.size(), 50);
+  EXPECT_EQ(copy["49"], std::string(30, 'x'));
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(copy.size(), 50);
+  map = copy;
+  EXPECT_EQ(map.size(), 50);
+}
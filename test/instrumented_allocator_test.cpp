@@ -0,0 +1,64 @@
+// built with -DTRACYSTL_ALLOC_STATS=1, see commands.sh
+#include "../src/instrumented_allocator.h"
+#include "../src/list.h"
+#include "../src/vector.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+using tracystl::alloc_stats;
+using tracystl::InstrumentedAllocator;
+
+TEST(InstrumentedAllocatorTest, TracksVectorGrowth) {
+  alloc_stats stats("vector");
+  {
+    tracystl::Vector<int, InstrumentedAllocator<int>> vec{
+        InstrumentedAllocator<int>(stats)};
+    for (int i = 0; i < 5; ++i) {
+      vec.push_back(i);
+    }
+    // capacities 1, 2, 4, 8: four buffers, three of them replaced on growth
+    EXPECT_EQ(stats.allocations(), 4);
+    EXPECT_EQ(stats.deallocations(), 3);
+    EXPECT_EQ(stats.reallocations(), 3);
+    EXPECT_EQ(stats.live_bytes(), 8 * sizeof(int));
+    EXPECT_EQ(stats.peak_bytes(), (4 + 8) * sizeof(int));
+    // 4, 8, 16 and 32 bytes
+    EXPECT_EQ(stats.histogram(2), 1);
+    EXPECT_EQ(stats.histogram(5), 1);
+  }
+  EXPECT_EQ(stats.live_bytes(), 0);
+}
+
+TEST(InstrumentedAllocatorTest, RebindSharesStats) {
+  alloc_stats stats("list");
+  tracystl::List<int, InstrumentedAllocator<int>> list{InstrumentedAllocator<int>(stats)};
+  for (int i = 0; i < 10; ++i) {
+    list.push_back(i);
+  }
+  EXPECT_EQ(stats.allocations(), 10);
+  EXPECT_EQ(stats.live_bytes(), 10 * sizeof(tracystl::list_node<int>));
+  list.clear();
+  EXPECT_EQ(stats.live_bytes(), 0);
+  EXPECT_EQ(stats.peak_bytes(), 10 * sizeof(tracystl::list_node<int>));
+}
+
+TEST(InstrumentedAllocatorTest, DefaultsToGlobalStatsAndReports) {
+  alloc_stats::global().reset();
+  {
+    tracystl::Vector<std::string, InstrumentedAllocator<std::string>> vec;
+    vec.reserve(16);
+  }
+  EXPECT_EQ(alloc_stats::global().allocations(), 1);
+
+  std::FILE* out = std::tmpfile();
+  ASSERT_NE(out, nullptr);
+  alloc_stats::global().report(out);
+  std::rewind(out);
+  char line[128] = {};
+  ASSERT_NE(std::fgets(line, sizeof(line), out), nullptr);
+  EXPECT_EQ(std::string(line), "[tracystl] allocation report: global\n");
+  std::fclose(out);
+}
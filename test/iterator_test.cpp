@@ -1,6 +1,14 @@
 #include "../src/iterator.h"
 
+#include "../src/deque.h"
+#include "../src/list.h"
+#include "../src/vector.h"
+
 #include <gtest/gtest.h>
+
+#include <iterator>
+#include <sstream>
+
 TEST(IteratorTest, IteratorTraitsForRawPointer) {
     typedef tracystl::iterator_traits<int*> traits;
 
@@ -8,7 +16,7 @@ TEST(IteratorTest, IteratorTraitsForRawPointer) {
                   "Incorrect iterator category for raw pointer");
     static_assert(std::is_same_v<traits::value_type, int>,
                   "Incorrect value type for raw pointer");
-    static_assert(std::is_same_v<traits::difference_type, std::size_t>,
+    static_assert(std::is_same_v<traits::difference_type, std::ptrdiff_t>,
                   "Incorrect difference type for raw pointer");
     static_assert(std::is_same_v<traits::pointer, int*>,
                   "Incorrect pointer type for raw pointer");
@@ -23,10 +31,60 @@ TEST(IteratorTest, IteratorTraitsForConstRawPointer) {
                   "Incorrect iterator category for const raw pointer");
     static_assert(std::is_same_v<traits::value_type, int>,
                   "Incorrect value type for const raw pointer");
-    static_assert(std::is_same_v<traits::difference_type, std::size_t>,
+    static_assert(std::is_same_v<traits::difference_type, std::ptrdiff_t>,
                   "Incorrect difference type for const raw pointer");
     static_assert(std::is_same_v<traits::pointer, const int*>,
                   "Incorrect pointer type for const raw pointer");
     static_assert(std::is_same_v<traits::reference, const int&>,
                   "Incorrect reference type for const raw pointer");
 }
+
+TEST(IteratorTest, ContiguousIterators) {
+    static_assert(std::is_base_of_v<tracystl::random_access_iterator_tag,
+                                    tracystl::contiguous_iterator_tag>);
+    static_assert(std::is_same_v<tracystl::iterator_traits<int*>::iterator_concept,
+                                 tracystl::contiguous_iterator_tag>);
+    static_assert(tracystl::is_contiguous_iterator_v<int*>);
+    static_assert(tracystl::is_contiguous_iterator_v<const int*>);
+    static_assert(tracystl::is_contiguous_iterator_v<tracystl::Vector<int>::iterator>);
+    static_assert(!tracystl::is_contiguous_iterator_v<tracystl::Deque<int>::iterator>);
+    static_assert(!tracystl::is_contiguous_iterator_v<tracystl::List<int>::iterator>);
+}
+
+TEST(IteratorTest, AdvanceDistanceNextPrev) {
+    int array[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int* p = array;
+    tracystl::advance(p, 7);
+    EXPECT_EQ(*p, 7);
+    tracystl::advance(p, -3);
+    EXPECT_EQ(*p, 4);
+    EXPECT_EQ(tracystl::distance(array + 8, array + 2), -6);
+    EXPECT_EQ(*tracystl::next(array), 1);
+    EXPECT_EQ(*tracystl::prev(array + 10, 2), 8);
+
+    tracystl::Deque<int> deque;
+    for (int i = 0; i < 1000; ++i) {
+        deque.push_back(i);
+    }
+    EXPECT_EQ(*tracystl::next(deque.begin(), 700), 700);
+    EXPECT_EQ(tracystl::distance(deque.begin(), deque.end()), 1000);
+
+    tracystl::List<int> list;
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    auto it = list.begin();
+    tracystl::advance(it, 6);
+    EXPECT_EQ(*it, 6);
+    tracystl::advance(it, -4);
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(*tracystl::prev(list.end()), 9);
+    EXPECT_EQ(tracystl::distance(list.begin(), list.end()), 10);
+
+    // single-pass input iterators only move forward
+    std::istringstream in("1 2 3 4");
+    std::istream_iterator<int> first(in);
+    tracystl::advance(first, 2);
+    EXPECT_EQ(*first, 3);
+    EXPECT_EQ(tracystl::distance(first, std::istream_iterator<int>()), 2);
+}
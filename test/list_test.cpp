@@ -1,6 +1,14 @@
 #include "gtest/gtest.h"
 #include "../src/list.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 class ListTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -54,3 +62,360 @@ TEST_F(ListTest, Erase) {
         EXPECT_EQ(*it, expected_values[i]);
     }
 }
+
+typedef tracystl::List<int, tracystl::PoolAllocator<int>> PoolList;
+
+TEST(ListPoolTest, ReusesFreedNodes) {
+    PoolList list;
+    for (int i = 0; i < 1000; ++i) {
+        list.push_back(i);
+    }
+    int* first = &list.front();
+    list.pop_front();
+    list.push_back(1000);
+    // the freed slot is handed out again
+    EXPECT_EQ(&list.back(), first);
+    EXPECT_EQ(list.size(), 1000);
+    EXPECT_EQ(list.front(), 1);
+}
+
+TEST(ListPoolTest, ClearReleasesSlabs) {
+    tracystl::List<std::string,
+                   tracystl::PoolAllocator<std::string, 4>> list;
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(std::string(40, 'a' + i));
+    }
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    // the list is usable again after its slabs were released
+    list.push_back("again");
+    EXPECT_EQ(list.front(), "again");
+    EXPECT_EQ(list.size(), 1);
+}
+
+namespace {
+template <class T>
+struct CountingAllocator : tracystl::Allocator<T> {
+    template <class U>
+    struct rebind {
+        typedef CountingAllocator<U> other;
+    };
+    int* live;
+    explicit CountingAllocator(int* counter) : live(counter) {}
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>& rhs) : live(rhs.live) {}
+    T* allocate(size_t n) {
+        ++*live;
+        return tracystl::Allocator<T>::allocate(n);
+    }
+    void deallocate(T* ptr) {
+        --*live;
+        tracystl::Allocator<T>::deallocate(ptr);
+    }
+};
+}  // namespace
+
+TEST(ListAllocatorTest, RebindsStatefulAllocatorToNodes) {
+    int live = 0;
+    {
+        tracystl::List<int, CountingAllocator<int>> list{CountingAllocator<int>(&live)};
+        for (int i = 0; i < 10; ++i) {
+            list.push_back(i);
+        }
+        // one node per element, the sentinel is part of the list itself
+        EXPECT_EQ(live, 10);
+        list.pop_front();
+        EXPECT_EQ(live, 9);
+        EXPECT_EQ(list.get_allocator().live, &live);
+    }
+    EXPECT_EQ(live, 0);
+}
+
+namespace {
+template <class List>
+std::vector<int> to_vector(const List& list) {
+    return std::vector<int>(list.begin(), list.end());
+}
+
+// sorts by key only, so equal keys with different payloads show stability
+struct keyed {
+    int key;
+    int payload;
+};
+struct by_key {
+    bool operator()(const keyed& a, const keyed& b) const { return a.key < b.key; }
+};
+}  // namespace
+
+TEST_F(ListTest, ConstIterator) {
+    const tracystl::List<int>& clist = list;
+    tracystl::List<int>::const_iterator it = clist.begin();
+    EXPECT_EQ(*it, 0);
+    ++it;
+    it++;
+    EXPECT_EQ(*it, 2);
+    --it;
+    EXPECT_EQ(*it, 1);
+    tracystl::List<int>::const_iterator from_mutable = list.begin();
+    EXPECT_TRUE(from_mutable == clist.begin());
+    EXPECT_EQ(std::vector<int>(clist.begin(), clist.end()),
+              (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST_F(ListTest, Splice) {
+    tracystl::List<int> other;
+    for (int i = 10; i < 14; ++i) {
+        other.push_back(i);
+    }
+    int* node = &other.front();
+    // a single element: the node itself moves, no copy
+    list.splice(list.begin(), other, other.begin());
+    EXPECT_EQ(&list.front(), node);
+    EXPECT_EQ(to_vector(list), (std::vector<int>{10, 0, 1, 2, 3, 4}));
+    EXPECT_EQ(other.size(), 3u);
+
+    // a range
+    auto first = other.begin();
+    auto last = std::next(first, 2);
+    list.splice(list.end(), other, first, last);
+    EXPECT_EQ(to_vector(list), (std::vector<int>{10, 0, 1, 2, 3, 4, 11, 12}));
+    EXPECT_EQ(to_vector(other), (std::vector<int>{13}));
+    EXPECT_EQ(list.size(), 8u);
+    EXPECT_EQ(other.size(), 1u);
+
+    // everything
+    list.splice(std::next(list.begin()), other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(to_vector(list), (std::vector<int>{10, 13, 0, 1, 2, 3, 4, 11, 12}));
+
+    // within the list
+    list.splice(list.begin(), list, std::prev(list.end()));
+    list.splice(list.end(), list, list.begin(), std::next(list.begin(), 3));
+    EXPECT_EQ(to_vector(list), (std::vector<int>{0, 1, 2, 3, 4, 11, 12, 10, 13}));
+    EXPECT_EQ(list.size(), 9u);
+    // onto itself: nothing happens
+    list.splice(list.begin(), list, list.begin());
+    list.splice(std::next(list.begin()), list, list.begin());
+    EXPECT_EQ(list.front(), 0);
+}
+
+TEST_F(ListTest, SwapAndReverse) {
+    tracystl::List<int> other;
+    list.swap(other);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(to_vector(other), (std::vector<int>{0, 1, 2, 3, 4}));
+    list.push_back(7);
+    list.swap(other);
+    EXPECT_EQ(to_vector(list), (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(to_vector(other), (std::vector<int>{7}));
+    EXPECT_EQ(list.size(), 5u);
+
+    list.reverse();
+    EXPECT_EQ(to_vector(list), (std::vector<int>{4, 3, 2, 1, 0}));
+    EXPECT_EQ(list.back(), 0);
+    EXPECT_EQ(*std::prev(list.end(), 2), 1);
+    tracystl::List<int> empty;
+    empty.reverse();
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST_F(ListTest, RemoveAndUnique) {
+    list.push_back(2);
+    list.push_back(2);
+    list.push_front(2);
+    // the value refers to an element that is itself removed
+    EXPECT_EQ(list.remove(*std::next(list.begin(), 3)), 4u);
+    EXPECT_EQ(to_vector(list), (std::vector<int>{0, 1, 3, 4}));
+    EXPECT_EQ(list.remove_if([](int x) { return x % 2 == 1; }), 2u);
+    EXPECT_EQ(to_vector(list), (std::vector<int>{0, 4}));
+    EXPECT_EQ(list.size(), 2u);
+
+    tracystl::List<int> runs;
+    for (int x : {1, 1, 1, 2, 3, 3, 1, 1, 4}) {
+        runs.push_back(x);
+    }
+    EXPECT_EQ(runs.unique(), 4u);
+    EXPECT_EQ(to_vector(runs), (std::vector<int>{1, 2, 3, 1, 4}));
+    // the predicate compares with the first element of the run
+    EXPECT_EQ(runs.unique([](int a, int b) { return b - a <= 1; }), 3u);
+    EXPECT_EQ(to_vector(runs), (std::vector<int>{1, 3}));
+}
+
+TEST(ListAlgorithmTest, Merge) {
+    tracystl::List<int> a;
+    tracystl::List<int> b;
+    for (int x : {1, 3, 3, 8}) {
+        a.push_back(x);
+    }
+    for (int x : {0, 2, 3, 9, 10}) {
+        b.push_back(x);
+    }
+    a.merge(b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(to_vector(a), (std::vector<int>{0, 1, 2, 3, 3, 3, 8, 9, 10}));
+    EXPECT_EQ(a.size(), 9u);
+
+    // equal elements: this list's first
+    tracystl::List<keyed> left;
+    tracystl::List<keyed> right;
+    left.push_back({1, 0});
+    left.push_back({2, 0});
+    right.push_back({1, 1});
+    right.push_back({2, 1});
+    left.merge(right, by_key());
+    std::vector<int> payloads;
+    for (const keyed& k : left) {
+        payloads.push_back(k.payload);
+    }
+    EXPECT_EQ(payloads, (std::vector<int>{0, 1, 0, 1}));
+}
+
+TEST(ListAlgorithmTest, SortMatchesStableSort) {
+    std::mt19937 rng(3);
+    for (int n : {0, 1, 2, 3, 10, 100, 1000, 12345}) {
+        tracystl::List<keyed> list;
+        std::vector<keyed> expected;
+        for (int i = 0; i < n; ++i) {
+            const keyed k{static_cast<int>(rng() % 50), i};
+            list.push_back(k);
+            expected.push_back(k);
+        }
+        std::stable_sort(expected.begin(), expected.end(), by_key());
+        const keyed* first_node = n != 0 ? &list.front() : nullptr;
+        list.sort(by_key());
+        ASSERT_EQ(list.size(), static_cast<size_t>(n));
+        size_t i = 0;
+        bool node_kept = n == 0;
+        for (const keyed& k : list) {
+            ASSERT_EQ(k.key, expected[i].key);
+            ASSERT_EQ(k.payload, expected[i].payload);
+            node_kept = node_kept || &k == first_node;
+            ++i;
+        }
+        // nodes were relinked, not copied
+        EXPECT_TRUE(node_kept);
+        // prev_ links are intact
+        i = n;
+        for (auto it = list.end(); it != list.begin();) {
+            --it;
+            ASSERT_EQ(it->payload, expected[--i].payload);
+        }
+    }
+
+    // sorted and reversed input, and the default comparator
+    tracystl::List<int> ints;
+    for (int i = 0; i < 1000; ++i) {
+        ints.push_back(i);
+    }
+    ints.sort();
+    EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end()));
+    ints.reverse();
+    ints.sort();
+    EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end()));
+    ints.sort(std::greater<int>());
+    EXPECT_EQ(ints.front(), 999);
+    EXPECT_EQ(ints.back(), 0);
+}
+
+TEST(ListAlgorithmTest, SortKeepsAllNodesWhenComparatorThrows) {
+    tracystl::List<int> list;
+    std::mt19937 rng(4);
+    for (int i = 0; i < 500; ++i) {
+        list.push_back(static_cast<int>(rng() % 1000));
+    }
+    int calls = 0;
+    EXPECT_THROW(list.sort([&calls](int a, int b) {
+                     if (++calls == 2000) {
+                         throw std::runtime_error("compare");
+                     }
+                     return a < b;
+                 }),
+                 std::runtime_error);
+    EXPECT_EQ(list.size(), 500u);
+    EXPECT_EQ(static_cast<size_t>(std::distance(list.begin(), list.end())), 500u);
+    list.sort();
+    EXPECT_TRUE(std::is_sorted(list.begin(), list.end()));
+}
+
+// two pool-backed lists never share a pool, so their allocators compare
+// unequal
+TEST(ListPoolTest, SwapTakesThePoolAlong) {
+    PoolList a;
+    PoolList b;
+    for (int i = 0; i < 5; ++i) {
+        a.push_back(i);
+    }
+    b.push_back(7);
+    a.swap(b);
+    EXPECT_EQ(to_vector(a), (std::vector<int>{7}));
+    EXPECT_EQ(to_vector(b), (std::vector<int>{0, 1, 2, 3, 4}));
+    // each list frees its nodes into the pool they came from
+    a.pop_front();
+    b.erase(std::next(b.begin()));
+    a.push_back(8);
+    b.push_back(9);
+    EXPECT_EQ(to_vector(a), (std::vector<int>{8}));
+    EXPECT_EQ(to_vector(b), (std::vector<int>{0, 2, 3, 4, 9}));
+}
+
+TEST(ListPoolTest, SpliceBetweenPools) {
+    PoolList list;
+    PoolList other;
+    for (int i = 0; i < 5; ++i) {
+        list.push_back(i);
+        other.push_back(10 + i);
+    }
+    // one element
+    list.splice(list.begin(), other, std::next(other.begin()));
+    EXPECT_EQ(to_vector(list), (std::vector<int>{11, 0, 1, 2, 3, 4}));
+    EXPECT_EQ(to_vector(other), (std::vector<int>{10, 12, 13, 14}));
+    // a range
+    list.splice(list.end(), other, std::next(other.begin()), other.end());
+    EXPECT_EQ(to_vector(list),
+              (std::vector<int>{11, 0, 1, 2, 3, 4, 12, 13, 14}));
+    EXPECT_EQ(to_vector(other), (std::vector<int>{10}));
+    // everything
+    list.splice(std::next(list.begin()), other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(to_vector(list),
+              (std::vector<int>{11, 10, 0, 1, 2, 3, 4, 12, 13, 14}));
+    EXPECT_EQ(list.size(), 10u);
+    // other's pool is still usable, list owns every node it holds
+    other.push_back(1);
+    list.clear();
+    EXPECT_EQ(to_vector(other), (std::vector<int>{1}));
+}
+
+TEST(ListPoolTest, MergeBetweenPools) {
+    tracystl::List<std::string, tracystl::PoolAllocator<std::string>> a;
+    tracystl::List<std::string, tracystl::PoolAllocator<std::string>> b;
+    for (const char* s : {"b", "d", "d", "f"}) {
+        a.push_back(s);
+    }
+    for (const char* s : {"a", "d", "e", "g"}) {
+        b.push_back(std::string(s) + "'");
+    }
+    // by first letter only, so "d" and "d'" are equal
+    a.merge(b, [](const std::string& x, const std::string& y) {
+        return x[0] < y[0];
+    });
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.size(), 8u);
+    // stable: a's "d"s come before b's "d'"
+    const std::vector<std::string> expected = {"a'", "b", "d", "d",
+                                               "d'", "e'", "f", "g'"};
+    EXPECT_EQ(std::vector<std::string>(a.begin(), a.end()), expected);
+}
+
+TEST(ListPoolTest, SortAndSpliceWithinPool) {
+    PoolList list;
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(99 - i);
+    }
+    list.sort();
+    EXPECT_EQ(list.front(), 0);
+    list.splice(list.begin(), list, std::prev(list.end()));
+    EXPECT_EQ(list.front(), 99);
+    EXPECT_EQ(list.remove(50), 1u);
+    EXPECT_EQ(list.size(), 99u);
+}
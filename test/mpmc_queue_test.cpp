@@ -0,0 +1,92 @@
+#include "../src/mpmc_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using tracystl::MpmcQueue;
+
+TEST(MpmcQueueTest, TryEnqueueDequeue) {
+  MpmcQueue<int> queue(3);  // rounded up to 4
+  EXPECT_EQ(queue.capacity(), 4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_enqueue(i));
+  }
+  EXPECT_FALSE(queue.try_enqueue(4));
+  int value = -1;
+  for (int lap = 0; lap < 3; ++lap) {
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(queue.try_dequeue(value));
+      EXPECT_EQ(value, lap * 4 + i);
+      EXPECT_TRUE(queue.try_enqueue(lap * 4 + i + 4));
+    }
+  }
+  EXPECT_EQ(queue.size_approx(), 4);
+}
+
+TEST(MpmcQueueTest, LeftoverElementsAreDestroyed) {
+  auto tracker = std::make_shared<int>(1);
+  {
+    MpmcQueue<std::shared_ptr<int>> queue(8);
+    queue.try_enqueue(tracker);
+    queue.enqueue(tracker);
+    std::shared_ptr<int> out;
+    EXPECT_TRUE(queue.try_dequeue(out));
+    EXPECT_EQ(tracker.use_count(), 3);
+  }
+  EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(MpmcQueueTest, ManyProducersManyConsumers) {
+  const int kProducers = 4;
+  const int kConsumers = 4;
+  const int kPerProducer = 50000;
+  MpmcQueue<int> queue(128);
+  std::atomic<long long> sum{0};
+  std::atomic<int> received{0};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p) {
+    threads.emplace_back([&queue] {
+      for (int i = 1; i <= kPerProducer; ++i) {
+        // half of them use the non-blocking path
+        if (i % 2 == 0) {
+          while (!queue.try_enqueue(i)) std::this_thread::yield();
+        } else {
+          queue.enqueue(i);
+        }
+      }
+    });
+  }
+  for (int c = 0; c < kConsumers; ++c) {
+    threads.emplace_back([&queue, &sum, &received, c] {
+      const int share = kProducers * kPerProducer / kConsumers;
+      for (int i = 0; i < share; ++i) {
+        int value;
+        if (c % 2 == 0) {
+          value = queue.dequeue();
+        } else {
+          while (!queue.try_dequeue(value)) std::this_thread::yield();
+        }
+        sum += value;
+        ++received;
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(received.load(), kProducers * kPerProducer);
+  EXPECT_EQ(sum.load(), 1LL * kProducers * kPerProducer * (kPerProducer + 1) / 2);
+}
+
+TEST(MpmcQueueTest, BlockingDequeueWakesUp) {
+  MpmcQueue<std::string> queue(2);
+  std::thread consumer([&queue] {
+    EXPECT_EQ(queue.dequeue(), "late");
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  queue.enqueue(std::string("late"));
+  consumer.join();
+}
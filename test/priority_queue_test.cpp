@@ -0,0 +1,226 @@
+#include "../src/priority_queue.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+using tracystl::IndexedPriorityQueue;
+using tracystl::PriorityQueue;
+
+namespace {
+
+template <class Queue>
+void expect_pops_sorted_descending(Queue& q, std::vector<int> expected) {
+  std::sort(expected.begin(), expected.end(), std::greater<int>());
+  ASSERT_EQ(q.size(), expected.size());
+  for (int value : expected) {
+    ASSERT_EQ(q.top(), value);
+    q.pop();
+  }
+  EXPECT_TRUE(q.empty());
+}
+
+template <size_t D>
+void check_arity() {
+  std::mt19937 rng(D);
+  PriorityQueue<int, std::less<int>, D> q;
+  std::priority_queue<int> expected;
+  for (int step = 0; step < 5000; ++step) {
+    if (rng() % 3 != 0 || expected.empty()) {
+      const int value = static_cast<int>(rng() % 1000);
+      q.push(value);
+      expected.push(value);
+    } else {
+      ASSERT_EQ(q.top(), expected.top());
+      q.pop();
+      expected.pop();
+    }
+  }
+  while (!expected.empty()) {
+    ASSERT_EQ(q.top(), expected.top());
+    q.pop();
+    expected.pop();
+  }
+  EXPECT_TRUE(q.empty());
+}
+
+}  // namespace
+
+TEST(PriorityQueueTest, MatchesStdForEveryArity) {
+  check_arity<2>();
+  check_arity<3>();
+  check_arity<4>();
+  check_arity<8>();
+  static_assert(PriorityQueue<int>::arity == 4);
+}
+
+TEST(PriorityQueueTest, BulkConstruction) {
+  std::mt19937 rng(5);
+  std::vector<int> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(static_cast<int>(rng() % 500));
+  }
+  PriorityQueue<int> from_range(values.begin(), values.end());
+  expect_pops_sorted_descending(from_range, values);
+
+  tracystl::Vector<int> vec;
+  for (int v : values) {
+    vec.push_back(v);
+  }
+  PriorityQueue<int> from_vector(std::move(vec));
+  expect_pops_sorted_descending(from_vector, values);
+
+  PriorityQueue<int> empty(values.begin(), values.begin());
+  EXPECT_TRUE(empty.empty());
+  PriorityQueue<int> one(values.begin(), values.begin() + 1);
+  EXPECT_EQ(one.top(), values[0]);
+}
+
+TEST(PriorityQueueTest, MinQueueAndMoveOnly) {
+  PriorityQueue<std::unique_ptr<int>,
+                std::function<bool(const std::unique_ptr<int>&,
+                                   const std::unique_ptr<int>&)>>
+      q([](const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) {
+        return *a > *b;
+      });
+  for (int v : {5, 1, 4, 2, 3}) {
+    q.push(std::make_unique<int>(v));
+  }
+  q.emplace(new int(0));
+  for (int expected = 0; expected <= 5; ++expected) {
+    std::unique_ptr<int> top = q.take_top();
+    ASSERT_EQ(*top, expected);
+  }
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(IndexedPriorityQueueTest, HandlesFollowTheirElements) {
+  IndexedPriorityQueue<int, std::greater<int>> q;
+  std::vector<IndexedPriorityQueue<int, std::greater<int>>::handle> handles;
+  for (int v : {50, 10, 40, 20, 30}) {
+    handles.push_back(q.push(v));
+  }
+  EXPECT_EQ(q.top(), 10);
+  EXPECT_EQ(q.top_handle(), handles[1]);
+  for (size_t i = 0; i < handles.size(); ++i) {
+    EXPECT_TRUE(q.contains(handles[i]));
+  }
+  EXPECT_EQ(q[handles[0]], 50);
+
+  q.decrease_key(handles[0], 5);  // 50 -> 5: now the earliest
+  EXPECT_EQ(q.top(), 5);
+  EXPECT_EQ(q.top_handle(), handles[0]);
+  q.increase_key(handles[0], 45);
+  EXPECT_EQ(q.top(), 10);
+  q.update(handles[2], 1);
+  EXPECT_EQ(q.top_handle(), handles[2]);
+  q.update(handles[2], 100);
+  EXPECT_EQ(q.top(), 10);
+
+  q.erase(handles[1]);
+  EXPECT_FALSE(q.contains(handles[1]));
+  EXPECT_EQ(q.top(), 20);
+  // erased handles are reused
+  EXPECT_EQ(q.push(7), handles[1]);
+  EXPECT_EQ(q.take_top(), 7);
+
+  std::vector<int> popped;
+  while (!q.empty()) {
+    popped.push_back(q.take_top());
+  }
+  EXPECT_EQ(popped, (std::vector<int>{20, 30, 45, 100}));
+}
+
+TEST(IndexedPriorityQueueTest, RandomOperationsMatchReference) {
+  std::mt19937 rng(9);
+  IndexedPriorityQueue<int, std::less<int>, 4> q;
+  // reference: handle -> value for live handles
+  std::vector<std::pair<size_t, int>> live;
+  for (int step = 0; step < 20000; ++step) {
+    const unsigned op = rng() % 6;
+    const int value = static_cast<int>(rng() % 10000);
+    if (op < 2 || live.empty()) {
+      live.emplace_back(q.push(value), value);
+    } else {
+      const size_t k = rng() % live.size();
+      const size_t h = live[k].first;
+      ASSERT_EQ(q[h], live[k].second);
+      if (op == 2) {
+        q.erase(h);
+        live.erase(live.begin() + static_cast<std::ptrdiff_t>(k));
+      } else if (op == 3) {
+        q.update(h, value);
+        live[k].second = value;
+      } else if (op == 4 && value >= live[k].second) {
+        // a larger value moves toward the top of a max-queue
+        q.decrease_key(h, value);
+        live[k].second = value;
+      } else {
+        const auto best = std::max_element(
+            live.begin(), live.end(),
+            [](const auto& a, const auto& b) { return a.second < b.second; });
+        ASSERT_EQ(q.top(), best->second);
+        ASSERT_EQ(q[q.top_handle()], best->second);
+        live.erase(std::find_if(live.begin(), live.end(), [&](const auto& e) {
+          return e.first == q.top_handle();
+        }));
+        q.pop();
+      }
+    }
+    ASSERT_EQ(q.size(), live.size());
+  }
+  for (const auto& e : live) {
+    ASSERT_TRUE(q.contains(e.first));
+    ASSERT_EQ(q[e.first], e.second);
+  }
+  q.clear();
+  EXPECT_TRUE(q.empty());
+  EXPECT_FALSE(q.contains(0));
+}
+
+namespace {
+
+bool allocations_fail = false;
+
+// throws bad_alloc while allocations_fail is set
+template <class T>
+struct FailingAllocator : tracystl::Allocator<T> {
+  template <class U>
+  struct rebind {
+    typedef FailingAllocator<U> other;
+  };
+  FailingAllocator() = default;
+  template <class U>
+  FailingAllocator(const FailingAllocator<U>&) {}
+  T* allocate(size_t n) {
+    if (allocations_fail) {
+      throw std::bad_alloc();
+    }
+    return tracystl::Allocator<T>::allocate(n);
+  }
+};
+
+}  // namespace
+
+TEST(IndexedPriorityQueueTest, EraseNeverAllocates) {
+  IndexedPriorityQueue<int, std::less<int>, 4, FailingAllocator<int>> q;
+  std::vector<size_t> handles;
+  for (int i = 0; i < 100; ++i) {
+    handles.push_back(q.push(i));
+  }
+  allocations_fail = true;
+  for (size_t h : handles) {
+    q.erase(h);
+  }
+  // reusing the freed handles does not allocate either
+  for (int i = 0; i < 100; ++i) {
+    q.push(i);
+  }
+  allocations_fail = false;
+  EXPECT_EQ(q.size(), 100u);
+  EXPECT_EQ(q.top(), 99);
+}
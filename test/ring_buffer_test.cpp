@@ -0,0 +1,84 @@
+#include "../src/ring_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using tracystl::RingBuffer;
+using tracystl::SpscQueue;
+
+TEST(RingBufferTest, PushPopUntilFullAndEmpty) {
+  RingBuffer<int, 4> ring;
+  EXPECT_EQ(ring.capacity(), 4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.try_push(i));
+  }
+  EXPECT_FALSE(ring.try_push(4));
+  EXPECT_EQ(ring.size_approx(), 4);
+  int value = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(ring.try_pop(value));
+  EXPECT_EQ(ring.front(), nullptr);
+}
+
+TEST(RingBufferTest, BatchesWrapAround) {
+  SpscQueue<int> queue(5);  // rounded up to 8
+  EXPECT_EQ(queue.capacity(), 8);
+  int in[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  int out[8] = {};
+  EXPECT_EQ(queue.try_push_n(in, 6), 6);
+  EXPECT_EQ(queue.try_pop_n(out, 5), 5);
+  // the next batch runs over the end of the slot array
+  EXPECT_EQ(queue.try_push_n(in, 8), 7);
+  EXPECT_EQ(queue.try_pop_n(out, 8), 8);
+  EXPECT_EQ(out[0], 5);
+  EXPECT_EQ(out[1], 0);
+  EXPECT_EQ(out[7], 6);
+  EXPECT_EQ(queue.try_pop_n(out, 8), 0);
+}
+
+TEST(RingBufferTest, NonTrivialElementsAreDestroyed) {
+  auto tracker = std::make_shared<int>(0);
+  {
+    SpscQueue<std::shared_ptr<int>> queue(4);
+    queue.try_push(tracker);
+    queue.try_emplace(tracker);
+    std::shared_ptr<int> batch[2] = {tracker, tracker};
+    EXPECT_EQ(queue.try_push_n(batch, 2), 2);
+    // the batch was moved into the queue, not copied
+    EXPECT_EQ(tracker.use_count(), 5);
+    EXPECT_EQ(batch[0], nullptr);
+    std::shared_ptr<int> out;
+    queue.try_pop(out);
+    EXPECT_EQ(out, tracker);
+  }
+  // the three left in the queue were destroyed with it
+  EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(RingBufferTest, ProducerConsumerThreads) {
+  const int kMessages = 200000;
+  SpscQueue<std::string> queue(64);
+  std::thread producer([&queue] {
+    for (int i = 0; i < kMessages; ++i) {
+      std::string message = std::to_string(i);
+      while (!queue.try_push(std::move(message))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::string message;
+  for (int i = 0; i < kMessages; ++i) {
+    while (!queue.try_pop(message)) {
+      std::this_thread::yield();
+    }
+    ASSERT_EQ(message, std::to_string(i));
+  }
+  producer.join();
+}
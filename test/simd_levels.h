@@ -0,0 +1,26 @@
+#ifndef _TRACYSTL_TEST_SIMD_LEVELS_H_
+#define _TRACYSTL_TEST_SIMD_LEVELS_H_
+
+#include "../src/algorithm.h"
+#include "gtest/gtest.h"
+
+// Shared by the tests of the SIMD kernels.
+
+// runs body once per kernel set this CPU has, then restores the default
+template <class Body>
+void for_each_level(Body body) {
+  const tracystl::simd_level levels[] = {tracystl::simd_level::scalar,
+                                         tracystl::simd_level::sse2,
+                                         tracystl::simd_level::avx2};
+  for (tracystl::simd_level level : levels) {
+    if (level > tracystl::cpu_simd_level()) {
+      continue;
+    }
+    tracystl::set_simd_level(level);
+    SCOPED_TRACE(static_cast<int>(level));
+    body();
+  }
+  tracystl::set_simd_level(tracystl::cpu_simd_level());
+}
+
+#endif  // _TRACYSTL_TEST_SIMD_LEVELS_H_
@@ -0,0 +1,200 @@
+#include "../src/small_vector.h"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+using tracystl::SmallVector;
+
+namespace {
+template <class T>
+struct CountingAllocator : tracystl::Allocator<T> {
+  template <class U>
+  struct rebind {
+    typedef CountingAllocator<U> other;
+  };
+  int* allocations;
+  explicit CountingAllocator(int* counter) : allocations(counter) {}
+  template <class U>
+  CountingAllocator(const CountingAllocator<U>& rhs)
+      : allocations(rhs.allocations) {}
+  T* allocate(size_t n) {
+    ++*allocations;
+    return tracystl::Allocator<T>::allocate(n);
+  }
+};
+}  // namespace
+
+TEST(SmallVectorTest, DefaultConstructor) {
+  SmallVector<int, 4> vec;
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_EQ(vec.capacity(), 4);
+  EXPECT_TRUE(vec.empty());
+  EXPECT_TRUE(vec.is_inline());
+}
+
+TEST(SmallVectorTest, StaysInlineUpToN) {
+  int allocations = 0;
+  SmallVector<int, 4, CountingAllocator<int>> vec{
+      CountingAllocator<int>(&allocations)};
+  for (int i = 0; i < 4; ++i) {
+    vec.push_back(i);
+  }
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(allocations, 0);
+
+  vec.push_back(4);
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_EQ(allocations, 1);
+  EXPECT_EQ(vec.capacity(), 8);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(vec[i], i);
+  }
+}
+
+TEST(SmallVectorTest, ElementAccess) {
+  SmallVector<int, 2> vec;
+  for (int i = 0; i < 5; ++i) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(vec.front(), 0);
+  EXPECT_EQ(vec.back(), 4);
+  EXPECT_EQ(*(vec.end() - 1), 4);
+  vec.pop_back();
+  EXPECT_EQ(vec.back(), 3);
+  EXPECT_EQ(vec.emplace_back(9), 9);
+}
+
+TEST(SmallVectorTest, PushBackOwnElementWhileSpilling) {
+  SmallVector<std::string, 2> vec;
+  vec.push_back(std::string(40, 'a'));
+  vec.push_back(std::string(40, 'b'));
+  vec.push_back(vec[0]);
+  EXPECT_EQ(vec[2], std::string(40, 'a'));
+  vec.resize(10, vec[1]);
+  EXPECT_EQ(vec[9], std::string(40, 'b'));
+}
+
+TEST(SmallVectorTest, CopyAndAssign) {
+  SmallVector<std::string, 3> small;
+  small.push_back("x");
+  SmallVector<std::string, 3> big;
+  for (int i = 0; i < 10; ++i) {
+    big.push_back(std::to_string(i));
+  }
+
+  SmallVector<std::string, 3> copy(small);
+  EXPECT_TRUE(copy.is_inline());
+  EXPECT_EQ(copy[0], "x");
+
+  copy = big;
+  EXPECT_EQ(copy.size(), 10);
+  EXPECT_EQ(copy[9], "9");
+  copy = small;
+  EXPECT_EQ(copy.size(), 1);
+  EXPECT_EQ(copy[0], "x");
+}
+
+TEST(SmallVectorTest, MoveInlineAndHeap) {
+  SmallVector<std::unique_ptr<int>, 2> inline_vec;
+  inline_vec.push_back(std::make_unique<int>(1));
+  SmallVector<std::unique_ptr<int>, 2> moved(std::move(inline_vec));
+  EXPECT_TRUE(moved.is_inline());
+  EXPECT_EQ(*moved[0], 1);
+  EXPECT_TRUE(inline_vec.empty());
+
+  SmallVector<std::unique_ptr<int>, 2> heap_vec;
+  for (int i = 0; i < 3; ++i) {
+    heap_vec.push_back(std::make_unique<int>(i));
+  }
+  const std::unique_ptr<int>* data = heap_vec.data();
+  moved = std::move(heap_vec);
+  // the heap buffer is stolen, not copied
+  EXPECT_EQ(moved.data(), data);
+  EXPECT_EQ(*moved[2], 2);
+  EXPECT_TRUE(heap_vec.empty());
+  EXPECT_TRUE(heap_vec.is_inline());
+  heap_vec.push_back(std::make_unique<int>(7));
+  EXPECT_EQ(*heap_vec[0], 7);
+}
+
+TEST(SmallVectorTest, Swap) {
+  SmallVector<std::string, 2> a;
+  a.push_back("a");
+  SmallVector<std::string, 2> b;
+  for (int i = 0; i < 4; ++i) {
+    b.push_back("b");
+  }
+  a.swap(b);
+  EXPECT_EQ(a.size(), 4);
+  EXPECT_FALSE(a.is_inline());
+  EXPECT_EQ(b.size(), 1);
+  EXPECT_TRUE(b.is_inline());
+  EXPECT_EQ(b[0], "a");
+}
+
+TEST(SmallVectorTest, ShrinkToFitReturnsInline) {
+  SmallVector<int, 4> vec;
+  for (int i = 0; i < 10; ++i) {
+    vec.push_back(i);
+  }
+  vec.resize(3);
+  vec.shrink_to_fit();
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 4);
+  EXPECT_EQ(vec[2], 2);
+
+  vec.reserve(20);
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 20);
+  vec.clear();
+  EXPECT_EQ(vec.capacity(), 20);
+}
+
+TEST(SmallVectorTest, InsertAndErase) {
+  SmallVector<std::string, 4> vec;
+  vec.insert(vec.begin(), "b");
+  vec.insert(vec.begin(), "a");
+  vec.emplace(vec.end(), "d");
+  vec.emplace(vec.begin() + 2, 1, 'c');
+  EXPECT_TRUE(vec.is_inline());
+  // spills while shifting, and the value refers into the old buffer
+  auto it = vec.insert(vec.begin() + 1, vec[3]);
+  EXPECT_EQ(*it, "d");
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_EQ(vec.size(), 5);
+  EXPECT_EQ(vec[0] + vec[1] + vec[2] + vec[3] + vec[4], "adbcd");
+  it = vec.erase(vec.begin() + 1);
+  EXPECT_EQ(*it, "b");
+  it = vec.erase(vec.begin(), vec.begin() + 2);
+  EXPECT_EQ(*it, "c");
+  EXPECT_EQ(vec.size(), 2);
+  EXPECT_EQ(vec.back(), "d");
+
+  SmallVector<int, 2> ints;
+  for (int i = 0; i < 6; ++i) {
+    ints.insert(ints.begin(), i);
+  }
+  ints.erase(ints.begin() + 1, ints.end() - 1);
+  EXPECT_EQ(ints.size(), 2);
+  EXPECT_EQ(ints[0], 5);
+  EXPECT_EQ(ints[1], 0);
+}
+
+TEST(SmallVectorTest, TypedefSwitch) {
+  // same interface as Vector
+  auto fill = [](auto& vec) {
+    vec.resize(3, 5);
+    vec.emplace_back(6);
+    vec.insert(vec.begin(), 1);
+    vec.erase(vec.begin() + 1);
+    int sum = 0;
+    for (auto it = vec.begin(); it != vec.end(); ++it) {
+      sum += *it;
+    }
+    return sum;
+  };
+  tracystl::Vector<int> vec;
+  SmallVector<int, 8> small;
+  EXPECT_EQ(fill(vec), fill(small));
+}
@@ -0,0 +1,298 @@
+#include "../src/sort.h"
+#include "../src/deque.h"
+#include "../src/vector.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// count every global allocation made by this test binary
+static size_t global_news = 0;
+
+void* operator new(size_t size) {
+  ++global_news;
+  if (void* p = std::malloc(size != 0 ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+// std::stable_sort asks for its buffer through this one
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  ++global_news;
+  return std::malloc(size != 0 ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+using tracystl::Vector;
+
+namespace {
+
+// the input shapes the benchmark covers, plus a few that stress pdqsort's
+// pattern detection
+enum class pattern {
+  random,
+  sorted,
+  reversed,
+  few_unique,
+  organ_pipe,
+  nearly_sorted,
+  all_equal
+};
+
+const pattern patterns[] = {pattern::random,     pattern::sorted,
+                            pattern::reversed,   pattern::few_unique,
+                            pattern::organ_pipe, pattern::nearly_sorted,
+                            pattern::all_equal};
+
+Vector<int> make_input(pattern p, size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  Vector<int> vec;
+  for (size_t i = 0; i < n; ++i) {
+    const int v = static_cast<int>(i);
+    switch (p) {
+      case pattern::random:
+        vec.push_back(static_cast<int>(rng()));
+        break;
+      case pattern::sorted:
+      case pattern::nearly_sorted:
+        vec.push_back(v);
+        break;
+      case pattern::reversed:
+        vec.push_back(static_cast<int>(n) - v);
+        break;
+      case pattern::few_unique:
+        vec.push_back(static_cast<int>(rng() % 8));
+        break;
+      case pattern::organ_pipe:
+        vec.push_back(i < n / 2 ? v : static_cast<int>(n) - v);
+        break;
+      case pattern::all_equal:
+        vec.push_back(42);
+        break;
+    }
+  }
+  if (p == pattern::nearly_sorted && n > 1) {
+    for (size_t i = 0; i < 4; ++i) {
+      std::swap(vec[rng() % n], vec[rng() % n]);
+    }
+  }
+  return vec;
+}
+
+const size_t sizes[] = {0, 1, 2, 3, 23, 24, 25, 100, 129, 1000, 10000};
+
+// sorts by key only, so equal keys with different payloads tell apart a
+// stable sort
+struct by_key {
+  bool operator()(const std::pair<int, int>& a,
+                  const std::pair<int, int>& b) const {
+    return a.first < b.first;
+  }
+};
+
+}  // namespace
+
+TEST(SortTest, SortMatchesStd) {
+  for (pattern p : patterns) {
+    for (size_t n : sizes) {
+      SCOPED_TRACE(static_cast<int>(p));
+      SCOPED_TRACE(n);
+      Vector<int> vec = make_input(p, n, static_cast<unsigned>(n));
+      std::vector<int> expected(vec.begin(), vec.end());
+      std::sort(expected.begin(), expected.end());
+      tracystl::sort(vec.begin(), vec.end());
+      ASSERT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(),
+                             expected.end()));
+
+      // descending, through the branchless partition again
+      std::reverse(expected.begin(), expected.end());
+      tracystl::sort(vec.begin(), vec.end(), std::greater<int>());
+      ASSERT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(),
+                             expected.end()));
+
+      // a lambda comparator takes the branching partition
+      tracystl::sort(vec.begin(), vec.end(),
+                     [](int a, int b) { return a < b; });
+      ASSERT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+    }
+  }
+}
+
+TEST(SortTest, SortOtherTypesAndIterators) {
+  std::mt19937 rng(7);
+  Vector<std::string> strings;
+  for (int i = 0; i < 2000; ++i) {
+    strings.push_back(std::to_string(rng() % 500));
+  }
+  std::vector<std::string> expected(strings.begin(), strings.end());
+  std::sort(expected.begin(), expected.end());
+  tracystl::sort(strings.begin(), strings.end());
+  EXPECT_TRUE(std::equal(strings.begin(), strings.end(), expected.begin()));
+
+  double doubles[500];
+  for (double& d : doubles) {
+    d = static_cast<double>(rng()) / 7.0 - 1e8;
+  }
+  tracystl::sort(doubles, doubles + 500);
+  EXPECT_TRUE(std::is_sorted(doubles, doubles + 500));
+
+  tracystl::Deque<int> deque;
+  for (int i = 0; i < 3000; ++i) {
+    deque.push_back(static_cast<int>(rng() % 1000));
+  }
+  tracystl::sort(deque.begin(), deque.end());
+  EXPECT_TRUE(std::is_sorted(deque.begin(), deque.end()));
+}
+
+TEST(SortTest, SortSurvivesAdversarialInput) {
+  // many equal keys interleaved with a sorted run hit both the equal-keys
+  // partition and the pattern breaking
+  Vector<int> vec;
+  for (int i = 0; i < 100000; ++i) {
+    vec.push_back(i % 2 == 0 ? 0 : i);
+  }
+  tracystl::sort(vec.begin(), vec.end());
+  EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+  EXPECT_EQ(std::count(vec.begin(), vec.end(), 0), 50000);
+}
+
+TEST(SortTest, StableSortKeepsEqualElementsInOrder) {
+  for (size_t n : sizes) {
+    std::mt19937 rng(static_cast<unsigned>(n));
+    Vector<std::pair<int, int>> vec;
+    for (size_t i = 0; i < n; ++i) {
+      vec.push_back(std::make_pair(static_cast<int>(rng() % 16),
+                                   static_cast<int>(i)));
+    }
+    std::vector<std::pair<int, int>> expected(vec.begin(), vec.end());
+    std::stable_sort(expected.begin(), expected.end(), by_key());
+    tracystl::stable_sort(vec.begin(), vec.end(), by_key());
+    ASSERT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(),
+                           expected.end()))
+        << n;
+  }
+  for (pattern p : patterns) {
+    Vector<int> vec = make_input(p, 5000, 3);
+    tracystl::stable_sort(vec.begin(), vec.end());
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+  }
+  // elements that own memory are moved through the buffer and back
+  Vector<std::string> strings;
+  for (int i = 0; i < 300; ++i) {
+    strings.push_back(std::string(20, static_cast<char>('a' + (i * 7) % 26)));
+  }
+  tracystl::stable_sort(strings.begin(), strings.end());
+  EXPECT_TRUE(std::is_sorted(strings.begin(), strings.end()));
+  EXPECT_EQ(strings.back(), std::string(20, 'z'));
+}
+
+TEST(SortTest, RadixSortIntegers) {
+  std::mt19937_64 rng(11);
+  for (size_t n : sizes) {
+    Vector<int> ints;
+    Vector<unsigned> uints;
+    Vector<int64_t> longs;
+    Vector<int16_t> shorts;
+    Vector<uint8_t> bytes;
+    for (size_t i = 0; i < n; ++i) {
+      const uint64_t r = rng();
+      ints.push_back(static_cast<int>(r));
+      uints.push_back(static_cast<unsigned>(r >> 7));
+      longs.push_back(static_cast<int64_t>(r));
+      shorts.push_back(static_cast<int16_t>(r >> 3));
+      bytes.push_back(static_cast<uint8_t>(r >> 11));
+    }
+    if (n > 2) {
+      ints[0] = std::numeric_limits<int>::min();
+      ints[1] = std::numeric_limits<int>::max();
+      longs[0] = std::numeric_limits<int64_t>::min();
+    }
+    tracystl::radix_sort(ints.begin(), ints.end());
+    tracystl::radix_sort(uints.begin(), uints.end());
+    tracystl::radix_sort(longs.begin(), longs.end());
+    tracystl::radix_sort(shorts.begin(), shorts.end());
+    tracystl::radix_sort(bytes.begin(), bytes.end());
+    EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end())) << n;
+    EXPECT_TRUE(std::is_sorted(uints.begin(), uints.end())) << n;
+    EXPECT_TRUE(std::is_sorted(longs.begin(), longs.end())) << n;
+    EXPECT_TRUE(std::is_sorted(shorts.begin(), shorts.end())) << n;
+    EXPECT_TRUE(std::is_sorted(bytes.begin(), bytes.end())) << n;
+  }
+
+  // small keys leave the high digits equal everywhere; those passes are
+  // skipped, which may leave the result in the scratch buffer
+  Vector<int> scratch;
+  for (unsigned round = 0; round < 3; ++round) {
+    Vector<int> small = make_input(pattern::few_unique, 1000, round);
+    std::vector<int> expected(small.begin(), small.end());
+    std::sort(expected.begin(), expected.end());
+    tracystl::radix_sort(small.begin(), small.end(), scratch);
+    EXPECT_TRUE(std::equal(small.begin(), small.end(), expected.begin(),
+                           expected.end()));
+  }
+  EXPECT_GE(scratch.size(), 1000u);
+
+  uint32_t raw[6] = {5, 0xffffffffu, 3, 0, 1u << 31, 3};
+  tracystl::radix_sort(raw, raw + 6);
+  EXPECT_TRUE(std::is_sorted(raw, raw + 6));
+}
+
+TEST(SortTest, RadixSortWithScratchDoesNotAllocate) {
+  Vector<int> ints = make_input(pattern::random, 10000, 1);
+  Vector<int64_t> longs;
+  for (int value : make_input(pattern::random, 10000, 2)) {
+    longs.push_back(static_cast<int64_t>(value) * 0x10001);
+  }
+  Vector<int> int_scratch(ints.size());
+  Vector<int64_t> long_scratch(longs.size());
+  const size_t before = global_news;
+  tracystl::radix_sort(ints.begin(), ints.end(), int_scratch);
+  tracystl::radix_sort(longs.begin(), longs.end(), long_scratch);
+  EXPECT_EQ(global_news, before);
+  EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end()));
+  EXPECT_TRUE(std::is_sorted(longs.begin(), longs.end()));
+}
+
+TEST(SortTest, RadixSortFloatingPoint) {
+  std::mt19937 rng(13);
+  Vector<float> floats;
+  Vector<double> doubles;
+  for (int i = 0; i < 5000; ++i) {
+    floats.push_back(
+        static_cast<float>(static_cast<int>(rng() % 20001) - 10000) / 3.0f);
+    doubles.push_back(std::ldexp(static_cast<double>(rng()) - 2147483648.0,
+                                 static_cast<int>(rng() % 200) - 100));
+  }
+  floats.push_back(std::numeric_limits<float>::infinity());
+  floats.push_back(-std::numeric_limits<float>::infinity());
+  floats.push_back(std::numeric_limits<float>::denorm_min());
+  floats.push_back(-0.0f);
+  floats.push_back(0.0f);
+  doubles.push_back(-std::numeric_limits<double>::max());
+  doubles.push_back(std::numeric_limits<double>::lowest() / 2);
+  tracystl::radix_sort(floats.begin(), floats.end());
+  tracystl::radix_sort(doubles.begin(), doubles.end());
+  EXPECT_TRUE(std::is_sorted(floats.begin(), floats.end()));
+  EXPECT_TRUE(std::is_sorted(doubles.begin(), doubles.end()));
+  EXPECT_EQ(floats.front(), -std::numeric_limits<float>::infinity());
+  EXPECT_EQ(floats.back(), std::numeric_limits<float>::infinity());
+  EXPECT_EQ(doubles.front(), -std::numeric_limits<double>::max());
+
+  // -0.0 sorts before +0.0
+  const auto zero = std::find(floats.begin(), floats.end(), 0.0f);
+  ASSERT_NE(zero, floats.end());
+  EXPECT_TRUE(std::signbit(*zero));
+  EXPECT_FALSE(std::signbit(*(zero + 1)));
+}
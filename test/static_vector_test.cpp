@@ -0,0 +1,134 @@
+#include "../src/static_vector.h"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+using tracystl::StaticVector;
+
+namespace {
+// a literal type with a non-trivial destructor, to exercise the destructor
+// loop during constant evaluation
+struct Tracked {
+  int value;
+  int* destroyed;
+  constexpr Tracked(int v, int* d) : value(v), destroyed(d) {}
+  constexpr Tracked(const Tracked& rhs) = default;
+  constexpr Tracked& operator=(const Tracked& rhs) = default;
+  constexpr ~Tracked() { ++*destroyed; }
+};
+
+constexpr int sum_of_squares(int n) {
+  StaticVector<int, 16> vec;
+  for (int i = 1; i <= n; ++i) {
+    vec.push_back(i * i);
+  }
+  vec.pop_back();
+  int sum = 0;
+  for (int x : vec) {
+    sum += x;
+  }
+  return sum;
+}
+
+constexpr int insert_erase() {
+  StaticVector<int, 8> vec;
+  vec.push_back(1);
+  vec.push_back(3);
+  vec.insert(vec.begin() + 1, 2);
+  vec.emplace(vec.begin(), 0);
+  vec.erase(vec.begin() + 2);
+  return vec[0] * 100 + vec[1] * 10 + vec[2];  // 0, 1, 3
+}
+
+constexpr int destroyed_count() {
+  int destroyed = 0;
+  {
+    StaticVector<Tracked, 4> vec;
+    vec.emplace_back(1, &destroyed);
+    vec.emplace_back(2, &destroyed);
+    StaticVector<Tracked, 4> copy(vec);
+    copy.pop_back();
+  }
+  // pop_back destroys one, each vector's destructor the rest
+  return destroyed;
+}
+}  // namespace
+
+TEST(StaticVectorTest, Constexpr) {
+  static_assert(sum_of_squares(4) == 1 + 4 + 9);
+  static_assert(destroyed_count() == 4);
+  static_assert(insert_erase() == 13);
+  // at run time the same shifts take the memmove path
+  EXPECT_EQ(insert_erase(), 13);
+  constexpr StaticVector<int, 3> filled(3, 7);
+  static_assert(filled.size() == 3 && filled[2] == 7);
+}
+
+TEST(StaticVectorTest, TrivialDestructorForTrivialTypes) {
+  static_assert(std::is_trivially_destructible<StaticVector<int, 8>>::value);
+  static_assert(
+      !std::is_trivially_destructible<StaticVector<std::string, 8>>::value);
+  static_assert(sizeof(StaticVector<int, 8>) ==
+                sizeof(int) * 8 + sizeof(size_t));
+}
+
+TEST(StaticVectorTest, Modifiers) {
+  StaticVector<std::string, 4> vec;
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.capacity(), 4);
+  vec.push_back("a");
+  vec.emplace_back(3, 'b');
+  EXPECT_EQ(vec.back(), "bbb");
+  vec.resize(4, vec.front());
+  EXPECT_TRUE(vec.full());
+  EXPECT_EQ(vec[3], "a");
+  vec.resize(1);
+  EXPECT_EQ(vec.size(), 1);
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+}
+
+TEST(StaticVectorTest, InsertAndErase) {
+  StaticVector<std::string, 5> vec;
+  vec.insert(vec.begin(), "c");
+  vec.insert(vec.begin(), "a");
+  vec.emplace(vec.begin() + 1, 1, 'b');
+  // the value refers to an element that gets shifted
+  auto it = vec.insert(vec.begin(), vec[2]);
+  EXPECT_EQ(*it, "c");
+  EXPECT_EQ(vec.size(), 4);
+  EXPECT_EQ(vec[0] + vec[1] + vec[2] + vec[3], "cabc");
+  it = vec.erase(vec.begin());
+  EXPECT_EQ(*it, "a");
+  it = vec.erase(vec.begin() + 1, vec.end());
+  EXPECT_EQ(it, vec.end());
+  EXPECT_EQ(vec.size(), 1);
+  EXPECT_EQ(vec.front(), "a");
+}
+
+TEST(StaticVectorTest, CopyMoveSwap) {
+  StaticVector<std::unique_ptr<int>, 4> a;
+  a.push_back(std::make_unique<int>(1));
+  a.push_back(std::make_unique<int>(2));
+  a.push_back(std::make_unique<int>(3));
+  StaticVector<std::unique_ptr<int>, 4> b(std::move(a));
+  EXPECT_EQ(*b[2], 3);
+
+  StaticVector<std::unique_ptr<int>, 4> c;
+  c.push_back(std::make_unique<int>(9));
+  c.swap(b);
+  EXPECT_EQ(c.size(), 3);
+  EXPECT_EQ(*c[0], 1);
+  EXPECT_EQ(b.size(), 1);
+  EXPECT_EQ(*b[0], 9);
+
+  StaticVector<std::string, 4> s(3, "x");
+  StaticVector<std::string, 4> t(1, "y");
+  t = s;
+  EXPECT_EQ(t.size(), 3);
+  s = StaticVector<std::string, 4>(1, "z");
+  EXPECT_EQ(s.size(), 1);
+  EXPECT_EQ(s[0], "z");
+}
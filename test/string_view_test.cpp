@@ -0,0 +1,130 @@
+#include "../src/string_view.h"
+#include "gtest/gtest.h"
+#include "simd_levels.h"
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using tracystl::StringView;
+
+TEST(StringViewTest, Basics) {
+  constexpr StringView empty;
+  static_assert(empty.empty() && empty.size() == 0);
+  constexpr StringView hello("hello");
+  static_assert(hello.size() == 5);
+
+  const char buffer[] = "key=value";
+  StringView v(buffer);
+  EXPECT_EQ(v.data(), buffer);
+  EXPECT_EQ(v.front(), 'k');
+  EXPECT_EQ(v.back(), 'e');
+  EXPECT_EQ(v.substr(4), "value");
+  EXPECT_EQ(v.substr(4).data(), buffer + 4);
+  EXPECT_EQ(v.substr(0, 3), "key");
+  EXPECT_EQ(v.substr(9), "");
+  v.remove_prefix(4);
+  v.remove_suffix(2);
+  EXPECT_EQ(v, "val");
+
+  std::string s = "from std";
+  StringView from_string = s;
+  EXPECT_EQ(from_string.data(), s.data());
+  std::string_view sv = from_string;
+  EXPECT_EQ(sv, "from std");
+  EXPECT_EQ(StringView(sv), "from std");
+}
+
+TEST(StringViewTest, CompareAndOrder) {
+  EXPECT_EQ(StringView("abc").compare("abc"), 0);
+  EXPECT_LT(StringView("abc").compare("abd"), 0);
+  EXPECT_LT(StringView("ab").compare("abc"), 0);
+  EXPECT_GT(StringView("abc").compare("ab"), 0);
+  EXPECT_GT(StringView("b").compare("abc"), 0);
+  EXPECT_TRUE(StringView("") == StringView());
+  EXPECT_TRUE(StringView("a") < StringView("b"));
+  EXPECT_TRUE(StringView("b") >= StringView("b"));
+  EXPECT_TRUE(StringView("abc") != StringView("abd"));
+  // bytes compare as unsigned, like std::string
+  EXPECT_LT(StringView("a").compare("\xff"), 0);
+
+  StringView v("GET /index.html HTTP/1.1");
+  EXPECT_TRUE(v.starts_with("GET "));
+  EXPECT_TRUE(v.starts_with('G'));
+  EXPECT_FALSE(v.starts_with("POST"));
+  EXPECT_TRUE(v.ends_with("1.1"));
+  EXPECT_TRUE(v.ends_with(""));
+  EXPECT_FALSE(StringView().ends_with('x'));
+  EXPECT_TRUE(v.contains("index"));
+  EXPECT_FALSE(v.contains("indeX"));
+}
+
+TEST(StringViewTest, FindMatchesStd) {
+  std::mt19937 rng(1);
+  // a small alphabet makes partial matches of the first and last needle
+  // characters common
+  std::string haystack;
+  for (int i = 0; i < 3000; ++i) {
+    haystack.push_back(static_cast<char>('a' + rng() % 3));
+  }
+  std::vector<std::string> needles = {"", "a", "ab", "abc", "cab", "aaaa"};
+  for (int i = 0; i < 40; ++i) {
+    const size_t pos = rng() % haystack.size();
+    const size_t len = 2 + rng() % 40;
+    needles.push_back(haystack.substr(pos, len));
+  }
+  needles.push_back(haystack.substr(haystack.size() - 17));
+  needles.push_back(haystack + "a");
+  needles.push_back(std::string(40, 'd'));
+
+  for_each_level([&] {
+    for (size_t n : {0u, 1u, 15u, 16u, 31u, 33u, 64u, 100u, 3000u}) {
+      const std::string h = haystack.substr(0, n);
+      const StringView view(h);
+      for (const std::string& needle : needles) {
+        for (size_t pos : {0u, 1u, 7u, 50u}) {
+          ASSERT_EQ(view.find(needle, pos), h.find(needle, pos))
+              << "n=" << n << " needle=" << needle << " pos=" << pos;
+        }
+        ASSERT_EQ(view.rfind(needle), h.rfind(needle));
+      }
+      for (char ch : {'a', 'c', 'd'}) {
+        ASSERT_EQ(view.find(ch, 3), h.find(ch, 3));
+        ASSERT_EQ(view.rfind(ch), h.rfind(ch));
+        ASSERT_EQ(view.rfind(ch, 10), h.rfind(ch, 10));
+      }
+    }
+  });
+}
+
+TEST(StringViewTest, FindFirstOf) {
+  StringView v("  name : value\r\n");
+  EXPECT_EQ(v.find_first_not_of(" "), 2u);
+  EXPECT_EQ(v.find_first_of(":"), 7u);
+  EXPECT_EQ(v.find_first_of("\r\n"), 14u);
+  EXPECT_EQ(v.find_first_of("xyz"), StringView::npos);
+  EXPECT_EQ(v.find_first_not_of(" namevlu:\r\n"), StringView::npos);
+  EXPECT_EQ(v.find_first_of(":", 8), StringView::npos);
+}
+
+TEST(StringViewTest, PopTokenDoesNotCopy) {
+  const std::string buffer = "alpha,beta,,gamma";
+  StringView rest(buffer);
+  std::vector<StringView> tokens;
+  while (!rest.empty()) {
+    tokens.push_back(rest.pop_token(','));
+  }
+  ASSERT_EQ(tokens.size(), 4u);
+  EXPECT_EQ(tokens[0], "alpha");
+  EXPECT_EQ(tokens[1], "beta");
+  EXPECT_EQ(tokens[2], "");
+  EXPECT_EQ(tokens[3], "gamma");
+  EXPECT_EQ(tokens[1].data(), buffer.data() + 6);
+  EXPECT_EQ(tokens[3].data(), buffer.data() + 12);
+}
+
+TEST(StringViewTest, HashMatchesStdString) {
+  EXPECT_EQ(std::hash<StringView>()("some key"),
+            std::hash<std::string>()("some key"));
+}
@@ -0,0 +1,128 @@
+#include "../src/thread_cache_allocator.h"
+#include "../src/list.h"
+#include "../src/vector.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using tracystl::ThreadCacheAllocator;
+
+TEST(ThreadCacheAllocatorTest, ReusesFreedObjectsOnSameThread) {
+  ThreadCacheAllocator<int64_t> alloc;
+  int64_t* p = alloc.allocate(3);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 16, 0u);
+  alloc.deallocate(p, 3);
+  // 24 and 32 bytes share a size class, served from this thread's free list
+  EXPECT_EQ(alloc.allocate(4), p);
+  alloc.deallocate(p, 4);
+
+  // large requests bypass the caches
+  int64_t* big = alloc.allocate(1000);
+  big[999] = 1;
+  alloc.deallocate(big, 1000);
+}
+
+TEST(ThreadCacheAllocatorTest, WorksInsideContainers) {
+  tracystl::Vector<std::string, ThreadCacheAllocator<std::string>> vec;
+  tracystl::List<int, ThreadCacheAllocator<int>> list;
+  for (int i = 0; i < 10000; ++i) {
+    vec.push_back(std::to_string(i));
+    list.push_back(i);
+  }
+  EXPECT_EQ(vec[9999], "9999");
+  EXPECT_EQ(list.back(), 9999);
+}
+
+TEST(ThreadCacheAllocatorTest, CrossThreadFree) {
+  const int kThreads = 4;
+  const int kObjects = 20000;
+  std::vector<std::vector<int*>> produced(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&produced, t] {
+      ThreadCacheAllocator<int> alloc;
+      for (int i = 0; i < kObjects; ++i) {
+        int* p = alloc.allocate(1);
+        *p = t * kObjects + i;
+        produced[t].push_back(p);
+      }
+    });
+  }
+  for (auto& th : threads) th.join();
+  threads.clear();
+
+  // every thread frees the objects another (already finished) thread made,
+  // while allocating new ones of the same class
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&produced, t] {
+      ThreadCacheAllocator<int> alloc;
+      std::vector<int*>& victims = produced[(t + 1) % kThreads];
+      for (int i = 0; i < kObjects; ++i) {
+        EXPECT_EQ(*victims[i], ((t + 1) % kThreads) * kObjects + i);
+        alloc.deallocate(victims[i], 1);
+        int* fresh = alloc.allocate(1);
+        *fresh = -1;
+        alloc.deallocate(fresh, 1);
+      }
+    });
+  }
+  for (auto& th : threads) th.join();
+}
+
+TEST(ThreadCacheAllocatorTest, FetchHandsOutFreeObjectsBeforeCarving) {
+  using namespace tracystl::thread_cache_detail;
+  // 1008 bytes, a class no other test touches; one span holds 65 objects
+  const std::size_t cls = kNumClasses - 2;
+  const std::size_t per_span = kSpanSize / class_size(cls);
+  central_cache& central = central_cache::instance();
+  batch a = central.fetch(cls);
+  batch b = central.fetch(cls);
+  ASSERT_EQ(a.count_, kBatchSize);
+  ASSERT_EQ(b.count_, kBatchSize);
+  batch few = a.take(5);
+  free_object* first = few.head_;
+  central.give_back(cls, few);
+  // fewer than a batch is free: that is handed out, no new span is carved
+  batch c = central.fetch(cls);
+  EXPECT_EQ(c.count_, per_span - 2 * kBatchSize + 5);
+  EXPECT_EQ(c.head_, first);
+  central.give_back(cls, a);
+  central.give_back(cls, b);
+  central.give_back(cls, c);
+}
+
+namespace {
+
+// Built before the thread's cache, so destroyed after it: its destructor
+// frees and allocates while the thread is exiting.
+struct late_user {
+  int* held = nullptr;
+  bool saw_destroyed_cache = false;
+  bool* report = nullptr;
+  ~late_user() {
+    saw_destroyed_cache =
+        tracystl::thread_cache_detail::thread_cache::destroyed();
+    ThreadCacheAllocator<int>::deallocate(held, 1);
+    int* p = ThreadCacheAllocator<int>::allocate(1);
+    *p = 7;
+    ThreadCacheAllocator<int>::deallocate(p, 1);
+    *report = saw_destroyed_cache;
+  }
+};
+
+}  // namespace
+
+TEST(ThreadCacheAllocatorTest, FreeDuringThreadExit) {
+  bool saw_destroyed_cache = false;
+  std::thread([&saw_destroyed_cache] {
+    static thread_local late_user user;
+    user.report = &saw_destroyed_cache;
+    user.held = ThreadCacheAllocator<int>::allocate(1);
+  }).join();
+  EXPECT_TRUE(saw_destroyed_cache);
+}
@@ -0,0 +1,153 @@
+#include "../src/thread_pool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using tracystl::ThreadPool;
+using tracystl::WorkStealingDeque;
+
+namespace {
+
+long fib(ThreadPool& pool, int n) {
+  if (n < 2) {
+    return n;
+  }
+  long a = 0;
+  long b = 0;
+  pool.fork_join([&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+  return a + b;
+}
+
+}  // namespace
+
+TEST(ThreadPoolTest, DequeIsLifoForOwnerFifoForThieves) {
+  WorkStealingDeque<int> deque(2);
+  int out = 0;
+  EXPECT_FALSE(deque.pop(out));
+  EXPECT_FALSE(deque.steal(out));
+  // grows past the initial capacity
+  for (int i = 0; i < 100; ++i) {
+    deque.push(i);
+  }
+  EXPECT_EQ(deque.size_approx(), 100u);
+  ASSERT_TRUE(deque.pop(out));
+  EXPECT_EQ(out, 99);
+  ASSERT_TRUE(deque.steal(out));
+  EXPECT_EQ(out, 0);
+  ASSERT_TRUE(deque.steal(out));
+  EXPECT_EQ(out, 1);
+  for (int expected = 98; expected >= 2; --expected) {
+    ASSERT_TRUE(deque.pop(out));
+    EXPECT_EQ(out, expected);
+  }
+  EXPECT_FALSE(deque.pop(out));
+  EXPECT_EQ(deque.size_approx(), 0u);
+}
+
+TEST(ThreadPoolTest, DequeHandsOutEveryElementOnce) {
+  constexpr int kItems = 200000;
+  constexpr int kThieves = 3;
+  WorkStealingDeque<int> deque;
+  std::vector<std::atomic<int>> seen(kItems);
+  std::atomic<bool> done{false};
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kThieves; ++i) {
+    thieves.emplace_back([&] {
+      int out = 0;
+      while (!done.load()) {
+        if (deque.steal(out)) {
+          seen[out].fetch_add(1);
+        }
+      }
+      while (deque.steal(out)) {
+        seen[out].fetch_add(1);
+      }
+    });
+  }
+  int out = 0;
+  for (int i = 0; i < kItems; ++i) {
+    deque.push(i);
+    // pop every other push so the owner races the thieves for the bottom
+    if (i % 2 == 1 && deque.pop(out)) {
+      seen[out].fetch_add(1);
+    }
+  }
+  while (deque.pop(out)) {
+    seen[out].fetch_add(1);
+  }
+  done.store(true);
+  for (std::thread& t : thieves) {
+    t.join();
+  }
+  for (int i = 0; i < kItems; ++i) {
+    ASSERT_EQ(seen[i].load(), 1) << i;
+  }
+}
+
+TEST(ThreadPoolTest, ForkJoin) {
+  for (size_t threads : {1, 2, 4}) {
+    ThreadPool pool(threads);
+    EXPECT_EQ(pool.size(), threads);
+    long result = 0;
+    pool.run([&] { result = fib(pool, 22); });
+    EXPECT_EQ(result, 17711);
+    // outside the pool fork_join just runs both
+    EXPECT_EQ(fib(pool, 10), 55);
+  }
+}
+
+TEST(ThreadPoolTest, RunFromManyThreadsAndNested) {
+  ThreadPool pool(3);
+  std::atomic<long> total{0};
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i) {
+    callers.emplace_back([&] {
+      for (int j = 0; j < 50; ++j) {
+        pool.run([&] {
+          EXPECT_TRUE(pool.in_pool());
+          // a nested run executes inline on the worker
+          pool.run([&] { total.fetch_add(fib(pool, 10)); });
+        });
+      }
+    });
+  }
+  for (std::thread& t : callers) {
+    t.join();
+  }
+  EXPECT_EQ(total.load(), 4 * 50 * 55);
+  EXPECT_FALSE(pool.in_pool());
+  EXPECT_GE(ThreadPool::default_pool().size(), 1u);
+}
+
+TEST(ThreadPoolTest, ExceptionsPropagate) {
+  ThreadPool pool(2);
+  EXPECT_THROW(pool.run([] { throw std::runtime_error("root"); }),
+               std::runtime_error);
+  std::atomic<int> ran{0};
+  EXPECT_THROW(pool.run([&] {
+                 pool.fork_join([&] { ran.fetch_add(1); },
+                                [&] {
+                                  ran.fetch_add(1);
+                                  throw std::logic_error("forked");
+                                });
+               }),
+               std::logic_error);
+  // when the first half throws the forked half still runs before unwinding
+  EXPECT_THROW(pool.run([&] {
+                 pool.fork_join(
+                     [&] {
+                       ran.fetch_add(1);
+                       throw std::logic_error("first");
+                     },
+                     [&] { ran.fetch_add(1); });
+               }),
+               std::logic_error);
+  EXPECT_EQ(ran.load(), 4);
+  // the pool is still usable
+  long result = 0;
+  pool.run([&] { result = fib(pool, 15); });
+  EXPECT_EQ(result, 610);
+}
@@ -0,0 +1,212 @@
+#include "../src/tracy_string.h"
+#include "../src/hash_map.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <string>
+#include <utility>
+
+using tracystl::String;
+using tracystl::StringView;
+
+namespace {
+
+// Allocator<char> that counts live buffers and allocations
+struct counting_allocator : tracystl::Allocator<char> {
+  static int allocations;
+  static int live;
+  char* allocate(size_t n) {
+    ++allocations;
+    ++live;
+    return tracystl::Allocator<char>::allocate(n);
+  }
+  void deallocate(char* p, size_t n) {
+    --live;
+    tracystl::Allocator<char>::deallocate(p, n);
+  }
+};
+int counting_allocator::allocations = 0;
+int counting_allocator::live = 0;
+
+typedef tracystl::BasicString<counting_allocator> CountedString;
+
+}  // namespace
+
+TEST(StringTest, Layout) {
+  EXPECT_EQ(sizeof(String), 3 * sizeof(void*));
+  EXPECT_EQ(String::short_capacity, 3 * sizeof(void*) - 1);
+  String s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.capacity(), String::short_capacity);
+  EXPECT_STREQ(s.c_str(), "");
+}
+
+TEST(StringTest, ShortStringsStayInline) {
+  counting_allocator::allocations = 0;
+  {
+    std::string expected;
+    for (size_t n = 0; n <= CountedString::short_capacity; ++n) {
+      CountedString s(expected.c_str());
+      EXPECT_EQ(s.size(), n);
+      EXPECT_EQ(s, expected);
+      EXPECT_EQ(s.c_str()[n], '\0');
+      // the string lives inside the object
+      EXPECT_GE(s.data(), reinterpret_cast<const char*>(&s));
+      EXPECT_LT(s.data(), reinterpret_cast<const char*>(&s + 1));
+      expected.push_back(static_cast<char>('a' + n));
+    }
+    EXPECT_EQ(counting_allocator::allocations, 0);
+    CountedString s(expected.c_str());
+    EXPECT_EQ(counting_allocator::allocations, 1);
+    EXPECT_EQ(s, expected);
+    EXPECT_EQ(s.capacity(), expected.size());
+  }
+  EXPECT_EQ(counting_allocator::live, 0);
+}
+
+TEST(StringTest, AppendGrowsGeometrically) {
+  counting_allocator::allocations = 0;
+  {
+    CountedString s;
+    std::string expected;
+    for (int i = 0; i < 100000; ++i) {
+      const char ch = static_cast<char>('a' + i % 26);
+      if (i % 3 == 0) {
+        s += ch;
+        expected += ch;
+      } else {
+        s.append("xy");
+        expected.append("xy");
+      }
+    }
+    EXPECT_EQ(s, expected);
+    EXPECT_EQ(s.c_str()[s.size()], '\0');
+    EXPECT_LE(counting_allocator::allocations, 20);
+    EXPECT_EQ(counting_allocator::live, 1);
+  }
+  EXPECT_EQ(counting_allocator::live, 0);
+}
+
+TEST(StringTest, MatchesStdString) {
+  std::mt19937 rng(3);
+  String s;
+  std::string expected;
+  for (int step = 0; step < 5000; ++step) {
+    const size_t len = rng() % 40;
+    const std::string piece(len, static_cast<char>('a' + rng() % 26));
+    const size_t pos = expected.empty() ? 0 : rng() % (expected.size() + 1);
+    switch (rng() % 7) {
+      case 0:
+        s.append(piece);
+        expected.append(piece);
+        break;
+      case 1:
+        s.insert(pos, piece);
+        expected.insert(pos, piece);
+        break;
+      case 2:
+        s.erase(pos, len);
+        expected.erase(pos, len);
+        break;
+      case 3:
+        s.resize(len * 3, 'z');
+        expected.resize(len * 3, 'z');
+        break;
+      case 4:
+        s.assign(piece);
+        expected.assign(piece);
+        break;
+      case 5:
+        s.shrink_to_fit();
+        break;
+      case 6:
+        if (!expected.empty()) {
+          s.pop_back();
+          expected.pop_back();
+        }
+        break;
+    }
+    ASSERT_EQ(s, expected);
+    ASSERT_EQ(s.c_str()[s.size()], '\0');
+    ASSERT_GE(s.capacity(), s.size());
+  }
+}
+
+TEST(StringTest, SelfAliasing) {
+  String s("0123456789");
+  s.append(s);
+  EXPECT_EQ(s, "01234567890123456789");
+  s.append(s);
+  EXPECT_EQ(s, "0123456789012345678901234567890123456789");
+  s.assign(s.view().substr(10, 5));
+  EXPECT_EQ(s, "01234");
+  s.insert(2, s);
+  EXPECT_EQ(s, "0101234234");
+  s.insert(0, s.view().substr(5));
+  EXPECT_EQ(s, "342340101234234");
+  String big(30, 'x');
+  big.insert(15, big.view().substr(0, 20));
+  EXPECT_EQ(big, String(50, 'x'));
+}
+
+TEST(StringTest, CopyMoveSwap) {
+  counting_allocator::allocations = 0;
+  {
+    CountedString short_one("short");
+    CountedString long_one("a string that is too long to be stored inline");
+    CountedString copy(long_one);
+    EXPECT_EQ(copy, long_one);
+    EXPECT_NE(copy.data(), long_one.data());
+    const char* buffer = long_one.data();
+    CountedString moved(std::move(long_one));
+    EXPECT_EQ(moved.data(), buffer);
+    EXPECT_TRUE(long_one.empty());
+    swap(moved, short_one);
+    EXPECT_EQ(moved, "short");
+    EXPECT_EQ(short_one.data(), buffer);
+    moved = std::move(short_one);
+    EXPECT_EQ(moved.data(), buffer);
+    copy = moved;
+    EXPECT_EQ(copy, moved);
+    copy = "tiny";
+    EXPECT_EQ(copy, "tiny");
+    copy.shrink_to_fit();
+    EXPECT_EQ(copy.capacity(), CountedString::short_capacity);
+    EXPECT_EQ(counting_allocator::live, 1);
+  }
+  EXPECT_EQ(counting_allocator::live, 0);
+}
+
+TEST(StringTest, SearchAndCompare) {
+  String s("Content-Type: text/plain; charset=utf-8");
+  EXPECT_EQ(s.find("charset"), 26u);
+  EXPECT_EQ(s.find(':'), 12u);
+  EXPECT_EQ(s.rfind('-'), 37u);
+  EXPECT_EQ(s.find("nope"), String::npos);
+  EXPECT_TRUE(s.starts_with("Content-"));
+  EXPECT_TRUE(s.ends_with("utf-8"));
+  EXPECT_TRUE(s.contains("text/plain"));
+  EXPECT_EQ(s.substr(14, 10), "text/plain");
+  EXPECT_EQ(s.find_first_of(";="), 24u);
+
+  EXPECT_TRUE(String("abc") == String("abc"));
+  EXPECT_TRUE(String("abc") < String("abd"));
+  EXPECT_TRUE(String("abc") == "abc");
+  EXPECT_TRUE("abc" == String("abc"));
+  EXPECT_TRUE(StringView("abc") == String("abc"));
+  EXPECT_TRUE(String("b") > StringView("a"));
+  EXPECT_EQ(String("key") + StringView("=value"), "key=value");
+}
+
+TEST(StringTest, HashMapKeys) {
+  tracystl::HashMap<String, int> counts;
+  StringView text = "get,set,get,del,get,set";
+  while (!text.empty()) {
+    ++counts[String(text.pop_token(','))];
+  }
+  EXPECT_EQ(counts.size(), 3u);
+  EXPECT_EQ(counts[String("get")], 3);
+  EXPECT_EQ(counts[String("set")], 2);
+  EXPECT_EQ(std::hash<String>()(String("get")),
+            std::hash<std::string>()("get"));
+}
@@ -0,0 +1,245 @@
+#include "../src/unrolled_list.h"
+#include "gtest/gtest.h"
+
+#include <array>
+#include <list>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+using tracystl::UnrolledList;
+
+namespace {
+// walks the list both ways and compares it with the reference
+template <class List, class Ref>
+void expect_same(const List& list, const Ref& expected) {
+  ASSERT_EQ(list.size(), expected.size());
+  auto it = list.begin();
+  for (auto ex = expected.begin(); ex != expected.end(); ++ex, ++it) {
+    ASSERT_EQ(*it, *ex);
+  }
+  EXPECT_EQ(it, list.end());
+  for (auto ex = expected.rbegin(); ex != expected.rend(); ++ex) {
+    --it;
+    ASSERT_EQ(*it, *ex);
+  }
+  EXPECT_EQ(it, list.begin());
+}
+
+struct throws_on_value {
+  explicit throws_on_value(int v) : value(v) {
+    if (v < 0) {
+      throw std::runtime_error("negative");
+    }
+  }
+  int value;
+  bool operator==(const throws_on_value& rhs) const {
+    return value == rhs.value;
+  }
+};
+}  // namespace
+
+TEST(UnrolledListTest, IteratorCategory) {
+  typedef UnrolledList<int>::iterator iterator;
+  static_assert(std::is_same<iterator::iterator_category,
+                             tracystl::bidirectional_iterator_tag>::value);
+  static_assert(
+      std::is_convertible<iterator, UnrolledList<int>::const_iterator>::value);
+  static_assert(UnrolledList<int>::node_values >= 32);
+  // huge elements still get a few per chunk
+  static_assert(UnrolledList<std::array<char, 1000>>::node_values == 4);
+}
+
+TEST(UnrolledListTest, PushPopBothEnds) {
+  UnrolledList<int> list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.begin(), list.end());
+  std::list<int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 3 == 0) {
+      list.push_front(i);
+      expected.push_front(i);
+    } else {
+      list.push_back(i);
+      expected.push_back(i);
+    }
+  }
+  expect_same(list, expected);
+  EXPECT_EQ(list.front(), expected.front());
+  EXPECT_EQ(list.back(), expected.back());
+  // appending at either end fills chunks completely
+  const size_t per_node = UnrolledList<int>::node_values;
+  EXPECT_LE(list.node_count(), 1000 / per_node + 3);
+
+  for (int i = 0; i < 600; ++i) {
+    if (i % 2 == 0) {
+      list.pop_front();
+      expected.pop_front();
+    } else {
+      list.pop_back();
+      expected.pop_back();
+    }
+  }
+  expect_same(list, expected);
+  list.clear();
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.node_count(), 0u);
+  list.push_back(7);
+  expect_same(list, std::list<int>{7});
+}
+
+TEST(UnrolledListTest, InsertReturnsInserted) {
+  UnrolledList<int, tracystl::Allocator<int>, 64> list{1, 2, 3, 4, 5, 6, 7,
+                                                       8, 9, 10, 11, 12};
+  std::list<int> expected{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  auto it = list.begin();
+  auto ex = expected.begin();
+  for (int i = 0; i < 5; ++i, ++it, ++ex) {
+  }
+  // repeated inserts at the same spot split full chunks
+  for (int v = 100; v < 140; ++v) {
+    it = list.insert(it, v);
+    ex = expected.insert(ex, v);
+    ASSERT_EQ(*it, v);
+  }
+  expect_same(list, expected);
+  it = list.insert(list.end(), -1);
+  EXPECT_EQ(*it, -1);
+  EXPECT_EQ(++it, list.end());
+}
+
+TEST(UnrolledListTest, EraseReturnsNext) {
+  UnrolledList<int, tracystl::Allocator<int>, 128> list;
+  std::list<int> expected;
+  for (int i = 0; i < 500; ++i) {
+    list.push_back(i);
+    expected.push_back(i);
+  }
+  // erase every other element, which drives chunks below a quarter full
+  // and makes them merge or borrow
+  auto it = list.begin();
+  auto ex = expected.begin();
+  while (it != list.end()) {
+    it = list.erase(it);
+    ex = expected.erase(ex);
+    if (ex == expected.end()) {
+      ASSERT_EQ(it, list.end());
+      break;
+    }
+    ASSERT_EQ(*it, *ex);
+    ++it;
+    ++ex;
+  }
+  expect_same(list, expected);
+  const size_t per_node = decltype(list)::node_values;
+  // chunks stay at least about a quarter full
+  EXPECT_LE(list.node_count(), 4 * expected.size() / per_node + 2);
+
+  // erasing the last element returns end()
+  it = --list.end();
+  ex = --expected.end();
+  EXPECT_EQ(list.erase(it), list.end());
+  expected.erase(ex);
+  expect_same(list, expected);
+  while (!list.empty()) {
+    it = list.erase(--list.end());
+    EXPECT_EQ(it, list.end());
+    expected.pop_back();
+    expect_same(list, expected);
+  }
+  EXPECT_EQ(list.node_count(), 0u);
+}
+
+TEST(UnrolledListTest, MatchesStdList) {
+  std::mt19937 rng(42);
+  UnrolledList<std::string, tracystl::Allocator<std::string>, 128> list;
+  std::list<std::string> expected;
+  for (int step = 0; step < 20000; ++step) {
+    size_t pos = expected.empty() ? 0 : rng() % (expected.size() + 1);
+    auto it = list.begin();
+    auto ex = expected.begin();
+    for (size_t i = 0; i < pos; ++i, ++it, ++ex) {
+    }
+    if (rng() % 5 < 3 || ex == expected.end()) {
+      std::string value = std::to_string(step) + std::string(20, 'x');
+      it = list.insert(it, value);
+      ex = expected.insert(ex, value);
+      ASSERT_EQ(*it, *ex);
+    } else {
+      it = list.erase(it);
+      ex = expected.erase(ex);
+      ASSERT_EQ(it == list.end(), ex == expected.end());
+      if (ex != expected.end()) {
+        ASSERT_EQ(*it, *ex);
+      }
+    }
+    if (step % 997 == 0) {
+      expect_same(list, expected);
+    }
+  }
+  expect_same(list, expected);
+}
+
+TEST(UnrolledListTest, NonRelocatableElements) {
+  UnrolledList<std::unique_ptr<int>, tracystl::Allocator<std::unique_ptr<int>>,
+               64>
+      list;
+  for (int i = 0; i < 100; ++i) {
+    list.insert(list.begin(), std::make_unique<int>(i));
+  }
+  int expected = 99;
+  for (const auto& p : list) {
+    ASSERT_EQ(*p, expected--);
+  }
+  list.emplace_back(new int(-1));
+  EXPECT_EQ(*list.back(), -1);
+}
+
+TEST(UnrolledListTest, ThrowingConstructorLeavesListIntact) {
+  UnrolledList<throws_on_value, tracystl::Allocator<throws_on_value>, 64>
+      list;
+  std::list<throws_on_value> expected;
+  for (int i = 0; i < 40; ++i) {
+    list.emplace_back(i);
+    expected.emplace_back(i);
+  }
+  auto it = list.begin();
+  for (int i = 0; i < 17; ++i, ++it) {
+  }
+  EXPECT_THROW(list.emplace(it, -1), std::runtime_error);
+  EXPECT_THROW(list.emplace(list.end(), -1), std::runtime_error);
+  EXPECT_THROW(list.emplace(list.begin(), -1), std::runtime_error);
+  expect_same(list, expected);
+  UnrolledList<throws_on_value> empty;
+  EXPECT_THROW(empty.emplace_back(-1), std::runtime_error);
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.node_count(), 0u);
+}
+
+TEST(UnrolledListTest, PoolAllocatedNodes) {
+  UnrolledList<int, tracystl::PoolAllocator<int>> list;
+  std::list<int> expected;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 2000; ++i) {
+      list.push_back(i);
+      expected.push_back(i);
+    }
+    auto it = list.begin();
+    auto ex = expected.begin();
+    while (it != list.end()) {
+      it = list.erase(it);
+      ex = expected.erase(ex);
+      if (it != list.end()) {
+        ++it;
+        ++ex;
+      }
+    }
+    expect_same(list, expected);
+  }
+  list.clear();
+  EXPECT_TRUE(list.empty());
+  list.push_front(1);
+  EXPECT_EQ(list.front(), 1);
+}
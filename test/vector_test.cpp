@@ -1,8 +1,12 @@
 #include "../src/vector.h"
+#include "../src/instrumented_allocator.h"
 
 #include "../src/iterator.h"
 #include "gtest/gtest.h"
 
+#include <memory>
+#include <string>
+
 
 using tracystl::iterator;
 using tracystl::Vector;
@@ -79,7 +83,220 @@ TEST(VectorTest, Modifiers) {
   for (int i = 0; i < 5; ++i) {
     vec.push_back(i);
   }
-  // vec.insert(vec.begin() + 2, 3);
-  // EXPECT_EQ(vec.size(), 6);
-  // EXPECT_EQ(vec[2], 3);
+  vec.insert(vec.begin() + 2, 3);
+  EXPECT_EQ(vec.size(), 6);
+  EXPECT_EQ(vec[2], 3);
+  EXPECT_EQ(vec[3], 2);
+}
+
+namespace {
+// counts how elements are carried over when the vector grows
+struct Tracked {
+  static int copies;
+  static int moves;
+  int value;
+  explicit Tracked(int v) : value(v) {}
+  Tracked(const Tracked& rhs) : value(rhs.value) { ++copies; }
+  Tracked(Tracked&& rhs) noexcept : value(rhs.value) { ++moves; }
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+// a type that owns a pointer and is safe to memcpy, opted in explicitly
+struct Relocatable {
+  std::unique_ptr<int> p;
+  explicit Relocatable(int v) : p(new int(v)) {}
+};
+}  // namespace
+
+template <>
+struct tracystl::is_trivially_relocatable<Relocatable> : std::true_type {};
+
+TEST(VectorTest, GrowthMovesInsteadOfCopies) {
+  Tracked::copies = Tracked::moves = 0;
+  Vector<Tracked> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(Tracked(i));
+  }
+  // every element is carried over by its noexcept move constructor
+  EXPECT_EQ(Tracked::copies, 0);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(vec[i].value, i);
+  }
+}
+
+TEST(VectorTest, GrowthRelocatesMoveOnlyAndOptInTypes) {
+  Vector<std::unique_ptr<int>> owners;
+  Vector<Relocatable> relocatable;
+  for (int i = 0; i < 33; ++i) {
+    owners.push_back(std::make_unique<int>(i));
+    relocatable.push_back(Relocatable(i));
+  }
+  for (int i = 0; i < 33; ++i) {
+    EXPECT_EQ(*owners[i], i);
+    EXPECT_EQ(*relocatable[i].p, i);
+  }
+}
+
+TEST(VectorTest, PushBackOwnElementWhileGrowing) {
+  Vector<std::string> vec;
+  vec.push_back(std::string(64, 'x'));
+  for (int i = 0; i < 10; ++i) {
+    // size() == capacity() on every power of two, so this reallocates while
+    // the argument still points into the old buffer
+    vec.push_back(vec[0]);
+  }
+  EXPECT_EQ(vec.size(), 11);
+  EXPECT_EQ(vec.back(), std::string(64, 'x'));
+}
+
+TEST(VectorTest, ReserveAndShrinkToFit) {
+  Vector<int> vec;
+  vec.reserve(100);
+  EXPECT_EQ(vec.capacity(), 100);
+  int* data = vec.data();
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(i);
+  }
+  // no reallocation happened after reserve
+  EXPECT_EQ(vec.data(), data);
+  vec.resize(10);
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 10);
+  EXPECT_EQ(vec[9], 9);
+}
+
+TEST(VectorTest, Resize) {
+  Vector<std::string> vec;
+  vec.resize(3);
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec[2], "");
+  vec.resize(5, "tracy");
+  EXPECT_EQ(vec.size(), 5);
+  EXPECT_EQ(vec[2], "");
+  EXPECT_EQ(vec[4], "tracy");
+  vec.resize(1);
+  EXPECT_EQ(vec.size(), 1);
+}
+
+TEST(VectorTest, EmplaceBack) {
+  Tracked::copies = Tracked::moves = 0;
+  Vector<Tracked> vec;
+  vec.reserve(4);
+  Tracked& t = vec.emplace_back(42);
+  EXPECT_EQ(t.value, 42);
+  EXPECT_EQ(Tracked::copies + Tracked::moves, 0);
+
+  Vector<std::string> strings;
+  strings.emplace_back(3, 'a');
+  EXPECT_EQ(strings.back(), "aaa");
+}
+
+TEST(VectorTest, MoveAndCopyAssignment) {
+  Vector<std::string> a(3, "x");
+  Vector<std::string> b(std::move(a));
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(b.size(), 3);
+
+  Vector<std::string> c(10, "y");
+  c = b;  // reuses c's buffer
+  EXPECT_EQ(c.size(), 3);
+  EXPECT_EQ(c[0], "x");
+
+  a = std::move(c);
+  EXPECT_EQ(a.size(), 3);
+  EXPECT_TRUE(c.empty());
+}
+
+TEST(VectorTest, GrowthPolicies) {
+  typedef tracystl::Allocator<int> alloc;
+  Vector<int, alloc, tracystl::vector_growth_1_5x> half;
+  Vector<int, alloc, tracystl::vector_growth_chunk<16>> chunk;
+  for (int i = 0; i < 5; ++i) {
+    half.push_back(i);
+    chunk.push_back(i);
+  }
+  // 1 -> 2 -> 3 -> 5
+  EXPECT_EQ(half.capacity(), 5);
+  EXPECT_EQ(chunk.capacity(), 16);
+  for (int i = 5; i < 17; ++i) {
+    chunk.push_back(i);
+  }
+  EXPECT_EQ(chunk.capacity(), 32);
+}
+
+namespace {
+// a stateful allocator: every instance reports to its own counter
+template <class T>
+struct CountingAllocator : tracystl::Allocator<T> {
+  template <class U>
+  struct rebind {
+    typedef CountingAllocator<U> other;
+  };
+  int* live;
+  explicit CountingAllocator(int* counter) : live(counter) {}
+  template <class U>
+  CountingAllocator(const CountingAllocator<U>& rhs) : live(rhs.live) {}
+  T* allocate(size_t n) {
+    ++*live;
+    return tracystl::Allocator<T>::allocate(n);
+  }
+  void deallocate(T* ptr, size_t n) {
+    if (ptr != nullptr) --*live;
+    tracystl::Allocator<T>::deallocate(ptr, n);
+  }
+};
+}  // namespace
+
+TEST(VectorTest, StatefulAllocator) {
+  // the default allocator is stored as an empty base
+  static_assert(sizeof(Vector<int>) == 3 * sizeof(int*));
+  // instrumentation is compiled out in this test, and costs nothing
+  static_assert(sizeof(Vector<int, tracystl::InstrumentedAllocator<int>>) ==
+                3 * sizeof(int*));
+
+  int live = 0;
+  {
+    Vector<int, CountingAllocator<int>> vec{CountingAllocator<int>(&live)};
+    for (int i = 0; i < 100; ++i) {
+      vec.push_back(i);
+    }
+    EXPECT_EQ(live, 1);
+    Vector<int, CountingAllocator<int>> copy(vec);
+    EXPECT_EQ(copy.get_allocator().live, &live);
+    EXPECT_EQ(live, 2);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(VectorTest, InsertErase) {
+  // std::string takes the move-assignment path, Relocatable the memmove one
+  Vector<std::string> strings;
+  strings.insert(strings.end(), "c");
+  strings.insert(strings.begin(), "a");
+  strings.emplace(strings.begin() + 1, 1, 'b');
+  // inserting a copy of an element of the vector itself
+  strings.insert(strings.begin(), strings[2]);
+  ASSERT_EQ(strings.size(), 4);
+  EXPECT_EQ(strings[0], "c");
+  EXPECT_EQ(strings[1], "a");
+  EXPECT_EQ(strings[2], "b");
+  EXPECT_EQ(strings[3], "c");
+  auto it = strings.erase(strings.begin());
+  EXPECT_EQ(*it, "a");
+  it = strings.erase(strings.begin() + 1, strings.end());
+  EXPECT_EQ(it, strings.end());
+  ASSERT_EQ(strings.size(), 1);
+  EXPECT_EQ(strings[0], "a");
+
+  Vector<Relocatable> relocatables;
+  for (int i = 0; i < 10; ++i) {
+    relocatables.insert(relocatables.begin(), Relocatable(i));
+  }
+  relocatables.erase(relocatables.begin() + 2, relocatables.begin() + 8);
+  ASSERT_EQ(relocatables.size(), 4);
+  EXPECT_EQ(*relocatables[0].p, 9);
+  EXPECT_EQ(*relocatables[1].p, 8);
+  EXPECT_EQ(*relocatables[2].p, 1);
+  EXPECT_EQ(*relocatables[3].p, 0);
 }